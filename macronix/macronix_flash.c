@@ -1,18 +1,12 @@
 #include "macronix_flash.h"
-#include "nrf_drv_gpiote.h"
 
-#include "nrf_drv_spi.h"
 #include "ruuvi_driver_sensor.h"
 #include "ruuvi_interface_gpio.h"
 #include "ruuvi_interface_log.h"
 #include "ruuvi_interface_spi.h"
-#include "ruuvi_nrf5_sdk15_error.h"
+#include "ruuvi_interface_yield.h"
 #include <stddef.h>
-
-static bool m_spi_init_done = false;
-//New SPI Instance "2" as 0 and 1 are occupied by ruuvi internal SPI
-static const nrf_drv_spi_t spi_macronix = NRF_DRV_SPI_INSTANCE(
-    SPI_INSTANCE_MACRONIX); /**< SPI instance. */
+#include <string.h>
 
 
 #if RI_LOG_ENABLED
@@ -55,37 +49,6 @@ static void test_mx_read(uint32_t address) {
   LOGDf("\r\n");
 }
 
-rd_status_t mx_init(void) {
-  //Return error if SPI is already init
-  if (m_spi_init_done) {
-    return NRF_ERROR_INVALID_STATE;
-  }
-  nrf_drv_spi_config_t spi_config_macronix = NRF_DRV_SPI_DEFAULT_CONFIG;
-  spi_config_macronix.ss_pin = NRF_DRV_SPI_PIN_NOT_USED;
-  spi_config_macronix.miso_pin = MISO_SPI_MACRONIX;
-  spi_config_macronix.mosi_pin = MOSI_SPI_MACRONIX;
-  spi_config_macronix.sck_pin = SCK_SPI_MACRONIX;
-  spi_config_macronix.irq_priority = SPI_DEFAULT_CONFIG_IRQ_PRIORITY;
-  spi_config_macronix.orc = 0xFF;
-  spi_config_macronix.frequency = NRF_DRV_SPI_FREQ_8M;
-  spi_config_macronix.mode = NRF_DRV_SPI_MODE_0;
-  spi_config_macronix.bit_order = NRF_DRV_SPI_BIT_ORDER_MSB_FIRST;
-
-  // Use blocking mode by using NULL as event handler
-  ret_code_t err_code = NRF_SUCCESS;
-  err_code = nrf_drv_spi_init(&spi_macronix, &spi_config_macronix, NULL, NULL);
-
-  //Initialize all SS Pins from SPI_SS_LIST_MACRONIX as output pins and set them high
-  ri_gpio_id_t ss_pins[SPI_SS_NUMBER_MACRONIX] = SPI_SS_LIST_MACRONIX;
-  for (size_t ii = 0; ii < SPI_SS_NUMBER_MACRONIX; ii++) {
-    ri_gpio_configure(ss_pins[ii],
-        RI_GPIO_MODE_OUTPUT_STANDARD);
-    ri_gpio_write(ss_pins[ii], RI_GPIO_HIGH);
-  }
-  m_spi_init_done = true;
-  return (err_code);
-}
-
 rd_status_t mx_read_rems(uint8_t *manufacturer_id, uint8_t *device_id) {
   rd_status_t err_code = RD_SUCCESS;
 
@@ -151,27 +114,87 @@ rd_status_t mx_read_config_register(uint8_t *config) {
   return err_code;
 }
 
+typedef struct {
+  uint8_t opcode;
+  uint8_t dummy_bytes;
+  uint8_t lanes;
+} mx_read_cmd_t;
+
+static const mx_read_cmd_t m_read_cmds[MX_READ_MODES] = {
+  [MX_READ_NORMAL] = {CMD_READ, 0, 1},
+  [MX_READ_FAST] = {CMD_FAST_READ, 1, 1},
+  [MX_READ_DUAL] = {CMD_DREAD, 1, 2},
+  [MX_READ_QUAD] = {CMD_QREAD, 1, 4},
+};
+
+static mx_read_mode_t m_read_mode = MX_READ_NORMAL;
+
 rd_status_t mx_read(uint32_t address, uint8_t *data_ptr, uint32_t data_length) {
-  uint8_t spi_tx_cmd[] = {CMD_READ, (address >> 16) & 0xFF, (address >> 8) & 0xFF, (address >> 0) & 0xFF};
+  const mx_read_cmd_t *cmd = &m_read_cmds[m_read_mode];
+  uint8_t spi_tx_cmd[] = {cmd->opcode, (address >> 16) & 0xFF, (address >> 8) & 0xFF, (address >> 0) & 0xFF, 0x00};
 
   rd_status_t err_code = RD_SUCCESS;
 
   ri_gpio_id_t chipSelect = RB_PORT_PIN_MAP(0, SS_SPI_MACRONIX);
   err_code |= ri_gpio_write(chipSelect, RI_GPIO_LOW);
 
-  err_code |= ri_spi_xfer_blocking_macronix(spi_tx_cmd, sizeof(spi_tx_cmd), 0, 0);
-  while (data_length > 255) {
-    err_code |= ri_spi_xfer_blocking_macronix(0, 0, data_ptr, 255);
-    data_ptr += 255;
-    data_length -= 255;
+  // Dummy cycles are clocked out with the address.
+  err_code |= ri_spi_xfer_blocking_macronix(spi_tx_cmd, sizeof(spi_tx_cmd) - 1 + cmd->dummy_bytes, 0, 0);
+  if (1 == cmd->lanes) {
+    err_code |= ri_spi_xfer_blocking_macronix(0, 0, data_ptr, data_length);
+  } else {
+    err_code |= ri_spi_rx_lanes_macronix(data_ptr, data_length, cmd->lanes);
   }
-  err_code |= ri_spi_xfer_blocking_macronix(0, 0, data_ptr, data_length);
   err_code |= ri_gpio_write(chipSelect, RI_GPIO_HIGH);
 
   return err_code;
 }
 
+rd_status_t mx_read_mode_set(mx_read_mode_t mode) {
+  rd_status_t err_code = RD_SUCCESS;
+
+  if (mode >= MX_READ_MODES) {
+    return RD_ERROR_INVALID_PARAM;
+  }
+
+  if (m_read_cmds[mode].lanes > ri_spi_data_lanes_macronix()) {
+    return RD_ERROR_NOT_SUPPORTED;
+  }
 
+  if (MX_READ_QUAD == mode) {
+    uint8_t status;
+    err_code |= mx_read_status_register(&status);
+
+    if (!(status & (1 << REG_SR_BIT_QE))) {
+      // Write status register alone, configuration registers keep their values.
+      uint8_t spi_tx_cmd[] = {CMD_WRSR, (status & ~((1 << REG_SR_BIT_WIP) | (1 << REG_SR_BIT_WEL))) | (1 << REG_SR_BIT_QE)};
+      mx_spi_ready_for_transfer();
+      ri_gpio_id_t chipSelect = RB_PORT_PIN_MAP(0, SS_SPI_MACRONIX);
+      err_code |= ri_gpio_write(chipSelect, RI_GPIO_LOW);
+      err_code |= ri_spi_xfer_blocking_macronix(spi_tx_cmd, sizeof(spi_tx_cmd), 0, 0);
+      err_code |= ri_gpio_write(chipSelect, RI_GPIO_HIGH);
+
+      while (mx_busy() == RD_ERROR_BUSY) {
+        ri_yield();
+      }
+
+      err_code |= mx_read_status_register(&status);
+      if (!(status & (1 << REG_SR_BIT_QE))) {
+        err_code |= RD_ERROR_INTERNAL;
+      }
+    }
+  }
+
+  if (RD_SUCCESS == err_code) {
+    m_read_mode = mode;
+  }
+
+  return err_code;
+}
+
+mx_read_mode_t mx_read_mode_get(void) {
+  return m_read_mode;
+}
 
 rd_status_t mx_write_enable(void) {
   static uint8_t spi_tx_cmd[] = {CMD_WREN};
@@ -201,6 +224,94 @@ rd_status_t mx_program(uint32_t address, const uint8_t *data_ptr, uint32_t data_
   return err_code;
 }
 
+static mx_write_stats_t m_write_stats;
+
+// Status register is clocked out repeatedly while chip select stays low,
+// so status is read in bursts without new commands or chip select cycles.
+static rd_status_t mx_wait_page_done(void) {
+  static const uint8_t spi_tx_cmd[] = {CMD_RDSR};
+  uint8_t status[MX_STATUS_POLL_BURST];
+  uint32_t polls = 0;
+
+  rd_status_t err_code = RD_SUCCESS;
+
+  ri_gpio_id_t chipSelect = RB_PORT_PIN_MAP(0, SS_SPI_MACRONIX);
+  err_code |= ri_gpio_write(chipSelect, RI_GPIO_LOW);
+  err_code |= ri_spi_xfer_blocking_macronix(spi_tx_cmd, sizeof(spi_tx_cmd), 0, 0);
+  err_code |= ri_spi_xfer_blocking_macronix(0, 0, status, sizeof(status));
+  polls += sizeof(status);
+
+  // Page program takes far longer than one byte, write enable latch is
+  // set until program is done unless page program was rejected.
+  if (!(status[0] & ((1 << REG_SR_BIT_WIP) | (1 << REG_SR_BIT_WEL)))) {
+    err_code |= RD_ERROR_INTERNAL;
+  }
+
+  while ((RD_SUCCESS == err_code) && (status[sizeof(status) - 1] & (1 << REG_SR_BIT_WIP))) {
+    if (polls >= MX_PAGE_POLL_MAX) {
+      err_code |= RD_ERROR_TIMEOUT;
+    } else {
+      err_code |= ri_spi_xfer_blocking_macronix(0, 0, status, sizeof(status));
+      polls += sizeof(status);
+    }
+  }
+
+  err_code |= ri_gpio_write(chipSelect, RI_GPIO_HIGH);
+  m_write_stats.polls += polls;
+  return err_code;
+}
+
+rd_status_t mx_write(uint32_t address, const uint8_t *data_ptr, uint32_t data_length) {
+  rd_status_t err_code = RD_SUCCESS;
+
+  if ((NULL == data_ptr) && (0 != data_length)) {
+    return RD_ERROR_NULL;
+  }
+
+  memset(&m_write_stats, 0, sizeof(m_write_stats));
+
+  // Previous erase or program may still be running.
+  while (mx_busy() == RD_ERROR_BUSY) {
+    ri_yield();
+  }
+
+  const uint64_t start = rd_sensor_timestamp_get();
+
+  while ((RD_SUCCESS == err_code) && (data_length > 0)) {
+    const uint32_t page_left = MX_PAGE_SIZE - (address % MX_PAGE_SIZE);
+    const uint32_t chunk = (data_length < page_left) ? data_length : page_left;
+
+    err_code |= mx_write_enable();
+    err_code |= mx_program(address, data_ptr, chunk);
+    err_code |= mx_wait_page_done();
+
+    if (RD_SUCCESS == err_code) {
+      m_write_stats.bytes += chunk;
+      m_write_stats.pages++;
+      address += chunk;
+      data_ptr += chunk;
+      data_length -= chunk;
+    }
+  }
+
+  m_write_stats.elapsed_ms = (uint32_t)(rd_sensor_timestamp_get() - start);
+
+  if (m_write_stats.elapsed_ms > 0) {
+    m_write_stats.bytes_per_s = (uint32_t)((1000ULL * m_write_stats.bytes)
+        / m_write_stats.elapsed_ms);
+  }
+
+  LOGDf("mx_write: %u bytes, %u pages, %u ms\r\n", (unsigned)m_write_stats.bytes,
+      (unsigned)m_write_stats.pages, (unsigned)m_write_stats.elapsed_ms);
+  return err_code;
+}
+
+void mx_write_stats_get(mx_write_stats_t *stats) {
+  if (NULL != stats) {
+    *stats = m_write_stats;
+  }
+}
+
 rd_status_t mx_sector_erase(uint32_t address) {
   uint8_t spi_tx_cmd[] = {CMD_SECTOR_ERASE, (address >> 16) & 0xFF, (address >> 8) & 0xFF, (address >> 0) & 0xFF};
 
@@ -225,22 +336,6 @@ rd_status_t mx_chip_erase(void) {
   return err_code;
 }
 
-rd_status_t ri_spi_xfer_blocking_macronix(const uint8_t *tx,
-    const size_t tx_len, uint8_t *rx, const size_t rx_len) {
-  //Return error if not init or if given null pointer
-  if (!m_spi_init_done) {
-    return RD_ERROR_INVALID_STATE;
-  }
-
-  if ((NULL == tx && 0 != tx_len) || (NULL == rx && 0 != rx_len)) {
-    return RD_ERROR_NULL;
-  }
-
-  ret_code_t err_code = NRF_SUCCESS;
-  err_code |= nrf_drv_spi_transfer(&spi_macronix, tx, tx_len, rx, rx_len);
-  return ruuvi_nrf5_sdk15_to_ruuvi_error(err_code);
-}
-
 rd_status_t mx_busy(void) {
   uint8_t status_register;
   mx_read_status_register(&status_register);
@@ -279,12 +374,16 @@ void mx_spi_ready_for_transfer (void){
     }
 }
 
-// TODO read register and only change desired bits
+// Configuration register 2 as last written, WRSR is skipped if mode does not change.
+static uint8_t m_config2;
+static bool m_config2_known = false;
+
+void mx_config_cache_invalidate (void){
+  m_config2_known = false;
+}
+
 rd_status_t mx_high_performance_switch (bool high_power){
   rd_status_t err_code = RD_SUCCESS;
-  uint8_t config;
-  err_code |= mx_read_config_register(&config);
-  LOGDf("current config: %x\n",config);
   uint8_t command;
 
   if (high_power==true){
@@ -293,14 +392,23 @@ rd_status_t mx_high_performance_switch (bool high_power){
   else{
   command = 0x00;
   }
-  uint8_t spi_tx_cmd [] = {CMD_WRSR, 0x00, 0x00, command};
-  err_code = RD_SUCCESS;
+
+  if (m_config2_known && (m_config2 == command)){
+    return RD_SUCCESS;
+  }
+
+  // Keep quad enable and block protection bits of status register.
+  uint8_t status;
+  err_code |= mx_read_status_register(&status);
+  status &= ~((1 << REG_SR_BIT_WIP) | (1 << REG_SR_BIT_WEL));
+  uint8_t spi_tx_cmd [] = {CMD_WRSR, status, 0x00, command};
   mx_spi_ready_for_transfer();
   ri_gpio_id_t chipSelect = RB_PORT_PIN_MAP(0, SS_SPI_MACRONIX);
   err_code |= ri_gpio_write(chipSelect, RI_GPIO_LOW);
   err_code |= ri_spi_xfer_blocking_macronix(spi_tx_cmd, sizeof(spi_tx_cmd), 0, 0);
   err_code |= ri_gpio_write(chipSelect, RI_GPIO_HIGH);
-  err_code |= mx_read_config_register(&config);
-  LOGDf("current config: %x\n",config);
+  m_config2 = command;
+  m_config2_known = (RD_SUCCESS == err_code);
+  LOGDf("config written: %x\n", command);
   return err_code;
 }
\ No newline at end of file
@@ -8,6 +8,9 @@
 #define CMD_WRSR                    0x01
 #define CMD_PROGRAM                 0x02
 #define CMD_READ                    0x03
+#define CMD_FAST_READ               0x0B
+#define CMD_DREAD                   0x3B
+#define CMD_QREAD                   0x6B
 #define CMD_RDSR                    0x05
 #define CMD_RDCR                    0x15
 #define CMD_WREN                    0x06
@@ -25,6 +28,11 @@
 #define REG_SR_BIT_QE               6
 #define REG_SR_BIT_SRWD             7
 
+#define MX_PAGE_SIZE                256U   // Page program wraps at page boundary
+#define MX_SECTOR_SIZE              4096U  // Smallest erasable unit
+#define MX_PAGE_POLL_MAX            65536U // Status bytes polled per page, ~65 ms at 8 MHz
+#define MX_STATUS_POLL_BURST        16U    // Status bytes read per transfer while waiting
+
 // SPI definitions for Macronix Flash
 #define SCK_SPI_MACRONIX                  RB_PORT_PIN_MAP(0, 20) // SPI clock GPIO pin number. Original:29, Neu 20
 #define MOSI_SPI_MACRONIX                 RB_PORT_PIN_MAP(0, 30) // SPI Master Out Slave In GPIO pin number. Original:25 Neu 30
@@ -39,6 +47,29 @@
 #define SPI_FREQ_MACRONIX                  SPI_FREQUENCY_1M_MACRONIX
 #define SPI_INSTANCE_MACRONIX              2
 
+// Same mapping as ruuvi.boards, for builds without board definitions.
+#ifndef RB_PORT_PIN_MAP
+#define RB_PORT_PIN_MAP(port, pin)         (((port) << 8) + (pin))
+#endif
+
+// Read command used by mx_read, set with mx_read_mode_set after mx_init.
+typedef enum {
+  MX_READ_NORMAL = 0, // READ, no dummy cycles, lowest maximum clock.
+  MX_READ_FAST,       // FAST_READ, 8 dummy cycles, full clock rate.
+  MX_READ_DUAL,       // DREAD, data on 2 lines, needs 2-lane bus.
+  MX_READ_QUAD,       // QREAD, data on 4 lines, needs 4-lane bus, sets QE.
+  MX_READ_MODES
+} mx_read_mode_t;
+
+// Statistics of the latest mx_write call.
+typedef struct {
+  uint32_t bytes;       // Bytes programmed.
+  uint32_t pages;       // Page program commands issued.
+  uint32_t polls;       // Status register bytes read while waiting.
+  uint32_t elapsed_ms;  // Time from first command to last page done.
+  uint32_t bytes_per_s; // Throughput, 0 if elapsed time is below timer resolution.
+} mx_write_stats_t;
+
 
 
 
@@ -54,16 +85,49 @@ rd_status_t mx_read_config_register(uint8_t *config);
 
 rd_status_t mx_read(uint32_t address, uint8_t * data_ptr, uint32_t data_length);
 
+/*
+ * Select read command used by mx_read. Dual and quad reads are accepted only
+ * if the bus reports enough data lanes, quad read also sets quad enable bit.
+ *
+ * @return RD_SUCCESS | Mode selected.
+ * @return RD_ERROR_INVALID_PARAM | Unknown mode.
+ * @return RD_ERROR_NOT_SUPPORTED | Bus does not have data lanes for mode.
+ */
+rd_status_t mx_read_mode_set(mx_read_mode_t mode);
+
+mx_read_mode_t mx_read_mode_get(void);
+
 rd_status_t mx_write_enable(void);
 
 rd_status_t mx_program(uint32_t address, const uint8_t * data_ptr, uint32_t data_length);
 
+/*
+ * Program data of any length and alignment. Data is split at page boundaries,
+ * each page gets its own write enable and page program and status register is
+ * streamed until the page is done.
+ *
+ * @return RD_SUCCESS | Data was programmed.
+ * @return RD_ERROR_NULL | Data pointer was NULL and length non-zero.
+ * @return RD_ERROR_INTERNAL | Flash did not accept page program.
+ * @return RD_ERROR_TIMEOUT | Page program did not finish in MX_PAGE_POLL_MAX polls.
+ */
+rd_status_t mx_write(uint32_t address, const uint8_t * data_ptr, uint32_t data_length);
+
+void mx_write_stats_get(mx_write_stats_t * stats);
+
 rd_status_t mx_sector_erase(uint32_t address);
 
 rd_status_t mx_chip_erase(void);
 
+// Transfer of any length, platform chains transfers over its DMA length limit.
 rd_status_t ri_spi_xfer_blocking_macronix (const uint8_t * tx,
                                   const size_t tx_len, uint8_t * rx, const size_t rx_len);
+
+// Number of data lanes the platform bus can receive on, 1 for plain SPI.
+uint8_t ri_spi_data_lanes_macronix (void);
+
+// Receive on given number of data lanes, lanes must not exceed ri_spi_data_lanes_macronix.
+rd_status_t ri_spi_rx_lanes_macronix (uint8_t * rx, const size_t rx_len, const uint8_t lanes);
                               
 rd_status_t mx_busy (void);
 
@@ -71,6 +135,10 @@ rd_status_t mx_check_write_enable(void);
 
 void mx_spi_ready_for_transfer (void);
 
+// Switch between high performance and low power mode, WRSR is sent only if mode changes.
 rd_status_t mx_high_performance_switch (bool high_power);
 
+// Forget cached mode, call if flash may have been reset or power cycled.
+void mx_config_cache_invalidate (void);
+
 #endif
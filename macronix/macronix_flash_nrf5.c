@@ -0,0 +1,88 @@
+#include "macronix_flash.h"
+#include "nrf_drv_gpiote.h"
+
+#include "nrf_drv_spi.h"
+#include "ruuvi_interface_gpio.h"
+#include "ruuvi_nrf5_sdk15_error.h"
+#include <stddef.h>
+
+// Longest single EasyDMA transfer of SPIM instance.
+#define MX_SPIM_MAXCNT ((1UL << SPIM2_EASYDMA_MAXCNT_SIZE) - 1UL)
+
+static bool m_spi_init_done = false;
+//New SPI Instance "2" as 0 and 1 are occupied by ruuvi internal SPI
+static const nrf_drv_spi_t spi_macronix = NRF_DRV_SPI_INSTANCE(
+    SPI_INSTANCE_MACRONIX); /**< SPI instance. */
+
+rd_status_t mx_init(void) {
+  //Return error if SPI is already init
+  if (m_spi_init_done) {
+    return NRF_ERROR_INVALID_STATE;
+  }
+  nrf_drv_spi_config_t spi_config_macronix = NRF_DRV_SPI_DEFAULT_CONFIG;
+  spi_config_macronix.ss_pin = NRF_DRV_SPI_PIN_NOT_USED;
+  spi_config_macronix.miso_pin = MISO_SPI_MACRONIX;
+  spi_config_macronix.mosi_pin = MOSI_SPI_MACRONIX;
+  spi_config_macronix.sck_pin = SCK_SPI_MACRONIX;
+  spi_config_macronix.irq_priority = SPI_DEFAULT_CONFIG_IRQ_PRIORITY;
+  spi_config_macronix.orc = 0xFF;
+  spi_config_macronix.frequency = NRF_DRV_SPI_FREQ_8M;
+  spi_config_macronix.mode = NRF_DRV_SPI_MODE_0;
+  spi_config_macronix.bit_order = NRF_DRV_SPI_BIT_ORDER_MSB_FIRST;
+
+  // Use blocking mode by using NULL as event handler
+  ret_code_t err_code = NRF_SUCCESS;
+  err_code = nrf_drv_spi_init(&spi_macronix, &spi_config_macronix, NULL, NULL);
+
+  //Initialize all SS Pins from SPI_SS_LIST_MACRONIX as output pins and set them high
+  ri_gpio_id_t ss_pins[SPI_SS_NUMBER_MACRONIX] = SPI_SS_LIST_MACRONIX;
+  for (size_t ii = 0; ii < SPI_SS_NUMBER_MACRONIX; ii++) {
+    ri_gpio_configure(ss_pins[ii],
+        RI_GPIO_MODE_OUTPUT_STANDARD);
+    ri_gpio_write(ss_pins[ii], RI_GPIO_HIGH);
+  }
+  m_spi_init_done = true;
+  // Mode of flash is not known before it is written.
+  mx_config_cache_invalidate();
+  return (err_code);
+}
+
+rd_status_t ri_spi_xfer_blocking_macronix(const uint8_t *tx,
+    const size_t tx_len, uint8_t *rx, const size_t rx_len) {
+  //Return error if not init or if given null pointer
+  if (!m_spi_init_done) {
+    return RD_ERROR_INVALID_STATE;
+  }
+
+  if ((NULL == tx && 0 != tx_len) || (NULL == rx && 0 != rx_len)) {
+    return RD_ERROR_NULL;
+  }
+
+  // Chain back-to-back EasyDMA transfers while chip select is held,
+  // flash sees one continuous transfer.
+  ret_code_t err_code = NRF_SUCCESS;
+  size_t tx_done = 0;
+  size_t rx_done = 0;
+  do {
+    const size_t tx_chunk = ((tx_len - tx_done) < MX_SPIM_MAXCNT) ? (tx_len - tx_done) : MX_SPIM_MAXCNT;
+    const size_t rx_chunk = ((rx_len - rx_done) < MX_SPIM_MAXCNT) ? (rx_len - rx_done) : MX_SPIM_MAXCNT;
+    err_code |= nrf_drv_spi_transfer(&spi_macronix, (0 == tx_chunk) ? NULL : &tx[tx_done], tx_chunk,
+        (0 == rx_chunk) ? NULL : &rx[rx_done], rx_chunk);
+    tx_done += tx_chunk;
+    rx_done += rx_chunk;
+  } while ((NRF_SUCCESS == err_code) && ((tx_done < tx_len) || (rx_done < rx_len)));
+  return ruuvi_nrf5_sdk15_to_ruuvi_error(err_code);
+}
+
+// SPIM has one data line in each direction.
+uint8_t ri_spi_data_lanes_macronix(void) {
+  return 1;
+}
+
+rd_status_t ri_spi_rx_lanes_macronix(uint8_t *rx, const size_t rx_len, const uint8_t lanes) {
+  if (1 != lanes) {
+    return RD_ERROR_NOT_SUPPORTED;
+  }
+
+  return ri_spi_xfer_blocking_macronix(0, 0, rx, rx_len);
+}
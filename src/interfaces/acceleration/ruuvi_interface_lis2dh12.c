@@ -51,11 +51,13 @@
 #define NM_BIT_DIVEDER       (64U)   //!< Normal mode uses 10 bits in 16 bit field, leading to 2^6 factor in results.
 #define MOTION_THRESHOLD_MAX (0x7FU) //!< Highest threshold value allowed.
 #define PWRON_DELAY_MS       (10U)   //!< Milliseconds from poweron to sensor rdy. 5ms typ.
+#define SINGLE_ODR_HZ        (400U)  //!< Data rate of single sample.
+#define SINGLE_DELAY_MS      ((7000U / SINGLE_ODR_HZ) + 1U) //!< Turn-on time of single sample.
 
 /** @brief Macro for checking that sensor is in sleep mode before configuration */
-#define VERIFY_SENSOR_SLEEPS() do { \
+#define VERIFY_SENSOR_SLEEPS(p_dev) do { \
           uint8_t MACRO_MODE = 0; \
-          ri_lis2dh12_mode_get(&MACRO_MODE); \
+          mode_get(p_dev, &MACRO_MODE); \
           if(RD_SENSOR_CFG_SLEEP != MACRO_MODE) { return RD_ERROR_INVALID_STATE; } \
           } while(0)
 
@@ -66,17 +68,263 @@ typedef union
     uint8_t u8bit[2]; //!< Buffer
 } axis1bit16_t;
 
+#if RI_LIS2DH12_MAX_INSTANCES > 4
+#   error "Over 4 instances of LIS2DH12 is not supported"
+#endif
+
 /**
- * @brief lis2dh12 sensor settings structure.
+ * @brief lis2dh12 sensor settings structure of first instance.
  */
 #ifndef CEEDLING
 static
 #endif
 ri_lis2dh12_dev dev = {0};
+#if RI_LIS2DH12_MAX_INSTANCES > 1
+/** @brief Settings of other instances. */
+static ri_lis2dh12_dev m_dev[RI_LIS2DH12_MAX_INSTANCES - 1U];
+#endif
+/** @brief Settings of each instance, context of application if one was given. */
+static ri_lis2dh12_dev * m_instance[RI_LIS2DH12_MAX_INSTANCES] =
+{
+    &dev,
+#if RI_LIS2DH12_MAX_INSTANCES > 1
+    &m_dev[0],
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 2
+    &m_dev[1],
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 3
+    &m_dev[2],
+#endif
+};
+/** @brief Sensor bound to each instance, NULL if instance is free. */
+static const rd_sensor_t * m_owner[RI_LIS2DH12_MAX_INSTANCES];
 
 static const char m_acc_name[] = "LIS2DH12";
 
-static void lis2dh12_get_samples_selftest (axis3bit16_t * p_data_raw_acceleration)
+static rd_status_t samplerate_get (ri_lis2dh12_dev * const p_dev, uint8_t * samplerate);
+static rd_status_t resolution_get (ri_lis2dh12_dev * const p_dev, uint8_t * resolution);
+static rd_status_t scale_get (ri_lis2dh12_dev * const p_dev, uint8_t * scale);
+static rd_status_t dsp_get (ri_lis2dh12_dev * const p_dev, uint8_t * dsp,
+                            uint8_t * parameter);
+static rd_status_t mode_get (ri_lis2dh12_dev * const p_dev, uint8_t * mode);
+static rd_status_t raw_data_parse (ri_lis2dh12_dev * const p_dev,
+                                   rd_sensor_data_t * const data,
+                                   axis3bit16_t *raw_acceleration,
+                                   uint8_t *raw_temperature);
+static rd_status_t fifo_use (ri_lis2dh12_dev * const p_dev, const bool enable);
+static rd_status_t fifo_interrupt_use (ri_lis2dh12_dev * const p_dev, const bool enable);
+static rd_status_t activity_interrupt_use (ri_lis2dh12_dev * const p_dev,
+                                           const bool enable, float * const limit_g);
+
+/** @brief Conversion of left-justified raw acceleration to mg on one configuration. */
+typedef struct
+{
+    uint8_t shift;        //!< Unused low bits of left-justified data.
+    uint8_t mg_per_digit; //!< Sensitivity of right-justified data.
+} lis2dh12_conversion_t;
+
+/**
+ * Sensitivities, ref datasheet table 4. Index by scale and resolution.
+ * Matches lis2dh12_from_fsX_Y_to_mg functions of STM driver.
+ */
+static const lis2dh12_conversion_t m_conversion[4][3] =
+{
+    [LIS2DH12_2g] =
+    {
+        [LIS2DH12_HR_12bit] = {.shift = 4U, .mg_per_digit = 1U},
+        [LIS2DH12_NM_10bit] = {.shift = 6U, .mg_per_digit = 4U},
+        [LIS2DH12_LP_8bit]  = {.shift = 8U, .mg_per_digit = 16U}
+    },
+    [LIS2DH12_4g] =
+    {
+        [LIS2DH12_HR_12bit] = {.shift = 4U, .mg_per_digit = 2U},
+        [LIS2DH12_NM_10bit] = {.shift = 6U, .mg_per_digit = 8U},
+        [LIS2DH12_LP_8bit]  = {.shift = 8U, .mg_per_digit = 32U}
+    },
+    [LIS2DH12_8g] =
+    {
+        [LIS2DH12_HR_12bit] = {.shift = 4U, .mg_per_digit = 4U},
+        [LIS2DH12_NM_10bit] = {.shift = 6U, .mg_per_digit = 16U},
+        [LIS2DH12_LP_8bit]  = {.shift = 8U, .mg_per_digit = 64U}
+    },
+    [LIS2DH12_16g] =
+    {
+        [LIS2DH12_HR_12bit] = {.shift = 4U, .mg_per_digit = 12U},
+        [LIS2DH12_NM_10bit] = {.shift = 6U, .mg_per_digit = 48U},
+        [LIS2DH12_LP_8bit]  = {.shift = 8U, .mg_per_digit = 192U}
+    }
+};
+
+/**
+ * Look up conversion factors of current scale and resolution.
+ * Factors are zeroed if configuration is unknown.
+ */
+static void conversion_update (ri_lis2dh12_dev * const p_dev)
+{
+    const size_t scales = sizeof (m_conversion) / sizeof (m_conversion[0]);
+    const size_t resolutions = sizeof (m_conversion[0]) / sizeof (m_conversion[0][0]);
+
+    if ( ( (size_t) p_dev->scale < scales) && ( (size_t) p_dev->resolution < resolutions))
+    {
+        const lis2dh12_conversion_t * const p_cnv =
+            &m_conversion[p_dev->scale][p_dev->resolution];
+        p_dev->mg_shift = p_cnv->shift;
+        p_dev->mg_per_digit = p_cnv->mg_per_digit;
+        p_dev->g_per_lsb = (float) p_cnv->mg_per_digit
+                           / (1000.0f * (float) (1UL << p_cnv->shift));
+    }
+    else
+    {
+        p_dev->mg_shift = 0;
+        p_dev->mg_per_digit = 0;
+        p_dev->g_per_lsb = 0;
+    }
+}
+
+/**
+ * Time between samples at given sample rate in nanoseconds.
+ * Returns 0 if sensor is powered down or samplerate is unknown.
+ */
+static uint32_t samplerate_interval_ns (ri_lis2dh12_dev * const p_dev,
+                                        const lis2dh12_odr_t samplerate)
+{
+    uint32_t interval_ns = 0;
+
+    switch (samplerate)
+    {
+        case LIS2DH12_ODR_1Hz:
+            interval_ns = 1000000000U;
+            break;
+
+        case LIS2DH12_ODR_10Hz:
+            interval_ns = 100000000U;
+            break;
+
+        case LIS2DH12_ODR_25Hz:
+            interval_ns = 40000000U;
+            break;
+
+        case LIS2DH12_ODR_50Hz:
+            interval_ns = 20000000U;
+            break;
+
+        case LIS2DH12_ODR_100Hz:
+            interval_ns = 10000000U;
+            break;
+
+        case LIS2DH12_ODR_200Hz:
+            interval_ns = 5000000U;
+            break;
+
+        case LIS2DH12_ODR_400Hz:
+            interval_ns = 2500000U;
+            break;
+
+        case LIS2DH12_ODR_1kHz620_LP:
+            interval_ns = 617284U;
+            break;
+
+        case LIS2DH12_ODR_5kHz376_LP_1kHz344_NM_HP:
+            interval_ns = (LIS2DH12_LP_8bit == p_dev->resolution) ? 186012U : 744048U;
+            break;
+
+        default:
+            interval_ns = 0;
+            break;
+    }
+
+    return interval_ns;
+}
+
+/** Forget measured FIFO timing, e.g. after samplerate change. */
+static void fifo_timing_reset (ri_lis2dh12_dev * const p_dev)
+{
+    p_dev->fifo_drain_ms = RD_UINT64_INVALID;
+    p_dev->fifo_base_ms = RD_UINT64_INVALID;
+    p_dev->fifo_base_samples = 0U;
+    p_dev->fifo_interval_ns = 0;
+}
+
+/** Measured sample interval if known, nominal interval otherwise. */
+static uint32_t fifo_interval_ns (ri_lis2dh12_dev * const p_dev)
+{
+    return (0U != p_dev->fifo_interval_ns) ? p_dev->fifo_interval_ns
+           : samplerate_interval_ns (p_dev, p_dev->samplerate);
+}
+
+/**
+ * Update drift baseline after a FIFO drain.
+ *
+ * Samples read on a drain were sampled after previous drain. Phase of sampling
+ * at drain time is unknown by up to one interval, so samples and time are
+ * accumulated over consecutive drains and interval is estimated only when
+ * baseline is long relative to that error. Full FIFO is counted as long as it
+ * did not overrun. Overrun, a read which left samples on FIFO or a drain
+ * interval which cannot be explained by clock drift, e.g. a delayed timestamp,
+ * restarts the baseline.
+ *
+ * @param[in] now Time of this drain.
+ * @param[in] elements Number of samples read on this drain.
+ * @param[in] drained True if FIFO was emptied on this drain.
+ * @param[in] overrun True if samples may have been overwritten before this drain.
+ */
+static void fifo_timing_update (ri_lis2dh12_dev * const p_dev, const uint64_t now,
+                                const size_t elements, const bool drained,
+                                const bool overrun)
+{
+    const uint64_t nominal_ns = samplerate_interval_ns (p_dev, p_dev->samplerate);
+    bool counted = false;
+
+    if ( (RD_UINT64_INVALID != p_dev->fifo_drain_ms)
+            && (now > p_dev->fifo_drain_ms)
+            && (0U < elements)
+            && drained
+            && (!overrun)
+            && (0U < nominal_ns))
+    {
+        const uint64_t elapsed_ns = (now - p_dev->fifo_drain_ms) * 1000000ULL;
+        const uint64_t expected_ns = elements * nominal_ns;
+        // One interval of slack for sample phase at the drain.
+        const uint64_t tolerance_ns = (expected_ns / RI_LIS2DH12_DRIFT_TOLERANCE_DIV)
+                                      + nominal_ns;
+        counted = (elapsed_ns + tolerance_ns >= expected_ns)
+                  && (elapsed_ns <= expected_ns + tolerance_ns);
+    }
+
+    if (counted)
+    {
+        p_dev->fifo_base_samples += (uint32_t) elements;
+
+        if (RI_LIS2DH12_DRIFT_MIN_SAMPLES <= p_dev->fifo_base_samples)
+        {
+            p_dev->fifo_interval_ns = (uint32_t) ( ( (now - p_dev->fifo_base_ms) * 1000000ULL)
+                                                   / p_dev->fifo_base_samples);
+        }
+    }
+
+    if ( (!counted) || (RI_LIS2DH12_DRIFT_MAX_SAMPLES <= p_dev->fifo_base_samples))
+    {
+        p_dev->fifo_base_ms = now;
+        p_dev->fifo_base_samples = 0U;
+    }
+
+    p_dev->fifo_drain_ms = drained ? now : RD_UINT64_INVALID;
+}
+
+/**
+ * Timestamp of a sample taken given number of intervals before now.
+ * Returns 0 if sample would be older than timestamp counter.
+ */
+static uint64_t fifo_sample_time_ms (const uint64_t now, const size_t age,
+                                     const uint32_t interval_ns)
+{
+    const uint64_t offset_ms = ( (uint64_t) age * interval_ns) / 1000000U;
+    return (now >= offset_ms) ? (now - offset_ms) : 0U;
+}
+
+static void lis2dh12_get_samples_selftest (ri_lis2dh12_dev * const p_dev,
+                                           axis3bit16_t * p_data_raw_acceleration)
 {
     axis3bit16_t data_raw_acceleration = {0};
     int32_t axis_x = 0;
@@ -85,12 +333,12 @@ static void lis2dh12_get_samples_selftest (axis3bit16_t * p_data_raw_acceleratio
     // Start delay
     ri_delay_ms (SELF_TEST_DELAY_MS);
     // Discard first sample
-    lis2dh12_acceleration_raw_get (&dev.ctx, data_raw_acceleration.u8bit);
+    lis2dh12_acceleration_raw_get (&p_dev->ctx, data_raw_acceleration.u8bit);
 
     // Obtain 5 no self test samples
     for (uint8_t i = 0; i < SELF_TEST_SAMPLES_NUM; i++)
     {
-        lis2dh12_acceleration_raw_get (&dev.ctx, data_raw_acceleration.u8bit);
+        lis2dh12_acceleration_raw_get (&p_dev->ctx, data_raw_acceleration.u8bit);
         axis_x += data_raw_acceleration.i16bit[0];
         axis_y += data_raw_acceleration.i16bit[1];
         axis_z += data_raw_acceleration.i16bit[2];
@@ -102,12 +350,13 @@ static void lis2dh12_get_samples_selftest (axis3bit16_t * p_data_raw_acceleratio
 }
 
 // Check that self-test values differ enough
-static rd_status_t lis2dh12_verify_selftest (const axis3bit16_t * const new,
-        const axis3bit16_t * const old)
+static rd_status_t lis2dh12_verify_selftest (ri_lis2dh12_dev * const p_dev,
+                                             const axis3bit16_t * const new,
+                                             const axis3bit16_t * const old)
 {
     rd_status_t err_code = RD_SUCCESS;
 
-    if (LIS2DH12_2g != dev.scale || LIS2DH12_NM_10bit != dev.resolution)
+    if (LIS2DH12_2g != p_dev->scale || LIS2DH12_NM_10bit != p_dev->resolution)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -139,7 +388,7 @@ static rd_status_t lis2dh12_verify_selftest (const axis3bit16_t * const new,
     return err_code;
 }
 
-static rd_status_t dev_ctx_init (const rd_bus_t bus,
+static rd_status_t dev_ctx_init (ri_lis2dh12_dev * const p_dev, const rd_bus_t bus,
                                  const uint8_t handle)
 {
     rd_status_t err_code = RD_SUCCESS;
@@ -147,8 +396,8 @@ static rd_status_t dev_ctx_init (const rd_bus_t bus,
     switch (bus)
     {
         case RD_BUS_SPI:
-            dev.ctx.write_reg = &ri_spi_lis2dh12_write;
-            dev.ctx.read_reg = &ri_spi_lis2dh12_read;
+            p_dev->ctx.write_reg = &ri_spi_lis2dh12_write;
+            p_dev->ctx.read_reg = &ri_spi_lis2dh12_read;
             break;
 
         case RD_BUS_I2C:
@@ -160,17 +409,17 @@ static rd_status_t dev_ctx_init (const rd_bus_t bus,
             break;
     }
 
-    dev.handle = handle;
-    dev.ctx.handle = &dev.handle;
-    dev.mode = RD_SENSOR_CFG_SLEEP;
+    p_dev->handle = handle;
+    p_dev->ctx.handle = &p_dev->handle;
+    p_dev->mode = RD_SENSOR_CFG_SLEEP;
     return err_code;
 }
 
-static rd_status_t check_whoami (void)
+static rd_status_t check_whoami (ri_lis2dh12_dev * const p_dev)
 {
     rd_status_t err_code = RD_SUCCESS;
     uint8_t whoamI = 0;
-    lis2dh12_device_id_get (&dev.ctx, &whoamI);
+    lis2dh12_device_id_get (&p_dev->ctx, &whoamI);
 
     if (whoamI != LIS2DH12_ID)
     {
@@ -180,21 +429,21 @@ static rd_status_t check_whoami (void)
     return err_code;
 }
 
-static rd_status_t clear_sensor_state (void)
+static rd_status_t clear_sensor_state (ri_lis2dh12_dev * const p_dev)
 {
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code = LIS_SUCCESS;
     float ths = 0;
     // Disable FIFO, activity
-    err_code |= ri_lis2dh12_fifo_use (false);
-    err_code |= ri_lis2dh12_fifo_interrupt_use (false);
-    err_code |= ri_lis2dh12_activity_interrupt_use (false, &ths);
+    err_code |= fifo_use (p_dev, false);
+    err_code |= fifo_interrupt_use (p_dev, false);
+    err_code |= activity_interrupt_use (p_dev, false, &ths);
     // Enable temperature sensor
-    lis_ret_code |= lis2dh12_temperature_meas_set (&dev.ctx, LIS2DH12_TEMP_ENABLE);
+    lis_ret_code |= lis2dh12_temperature_meas_set (&p_dev->ctx, LIS2DH12_TEMP_ENABLE);
     // Disable Block Data Update, allow values to update even if old is not read
-    lis_ret_code |= lis2dh12_block_data_update_set (&dev.ctx, PROPERTY_ENABLE);
+    lis_ret_code |= lis2dh12_block_data_update_set (&p_dev->ctx, PROPERTY_ENABLE);
     // Disable filtering
-    lis_ret_code |= lis2dh12_high_pass_on_outputs_set (&dev.ctx, PROPERTY_DISABLE);
+    lis_ret_code |= lis2dh12_high_pass_on_outputs_set (&p_dev->ctx, PROPERTY_DISABLE);
 
     if (LIS_SUCCESS != lis_ret_code)
     {
@@ -204,7 +453,7 @@ static rd_status_t clear_sensor_state (void)
     return err_code;
 }
 
-static rd_status_t selftest (void)
+static rd_status_t selftest (ri_lis2dh12_dev * const p_dev)
 {
     LOGD ("begin\r\n");
     axis3bit16_t data_raw_acceleration_old = {0};
@@ -212,194 +461,83 @@ static rd_status_t selftest (void)
     int32_t lis_ret_code = LIS_SUCCESS;
     rd_status_t err_code = RD_SUCCESS;
     // Set Output Data Rate for self-test
-    dev.samplerate = LIS2DH12_ODR_400Hz;
-    lis2dh12_data_rate_set (&dev.ctx, dev.samplerate);
+    p_dev->samplerate = LIS2DH12_ODR_400Hz;
+    lis2dh12_data_rate_set (&p_dev->ctx, p_dev->samplerate);
     // Set full scale to 2G for self-test
-    dev.scale = LIS2DH12_2g;
-    lis2dh12_full_scale_set (&dev.ctx, dev.scale);
+    p_dev->scale = LIS2DH12_2g;
+    lis2dh12_full_scale_set (&p_dev->ctx, p_dev->scale);
     // Set device in 10 bit mode
-    dev.resolution = LIS2DH12_NM_10bit;
-    lis2dh12_operating_mode_set (&dev.ctx, dev.resolution);
+    p_dev->resolution = LIS2DH12_NM_10bit;
+    lis2dh12_operating_mode_set (&p_dev->ctx, p_dev->resolution);
+    conversion_update (p_dev);
     // Run self-test
     // turn self-test off.
-    dev.selftest = LIS2DH12_ST_DISABLE;
-    lis_ret_code = lis2dh12_self_test_set (&dev.ctx, dev.selftest);
+    p_dev->selftest = LIS2DH12_ST_DISABLE;
+    lis_ret_code = lis2dh12_self_test_set (&p_dev->ctx, p_dev->selftest);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-    lis2dh12_get_samples_selftest (&data_raw_acceleration_old);
-    dev.selftest = LIS2DH12_ST_POSITIVE;
-    lis2dh12_self_test_set (&dev.ctx, dev.selftest);
-    lis2dh12_get_samples_selftest (&data_raw_acceleration_new);
-    lis_ret_code = lis2dh12_verify_selftest (&data_raw_acceleration_new,
+    lis2dh12_get_samples_selftest (p_dev, &data_raw_acceleration_old);
+    p_dev->selftest = LIS2DH12_ST_POSITIVE;
+    lis2dh12_self_test_set (&p_dev->ctx, p_dev->selftest);
+    lis2dh12_get_samples_selftest (p_dev, &data_raw_acceleration_new);
+    lis_ret_code = lis2dh12_verify_selftest (p_dev, &data_raw_acceleration_new,
                    &data_raw_acceleration_old);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_SELFTEST;
     LOGD ("selftest = LIS2DH12_ST_POSITIVE.Error = %08x\r\n", err_code);
-    dev.selftest = LIS2DH12_ST_NEGATIVE;
-    lis2dh12_self_test_set (&dev.ctx, dev.selftest);
-    lis2dh12_get_samples_selftest (&data_raw_acceleration_new);
-    lis_ret_code = lis2dh12_verify_selftest (&data_raw_acceleration_new,
+    p_dev->selftest = LIS2DH12_ST_NEGATIVE;
+    lis2dh12_self_test_set (&p_dev->ctx, p_dev->selftest);
+    lis2dh12_get_samples_selftest (p_dev, &data_raw_acceleration_new);
+    lis_ret_code = lis2dh12_verify_selftest (p_dev, &data_raw_acceleration_new,
                    &data_raw_acceleration_old);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_SELFTEST;
     LOGD ("selftest = LIS2DH12_ST_NEGATIVE.Error = %08x\r\n", err_code);
     // turn self-test off, keep error code in case we "lose" sensor after self-test
-    dev.selftest = LIS2DH12_ST_DISABLE;
-    lis_ret_code = lis2dh12_self_test_set (&dev.ctx, dev.selftest);
+    p_dev->selftest = LIS2DH12_ST_DISABLE;
+    lis_ret_code = lis2dh12_self_test_set (&p_dev->ctx, p_dev->selftest);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     // Turn accelerometer off
-    dev.samplerate = LIS2DH12_POWER_DOWN;
-    lis_ret_code = lis2dh12_data_rate_set (&dev.ctx, dev.samplerate);
+    p_dev->samplerate = LIS2DH12_POWER_DOWN;
+    lis_ret_code = lis2dh12_data_rate_set (&p_dev->ctx, p_dev->samplerate);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     LOGD ("end. Error = %08x\r\n", err_code);
     return err_code;
 }
 
-rd_status_t ri_lis2dh12_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
-{
-    rd_status_t err_code = RD_SUCCESS;
-    LOGD ("begin\r\n");
-
-    if (NULL == p_sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-        LOGD ("p_sensor. Error = %08x\r\n", err_code);
-    }
-    else if (rd_sensor_is_init (p_sensor))
-    {
-        err_code |= RD_ERROR_INVALID_STATE;
-        LOGD ("write_reg. Error = %08x\r\n", err_code);
-    }
-    else
-    {
-        err_code |= dev_ctx_init (bus, handle);
-        LOGD ("dev_ctx_init. Error = %08x\r\n", err_code);
-        rd_sensor_initialize (p_sensor);
-        p_sensor->name = m_acc_name;
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= ri_delay_ms (PWRON_DELAY_MS);
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= check_whoami();
-            LOGD ("check_whoami. Error = %08x\r\n", err_code);
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= clear_sensor_state();
-            LOGD ("clear_sensor_state. Error = %08x\r\n", err_code);
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= selftest();
-            LOGD ("selftest. Error = %08x\r\n", err_code);
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            p_sensor->init                  = ri_lis2dh12_init;
-            p_sensor->uninit                = ri_lis2dh12_uninit;
-            p_sensor->samplerate_set        = ri_lis2dh12_samplerate_set;
-            p_sensor->samplerate_get        = ri_lis2dh12_samplerate_get;
-            p_sensor->resolution_set        = ri_lis2dh12_resolution_set;
-            p_sensor->resolution_get        = ri_lis2dh12_resolution_get;
-            p_sensor->scale_set             = ri_lis2dh12_scale_set;
-            p_sensor->scale_get             = ri_lis2dh12_scale_get;
-            p_sensor->dsp_set               = ri_lis2dh12_dsp_set;
-            p_sensor->dsp_get               = ri_lis2dh12_dsp_get;
-            p_sensor->mode_set              = ri_lis2dh12_mode_set;
-            p_sensor->mode_get              = ri_lis2dh12_mode_get;
-            p_sensor->data_get              = ri_lis2dh12_data_get;
-            p_sensor->configuration_set     = rd_sensor_configuration_set;
-            p_sensor->configuration_get     = rd_sensor_configuration_get;
-            p_sensor->fifo_enable           = ri_lis2dh12_fifo_use;
-            p_sensor->fifo_interrupt_enable = ri_lis2dh12_fifo_interrupt_use;
-            p_sensor->fifo_read             = ri_lis2dh12_fifo_read;
-            p_sensor->level_interrupt_set   = ri_lis2dh12_activity_interrupt_use;
-            p_sensor->provides.datas.acceleration_x_g = 1;
-            p_sensor->provides.datas.acceleration_y_g = 1;
-            p_sensor->provides.datas.acceleration_z_g = 1;
-            p_sensor->provides.datas.temperature_c = 1;
-            dev.tsample = RD_UINT64_INVALID;
-        }
-        else
-        {
-            rd_sensor_uninitialize (p_sensor);
-            memset (&dev, 0, sizeof (dev));
-        }
-    }
-
-    LOGD ("end. Error = %08x\r\n", err_code);
-    return err_code;
-}
-
-/*
- * Lis2dh12 does not have a proper softreset (boot does not reset all registers)
- * Therefore just stop sampling
- */
-rd_status_t ri_lis2dh12_uninit (rd_sensor_t * p_sensor,
-                                rd_bus_t bus, uint8_t handle)
-{
-    rd_status_t err_code = RD_SUCCESS;
-
-    if (NULL == p_sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-    }
-    else
-    {
-        rd_sensor_uninitialize (p_sensor);
-        dev.samplerate = LIS2DH12_POWER_DOWN;
-        //LIS2DH12 function returns SPI write result which is rd_status_t
-        int32_t lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), dev.samplerate);
-        memset (&dev, 0, sizeof (dev));
-
-        if (LIS_SUCCESS != lis_ret_code)
-        {
-            err_code |= RD_ERROR_INTERNAL;
-        }
-    }
-
-    return err_code;
-}
-
 /**
  * Set up samplerate. Powers down sensor on SAMPLERATE_STOP, writes value to
  * lis2dh12 only if mode is continous as writing samplerate to sensor starts sampling.
  * MAX is 200 Hz as it can be represented by the configuration format
  * Samplerate is rounded up, i.e. "Please give me at least samplerate F.", 5 is rounded to 10 Hz etc.
  */
-rd_status_t ri_lis2dh12_samplerate_set (uint8_t * samplerate)
+static rd_status_t samplerate_set (ri_lis2dh12_dev * const p_dev, uint8_t * samplerate)
 {
     if (NULL == samplerate) { return RD_ERROR_NULL; }
 
-    VERIFY_SENSOR_SLEEPS();
+    VERIFY_SENSOR_SLEEPS (p_dev);
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
 
     if (RD_SENSOR_CFG_NO_CHANGE == *samplerate)     {}
-    else if (RD_SENSOR_CFG_MIN == *samplerate)      { dev.samplerate = LIS2DH12_ODR_1Hz;   }
-    else if (RD_SENSOR_CFG_MAX == *samplerate)      { dev.samplerate = LIS2DH12_ODR_5kHz376_LP_1kHz344_NM_HP; }
-    else if (RD_SENSOR_CFG_DEFAULT == *samplerate)  { dev.samplerate = LIS2DH12_ODR_1Hz;   }
-    else if (1   == *samplerate)                              { dev.samplerate = LIS2DH12_ODR_1Hz;   }
-    else if (10  >= *samplerate)                              { dev.samplerate = LIS2DH12_ODR_10Hz;  }
-    else if (25  >= *samplerate)                              { dev.samplerate = LIS2DH12_ODR_25Hz;  }
-    else if (50  >= *samplerate)                              { dev.samplerate = LIS2DH12_ODR_50Hz;  }
-    else if (100 >= *samplerate)                              { dev.samplerate = LIS2DH12_ODR_100Hz; }
-    else if (200 >= *samplerate)                              { dev.samplerate = LIS2DH12_ODR_200Hz; }
-    else if (RD_SENSOR_CFG_CUSTOM_1 == *samplerate) { dev.samplerate = LIS2DH12_ODR_400Hz; }
-    else if (RD_SENSOR_CFG_CUSTOM_2 == *samplerate) { dev.samplerate = LIS2DH12_ODR_1kHz620_LP; }
+    else if (RD_SENSOR_CFG_MIN == *samplerate)      { p_dev->samplerate = LIS2DH12_ODR_1Hz;   }
+    else if (RD_SENSOR_CFG_MAX == *samplerate)      { p_dev->samplerate = LIS2DH12_ODR_5kHz376_LP_1kHz344_NM_HP; }
+    else if (RD_SENSOR_CFG_DEFAULT == *samplerate)  { p_dev->samplerate = LIS2DH12_ODR_1Hz;   }
+    else if (1   == *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_1Hz;   }
+    else if (10  >= *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_10Hz;  }
+    else if (25  >= *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_25Hz;  }
+    else if (50  >= *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_50Hz;  }
+    else if (100 >= *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_100Hz; }
+    else if (200 >= *samplerate)                              { p_dev->samplerate = LIS2DH12_ODR_200Hz; }
+    else if (RD_SENSOR_CFG_CUSTOM_1 == *samplerate) { p_dev->samplerate = LIS2DH12_ODR_400Hz; }
+    else if (RD_SENSOR_CFG_CUSTOM_2 == *samplerate) { p_dev->samplerate = LIS2DH12_ODR_1kHz620_LP; }
     // This is equal to LIS2DH12_ODR_5kHz376_LP
-    else if (RD_SENSOR_CFG_CUSTOM_3 == *samplerate) { dev.samplerate = LIS2DH12_ODR_5kHz376_LP_1kHz344_NM_HP; }
+    else if (RD_SENSOR_CFG_CUSTOM_3 == *samplerate) { p_dev->samplerate = LIS2DH12_ODR_5kHz376_LP_1kHz344_NM_HP; }
     else { *samplerate = RD_SENSOR_ERR_NOT_SUPPORTED; err_code |= RD_ERROR_NOT_SUPPORTED; }
 
     if (RD_SUCCESS == err_code)
     {
-        lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), dev.samplerate);
+        lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), p_dev->samplerate);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        err_code |= ri_lis2dh12_samplerate_get (samplerate);
+        err_code |= samplerate_get (p_dev, samplerate);
+        fifo_timing_reset (p_dev);
     }
 
     return err_code;
@@ -408,16 +546,16 @@ rd_status_t ri_lis2dh12_samplerate_set (uint8_t * samplerate)
 /*
  *. Read sample rate to pointer
  */
-rd_status_t ri_lis2dh12_samplerate_get (uint8_t * samplerate)
+static rd_status_t samplerate_get (ri_lis2dh12_dev * const p_dev, uint8_t * samplerate)
 {
     if (NULL == samplerate) { return RD_ERROR_NULL; }
 
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_data_rate_get (& (dev.ctx), &dev.samplerate);
+    lis_ret_code = lis2dh12_data_rate_get (& (p_dev->ctx), &p_dev->samplerate);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
-    switch (dev.samplerate)
+    switch (p_dev->samplerate)
     {
         case LIS2DH12_ODR_1Hz:
             *samplerate = 1;
@@ -466,43 +604,52 @@ rd_status_t ri_lis2dh12_samplerate_get (uint8_t * samplerate)
 /**
  * Setup resolution. Resolution is rounded up, i.e. "please give at least this many bits"
  */
-rd_status_t ri_lis2dh12_resolution_set (uint8_t * resolution)
+static rd_status_t resolution_set (ri_lis2dh12_dev * const p_dev, uint8_t * resolution)
 {
     if (NULL == resolution)                               { return RD_ERROR_NULL; }
 
-    VERIFY_SENSOR_SLEEPS();
+    VERIFY_SENSOR_SLEEPS (p_dev);
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
 
     if (RD_SENSOR_CFG_NO_CHANGE == *resolution)    { }
-    else if (RD_SENSOR_CFG_MIN == *resolution)     { dev.resolution = LIS2DH12_LP_8bit;  }
-    else if (RD_SENSOR_CFG_MAX == *resolution)     { dev.resolution = LIS2DH12_HR_12bit; }
-    else if (RD_SENSOR_CFG_DEFAULT == *resolution) { dev.resolution = LIS2DH12_NM_10bit; }
-    else if (8 >= *resolution)                              { dev.resolution = LIS2DH12_LP_8bit;  }
-    else if (10 >= *resolution)                             { dev.resolution = LIS2DH12_NM_10bit; }
-    else if (12 >= *resolution)                             { dev.resolution = LIS2DH12_HR_12bit; }
+    else if (RD_SENSOR_CFG_MIN == *resolution)     { p_dev->resolution = LIS2DH12_LP_8bit;  }
+    else if (RD_SENSOR_CFG_MAX == *resolution)     { p_dev->resolution = LIS2DH12_HR_12bit; }
+    else if (RD_SENSOR_CFG_DEFAULT == *resolution) { p_dev->resolution = LIS2DH12_NM_10bit; }
+    else if (8 >= *resolution)                              { p_dev->resolution = LIS2DH12_LP_8bit;  }
+    else if (10 >= *resolution)                             { p_dev->resolution = LIS2DH12_NM_10bit; }
+    else if (12 >= *resolution)                             { p_dev->resolution = LIS2DH12_HR_12bit; }
     else { *resolution = RD_SENSOR_ERR_NOT_SUPPORTED; err_code |= RD_ERROR_NOT_SUPPORTED; }
 
     if (RD_SUCCESS == err_code)
     {
-        lis_ret_code = lis2dh12_operating_mode_set (& (dev.ctx), dev.resolution);
+        lis_ret_code = lis2dh12_operating_mode_set (& (p_dev->ctx), p_dev->resolution);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        err_code |= ri_lis2dh12_resolution_get (resolution);
+        err_code |= resolution_get (p_dev, resolution);
+        conversion_update (p_dev);
+        fifo_timing_reset (p_dev);
     }
 
     return err_code;
 }
 
-rd_status_t ri_lis2dh12_resolution_get (uint8_t * resolution)
+static rd_status_t resolution_get (ri_lis2dh12_dev * const p_dev, uint8_t * resolution)
 {
     if (NULL == resolution) { return RD_ERROR_NULL; }
 
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_operating_mode_get (& (dev.ctx), &dev.resolution);
+    const lis2dh12_op_md_t cached = p_dev->resolution;
+    lis_ret_code = lis2dh12_operating_mode_get (& (p_dev->ctx), &p_dev->resolution);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
-    switch (dev.resolution)
+    // Keep cached conversion in sync with resolution read from sensor.
+    if (cached != p_dev->resolution)
+    {
+        conversion_update (p_dev);
+    }
+
+    switch (p_dev->resolution)
     {
         case LIS2DH12_LP_8bit:
             *resolution = 8;
@@ -528,22 +675,22 @@ rd_status_t ri_lis2dh12_resolution_get (uint8_t * resolution)
 /**
  * Setup lis2dh12 scale. Scale is rounded up, i.e. "at least this much"
  */
-rd_status_t ri_lis2dh12_scale_set (uint8_t * scale)
+static rd_status_t scale_set (ri_lis2dh12_dev * const p_dev, uint8_t * scale)
 {
     if (NULL == scale)                               { return RD_ERROR_NULL; }
 
-    VERIFY_SENSOR_SLEEPS();
+    VERIFY_SENSOR_SLEEPS (p_dev);
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
 
     if (RD_SENSOR_CFG_NO_CHANGE == *scale)    { }
-    else if (RD_SENSOR_CFG_MIN == *scale)     { dev.scale = LIS2DH12_2g; }
-    else if (RD_SENSOR_CFG_MAX == *scale)     { dev.scale = LIS2DH12_16g; }
-    else if (RD_SENSOR_CFG_DEFAULT == *scale) { dev.scale = LIS2DH12_2g;  }
-    else if (2  >= *scale)                              { dev.scale = LIS2DH12_2g;  }
-    else if (4  >= *scale)                              { dev.scale = LIS2DH12_4g;  }
-    else if (8  >= *scale)                              { dev.scale = LIS2DH12_8g;  }
-    else if (16 >= *scale)                              { dev.scale = LIS2DH12_16g; }
+    else if (RD_SENSOR_CFG_MIN == *scale)     { p_dev->scale = LIS2DH12_2g; }
+    else if (RD_SENSOR_CFG_MAX == *scale)     { p_dev->scale = LIS2DH12_16g; }
+    else if (RD_SENSOR_CFG_DEFAULT == *scale) { p_dev->scale = LIS2DH12_2g;  }
+    else if (2  >= *scale)                              { p_dev->scale = LIS2DH12_2g;  }
+    else if (4  >= *scale)                              { p_dev->scale = LIS2DH12_4g;  }
+    else if (8  >= *scale)                              { p_dev->scale = LIS2DH12_8g;  }
+    else if (16 >= *scale)                              { p_dev->scale = LIS2DH12_16g; }
     else
     {
         *scale = RD_SENSOR_ERR_NOT_SUPPORTED;
@@ -552,24 +699,32 @@ rd_status_t ri_lis2dh12_scale_set (uint8_t * scale)
 
     if (RD_SUCCESS == err_code)
     {
-        lis_ret_code = lis2dh12_full_scale_set (& (dev.ctx), dev.scale);
+        lis_ret_code = lis2dh12_full_scale_set (& (p_dev->ctx), p_dev->scale);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        err_code |= ri_lis2dh12_scale_get (scale);
+        err_code |= scale_get (p_dev, scale);
+        conversion_update (p_dev);
     }
 
     return err_code;
 }
 
-rd_status_t ri_lis2dh12_scale_get (uint8_t * scale)
+static rd_status_t scale_get (ri_lis2dh12_dev * const p_dev, uint8_t * scale)
 {
     if (NULL == scale) { return RD_ERROR_NULL; }
 
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_full_scale_get (& (dev.ctx), &dev.scale);
+    const lis2dh12_fs_t cached = p_dev->scale;
+    lis_ret_code = lis2dh12_full_scale_get (& (p_dev->ctx), &p_dev->scale);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
-    switch (dev.scale)
+    // Keep cached conversion in sync with scale read from sensor.
+    if (cached != p_dev->scale)
+    {
+        conversion_update (p_dev);
+    }
+
+    switch (p_dev->scale)
     {
         case LIS2DH12_2g:
             *scale = 2;
@@ -603,16 +758,17 @@ rd_status_t ri_lis2dh12_scale_get (uint8_t * scale)
  10 ODR/9
  11 ODR/400
 */
-rd_status_t ri_lis2dh12_dsp_set (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_set (ri_lis2dh12_dev * const p_dev, uint8_t * dsp,
+                            uint8_t * parameter)
 {
     if (NULL == dsp || NULL == parameter) { return RD_ERROR_NULL; }
 
-    VERIFY_SENSOR_SLEEPS();
+    VERIFY_SENSOR_SLEEPS (p_dev);
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
     // Read original values in case one is NO_CHANGE and other should be adjusted.
     uint8_t orig_dsp, orig_param;
-    err_code |= ri_lis2dh12_dsp_get (&orig_dsp, &orig_param);
+    err_code |= dsp_get (p_dev, &orig_dsp, &orig_param);
 
     if (RD_SENSOR_CFG_NO_CHANGE == *dsp)       { *dsp       = orig_dsp; }
 
@@ -652,11 +808,11 @@ rd_status_t ri_lis2dh12_dsp_set (uint8_t * dsp, uint8_t * parameter)
                 return RD_ERROR_NOT_SUPPORTED;
         }
 
-        lis_ret_code = lis2dh12_high_pass_bandwidth_set (& (dev.ctx), hpcf);
+        lis_ret_code = lis2dh12_high_pass_bandwidth_set (& (p_dev->ctx), hpcf);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        lis_ret_code = lis2dh12_high_pass_mode_set (& (dev.ctx), LIS2DH12_NORMAL);
+        lis_ret_code = lis2dh12_high_pass_mode_set (& (p_dev->ctx), LIS2DH12_NORMAL);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        lis_ret_code = lis2dh12_high_pass_on_outputs_set (& (dev.ctx), PROPERTY_ENABLE);
+        lis_ret_code = lis2dh12_high_pass_on_outputs_set (& (p_dev->ctx), PROPERTY_ENABLE);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         return err_code;
     }
@@ -669,7 +825,7 @@ rd_status_t ri_lis2dh12_dsp_set (uint8_t * dsp, uint8_t * parameter)
 
     if (RD_SENSOR_DSP_LAST == *dsp)
     {
-        lis_ret_code = lis2dh12_high_pass_on_outputs_set (& (dev.ctx), PROPERTY_DISABLE);
+        lis_ret_code = lis2dh12_high_pass_on_outputs_set (& (p_dev->ctx), PROPERTY_DISABLE);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         *dsp = RD_SENSOR_DSP_LAST;
         return err_code;
@@ -678,15 +834,16 @@ rd_status_t ri_lis2dh12_dsp_set (uint8_t * dsp, uint8_t * parameter)
     return RD_ERROR_NOT_SUPPORTED;
 }
 
-rd_status_t ri_lis2dh12_dsp_get (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_get (ri_lis2dh12_dev * const p_dev, uint8_t * dsp,
+                            uint8_t * parameter)
 {
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
     uint8_t mode;
     lis2dh12_hpcf_t hpcf;
-    lis_ret_code = lis2dh12_high_pass_bandwidth_get (& (dev.ctx), &hpcf);
+    lis_ret_code = lis2dh12_high_pass_bandwidth_get (& (p_dev->ctx), &hpcf);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-    lis_ret_code = lis2dh12_high_pass_on_outputs_get (& (dev.ctx), &mode);
+    lis_ret_code = lis2dh12_high_pass_on_outputs_get (& (p_dev->ctx), &mode);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
     if (mode) { *dsp = RD_SENSOR_DSP_HIGH_PASS; }
@@ -718,7 +875,7 @@ rd_status_t ri_lis2dh12_dsp_get (uint8_t * dsp, uint8_t * parameter)
     return err_code;
 }
 
-rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
+static rd_status_t mode_set (ri_lis2dh12_dev * const p_dev, uint8_t * mode)
 {
     if (NULL == mode) { return RD_ERROR_NULL; }
 
@@ -729,7 +886,7 @@ rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
     {
         // Do nothing if sensor is in continuous mode
         uint8_t current_mode;
-        ri_lis2dh12_mode_get (&current_mode);
+        mode_get (p_dev, &current_mode);
 
         if (RD_SENSOR_CFG_CONTINUOUS == current_mode)
         {
@@ -740,13 +897,13 @@ rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
         // Start sensor at 400 Hz (highest common samplerate)
         // and wait for 7/ODR ms for turn-on (?) NOTE: 7 s / 400 just to be on safe side.
         // Refer to LIS2DH12 datasheet p.16.
-        dev.samplerate = LIS2DH12_ODR_400Hz;
-        lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), dev.samplerate);
+        p_dev->samplerate = LIS2DH12_ODR_400Hz;
+        lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), p_dev->samplerate);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-        ri_delay_ms ( (7000 / 400) + 1);
-        dev.tsample = rd_sensor_timestamp_get();
-        dev.samplerate = LIS2DH12_POWER_DOWN;
-        lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), dev.samplerate);
+        ri_delay_ms (SINGLE_DELAY_MS);
+        p_dev->tsample = rd_sensor_timestamp_get();
+        p_dev->samplerate = LIS2DH12_POWER_DOWN;
+        lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), p_dev->samplerate);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         *mode = RD_SENSOR_CFG_SLEEP;
         return err_code;
@@ -756,14 +913,14 @@ rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
     // when mode is set to continous.
     if (RD_SENSOR_CFG_SLEEP == *mode)
     {
-        dev.mode = *mode;
-        lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), LIS2DH12_POWER_DOWN);
+        p_dev->mode = *mode;
+        lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), LIS2DH12_POWER_DOWN);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     }
     else if (RD_SENSOR_CFG_CONTINUOUS == *mode)
     {
-        dev.mode = *mode;
-        lis_ret_code = lis2dh12_data_rate_set (& (dev.ctx), dev.samplerate);
+        p_dev->mode = *mode;
+        lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), p_dev->samplerate);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     }
     else { err_code |= RD_ERROR_INVALID_PARAM; }
@@ -771,11 +928,11 @@ rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_lis2dh12_mode_get (uint8_t * mode)
+static rd_status_t mode_get (ri_lis2dh12_dev * const p_dev, uint8_t * mode)
 {
     if (NULL == mode) { return RD_ERROR_NULL; }
 
-    switch (dev.mode)
+    switch (p_dev->mode)
     {
         case RD_SENSOR_CFG_SLEEP:
             *mode = RD_SENSOR_CFG_SLEEP;
@@ -793,6 +950,115 @@ rd_status_t ri_lis2dh12_mode_get (uint8_t * mode)
     return RD_SUCCESS;
 }
 
+/** @brief Typical current of a data rate, datasheet table 12. */
+typedef struct
+{
+    uint16_t lp_hz;   //!< Data rate in low-power mode.
+    uint16_t nm_hz;   //!< Data rate in normal and high-resolution mode, 0 if N/A.
+    uint32_t lp_na;   //!< Current in low-power mode.
+    uint32_t nm_na;   //!< Current in normal and high-resolution mode.
+} lis2dh12_cost_row_t;
+
+static const lis2dh12_cost_row_t m_cost_rows[] =
+{
+    {1U,    1U,    2000U,   2000U},
+    {10U,   10U,   3000U,   4000U},
+    {25U,   25U,   4000U,   6000U},
+    {50U,   50U,   6000U,   11000U},
+    {100U,  100U,  10000U,  20000U},
+    {200U,  200U,  18000U,  38000U},
+    {400U,  400U,  36000U,  73000U},
+    {1620U, 0U,    100000U, 0U},
+    {5376U, 1344U, 185000U, 185000U}
+};
+
+#define COST_ROW_400HZ (6U) //!< Index of SINGLE_ODR_HZ in m_cost_rows.
+#define COST_ROW_NONE  (0xFFU)
+
+/** @brief Row of cost table of samplerate, COST_ROW_NONE if not supported. */
+static uint8_t cost_row (const uint8_t samplerate)
+{
+    uint8_t row = COST_ROW_NONE;
+
+    if ( (RD_SENSOR_CFG_NO_CHANGE == samplerate) || (RD_SENSOR_CFG_MIN == samplerate)
+            || (RD_SENSOR_CFG_DEFAULT == samplerate) || (1U == samplerate)) { row = 0U; }
+    else if (10U  >= samplerate)                    { row = 1U; }
+    else if (25U  >= samplerate)                    { row = 2U; }
+    else if (50U  >= samplerate)                    { row = 3U; }
+    else if (100U >= samplerate)                    { row = 4U; }
+    else if (200U >= samplerate)                    { row = 5U; }
+    else if (RD_SENSOR_CFG_CUSTOM_1 == samplerate) { row = COST_ROW_400HZ; }
+    else if (RD_SENSOR_CFG_CUSTOM_2 == samplerate) { row = 7U; }
+    else if ( (RD_SENSOR_CFG_CUSTOM_3 == samplerate)
+              || (RD_SENSOR_CFG_MAX == samplerate)) { row = 8U; }
+    else { }
+
+    return row;
+}
+
+rd_status_t ri_lis2dh12_cost_get (const rd_sensor_configuration_t * const p_config,
+                                  rd_sensor_cost_t * const p_cost)
+{
+    if ( (NULL == p_config) || (NULL == p_cost)) { return RD_ERROR_NULL; }
+
+    const uint8_t resolution = p_config->resolution;
+    const uint8_t row = cost_row (p_config->samplerate);
+    bool low_power;
+
+    if ( (RD_SENSOR_CFG_MIN == resolution)
+            || ( (RD_SENSOR_CFG_DEFAULT != resolution) && (8U >= resolution)))
+    {
+        low_power = true;
+    }
+    else if ( (RD_SENSOR_CFG_NO_CHANGE == resolution) || (RD_SENSOR_CFG_MAX == resolution)
+              || (RD_SENSOR_CFG_DEFAULT == resolution) || (12U >= resolution))
+    {
+        low_power = false;
+    }
+    else { return RD_ERROR_NOT_SUPPORTED; }
+
+    if ( (COST_ROW_NONE == row) || ( (!low_power) && (0U == m_cost_rows[row].nm_hz)))
+    {
+        return RD_ERROR_NOT_SUPPORTED;
+    }
+
+    rd_status_t err_code = RD_SUCCESS;
+    const lis2dh12_cost_row_t * const p_row = &m_cost_rows[row];
+    const uint32_t rate_hz = low_power ? p_row->lp_hz : p_row->nm_hz;
+    const uint32_t rate_na = low_power ? p_row->lp_na : p_row->nm_na;
+    const uint32_t single_na = low_power ? m_cost_rows[COST_ROW_400HZ].lp_na
+                               : m_cost_rows[COST_ROW_400HZ].nm_na;
+    p_cost->conversion_us = SINGLE_DELAY_MS * 1000U;
+    p_cost->charge_nc = (single_na * SINGLE_DELAY_MS) / 1000U;
+    p_cost->sleep_na = RI_LIS2DH12_POWER_DOWN_NA;
+
+    switch (p_config->mode)
+    {
+        case RD_SENSOR_CFG_DEFAULT:
+        case RD_SENSOR_CFG_NO_CHANGE:
+        case RD_SENSOR_CFG_SLEEP:
+            p_cost->average_na = p_cost->sleep_na;
+            break;
+
+        case RD_SENSOR_CFG_SINGLE:
+            p_cost->average_na = rd_sensor_cost_average_na (p_cost, 1000000U / rate_hz);
+            break;
+
+        case RD_SENSOR_CFG_CONTINUOUS:
+            // Table gives average current of running sensor.
+            p_cost->conversion_us = 1000000U / rate_hz;
+            p_cost->charge_nc = rate_na / rate_hz;
+            p_cost->average_na = rate_na;
+            break;
+
+        default:
+            err_code |= RD_ERROR_NOT_SUPPORTED;
+            break;
+    }
+
+    return err_code;
+}
+
 /**
  * Convert raw value to temperature in celcius
  *
@@ -800,13 +1066,13 @@ rd_status_t ri_lis2dh12_mode_get (uint8_t * mode)
  * parameter acceleration: Output. Temperature values in C.
  *
  */
-static rd_status_t rawToC (const uint8_t * const raw_temperature,
-                           float * temperature)
+static rd_status_t rawToC (ri_lis2dh12_dev * const p_dev,
+                           const uint8_t * const raw_temperature, float * temperature)
 {
     rd_status_t err_code = RD_SUCCESS;
     int16_t value = (raw_temperature[1] * 256) + raw_temperature[0];
 
-    switch (dev.resolution)
+    switch (p_dev->resolution)
     {
         case LIS2DH12_LP_8bit:
             *temperature = lis2dh12_from_lsb_lp_to_celsius (value);
@@ -830,122 +1096,58 @@ static rd_status_t rawToC (const uint8_t * const raw_temperature,
 }
 
 /**
- * Convert raw value to acceleration in mg
+ * Convert raw value to acceleration in g
  *
  * parameter raw: Input. Raw values from LIS2DH12
- * parameter acceleration: Output. Acceleration values in mg
+ * parameter acceleration: Output. Acceleration values in g
  *
  */
-static rd_status_t rawToMg (const axis3bit16_t * raw_acceleration,
-                            float * acceleration)
+static rd_status_t rawToG (ri_lis2dh12_dev * const p_dev,
+                           const axis3bit16_t * raw_acceleration, float * acceleration)
 {
     rd_status_t err_code = RD_SUCCESS;
 
-    for (size_t ii = 0; ii < 3; ii++)
+    if (0U == p_dev->mg_per_digit)
+    {
+        acceleration[0] = RD_FLOAT_INVALID;
+        acceleration[1] = RD_FLOAT_INVALID;
+        acceleration[2] = RD_FLOAT_INVALID;
+        err_code |= RD_ERROR_INTERNAL;
+    }
+    else
     {
-        switch (dev.scale)
+        for (size_t ii = 0; ii < NUM_AXIS; ii++)
         {
-            case LIS2DH12_2g:
-                switch (dev.resolution)
-                {
-                    case LIS2DH12_LP_8bit:
-                        acceleration[ii] = lis2dh12_from_fs2_lp_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    case LIS2DH12_NM_10bit:
-                        acceleration[ii] = lis2dh12_from_fs2_nm_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    case LIS2DH12_HR_12bit:
-                        acceleration[ii] = lis2dh12_from_fs2_hr_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    default:
-                        acceleration[ii] = RD_FLOAT_INVALID;
-                        err_code |= RD_ERROR_INTERNAL;
-                        break;
-                }
-
-                break;
-
-            case LIS2DH12_4g:
-                switch (dev.resolution)
-                {
-                    case LIS2DH12_LP_8bit:
-                        acceleration[ii] = lis2dh12_from_fs4_lp_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    case LIS2DH12_NM_10bit:
-                        acceleration[ii] = lis2dh12_from_fs4_nm_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
+            acceleration[ii] = (float) raw_acceleration->i16bit[ii] * p_dev->g_per_lsb;
+        }
+    }
 
-                    case LIS2DH12_HR_12bit:
-                        acceleration[ii] = lis2dh12_from_fs4_hr_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
+    return err_code;
+}
 
-                    default:
-                        acceleration[ii] = RD_FLOAT_INVALID;
-                        err_code |= RD_ERROR_INTERNAL;
-                        break;
-                }
+static rd_status_t raw_to_mg (ri_lis2dh12_dev * const p_dev,
+                              const axis3bit16_t * const p_raw, int16_t * const p_mg,
+                              const size_t num_elements)
+{
+    if (NULL == p_raw || NULL == p_mg) { return RD_ERROR_NULL; }
 
-                break;
+    if (0U == p_dev->mg_per_digit) { return RD_ERROR_INVALID_STATE; }
 
-            case LIS2DH12_8g:
-                switch (dev.resolution)
-                {
-                    case LIS2DH12_LP_8bit:
-                        acceleration[ii] = lis2dh12_from_fs8_lp_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
+    const int32_t mg_per_digit = p_dev->mg_per_digit;
+    const int32_t divisor = (int32_t) (1L << p_dev->mg_shift);
 
-                    case LIS2DH12_NM_10bit:
-                        acceleration[ii] = lis2dh12_from_fs8_nm_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
+    // Unused low bits are 0, division is exact.
+    for (size_t ii = 0; ii < num_elements; ii++)
+    {
+        for (size_t jj = 0; jj < NUM_AXIS; jj++)
+        {
+            p_mg[ (ii * NUM_AXIS) + jj] =
+                (int16_t) ( (p_raw[ii].i16bit[jj] / divisor) * mg_per_digit);
+        }
+    }
 
-                    case LIS2DH12_HR_12bit:
-                        acceleration[ii] = lis2dh12_from_fs8_hr_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    default:
-                        acceleration[ii] = RD_FLOAT_INVALID;
-                        err_code |= RD_ERROR_INTERNAL;
-                        break;
-                }
-
-                break;
-
-            case LIS2DH12_16g:
-                switch (dev.resolution)
-                {
-                    case LIS2DH12_LP_8bit:
-                        acceleration[ii] = lis2dh12_from_fs16_lp_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    case LIS2DH12_NM_10bit:
-                        acceleration[ii] = lis2dh12_from_fs16_nm_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    case LIS2DH12_HR_12bit:
-                        acceleration[ii] = lis2dh12_from_fs16_hr_to_mg (raw_acceleration->i16bit[ii]);
-                        break;
-
-                    default:
-                        acceleration[ii] = RD_FLOAT_INVALID;
-                        err_code |= RD_ERROR_INTERNAL;
-                        break;
-                }
-
-                break;
-
-            default:
-                acceleration[ii] = RD_FLOAT_INVALID;
-                err_code |= RD_ERROR_INTERNAL;
-                break;
-        }
-    }
-
-    return err_code;
-}
+    return RD_SUCCESS;
+}
 
 /**
  * @brief Test if FIFO is active
@@ -954,10 +1156,10 @@ static rd_status_t rawToMg (const axis3bit16_t * raw_acceleration,
  * @return RD_ERROR_INVALID_STATE when FIFO is not active
  * @return RD_ERROR_INTERNAL in case of error
  */
-rd_status_t ri_lis2dh12_fifo_active (void) {
+static rd_status_t fifo_active (ri_lis2dh12_dev * const p_dev) {
     int32_t lis_ret_code;
     uint8_t enable;
-    lis_ret_code = lis2dh12_fifo_get (& (dev.ctx), &enable);
+    lis_ret_code = lis2dh12_fifo_get (& (p_dev->ctx), &enable);
     if(LIS_SUCCESS == lis_ret_code) {
         if(enable) {
             return RD_SUCCESS;
@@ -969,23 +1171,24 @@ rd_status_t ri_lis2dh12_fifo_active (void) {
     }
 }
 
-rd_status_t ri_lis2dh12_acceleration_raw_get (uint8_t * const raw_data)
+static rd_status_t acceleration_raw_get (ri_lis2dh12_dev * const p_dev,
+                                         uint8_t * const raw_data)
 {
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_acceleration_raw_get (& (dev.ctx), raw_data);
+    lis_ret_code = lis2dh12_acceleration_raw_get (& (p_dev->ctx), raw_data);
 
     return (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 }
 
-rd_status_t ri_lis2dh12_temperature_raw_get(uint8_t * const raw_temperature) 
+static rd_status_t temperature_raw_get (ri_lis2dh12_dev * const p_dev,
+                                        uint8_t * const raw_temperature)
 {
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_temperature_raw_get (& (dev.ctx), raw_temperature);
+    lis_ret_code = lis2dh12_temperature_raw_get (& (p_dev->ctx), raw_temperature);
     return (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 }
 
-rd_status_t ri_lis2dh12_data_get (rd_sensor_data_t * const
-                                  data)
+static rd_status_t data_get (ri_lis2dh12_dev * const p_dev, rd_sensor_data_t * const data)
 {
     if (NULL == data) { return RD_ERROR_NULL; }
 
@@ -993,32 +1196,34 @@ rd_status_t ri_lis2dh12_data_get (rd_sensor_data_t * const
     axis3bit16_t raw_acceleration;
     uint8_t raw_temperature[2];
     memset (raw_acceleration.u8bit, 0x00, 3 * sizeof (int16_t));
-    err_code |= ri_lis2dh12_acceleration_raw_get(raw_acceleration.u8bit);
-    err_code |= ri_lis2dh12_temperature_raw_get(raw_temperature);
-    err_code |= ri_lis2dh12_raw_data_parse(data, &raw_acceleration, raw_temperature);
+    err_code |= acceleration_raw_get (p_dev, raw_acceleration.u8bit);
+    err_code |= temperature_raw_get (p_dev, raw_temperature);
+    err_code |= raw_data_parse (p_dev, data, &raw_acceleration, raw_temperature);
 
     return err_code;
 }
 
 
-rd_status_t ri_lis2dh12_raw_data_parse (rd_sensor_data_t * const data, 
-            axis3bit16_t *raw_acceleration, uint8_t *raw_temperature)
+static rd_status_t raw_data_parse (ri_lis2dh12_dev * const p_dev,
+                                   rd_sensor_data_t * const data,
+                                   axis3bit16_t *raw_acceleration,
+                                   uint8_t *raw_temperature)
 {
     rd_status_t err_code = RD_SUCCESS;
 
     // Compensate data with resolution, scale
     float acceleration[3];
     float temperature = RD_FLOAT_INVALID;
-    err_code |= rawToMg (raw_acceleration, acceleration);
+    err_code |= rawToG (p_dev, raw_acceleration, acceleration);
 
     if(raw_temperature!=NULL) {
-        err_code |= rawToC (raw_temperature, &temperature);
+        err_code |= rawToC (p_dev, raw_temperature, &temperature);
     }
 
     uint8_t mode;
-    err_code |= ri_lis2dh12_mode_get (&mode);
+    err_code |= mode_get (p_dev, &mode);
 
-    if (RD_SENSOR_CFG_SLEEP == mode)           {  data->timestamp_ms   = dev.tsample; }
+    if (RD_SENSOR_CFG_SLEEP == mode)           {  data->timestamp_ms   = p_dev->tsample; }
     else if (RD_SENSOR_CFG_CONTINUOUS == mode)
     {
         data->timestamp_ms = rd_sensor_timestamp_get();
@@ -1037,10 +1242,9 @@ rd_status_t ri_lis2dh12_raw_data_parse (rd_sensor_data_t * const data,
         acc_fields.datas.acceleration_y_g = 1;
         acc_fields.datas.acceleration_z_g = 1;
         
-        //Convert mG to G.
-        values[0] = acceleration[0] / 1000.0;
-        values[1] = acceleration[1] / 1000.0;
-        values[2] = acceleration[2] / 1000.0;
+        values[0] = acceleration[0];
+        values[1] = acceleration[1];
+        values[2] = acceleration[2];
 
         if(raw_temperature!=NULL) {
             acc_fields.datas.temperature_c = 1;
@@ -1058,7 +1262,7 @@ rd_status_t ri_lis2dh12_raw_data_parse (rd_sensor_data_t * const data,
 }
 
 // TODO: State checks
-rd_status_t ri_lis2dh12_fifo_use (const bool enable)
+static rd_status_t fifo_use (ri_lis2dh12_dev * const p_dev, const bool enable)
 {
     lis2dh12_fm_t mode;
     int32_t lis_ret_code;
@@ -1067,65 +1271,118 @@ rd_status_t ri_lis2dh12_fifo_use (const bool enable)
     if (enable) { mode = LIS2DH12_DYNAMIC_STREAM_MODE; }
     else { mode = LIS2DH12_BYPASS_MODE; }
 
-    lis_ret_code = lis2dh12_fifo_set (& (dev.ctx), enable);
+    lis_ret_code = lis2dh12_fifo_set (& (p_dev->ctx), enable);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
-    lis_ret_code = lis2dh12_fifo_mode_set (& (dev.ctx),  mode);
+    lis_ret_code = lis2dh12_fifo_mode_set (& (p_dev->ctx),  mode);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
+    fifo_timing_reset (p_dev);
     return err_code;
 }
 
-//TODO * return: RD_INVALID_STATE if FIFO is not in use
-rd_status_t ri_lis2dh12_fifo_read (size_t * num_elements,
-                                   rd_sensor_data_t * p_data)
+/**
+ * Read raw samples from FIFO in one burst.
+ *
+ * @param[out] p_overrun True if FIFO was full and samples may have been
+ *                       overwritten before read. May be NULL.
+ */
+static rd_status_t fifo_raw_read (ri_lis2dh12_dev * const p_dev,
+                                  size_t * const num_elements, axis3bit16_t * const p_raw,
+                                  bool * const p_overrun)
 {
-    if (NULL == num_elements || NULL == p_data) { return RD_ERROR_NULL; }
+    if (NULL == num_elements || NULL == p_raw) { return RD_ERROR_NULL; }
 
     uint8_t elements = 0;
-    rd_status_t err_code = ri_lis2dh12_fifo_active();
-    if(err_code!=RD_SUCCESS) {
+    rd_status_t err_code = fifo_active (p_dev);
+
+    if (err_code != RD_SUCCESS)
+    {
         return err_code;
     }
 
     int32_t lis_ret_code;
-    lis_ret_code = lis2dh12_fifo_data_level_get (& (dev.ctx), &elements);
+    lis_ret_code = lis2dh12_fifo_data_level_get (& (p_dev->ctx), &elements);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
-    if (!elements)
+    if (elements)
     {
-        *num_elements = 0;
-        return RD_SUCCESS;
+        // 31 FIFO + latest
+        elements++;
     }
 
-    // 31 FIFO + latest
-    elements++;
+    if (NULL != p_overrun)
+    {
+        uint8_t overrun = 0;
+
+        // Overrun flag is latched only when FIFO is full, check before it is read out.
+        if (RI_LIS2DH12_FIFO_SIZE <= elements)
+        {
+            lis_ret_code = lis2dh12_fifo_ovr_flag_get (& (p_dev->ctx), &overrun);
+            err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
+        }
+
+        *p_overrun = (0U != overrun);
+    }
 
     // Do not read more than buffer size
-    if (elements > *num_elements) { elements = *num_elements; }
+    if (elements > *num_elements) { elements = (uint8_t) *num_elements; }
 
-    // get current time
-    p_data->timestamp_ms = rd_sensor_timestamp_get();
-    // Read all elements
-    axis3bit16_t raw_acceleration;
+    if (elements)
+    {
+        // Output registers are read with address auto-increment. In FIFO mode the
+        // address rolls over from OUT_Z_H back to OUT_X_L, so the entire FIFO level
+        // is drained in one bus transaction.
+        lis_ret_code = lis2dh12_read_reg (& (p_dev->ctx), LIS2DH12_OUT_X_L, p_raw[0].u8bit,
+                                          (uint16_t) (elements * sizeof (axis3bit16_t)));
+        err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
+    }
+
+    *num_elements = elements;
+    return err_code;
+}
+
+static rd_status_t fifo_read (ri_lis2dh12_dev * const p_dev, size_t * num_elements,
+                              rd_sensor_data_t * p_data)
+{
+    if (NULL == num_elements || NULL == p_data) { return RD_ERROR_NULL; }
+
+    axis3bit16_t raw_acceleration[RI_LIS2DH12_FIFO_SIZE];
+    size_t elements = *num_elements;
+
+    // Do not read more than FIFO size
+    if (elements > RI_LIS2DH12_FIFO_SIZE) { elements = RI_LIS2DH12_FIFO_SIZE; }
+
+    const size_t max_elements = elements;
+    bool overrun = false;
+    rd_status_t err_code = fifo_raw_read (p_dev, &elements, raw_acceleration, &overrun);
+
+    if (RD_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    // Samples may be left on FIFO if buffer was smaller than FIFO.
+    const bool drained = (elements < max_elements) || (RI_LIS2DH12_FIFO_SIZE == max_elements);
+    const uint64_t now = rd_sensor_timestamp_get();
+    fifo_timing_update (p_dev, now, elements, drained, overrun);
+    const uint32_t interval_ns = fifo_interval_ns (p_dev);
+    // Convert all elements
     float acceleration[3];
 
     for (size_t ii = 0; ii < elements; ii++)
     {
-        lis_ret_code = lis2dh12_acceleration_raw_get (& (dev.ctx), raw_acceleration.u8bit);
-        err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
+        // Newest sample is taken at read time, older samples one interval apart.
+        p_data[ii].timestamp_ms = fifo_sample_time_ms (now, elements - 1U - ii, interval_ns);
         // Compensate data with resolution, scale
-        err_code |= rawToMg (&raw_acceleration, acceleration);
+        err_code |= rawToG (p_dev, & (raw_acceleration[ii]), acceleration);
         rd_sensor_data_t d_acceleration;
         rd_sensor_data_fields_t acc_fields = {.bitfield = 0};
         acc_fields.datas.acceleration_x_g = 1;
         acc_fields.datas.acceleration_y_g = 1;
         acc_fields.datas.acceleration_z_g = 1;
-        //Convert mG to G
-        acceleration[0] = acceleration[0] / 1000.0;
-        acceleration[1] = acceleration[1] / 1000.0;
-        acceleration[2] = acceleration[2] / 1000.0;
         d_acceleration.data = acceleration;
         d_acceleration.valid  = acc_fields;
         d_acceleration.fields = acc_fields;
+        d_acceleration.timestamp_ms = p_data[ii].timestamp_ms;
         rd_sensor_data_populate (& (p_data[ii]),
                                  &d_acceleration,
                                  p_data[ii].fields);
@@ -1135,8 +1392,71 @@ rd_status_t ri_lis2dh12_fifo_read (size_t * num_elements,
     return err_code;
 }
 
+static rd_status_t fifo_block_read (ri_lis2dh12_dev * const p_dev,
+                                    rd_sensor_fifo_block_t * const p_block)
+{
+    if (NULL == p_block) { return RD_ERROR_NULL; }
 
-rd_status_t ri_lis2dh12_fifo_interrupt_use (const bool enable)
+    axis3bit16_t raw_acceleration[RI_LIS2DH12_FIFO_SIZE];
+    size_t elements = RI_LIS2DH12_FIFO_SIZE;
+
+    if (elements > RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES)
+    {
+        elements = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES;
+    }
+
+    bool overrun = false;
+    rd_status_t err_code = fifo_raw_read (p_dev, &elements, raw_acceleration, &overrun);
+
+    if (RD_SUCCESS != err_code)
+    {
+        return err_code;
+    }
+
+    const uint64_t now = rd_sensor_timestamp_get();
+    fifo_timing_update (p_dev, now, elements, true, overrun);
+    const uint32_t interval_ns = fifo_interval_ns (p_dev);
+    // Newest sample is taken at read time, oldest sample one interval per element earlier.
+    const size_t oldest_age = (elements) ? (elements - 1U) : 0U;
+    p_block->timestamp_ms = fifo_sample_time_ms (now, oldest_age, interval_ns);
+    p_block->interval_us = interval_ns / 1000U;
+    p_block->count = (uint8_t) elements;
+
+    for (size_t ii = 0; (ii < elements) && (RD_SUCCESS == err_code); ii++)
+    {
+        int16_t mg[NUM_AXIS];
+        err_code |= raw_to_mg (p_dev, & (raw_acceleration[ii]), mg, 1U);
+        p_block->x[ii] = mg[0];
+        p_block->y[ii] = mg[1];
+        p_block->z[ii] = mg[2];
+    }
+
+    return err_code;
+}
+
+static rd_status_t fifo_drift_get (ri_lis2dh12_dev * const p_dev,
+                                   int32_t * const p_drift_ppm)
+{
+    if (NULL == p_drift_ppm) { return RD_ERROR_NULL; }
+
+    rd_status_t err_code = RD_SUCCESS;
+    const int64_t nominal_ns = (int64_t) samplerate_interval_ns (p_dev, p_dev->samplerate);
+
+    if ( (0 == p_dev->fifo_interval_ns) || (0 == nominal_ns))
+    {
+        *p_drift_ppm = 0;
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        *p_drift_ppm = (int32_t) ( ( ( (int64_t) p_dev->fifo_interval_ns - nominal_ns) * 1000000)
+                                   / nominal_ns);
+    }
+
+    return err_code;
+}
+
+static rd_status_t fifo_interrupt_use (ri_lis2dh12_dev * const p_dev, const bool enable)
 {
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
@@ -1146,12 +1466,12 @@ rd_status_t ri_lis2dh12_fifo_interrupt_use (const bool enable)
     {
         // Setting the FTH [4:0] bit in the FIFO_CTRL_REG (2Eh) register to an N value,
         // the number of X, Y and Z data samples that should be read at the rise of the watermark interrupt is up to (N+1).
-        lis_ret_code = lis2dh12_fifo_watermark_set (& (dev.ctx), 31);
+        lis_ret_code = lis2dh12_fifo_watermark_set (& (p_dev->ctx), 31);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         ctrl.i1_wtm = PROPERTY_ENABLE;
     }
 
-    lis_ret_code = lis2dh12_pin_int1_config_set (& (dev.ctx), &ctrl);
+    lis_ret_code = lis2dh12_pin_int1_config_set (& (p_dev->ctx), &ctrl);
     err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     return err_code;
 }
@@ -1171,7 +1491,8 @@ rd_status_t ri_lis2dh12_fifo_interrupt_use (const bool enable)
  * returns: error code from stack on error.
  *
  */
-rd_status_t ri_lis2dh12_activity_interrupt_use (const bool enable, float * const limit_g)
+static rd_status_t activity_interrupt_use (ri_lis2dh12_dev * const p_dev,
+                                           const bool enable, float * const limit_g)
 {
     rd_status_t err_code = RD_SUCCESS;
     int32_t lis_ret_code;
@@ -1208,7 +1529,7 @@ rd_status_t ri_lis2dh12_activity_interrupt_use (const bool enable, float * const
         uint8_t  scale;
         uint32_t threshold;
         float divisor;
-        lis_ret_code = ri_lis2dh12_scale_get (&scale);
+        lis_ret_code = scale_get (p_dev, &scale);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
 
         switch (scale)
@@ -1244,7 +1565,7 @@ rd_status_t ri_lis2dh12_activity_interrupt_use (const bool enable, float * const
         {
             *limit_g = ( (float) threshold) * divisor;
             // Configure INTERRUPT 1 Threshold
-            lis_ret_code = lis2dh12_int1_gen_threshold_set (& (dev.ctx), threshold);
+            lis_ret_code = lis2dh12_int1_gen_threshold_set (& (p_dev->ctx), threshold);
             err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         }
     }
@@ -1256,17 +1577,468 @@ rd_status_t ri_lis2dh12_activity_interrupt_use (const bool enable, float * const
     if (RD_SUCCESS == err_code)
     {
         // Configure highpass on INTERRUPT 1
-        lis_ret_code = lis2dh12_high_pass_int_conf_set (& (dev.ctx), high_pass);
+        lis_ret_code = lis2dh12_high_pass_int_conf_set (& (p_dev->ctx), high_pass);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         // Configure INTERRUPT 1.
-        lis_ret_code = lis2dh12_int1_gen_conf_set (& (dev.ctx), &cfg);
+        lis_ret_code = lis2dh12_int1_gen_conf_set (& (p_dev->ctx), &cfg);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
         // Route INTERRUPT 1 to PIN 2.
-        lis_ret_code = lis2dh12_pin_int2_config_set (& (dev.ctx), &ctrl6);
+        lis_ret_code = lis2dh12_pin_int2_config_set (& (p_dev->ctx), &ctrl6);
         err_code |= (LIS_SUCCESS == lis_ret_code) ? RD_SUCCESS : RD_ERROR_INTERNAL;
     }
 
     return err_code;
 }
+
+rd_status_t ri_lis2dh12_samplerate_set (uint8_t * samplerate)
+{
+    return samplerate_set (m_instance[0], samplerate);
+}
+
+rd_status_t ri_lis2dh12_samplerate_get (uint8_t * samplerate)
+{
+    return samplerate_get (m_instance[0], samplerate);
+}
+
+rd_status_t ri_lis2dh12_resolution_set (uint8_t * resolution)
+{
+    return resolution_set (m_instance[0], resolution);
+}
+
+rd_status_t ri_lis2dh12_resolution_get (uint8_t * resolution)
+{
+    return resolution_get (m_instance[0], resolution);
+}
+
+rd_status_t ri_lis2dh12_scale_set (uint8_t * scale)
+{
+    return scale_set (m_instance[0], scale);
+}
+
+rd_status_t ri_lis2dh12_scale_get (uint8_t * scale)
+{
+    return scale_get (m_instance[0], scale);
+}
+
+rd_status_t ri_lis2dh12_dsp_set (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_set (m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_lis2dh12_dsp_get (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_get (m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_lis2dh12_mode_set (uint8_t * mode)
+{
+    return mode_set (m_instance[0], mode);
+}
+
+rd_status_t ri_lis2dh12_mode_get (uint8_t * mode)
+{
+    return mode_get (m_instance[0], mode);
+}
+
+rd_status_t ri_lis2dh12_raw_to_mg (const axis3bit16_t * const p_raw,
+                                   int16_t * const p_mg,
+                                   const size_t num_elements)
+{
+    return raw_to_mg (m_instance[0], p_raw, p_mg, num_elements);
+}
+
+rd_status_t ri_lis2dh12_raw_to_g (const axis3bit16_t * const p_raw,
+                                  float * const p_g,
+                                  const size_t num_elements)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_raw) || (NULL == p_g))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        for (size_t ii = 0; ii < num_elements; ii++)
+        {
+            err_code |= rawToG (m_instance[0], &p_raw[ii], &p_g[ii * NUM_AXIS]);
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_lis2dh12_fifo_active (void)
+{
+    return fifo_active (m_instance[0]);
+}
+
+rd_status_t ri_lis2dh12_acceleration_raw_get (uint8_t * const raw_data)
+{
+    return acceleration_raw_get (m_instance[0], raw_data);
+}
+
+rd_status_t ri_lis2dh12_temperature_raw_get(uint8_t * const raw_temperature)
+{
+    return temperature_raw_get (m_instance[0], raw_temperature);
+}
+
+rd_status_t ri_lis2dh12_data_get (rd_sensor_data_t * const
+                                  data)
+{
+    return data_get (m_instance[0], data);
+}
+
+rd_status_t ri_lis2dh12_raw_data_parse (rd_sensor_data_t * const data, 
+            axis3bit16_t *raw_acceleration, uint8_t *raw_temperature)
+{
+    return raw_data_parse (m_instance[0], data, raw_acceleration, raw_temperature);
+}
+
+rd_status_t ri_lis2dh12_fifo_use (const bool enable)
+{
+    return fifo_use (m_instance[0], enable);
+}
+
+rd_status_t ri_lis2dh12_fifo_raw_read (size_t * const num_elements,
+                                       axis3bit16_t * const p_raw)
+{
+    rd_status_t err_code = fifo_raw_read (m_instance[0], num_elements, p_raw, NULL);
+
+    // Samples read here are not timed, next timed read restarts drift baseline.
+    if ( (NULL != num_elements) && (0U < *num_elements))
+    {
+        dev.fifo_drain_ms = RD_UINT64_INVALID;
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_lis2dh12_fifo_read (size_t * num_elements,
+                                   rd_sensor_data_t * p_data)
+{
+    return fifo_read (m_instance[0], num_elements, p_data);
+}
+
+rd_status_t ri_lis2dh12_fifo_block_read (rd_sensor_fifo_block_t * const p_block)
+{
+    return fifo_block_read (m_instance[0], p_block);
+}
+
+rd_status_t ri_lis2dh12_fifo_drift_get (int32_t * const p_drift_ppm)
+{
+    return fifo_drift_get (m_instance[0], p_drift_ppm);
+}
+
+rd_status_t ri_lis2dh12_fifo_interrupt_use (const bool enable)
+{
+    return fifo_interrupt_use (m_instance[0], enable);
+}
+
+rd_status_t ri_lis2dh12_activity_interrupt_use (const bool enable, float * const limit_g)
+{
+    return activity_interrupt_use (m_instance[0], enable, limit_g);
+}
+
+/** @brief Functions of one instance which depend on state of the instance. */
+typedef struct
+{
+    rd_sensor_setup_fp samplerate_set;
+    rd_sensor_setup_fp samplerate_get;
+    rd_sensor_setup_fp resolution_set;
+    rd_sensor_setup_fp resolution_get;
+    rd_sensor_setup_fp scale_set;
+    rd_sensor_setup_fp scale_get;
+    rd_sensor_dsp_fp dsp_set;
+    rd_sensor_dsp_fp dsp_get;
+    rd_sensor_setup_fp mode_set;
+    rd_sensor_setup_fp mode_get;
+    rd_sensor_data_fp data_get;
+    rd_sensor_fifo_enable_fp fifo_enable;
+    rd_sensor_fifo_enable_fp fifo_interrupt_enable;
+    rd_sensor_fifo_read_fp fifo_read;
+    rd_sensor_fifo_block_read_fp fifo_block_read;
+    rd_sensor_level_interrupt_use_fp level_interrupt_set;
+} lis2dh12_api_t;
+
+/** @brief Define functions of instance n, public functions are instance 0. */
+#define LIS2DH12_INSTANCE_DEFINE(n)                                                     \
+    RD_SENSOR_SETUP_BIND (samplerate_set_##n, samplerate_set, m_instance[n])          \
+    RD_SENSOR_SETUP_BIND (samplerate_get_##n, samplerate_get, m_instance[n])          \
+    RD_SENSOR_SETUP_BIND (resolution_set_##n, resolution_set, m_instance[n])          \
+    RD_SENSOR_SETUP_BIND (resolution_get_##n, resolution_get, m_instance[n])          \
+    RD_SENSOR_SETUP_BIND (scale_set_##n, scale_set, m_instance[n])                    \
+    RD_SENSOR_SETUP_BIND (scale_get_##n, scale_get, m_instance[n])                    \
+    RD_SENSOR_DSP_BIND (dsp_set_##n, dsp_set, m_instance[n])                          \
+    RD_SENSOR_DSP_BIND (dsp_get_##n, dsp_get, m_instance[n])                          \
+    RD_SENSOR_SETUP_BIND (mode_set_##n, mode_set, m_instance[n])                      \
+    RD_SENSOR_SETUP_BIND (mode_get_##n, mode_get, m_instance[n])                      \
+    RD_SENSOR_DATA_BIND (data_get_##n, data_get, m_instance[n])                       \
+    RD_SENSOR_FIFO_ENABLE_BIND (fifo_use_##n, fifo_use, m_instance[n])                \
+    RD_SENSOR_FIFO_ENABLE_BIND (fifo_interrupt_use_##n, fifo_interrupt_use,           \
+                                m_instance[n])                                        \
+    RD_SENSOR_FIFO_READ_BIND (fifo_read_##n, fifo_read, m_instance[n])                \
+    RD_SENSOR_FIFO_BLOCK_READ_BIND (fifo_block_read_##n, fifo_block_read,             \
+                                    m_instance[n])                                    \
+    RD_SENSOR_LEVEL_INTERRUPT_BIND (activity_interrupt_use_##n, activity_interrupt_use, \
+                                    m_instance[n])
+
+/** @brief Functions of instance n defined by @ref LIS2DH12_INSTANCE_DEFINE. */
+#define LIS2DH12_INSTANCE_API(n)                                                         \
+    {                                                                                    \
+        samplerate_set_##n, samplerate_get_##n, resolution_set_##n, resolution_get_##n,  \
+        scale_set_##n, scale_get_##n, dsp_set_##n, dsp_get_##n, mode_set_##n,            \
+        mode_get_##n, data_get_##n, fifo_use_##n, fifo_interrupt_use_##n, fifo_read_##n, \
+        fifo_block_read_##n, activity_interrupt_use_##n                                  \
+    }
+
+#if RI_LIS2DH12_MAX_INSTANCES > 1
+LIS2DH12_INSTANCE_DEFINE (1)
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 2
+LIS2DH12_INSTANCE_DEFINE (2)
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 3
+LIS2DH12_INSTANCE_DEFINE (3)
+#endif
+
+static const lis2dh12_api_t m_api[RI_LIS2DH12_MAX_INSTANCES] =
+{
+    {
+        ri_lis2dh12_samplerate_set, ri_lis2dh12_samplerate_get,
+        ri_lis2dh12_resolution_set, ri_lis2dh12_resolution_get,
+        ri_lis2dh12_scale_set, ri_lis2dh12_scale_get,
+        ri_lis2dh12_dsp_set, ri_lis2dh12_dsp_get,
+        ri_lis2dh12_mode_set, ri_lis2dh12_mode_get, ri_lis2dh12_data_get,
+        ri_lis2dh12_fifo_use, ri_lis2dh12_fifo_interrupt_use,
+        ri_lis2dh12_fifo_read, ri_lis2dh12_fifo_block_read,
+        ri_lis2dh12_activity_interrupt_use
+    },
+#if RI_LIS2DH12_MAX_INSTANCES > 1
+    LIS2DH12_INSTANCE_API (1),
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 2
+    LIS2DH12_INSTANCE_API (2),
+#endif
+#if RI_LIS2DH12_MAX_INSTANCES > 3
+    LIS2DH12_INSTANCE_API (3),
+#endif
+};
+
+/**
+ * @brief Find instance bound to sensor or a free instance.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor if it has one, otherwise index of
+ *         first free instance. @ref RI_LIS2DH12_MAX_INSTANCES if none is found.
+ */
+static uint8_t instance_find (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_LIS2DH12_MAX_INSTANCES;
+    uint8_t free = RI_LIS2DH12_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_LIS2DH12_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+        else if ( (NULL == m_owner[ii]) && (RI_LIS2DH12_MAX_INSTANCES == free))
+        {
+            free = ii;
+        }
+        else
+        {
+            // Instance belongs to other sensor.
+        }
+    }
+
+    return (RI_LIS2DH12_MAX_INSTANCES == own) ? free : own;
+}
+
+/**
+ * @brief Find instance bound to sensor.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor, @ref RI_LIS2DH12_MAX_INSTANCES if
+ *         sensor has no instance.
+ */
+static uint8_t instance_owned (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_LIS2DH12_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_LIS2DH12_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+    }
+
+    return own;
+}
+
+/** @brief Settings held by driver for instance. */
+static ri_lis2dh12_dev * dev_pool (const uint8_t instance)
+{
+#if RI_LIS2DH12_MAX_INSTANCES > 1
+    return (0U == instance) ? &dev : &m_dev[instance - 1U];
+#else
+    (void) instance;
+    return &dev;
+#endif
+}
+
+/** @brief Return instance to settings held by driver. */
+static void dev_release (rd_sensor_t * const p_sensor, const uint8_t instance)
+{
+    memset (m_instance[instance], 0, sizeof (ri_lis2dh12_dev));
+
+    if (dev_pool (instance) == p_sensor->p_ctx)
+    {
+        p_sensor->p_ctx = NULL;
+    }
+
+    m_instance[instance] = dev_pool (instance);
+}
+
+rd_status_t ri_lis2dh12_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t instance = RI_LIS2DH12_MAX_INSTANCES;
+    LOGD ("begin\r\n");
+
+    if (NULL == p_sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+        LOGD ("p_sensor. Error = %08x\r\n", err_code);
+    }
+    else if (rd_sensor_is_init (p_sensor))
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+        LOGD ("write_reg. Error = %08x\r\n", err_code);
+    }
+    else if (RI_LIS2DH12_MAX_INSTANCES == (instance = instance_find (p_sensor)))
+    {
+        err_code |= RD_ERROR_RESOURCES;
+        LOGD ("instance_find. Error = %08x\r\n", err_code);
+    }
+    else
+    {
+        if (NULL == p_sensor->p_ctx)
+        {
+            p_sensor->p_ctx = dev_pool (instance);
+        }
+
+        m_instance[instance] = p_sensor->p_ctx;
+        ri_lis2dh12_dev * const p_dev = m_instance[instance];
+        const lis2dh12_api_t * const p_api = &m_api[instance];
+        err_code |= dev_ctx_init (p_dev, bus, handle);
+        LOGD ("dev_ctx_init. Error = %08x\r\n", err_code);
+        rd_sensor_initialize (p_sensor);
+        p_sensor->name = m_acc_name;
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= ri_delay_ms (PWRON_DELAY_MS);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= check_whoami (p_dev);
+            LOGD ("check_whoami. Error = %08x\r\n", err_code);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= clear_sensor_state (p_dev);
+            LOGD ("clear_sensor_state. Error = %08x\r\n", err_code);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= selftest (p_dev);
+            LOGD ("selftest. Error = %08x\r\n", err_code);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            p_sensor->init                  = ri_lis2dh12_init;
+            p_sensor->uninit                = ri_lis2dh12_uninit;
+            p_sensor->samplerate_set        = p_api->samplerate_set;
+            p_sensor->samplerate_get        = p_api->samplerate_get;
+            p_sensor->resolution_set        = p_api->resolution_set;
+            p_sensor->resolution_get        = p_api->resolution_get;
+            p_sensor->scale_set             = p_api->scale_set;
+            p_sensor->scale_get             = p_api->scale_get;
+            p_sensor->dsp_set               = p_api->dsp_set;
+            p_sensor->dsp_get               = p_api->dsp_get;
+            p_sensor->mode_set              = p_api->mode_set;
+            p_sensor->mode_get              = p_api->mode_get;
+            p_sensor->data_get              = p_api->data_get;
+            p_sensor->cost_get              = ri_lis2dh12_cost_get;
+            p_sensor->configuration_set     = rd_sensor_configuration_set;
+            p_sensor->configuration_get     = rd_sensor_configuration_get;
+            p_sensor->fifo_enable           = p_api->fifo_enable;
+            p_sensor->fifo_interrupt_enable = p_api->fifo_interrupt_enable;
+            p_sensor->fifo_read             = p_api->fifo_read;
+            p_sensor->fifo_block_read       = p_api->fifo_block_read;
+            p_sensor->level_interrupt_set   = p_api->level_interrupt_set;
+            p_sensor->provides.datas.acceleration_x_g = 1;
+            p_sensor->provides.datas.acceleration_y_g = 1;
+            p_sensor->provides.datas.acceleration_z_g = 1;
+            p_sensor->provides.datas.temperature_c = 1;
+            p_dev->tsample = RD_UINT64_INVALID;
+            fifo_timing_reset (p_dev);
+            m_owner[instance] = p_sensor;
+        }
+        else
+        {
+            rd_sensor_uninitialize (p_sensor);
+            dev_release (p_sensor, instance);
+        }
+    }
+
+    LOGD ("end. Error = %08x\r\n", err_code);
+    return err_code;
+}
+
+/*
+ * Lis2dh12 does not have a proper softreset (boot does not reset all registers)
+ * Therefore just stop sampling
+ */
+rd_status_t ri_lis2dh12_uninit (rd_sensor_t * p_sensor,
+                                rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        // Sensor which was never initialized has no device to power down.
+        const uint8_t instance = instance_owned (p_sensor);
+        rd_sensor_uninitialize (p_sensor);
+
+        if (RI_LIS2DH12_MAX_INSTANCES > instance)
+        {
+            ri_lis2dh12_dev * const p_dev = m_instance[instance];
+            p_dev->samplerate = LIS2DH12_POWER_DOWN;
+            //LIS2DH12 function returns SPI write result which is rd_status_t
+            int32_t lis_ret_code = lis2dh12_data_rate_set (& (p_dev->ctx), p_dev->samplerate);
+            dev_release (p_sensor, instance);
+            m_owner[instance] = NULL;
+
+            if (LIS_SUCCESS != lis_ret_code)
+            {
+                err_code |= RD_ERROR_INTERNAL;
+            }
+        }
+    }
+
+    return err_code;
+}
 /*@}*/
 #endif
@@ -65,8 +65,33 @@
 #define LIS_SUCCESS (0)  //!< No error in LIS driver.
 #define SELF_TEST_DELAY_MS (100U) //!< At least 3 samples at 400 Hz, but recommended value 100
 #define SELF_TEST_SAMPLES_NUM (5) //!< 5 samples
+/** @brief Drains with sample interval further than 1/N from nominal restart drift baseline. */
+#define RI_LIS2DH12_DRIFT_TOLERANCE_DIV (8U)
+/**
+ * @brief Samples on drift baseline before interval is estimated.
+ *
+ * Sample phase at both ends of baseline is known to one interval, error of
+ * the estimate is at most 2 / N.
+ */
+#define RI_LIS2DH12_DRIFT_MIN_SAMPLES (4096U)
+/** @brief Baseline is restarted after N samples to follow temperature drift. */
+#define RI_LIS2DH12_DRIFT_MAX_SAMPLES (65536U)
+/** @brief Typical current in power-down mode, nA. */
+#define RI_LIS2DH12_POWER_DOWN_NA (500U)
 
-/** @brief @ref rd_sensor_init_fp */
+/**
+ * @brief @ref rd_sensor_init_fp
+ *
+ * Up to @ref RI_LIS2DH12_MAX_INSTANCES sensors can be initialized at once,
+ * each with own handle. Function pointers of the initialized sensor operate
+ * on that sensor. Functions ri_lis2dh12_* below operate on instance 0, which
+ * is taken by first sensor initialized while it is free.
+ *
+ * Give a @ref ri_lis2dh12_dev in p_ctx of sensor to keep settings in
+ * application memory. If p_ctx is NULL, a context is taken from driver.
+ *
+ * @retval RD_ERROR_RESOURCES if all instances are in use.
+ */
 rd_status_t ri_lis2dh12_init (rd_sensor_t * acceleration_sensor, rd_bus_t bus,
                               uint8_t handle);
 /** @brief @ref rd_sensor_init_fp */
@@ -95,6 +120,18 @@ rd_status_t ri_lis2dh12_mode_get (uint8_t *);
 /** @brief @ref rd_sensor_data_fp */
 rd_status_t ri_lis2dh12_data_get (rd_sensor_data_t * const data);
 
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Samplerate and resolution are evaluated like in @ref ri_lis2dh12_samplerate_set
+ * and @ref ri_lis2dh12_resolution_set, current of each data rate and operating mode
+ * is from current consumption table of datasheet. Scale and DSP do not
+ * affect current and are not evaluated. Single sample runs the sensor at 400 Hz
+ * for turn-on time.
+ */
+rd_status_t ri_lis2dh12_cost_get (const rd_sensor_configuration_t * const p_config,
+                                  rd_sensor_cost_t * const p_cost);
+
 /** @brief Representation of 3*2 bytes buffer as 3*int16_t */
 #define NUM_AXIS    (3U) //!< X, Y, Z.
 typedef union
@@ -116,6 +153,11 @@ rd_status_t ri_lis2dh12_fifo_use (const bool enable);
 * @brief Read FIFO
 * Reads up to num_elements data points from FIFO and populates pointer data with them
 *
+* Each data point is timestamped. The newest data point has the time of the read,
+* older points are spaced by sample interval. Sample interval is measured from
+* consecutive reads, see @ref ri_lis2dh12_fifo_drift_get, and nominal interval of
+* samplerate is used until first measurement.
+*
 * @param[in, out] num_elements Input: number of elements in data. Output: Number of elements placed in data
 * @param[out] data array with num_elements slots.
 * @param RD_SUCCESS on success
@@ -125,6 +167,58 @@ rd_status_t ri_lis2dh12_fifo_use (const bool enable);
 */
 rd_status_t ri_lis2dh12_fifo_read (size_t * num_elements, rd_sensor_data_t * data);
 
+/**
+* @brief Read FIFO as raw samples in a single bus transaction.
+*
+* Reads up to num_elements samples from FIFO with one auto-incrementing
+* register read, without converting them. Use @ref ri_lis2dh12_raw_data_parse
+* or @ref ri_lis2dh12_fifo_read to get samples in physical units.
+*
+* @param[in, out] num_elements Input: number of elements in p_raw.
+*                              Output: Number of elements placed in p_raw.
+* @param[out] p_raw array with num_elements slots.
+* @retval RD_SUCCESS on success
+* @retval RD_ERROR_NULL if either parameter is NULL
+* @retval RD_ERROR_INVALID_STATE if FIFO is not in use
+* @return error code from stack on error.
+*/
+rd_status_t ri_lis2dh12_fifo_raw_read (size_t * const num_elements,
+                                       axis3bit16_t * const p_raw);
+
+/**
+* @brief Read FIFO into a compact block of samples in milli-g.
+*
+* Reads entire FIFO in one bus transaction. Timestamp of the block is read time
+* minus one sample interval per sample. Sample interval is measured from
+* consecutive reads like in @ref ri_lis2dh12_fifo_read, nominal interval of
+* samplerate is used until first measurement.
+*
+* @param[out] p_block Block to fill, @ref rd_sensor_fifo_block_read_fp.
+* @retval RD_SUCCESS on success
+* @retval RD_ERROR_NULL if p_block is NULL
+* @retval RD_ERROR_INVALID_STATE if FIFO is not in use
+* @return error code from stack on error.
+*/
+rd_status_t ri_lis2dh12_fifo_block_read (rd_sensor_fifo_block_t * const p_block);
+
+/**
+* @brief Get drift of sensor sample clock measured between FIFO reads.
+*
+* Samples read and time elapsed are accumulated over consecutive reads which
+* empty FIFO. Interval is estimated after @ref RI_LIS2DH12_DRIFT_MIN_SAMPLES
+* samples, so that error of sample phase at read times is small relative to the
+* baseline. FIFO overrun, a read which leaves samples on FIFO or an implausible
+* read interval restarts the baseline, previous estimate is kept. Measurement
+* is reset on samplerate, resolution and FIFO configuration.
+*
+* @param[out] p_drift_ppm Measured sample interval error relative to nominal, ppm.
+*                         Positive value means sensor samples slower than nominal.
+* @retval RD_SUCCESS on success.
+* @retval RD_ERROR_NULL if p_drift_ppm is NULL.
+* @retval RD_ERROR_INVALID_STATE if drift has not been measured yet.
+*/
+rd_status_t ri_lis2dh12_fifo_drift_get (int32_t * const p_drift_ppm);
+
 /**
 * @brief Enable FIFO full interrupt on LIS2DH12.
 * Triggers as ACTIVE HIGH interrupt once FIFO has 32 elements.
@@ -187,6 +281,37 @@ rd_status_t ri_lis2dh12_raw_data_parse (rd_sensor_data_t * const data,
             axis3bit16_t *raw_acceleration, uint8_t *raw_temperature);
 
 
+/**
+ * @brief Convert raw acceleration samples to milli-g in fixed point.
+ *
+ * Uses conversion factors cached on scale and resolution configuration,
+ * no floating point operations are needed.
+ *
+ * @param[in] p_raw Raw samples, e.g. from @ref ri_lis2dh12_fifo_raw_read.
+ * @param[out] p_mg Array of num_elements * 3 values, X, Y, Z of each sample in mg.
+ * @param[in] num_elements Number of samples to convert.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if either pointer is NULL.
+ * @retval RD_ERROR_INVALID_STATE if scale or resolution is not configured.
+ */
+rd_status_t ri_lis2dh12_raw_to_mg (const axis3bit16_t * const p_raw,
+                                   int16_t * const p_mg,
+                                   const size_t num_elements);
+
+/**
+ * @brief Convert raw acceleration samples to g, as reported by data_get.
+ *
+ * @param[in] p_raw Raw samples, e.g. from @ref ri_lis2dh12_fifo_raw_read.
+ * @param[out] p_g Array of num_elements * 3 values, X, Y, Z of each sample in g.
+ * @param[in] num_elements Number of samples to convert.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if either pointer is NULL.
+ * @retval RD_ERROR_INTERNAL if scale or resolution is not configured.
+ */
+rd_status_t ri_lis2dh12_raw_to_g (const axis3bit16_t * const p_raw,
+                                  float * const p_g,
+                                  const size_t num_elements);
+
 /** @brief context for LIS2DH12 */
 typedef struct
 {
@@ -197,6 +322,13 @@ typedef struct
     uint8_t mode;                //!< Operating mode. Sleep, single or continuous.
     uint8_t handle;              //!< Device handle, SPI GPIO pin or I2C address.
     uint64_t tsample;            //!< Time of sample, @ref rd_sensor_timestamp_get
+    float g_per_lsb;             //!< Cached conversion of raw data to g on current configuration.
+    uint8_t mg_shift;            //!< Cached number of unused low bits in raw data.
+    uint8_t mg_per_digit;        //!< Cached sensitivity of raw data, 0 if not configured.
+    uint64_t fifo_drain_ms;      //!< Time of last FIFO read which emptied FIFO, RD_UINT64_INVALID if unknown.
+    uint64_t fifo_base_ms;       //!< Start of drift baseline, time of a FIFO read which emptied FIFO.
+    uint32_t fifo_base_samples;  //!< Samples read since start of drift baseline.
+    uint32_t fifo_interval_ns;   //!< Sample interval measured over drift baseline, 0 if unknown.
     stmdev_ctx_t ctx;            //!< Driver control structure
 } ri_lis2dh12_dev;
 
@@ -3,6 +3,7 @@
 #include "ruuvi_driver_error.h"
 #include "ruuvi_driver_sensor.h"
 #include "ruuvi_interface_gpio.h"
+#include <stddef.h>
 /**
  * @addtogroup ADC
  *
@@ -23,6 +24,25 @@
 #  define RUUVI_NRF5_SDK15_ADC_ENABLED RUUVI_NRF5_SDK15_ENABLED
 #endif
 
+/**
+ * @brief Estimated time of one single-ended sample, including acquisition, us.
+ *
+ * Used by cost estimates of ADC sensors, override in application for other MCUs.
+ */
+#ifndef RI_ADC_SAMPLE_US
+#  define RI_ADC_SAMPLE_US (20U)
+#endif
+
+/** @brief Estimated current of ADC while sampling, nA. Current of divider is excluded. */
+#ifndef RI_ADC_ACTIVE_NA
+#  define RI_ADC_ACTIVE_NA (1300000U)
+#endif
+
+/** @brief Sample interval assumed by cost estimates of on-demand ADC sensors, us. */
+#ifndef RI_ADC_COST_INTERVAL_US
+#  define RI_ADC_COST_INTERVAL_US (1000000U)
+#endif
+
 /* Analog input channels of device */
 typedef enum
 {
@@ -149,6 +169,14 @@ typedef struct
     ri_adc_resolution_t resolution;
 } ri_adc_config_t;
 
+/**
+ * @brief Called in interrupt context when a stream buffer has been filled.
+ *
+ * @param[in] p_buffer Buffer given to @ref ri_adc_stream_buffer_put.
+ * @param[in] count Number of samples in buffer.
+ */
+typedef void (*ri_adc_stream_fp_t) (int16_t * const p_buffer, const size_t count);
+
 /* ADC result config struct. */
 typedef struct
 {
@@ -246,6 +274,97 @@ rd_status_t ri_adc_get_data_ratio (uint8_t channel_num,
                                    ri_adc_get_data_t * p_config,
                                    float * p_data);
 
+/**
+ * @brief Sample all configured channels in one scan.
+ *
+ * ADC is enabled once and every configured channel is converted in ascending
+ * order of channel number. Function returns after all channels are sampled.
+ *
+ * @param[out] p_data Raw ADC data, one value per configured channel.
+ * @param[in] count Number of values in p_data, must equal number of configured channels.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_data is NULL.
+ * @retval RD_ERROR_INVALID_STATE if ADC is not initialized.
+ * @retval RD_ERROR_INVALID_PARAM if count does not match configured channels.
+ * @retval RD_ERROR_TIMEOUT if scan does not complete, scan is aborted.
+ */
+rd_status_t ri_adc_scan_raw_data (int16_t * const p_data, const size_t count);
+
+/**
+ * @brief Convert raw ADC data to volts.
+ *
+ * @param[in] channel_num ADC channel the data was sampled on.
+ * @param[in] p_config ADC output config.
+ * @param[in] raw Raw ADC data, e.g. from @ref ri_adc_scan_raw_data.
+ * @param[out] p_data ADC data in volts.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_PARAM if channel is not configured or p_config is invalid.
+ * @return RD_ERROR_NULL if either pointer is NULL.
+ */
+rd_status_t ri_adc_raw_to_absolute (const uint8_t channel_num,
+                                    ri_adc_get_data_t * const p_config,
+                                    const int16_t raw, float * const p_data);
+
+/**
+ * @brief Convert raw ADC data to ratio to VDD.
+ *
+ * @param[in] channel_num ADC channel the data was sampled on.
+ * @param[in] p_config ADC output config.
+ * @param[in] raw Raw ADC data, e.g. from @ref ri_adc_scan_raw_data.
+ * @param[out] p_data ADC data as a ratio to VDD.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_PARAM if channel is not configured or p_config is invalid.
+ * @return RD_ERROR_NULL if either pointer is NULL.
+ */
+rd_status_t ri_adc_raw_to_ratio (const uint8_t channel_num,
+                                 ri_adc_get_data_t * const p_config,
+                                 const int16_t raw, float * const p_data);
+
+/**
+ * @brief Start sampling a channel continuously at a fixed rate.
+ *
+ * Samples are written into buffers given with @ref ri_adc_stream_buffer_put
+ * without CPU intervention. When a buffer is full, sampling continues into
+ * the next queued buffer and on_full is called with the full buffer.
+ * If no buffer is queued, samples are lost until next buffer is put.
+ * Queue at least one buffer before starting the stream.
+ *
+ * @param[in] channel_num ADC channel, must be the only configured channel.
+ * @param[in,out] p_samplerate_hz Requested sample rate, actual rate on return.
+ * @param[in] on_full Called in interrupt context when a buffer is full.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if either pointer is NULL.
+ * @retval RD_ERROR_INVALID_STATE if ADC is not initialized or already streaming.
+ * @retval RD_ERROR_INVALID_PARAM if channel is not configured or other channels are.
+ * @retval RD_ERROR_NOT_SUPPORTED if sample rate cannot be reached.
+ */
+rd_status_t ri_adc_stream_start (const uint8_t channel_num,
+                                 uint32_t * const p_samplerate_hz,
+                                 const ri_adc_stream_fp_t on_full);
+
+/**
+ * @brief Queue a buffer to be filled by stream.
+ *
+ * Implementation holds at most two buffers, one being filled and the next one.
+ * Function is safe to call from @ref ri_adc_stream_fp_t.
+ *
+ * @param[in] p_buffer Buffer to fill, must stay valid until it is returned by
+ *                     @ref ri_adc_stream_fp_t or stream is stopped.
+ * @param[in] count Number of samples to fill.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_buffer is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if count is 0 or too large.
+ * @retval RD_ERROR_BUSY if two buffers are already queued.
+ */
+rd_status_t ri_adc_stream_buffer_put (int16_t * const p_buffer, const size_t count);
+
+/**
+ * @brief Stop stream and release queued buffers.
+ *
+ * @retval RD_SUCCESS on success.
+ */
+rd_status_t ri_adc_stream_stop (void);
+
 /**
  * @brief Return true if given channel  index can be used by underlying implementation.
  *
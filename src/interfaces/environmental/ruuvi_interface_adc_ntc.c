@@ -7,6 +7,7 @@
 #include "ruuvi_interface_adc_ntc.h"
 #include "ruuvi_interface_adc_mcu.h"
 #include "ruuvi_interface_yield.h"
+#include <string.h>
 
 /**
  * @addtogroup ADC_NTC
@@ -101,28 +102,82 @@ float m_temperture;                  //!< Last measured temperature
 static bool m_is_init;               //!< Flag, is sensor init.
 static const char m_sensor_name[] = "NTC"; //!< Human-readable name of the sensor.
 
+#define ADC_NTC_LN_LUT_BITS       (6U) //!< 64 segments per octave.
+#define ADC_NTC_LN_LUT_SIZE       ((1U << ADC_NTC_LN_LUT_BITS) + 1U)
+#define ADC_NTC_LN2               (0.693147181f)
+#define ADC_NTC_FLOAT_EXP_BIAS    (127)
+#define ADC_NTC_FLOAT_EXP_MASK    (0xFFU)
+#define ADC_NTC_FLOAT_MANT_BITS   (23U)
+#define ADC_NTC_LUT_FRAC_BITS     (ADC_NTC_FLOAT_MANT_BITS - ADC_NTC_LN_LUT_BITS)
+#define ADC_NTC_LUT_FRAC_MASK     ((1UL << ADC_NTC_LUT_FRAC_BITS) - 1U)
+/** @brief Balance resistor relative to calibration resistance of NTC. */
+#define ADC_NTC_BALANCE_TO_R0     ((float) ADC_NTC_BALANCE / (float) ADC_NTC_DEFAULT_RES)
+#define ADC_NTC_INV_T0            (1.0F / (float) ADC_NTC_DEFAULT_TEMP_K)
+#define ADC_NTC_INV_BETA          (1.0F / (float) ADC_NTC_DEFAULT_BETA)
+
+/** @brief ln(1 + i / 64), i = 0 ... 64. */
+static const float m_ln_lut[ADC_NTC_LN_LUT_SIZE] =
+{
+    0.000000000f, 0.015504187f, 0.030771659f, 0.045809536f, 0.060624622f,
+    0.075223421f, 0.089612159f, 0.103796794f, 0.117783036f, 0.131576358f,
+    0.145182010f, 0.158605030f, 0.171850257f, 0.184922338f, 0.197825743f,
+    0.210564769f, 0.223143551f, 0.235566071f, 0.247836164f, 0.259957524f,
+    0.271933715f, 0.283768173f, 0.295464213f, 0.307025035f, 0.318453731f,
+    0.329753286f, 0.340926587f, 0.351976423f, 0.362905494f, 0.373716410f,
+    0.384411699f, 0.394993808f, 0.405465108f, 0.415827895f, 0.426084395f,
+    0.436236767f, 0.446287103f, 0.456237433f, 0.466089730f, 0.475845905f,
+    0.485507816f, 0.495077267f, 0.504556011f, 0.513945751f, 0.523248144f,
+    0.532464799f, 0.541597282f, 0.550647118f, 0.559615788f, 0.568504735f,
+    0.577315365f, 0.586049045f, 0.594707108f, 0.603290851f, 0.611801541f,
+    0.620240410f, 0.628608659f, 0.636907462f, 0.645137961f, 0.653301272f,
+    0.661398482f, 0.669430654f, 0.677398824f, 0.685304003f, 0.693147181f,
+};
+
 /**
- * @brief convert measured voltage ratio to temperature
+ * @brief Natural logarithm by linear interpolation of mantissa.
  *
- * @param[in] ratio Measured voltage ratio in NTC divider. 0.0 ... 1.0
- * @return temperature in celcius.
- * @retval RD_FLOAT_INVALID if ratio < 0.0 or ratio > 1.0
+ * Exponent of float gives the integer part of log2, logarithm of mantissa
+ * is interpolated from @ref m_ln_lut. Interpolation error is below
+ * 1 / (8 * 64^2) = 3.1e-5 which is below @ref RI_ADC_NTC_LN_ERROR_MAX.
+ * Zero, subnormal, infinite and NaN input fall back to libm.
+ *
+ * @param[in] x Value to take logarithm of.
+ * @return ln(x).
  */
-static float ratio_to_temperature (const float * const ratio)
+static float ntc_ln (const float x)
+{
+    uint32_t bits;
+    float result;
+    memcpy (&bits, &x, sizeof (bits));
+    const uint32_t exponent = (bits >> ADC_NTC_FLOAT_MANT_BITS) & ADC_NTC_FLOAT_EXP_MASK;
+
+    if ( (0U == exponent) || (ADC_NTC_FLOAT_EXP_MASK == exponent) || (x < 0.0F))
+    {
+        result = logf (x);
+    }
+    else
+    {
+        const uint32_t index = (bits >> ADC_NTC_LUT_FRAC_BITS)
+                               & ( (1UL << ADC_NTC_LN_LUT_BITS) - 1U);
+        const float fraction = (float) (bits & ADC_NTC_LUT_FRAC_MASK)
+                               / (float) (1UL << ADC_NTC_LUT_FRAC_BITS);
+        result = (float) ( (int32_t) exponent - ADC_NTC_FLOAT_EXP_BIAS) * ADC_NTC_LN2;
+        result += m_ln_lut[index] + (fraction * (m_ln_lut[index + 1U] - m_ln_lut[index]));
+    }
+
+    return result;
+}
+
+float ri_adc_ntc_ratio_to_temperature (const float ratio)
 {
     float result = RD_FLOAT_INVALID;
-    float Rt;
-    float Rb = (float)   ADC_NTC_BALANCE;        //!< Fixed divider resistance
-    float beta = (float) ADC_NTC_DEFAULT_BETA;   //!< Beta of NTC
-    float T0 = (float)   ADC_NTC_DEFAULT_TEMP_K; //!< Calibration temp of NTC.
-    float R0 = (float)   RI_ADC_NTC_DEFAULT_RES; //!< Calibration resistance of NTC.
 
-    if ( (NULL != ratio) && (*ratio >= 0.0F) && (*ratio <= 1.0F))
+    if ( (ratio >= 0.0F) && (ratio <= 1.0F))
     {
-        // Calculate NTC resistance.
-        Rt = (Rb * *ratio) / (1.0F - *ratio);
+        // Rt / R0, divider constants are folded at compile time.
+        const float rt_r0 = (ADC_NTC_BALANCE_TO_R0 * ratio) / (1.0F - ratio);
         // 1/T = 1/T0 + 1/B * ln(R/R0)
-        result = 1.0F / ( (1 / T0) + ( (1 / beta) * log (Rt / R0)));
+        result = 1.0F / (ADC_NTC_INV_T0 + (ADC_NTC_INV_BETA * ntc_ln (rt_r0)));
         // Convert K->C
         result -= ADC_K_TO_C_CONST;
     }
@@ -141,7 +196,7 @@ static rd_status_t get_data (void)
             &ratio))
     {
         //m_temperture = volts_to_temperature (&volts);
-        m_temperture = ratio_to_temperature (&ratio);
+        m_temperture = ri_adc_ntc_ratio_to_temperature (ratio);
     }
     else
     {
@@ -192,7 +247,7 @@ rd_status_t ri_adc_ntc_dsp_set (uint8_t * dsp, uint8_t * parameter)
         }
     }
 
-    return RD_SUCCESS;
+    return err_code;
 }
 
 rd_status_t ri_adc_ntc_dsp_get (uint8_t * dsp, uint8_t * parameter)
@@ -201,6 +256,41 @@ rd_status_t ri_adc_ntc_dsp_get (uint8_t * dsp, uint8_t * parameter)
              validate_default_input_get (parameter));
 }
 
+rd_status_t ri_adc_ntc_cost_get (const rd_sensor_configuration_t * const p_config,
+                                 rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else if ( (RD_SENSOR_DSP_LAST != p_config->dsp_function)
+              && (RD_SENSOR_CFG_NO_CHANGE != p_config->dsp_function))
+    {
+        err_code = RD_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        p_cost->conversion_us = RI_ADC_SAMPLE_US;
+        p_cost->charge_nc = (RI_ADC_ACTIVE_NA / 1000U) * RI_ADC_SAMPLE_US / 1000U;
+        p_cost->sleep_na = 0U;
+
+        if ( (RD_SENSOR_CFG_SINGLE == p_config->mode)
+                || (RD_SENSOR_CFG_CONTINUOUS == p_config->mode))
+        {
+            p_cost->average_na = rd_sensor_cost_average_na (p_cost,
+                                 RI_ADC_COST_INTERVAL_US);
+        }
+        else
+        {
+            p_cost->average_na = p_cost->sleep_na;
+        }
+    }
+
+    return err_code;
+}
+
 rd_status_t ri_adc_ntc_init (rd_sensor_t *
                              environmental_sensor, rd_bus_t bus, uint8_t handle)
 {
@@ -241,6 +331,7 @@ rd_status_t ri_adc_ntc_init (rd_sensor_t *
                 environmental_sensor->mode_set          = ri_adc_ntc_mode_set;
                 environmental_sensor->mode_get          = ri_adc_ntc_mode_get;
                 environmental_sensor->data_get          = ri_adc_ntc_data_get;
+                environmental_sensor->cost_get          = ri_adc_ntc_cost_get;
                 environmental_sensor->configuration_set = rd_sensor_configuration_set;
                 environmental_sensor->configuration_get = rd_sensor_configuration_get;
                 environmental_sensor->provides.datas.temperature_c = ADC_NTC_ENABLE_BYTE;
@@ -29,6 +29,14 @@
 #include "ruuvi_driver_error.h"
 #include "ruuvi_driver_sensor.h"
 
+/**
+ * @brief Maximum absolute error of ln(R/R0) in temperature conversion.
+ *
+ * Error of temperature in kelvins is T^2 / B * error of logarithm, i.e.
+ * below 0.005 C between -40 C and +125 C with default beta of 3974.
+ */
+#define RI_ADC_NTC_LN_ERROR_MAX (4.0e-5F)
+
 /** @brief @ref rd_sensor_init_fp */
 rd_status_t ri_adc_ntc_init (rd_sensor_t *
                              environmental_sensor, rd_bus_t bus, uint8_t handle);
@@ -58,5 +66,27 @@ rd_status_t ri_adc_ntc_mode_get (uint8_t *);
 /** @brief @ref rd_sensor_data_fp */
 rd_status_t ri_adc_ntc_data_get (rd_sensor_data_t * const
                                  data);
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Sensor samples ADC on demand, average current is estimated for one sample per
+ * @ref RI_ADC_COST_INTERVAL_US. Current of the divider depends on the board
+ * and is not included.
+ */
+rd_status_t ri_adc_ntc_cost_get (const rd_sensor_configuration_t * const p_config,
+                                 rd_sensor_cost_t * const p_cost);
+
+/**
+ * @brief Convert measured voltage ratio of NTC divider to temperature.
+ *
+ * Uses beta equation 1/T = 1/T0 + 1/B * ln(R/R0) with a lookup table for the
+ * logarithm, error is bounded by @ref RI_ADC_NTC_LN_ERROR_MAX. No double
+ * precision or libm calls are used on valid NTC readings.
+ *
+ * @param[in] ratio Measured voltage ratio in NTC divider. 0.0 ... 1.0
+ * @return temperature in celcius.
+ * @retval RD_FLOAT_INVALID if ratio < 0.0 or ratio > 1.0
+ */
+float ri_adc_ntc_ratio_to_temperature (const float ratio);
 /*@}*/
 #endif
\ No newline at end of file
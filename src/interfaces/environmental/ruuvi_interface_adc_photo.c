@@ -146,7 +146,7 @@ rd_status_t ri_adc_photo_dsp_set (uint8_t * dsp, uint8_t * parameter)
         }
     }
 
-    return RD_SUCCESS;
+    return err_code;
 }
 
 rd_status_t ri_adc_photo_dsp_get (uint8_t * dsp, uint8_t * parameter)
@@ -158,6 +158,41 @@ rd_status_t ri_adc_photo_dsp_get (uint8_t * dsp, uint8_t * parameter)
     return err_code;
 }
 
+rd_status_t ri_adc_photo_cost_get (const rd_sensor_configuration_t * const p_config,
+                                   rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else if ( (RD_SENSOR_DSP_LAST != p_config->dsp_function)
+              && (RD_SENSOR_CFG_NO_CHANGE != p_config->dsp_function))
+    {
+        err_code = RD_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        p_cost->conversion_us = RI_ADC_SAMPLE_US;
+        p_cost->charge_nc = (RI_ADC_ACTIVE_NA / 1000U) * RI_ADC_SAMPLE_US / 1000U;
+        p_cost->sleep_na = 0U;
+
+        if ( (RD_SENSOR_CFG_SINGLE == p_config->mode)
+                || (RD_SENSOR_CFG_CONTINUOUS == p_config->mode))
+        {
+            p_cost->average_na = rd_sensor_cost_average_na (p_cost,
+                                 RI_ADC_COST_INTERVAL_US);
+        }
+        else
+        {
+            p_cost->average_na = p_cost->sleep_na;
+        }
+    }
+
+    return err_code;
+}
+
 rd_status_t ri_adc_photo_init (rd_sensor_t *
                                environmental_sensor, rd_bus_t bus, uint8_t handle)
 {
@@ -198,6 +233,7 @@ rd_status_t ri_adc_photo_init (rd_sensor_t *
                 environmental_sensor->mode_set          = ri_adc_photo_mode_set;
                 environmental_sensor->mode_get          = ri_adc_photo_mode_get;
                 environmental_sensor->data_get          = ri_adc_photo_data_get;
+                environmental_sensor->cost_get          = ri_adc_photo_cost_get;
                 environmental_sensor->configuration_set = rd_sensor_configuration_set;
                 environmental_sensor->configuration_get = rd_sensor_configuration_get;
                 environmental_sensor->provides.datas.luminosity = ADC_PHOTO_ENABLE_BYTE;
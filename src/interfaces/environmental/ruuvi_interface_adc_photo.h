@@ -57,5 +57,14 @@ rd_status_t ri_adc_photo_mode_get (uint8_t *);
 /** @brief @ref rd_sensor_data_fp */
 rd_status_t ri_adc_photo_data_get (rd_sensor_data_t * const
                                    data);
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Sensor samples ADC on demand, average current is estimated for one sample per
+ * @ref RI_ADC_COST_INTERVAL_US. Current of the divider depends on the board
+ * and is not included.
+ */
+rd_status_t ri_adc_photo_cost_get (const rd_sensor_configuration_t * const p_config,
+                                   rd_sensor_cost_t * const p_cost);
 /*@}*/
 #endif
\ No newline at end of file
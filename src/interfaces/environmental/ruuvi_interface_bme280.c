@@ -52,6 +52,13 @@
 #define BME280_SAMPLERATE_10MS           (100U)
 #define BME280_SAMPLERATE_0_5MS          (200U)
 
+// Datasheet 1, typical currents in nA.
+#define BME280_HUMIDITY_NA               (340000U)
+#define BME280_PRESSURE_NA               (714000U)
+#define BME280_TEMPERATURE_NA            (350000U)
+#define BME280_SLEEP_NA                  (100U)
+#define BME280_STANDBY_NA                (200U)
+
 #define BME280_DSP_MODE_0                (1U)
 #define BME280_DSP_MODE_1                (2U)
 #define BME280_DSP_MODE_2                (4U)
@@ -67,23 +74,58 @@
 
 typedef float bme_float;
 
+/** @brief State of one sensor. */
+typedef struct
+{
+    struct bme280_dev * p_dev; //!< State of Bosch driver.
+    uint64_t tsample;          //!< Time of last single sample.
+    uint64_t ready_ms;         //!< Time when split-phase sample is ready.
+    bool measuring;            //!< Split-phase sample is running.
+} bme280_instance_t;
+
+#if RI_BME280_MAX_INSTANCES > 4
+#   error "Over 4 instances of BME280 is not supported"
+#endif
+
 /** State variables **/
+/** @brief State of Bosch driver of first instance. */
 #ifndef CEEDLING
 static
 #endif
 struct bme280_dev dev = {0};
-static uint64_t tsample;
+#if RI_BME280_MAX_INSTANCES > 1
+/** @brief State of Bosch driver of other instances. */
+static struct bme280_dev m_dev[RI_BME280_MAX_INSTANCES - 1U];
+#endif
+static bme280_instance_t m_instance[RI_BME280_MAX_INSTANCES] =
+{
+    { .p_dev = &dev },
+#if RI_BME280_MAX_INSTANCES > 1
+    { .p_dev = &m_dev[0] },
+#endif
+#if RI_BME280_MAX_INSTANCES > 2
+    { .p_dev = &m_dev[1] },
+#endif
+#if RI_BME280_MAX_INSTANCES > 3
+    { .p_dev = &m_dev[2] },
+#endif
+};
+/** @brief Sensor bound to each instance, NULL if instance is free. */
+static const rd_sensor_t * m_owner[RI_BME280_MAX_INSTANCES];
 static const char m_sensor_name[] = "BME280";
 
+static rd_status_t samplerate_get (bme280_instance_t * const p_inst, uint8_t * samplerate);
+static rd_status_t mode_get (bme280_instance_t * const p_inst, uint8_t * mode);
+
 /** @brief Function for checking that sensor is in sleep mode before configuration */
 #ifndef CEEDLING
 static
 #endif
-rd_status_t bme280_verify_sensor_sleep (void)
+rd_status_t bme280_verify_sensor_sleep (bme280_instance_t * const p_inst)
 {
     rd_status_t err_code = RD_SUCCESS;
     uint8_t mode = 0;
-    ri_bme280_mode_get (&mode);
+    mode_get (p_inst, &mode);
 
     if (RD_SENSOR_CFG_SLEEP != mode)
     {
@@ -149,17 +191,16 @@ uint32_t bme280_max_meas_time (const uint8_t oversampling)
 #ifndef CEEDLING
 static
 #endif
-rd_status_t bme280_spi_init (const struct bme280_dev * const p_dev, const uint8_t handle)
+rd_status_t bme280_spi_init (struct bme280_dev * const p_dev, const uint8_t handle)
 {
-    (void) (p_dev);
     rd_status_t err_code = RD_ERROR_NOT_ENABLED;
 #if RI_BME280_SPI_ENABLED
-    dev.dev_id = handle;
-    dev.intf = BME280_SPI_INTF;
-    dev.read = &ri_spi_bme280_read;
-    dev.write = &ri_spi_bme280_write;
-    dev.delay_ms = bosch_delay_ms;
-    err_code = BME_TO_RUUVI_ERROR (bme280_init (&dev));
+    p_dev->dev_id = handle;
+    p_dev->intf = BME280_SPI_INTF;
+    p_dev->read = &ri_spi_bme280_read;
+    p_dev->write = &ri_spi_bme280_write;
+    p_dev->delay_ms = bosch_delay_ms;
+    err_code = BME_TO_RUUVI_ERROR (bme280_init (p_dev));
 #endif
     return err_code;
 }
@@ -167,119 +208,20 @@ rd_status_t bme280_spi_init (const struct bme280_dev * const p_dev, const uint8_
 #ifndef CEEDLING
 static
 #endif
-rd_status_t bme280_i2c_init (const struct bme280_dev * const p_dev, const uint8_t handle)
+rd_status_t bme280_i2c_init (struct bme280_dev * const p_dev, const uint8_t handle)
 {
-    (void) (p_dev);
     rd_status_t err_code = RD_ERROR_NOT_ENABLED;
 #if RI_BME280_I2C_ENABLED
-    dev.dev_id = handle;
-    dev.intf = BME280_I2C_INTF;
-    dev.read = &ri_i2c_bme280_read;
-    dev.write = &ri_i2c_bme280_write;
-    dev.delay_ms = bosch_delay_ms;
-    err_code = BME_TO_RUUVI_ERROR (bme280_init (&dev));
+    p_dev->dev_id = handle;
+    p_dev->intf = BME280_I2C_INTF;
+    p_dev->read = &ri_i2c_bme280_read;
+    p_dev->write = &ri_i2c_bme280_write;
+    p_dev->delay_ms = bosch_delay_ms;
+    err_code = BME_TO_RUUVI_ERROR (bme280_init (p_dev));
 #endif
     return err_code;
 }
 
-static void bme280_ri_setup (rd_sensor_t * const environmental_sensor)
-{
-    environmental_sensor->init              = ri_bme280_init;
-    environmental_sensor->uninit            = ri_bme280_uninit;
-    environmental_sensor->samplerate_set    = ri_bme280_samplerate_set;
-    environmental_sensor->samplerate_get    = ri_bme280_samplerate_get;
-    environmental_sensor->resolution_set    = ri_bme280_resolution_set;
-    environmental_sensor->resolution_get    = ri_bme280_resolution_get;
-    environmental_sensor->scale_set         = ri_bme280_scale_set;
-    environmental_sensor->scale_get         = ri_bme280_scale_get;
-    environmental_sensor->dsp_set           = ri_bme280_dsp_set;
-    environmental_sensor->dsp_get           = ri_bme280_dsp_get;
-    environmental_sensor->mode_set          = ri_bme280_mode_set;
-    environmental_sensor->mode_get          = ri_bme280_mode_get;
-    environmental_sensor->data_get          = ri_bme280_data_get;
-    environmental_sensor->configuration_set = rd_sensor_configuration_set;
-    environmental_sensor->configuration_get = rd_sensor_configuration_get;
-    environmental_sensor->provides.datas.temperature_c = 1;
-    environmental_sensor->provides.datas.humidity_rh = 1;
-    environmental_sensor->provides.datas.pressure_pa = 1;
-    tsample = RD_UINT64_INVALID;
-}
-
-/** Initialize BME280 into low-power mode **/
-rd_status_t ri_bme280_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
-{
-    rd_status_t err_code = RD_SUCCESS;
-
-    if (NULL == p_sensor)
-    {
-        err_code = RD_ERROR_NULL;
-    }
-    else if (rd_sensor_is_init (p_sensor))
-    {
-        err_code = RD_ERROR_INVALID_STATE;
-    }
-    else
-    {
-        rd_sensor_initialize (p_sensor);
-        p_sensor->name = m_sensor_name;
-
-        if (RD_BUS_SPI == bus)
-        {
-            err_code |= bme280_spi_init (&dev, handle);
-        }
-        else if (RD_BUS_I2C == bus)
-        {
-            err_code |= bme280_i2c_init (&dev, handle);
-        }
-        else
-        {
-            err_code |= RD_ERROR_INVALID_PARAM;
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= BME_TO_RUUVI_ERROR (bme280_soft_reset (&dev));
-            // Setup Oversampling 1 to enable sensor
-            uint8_t dsp = RD_SENSOR_DSP_OS;
-            uint8_t dsp_parameter = 1;
-            err_code |= ri_bme280_dsp_set (&dsp, &dsp_parameter);
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            bme280_ri_setup (p_sensor);
-        }
-    }
-
-    return err_code;
-}
-
-rd_status_t ri_bme280_uninit (rd_sensor_t * sensor,
-                              rd_bus_t bus, uint8_t handle)
-{
-    rd_status_t err_code = RD_SUCCESS;
-    (void) bus;
-    (void) handle;
-
-    if (NULL == sensor)
-    {
-        err_code = RD_ERROR_NULL;
-    }
-    else
-    {
-        err_code = BME_TO_RUUVI_ERROR (bme280_soft_reset (&dev));
-
-        if (RD_SUCCESS == err_code)
-        {
-            rd_sensor_uninitialize (sensor);
-            memset (&dev, 0, sizeof (dev));
-            tsample = RD_UINT64_INVALID;
-        }
-    }
-
-    return err_code;
-}
-
 #ifndef CEEDLING
 static
 #endif
@@ -309,22 +251,23 @@ rd_status_t ri2bme_rate (struct bme280_dev * p_dev, uint8_t * const samplerate)
     return err_code;
 }
 
-rd_status_t ri_bme280_samplerate_set (uint8_t * samplerate)
+static rd_status_t samplerate_set (bme280_instance_t * const p_inst, uint8_t * samplerate)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == samplerate)
     {
         err_code = RD_ERROR_NULL;
     }
-    else if (RD_SUCCESS == bme280_verify_sensor_sleep())
+    else if (RD_SUCCESS == bme280_verify_sensor_sleep (p_inst))
     {
-        err_code = ri2bme_rate (&dev, samplerate);
+        err_code = ri2bme_rate (p_dev, samplerate);
 
         if (RD_SUCCESS == err_code)
         {
-            err_code |= BME_TO_RUUVI_ERROR (bme280_set_sensor_settings (BME280_STANDBY_SEL, &dev));
-            err_code |= ri_bme280_samplerate_get (samplerate);
+            err_code |= BME_TO_RUUVI_ERROR (bme280_set_sensor_settings (BME280_STANDBY_SEL, p_dev));
+            err_code |= samplerate_get (p_inst, samplerate);
         }
     }
     else
@@ -335,8 +278,9 @@ rd_status_t ri_bme280_samplerate_set (uint8_t * samplerate)
     return err_code;
 }
 
-rd_status_t ri_bme280_samplerate_get (uint8_t * samplerate)
+static rd_status_t samplerate_get (bme280_instance_t * const p_inst, uint8_t * samplerate)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == samplerate)
@@ -345,35 +289,35 @@ rd_status_t ri_bme280_samplerate_get (uint8_t * samplerate)
     }
     else
     {
-        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_settings (&dev));
+        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_settings (p_dev));
 
         if (RD_SUCCESS == err_code)
         {
-            if (BME280_STANDBY_TIME_1000_MS == dev.settings.standby_time)
+            if (BME280_STANDBY_TIME_1000_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_1000MS;
             }
-            else if (BME280_STANDBY_TIME_500_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_500_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_500MS;
             }
-            else if (BME280_STANDBY_TIME_125_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_125_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_125MS;
             }
-            else if (BME280_STANDBY_TIME_62_5_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_62_5_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_62_5MS;
             }
-            else if (BME280_STANDBY_TIME_20_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_20_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_20MS;
             }
-            else if (BME280_STANDBY_TIME_10_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_10_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_10MS;
             }
-            else if (BME280_STANDBY_TIME_0_5_MS == dev.settings.standby_time)
+            else if (BME280_STANDBY_TIME_0_5_MS == p_dev->settings.standby_time)
             {
                 *samplerate = BME280_SAMPLERATE_0_5MS;
             }
@@ -387,7 +331,7 @@ rd_status_t ri_bme280_samplerate_get (uint8_t * samplerate)
     return err_code;
 }
 
-rd_status_t ri_bme280_resolution_set (uint8_t * resolution)
+static rd_status_t resolution_set (bme280_instance_t * const p_inst, uint8_t * resolution)
 {
     rd_status_t err_code = RD_ERROR_NOT_SUPPORTED;
 
@@ -397,7 +341,7 @@ rd_status_t ri_bme280_resolution_set (uint8_t * resolution)
     }
     else
     {
-        err_code = bme280_verify_sensor_sleep();
+        err_code = bme280_verify_sensor_sleep (p_inst);
 
         if (RD_SUCCESS == err_code)
         {
@@ -431,7 +375,7 @@ rd_status_t ri_bme280_resolution_get (uint8_t * resolution)
     return err_code;
 }
 
-rd_status_t ri_bme280_scale_set (uint8_t * scale)
+static rd_status_t scale_set (bme280_instance_t * const p_inst, uint8_t * scale)
 {
     rd_status_t err_code = RD_ERROR_NOT_SUPPORTED;
 
@@ -441,7 +385,7 @@ rd_status_t ri_bme280_scale_set (uint8_t * scale)
     }
     else
     {
-        err_code = bme280_verify_sensor_sleep();
+        err_code = bme280_verify_sensor_sleep (p_inst);
 
         if (RD_SUCCESS == err_code)
         {
@@ -475,7 +419,8 @@ rd_status_t ri_bme280_scale_get (uint8_t * scale)
     return err_code;
 }
 
-static rd_status_t ri_bme280_dsp_setup_over (uint8_t * parameter)
+static rd_status_t dsp_setup_over (struct bme280_dev * const p_dev,
+                                   uint8_t * parameter)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -483,38 +428,38 @@ static rd_status_t ri_bme280_dsp_setup_over (uint8_t * parameter)
             (RD_SENSOR_CFG_MIN     == *parameter) || \
             (BME280_DSP_MODE_0 == *parameter))
     {
-        dev.settings.osr_h = BME280_OVERSAMPLING_1X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_1X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_1X;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_1X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_1X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_1X;
         *parameter = BME280_DSP_MODE_0;
     }
     else if (BME280_DSP_MODE_1 == *parameter)
     {
-        dev.settings.osr_h = BME280_OVERSAMPLING_2X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_2X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_2X;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_2X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_2X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_2X;
         *parameter = BME280_DSP_MODE_1;
     }
     else if (BME280_DSP_MODE_2 >= *parameter)
     {
-        dev.settings.osr_h = BME280_OVERSAMPLING_4X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_4X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_4X;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_4X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_4X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_4X;
         *parameter = BME280_DSP_MODE_2;
     }
     else if (BME280_DSP_MODE_3 >= *parameter)
     {
-        dev.settings.osr_h = BME280_OVERSAMPLING_8X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_8X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_8X;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_8X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_8X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_8X;
         *parameter = BME280_DSP_MODE_3;
     }
     else if ( (BME280_DSP_MODE_4 >= *parameter) || \
               (RD_SENSOR_CFG_MAX == *parameter))
     {
-        dev.settings.osr_h = BME280_OVERSAMPLING_16X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_16X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_16X;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_16X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_16X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_16X;
         *parameter = BME280_DSP_MODE_4;
     }
     else
@@ -526,8 +471,8 @@ static rd_status_t ri_bme280_dsp_setup_over (uint8_t * parameter)
     return err_code;
 }
 
-static rd_status_t ri_bme280_dsp_setup (uint8_t * p_settings_sel, const uint8_t * dsp,
-                                        uint8_t * parameter)
+static rd_status_t dsp_setup (struct bme280_dev * const p_dev, uint8_t * p_settings_sel,
+                              const uint8_t * dsp, uint8_t * parameter)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -540,10 +485,10 @@ static rd_status_t ri_bme280_dsp_setup (uint8_t * p_settings_sel, const uint8_t
     else
     {
         // Always 1x oversampling to keep sensing element enabled
-        dev.settings.osr_h = BME280_OVERSAMPLING_1X;
-        dev.settings.osr_p = BME280_OVERSAMPLING_1X;
-        dev.settings.osr_t = BME280_OVERSAMPLING_1X;
-        dev.settings.filter = BME280_FILTER_COEFF_OFF;
+        p_dev->settings.osr_h = BME280_OVERSAMPLING_1X;
+        p_dev->settings.osr_p = BME280_OVERSAMPLING_1X;
+        p_dev->settings.osr_t = BME280_OVERSAMPLING_1X;
+        p_dev->settings.filter = BME280_FILTER_COEFF_OFF;
         *p_settings_sel |= BME280_OSR_PRESS_SEL;
         *p_settings_sel |= BME280_OSR_TEMP_SEL;
         *p_settings_sel |= BME280_OSR_HUM_SEL;
@@ -556,28 +501,28 @@ static rd_status_t ri_bme280_dsp_setup (uint8_t * p_settings_sel, const uint8_t
                     (RD_SENSOR_CFG_MIN     == *parameter) || \
                     (BME280_DSP_MODE_0 == *parameter))
             {
-                dev.settings.filter = BME280_FILTER_COEFF_OFF;
+                p_dev->settings.filter = BME280_FILTER_COEFF_OFF;
                 *parameter = BME280_DSP_MODE_0;
             }
             else if (BME280_DSP_MODE_1 == *parameter)
             {
-                dev.settings.filter = BME280_FILTER_COEFF_2;
+                p_dev->settings.filter = BME280_FILTER_COEFF_2;
                 *parameter = BME280_DSP_MODE_1;
             }
             else if (BME280_DSP_MODE_2 >= *parameter)
             {
-                dev.settings.filter = BME280_FILTER_COEFF_4;
+                p_dev->settings.filter = BME280_FILTER_COEFF_4;
                 *parameter = BME280_DSP_MODE_2;
             }
             else if (BME280_DSP_MODE_3 >= *parameter)
             {
-                dev.settings.filter = BME280_FILTER_COEFF_8;
+                p_dev->settings.filter = BME280_FILTER_COEFF_8;
                 *parameter = BME280_DSP_MODE_3;
             }
             else if ( (RD_SENSOR_CFG_MAX == *parameter) || \
                       (BME280_DSP_MODE_4 >= *parameter))
             {
-                dev.settings.filter = BME280_FILTER_COEFF_16;
+                p_dev->settings.filter = BME280_FILTER_COEFF_16;
                 *parameter = BME280_DSP_MODE_4;
             }
             else
@@ -590,16 +535,105 @@ static rd_status_t ri_bme280_dsp_setup (uint8_t * p_settings_sel, const uint8_t
         if ( (RD_SUCCESS == err_code) &&
                 ( (RD_SENSOR_DSP_OS & *dsp) != 0))
         {
-            err_code = ri_bme280_dsp_setup_over (parameter);
+            err_code = dsp_setup_over (p_dev, parameter);
         }
     }
 
     return err_code;
 }
 
-rd_status_t ri_bme280_dsp_set (uint8_t * dsp, uint8_t * parameter)
+/** @brief Standby time of normal mode in us, datasheet 3.6.3. */
+static uint32_t standby_us (const uint8_t standby_time)
+{
+    static const uint32_t standby_table[] =
+    {
+        500U, 62500U, 125000U, 250000U, 500000U, 1000000U, 10000U, 20000U
+    };
+    return standby_table[standby_time & 0x07U];
+}
+
+rd_status_t ri_bme280_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost)
 {
     rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else
+    {
+        // Resolve settings the same way as setters do, without touching sensor.
+        struct bme280_dev settings = {0};
+        uint8_t settings_sel = 0;
+        uint8_t samplerate = p_config->samplerate;
+        uint8_t dsp = p_config->dsp_function;
+        uint8_t parameter = p_config->dsp_parameter;
+        settings.settings.standby_time = BME280_STANDBY_TIME_1000_MS;
+
+        if (RD_SENSOR_CFG_NO_CHANGE == dsp)
+        {
+            dsp = RD_SENSOR_DSP_LAST;
+        }
+
+        err_code |= ri2bme_rate (&settings, &samplerate);
+        err_code |= dsp_setup (&settings, &settings_sel, &dsp, &parameter);
+
+        if (RD_SUCCESS == err_code)
+        {
+            // Appendix B, maximum time for scheduling and typical time for charge.
+            const uint32_t os = 1U << (settings.settings.osr_h - 1U);
+            const uint32_t t_us = 1250U + (2300U * os);
+            const uint32_t ph_us = (2300U * os) + 575U;
+            const uint64_t charge =
+                ( (uint64_t) BME280_TEMPERATURE_NA * (1000U + (2000U * os)))
+                + ( (uint64_t) BME280_PRESSURE_NA * ( (2000U * os) + 500U))
+                + ( (uint64_t) BME280_HUMIDITY_NA * ( (2000U * os) + 500U));
+            const uint32_t interval_us = standby_us (settings.settings.standby_time);
+            rd_sensor_cost_t normal;
+            p_cost->conversion_us = t_us + (2U * ph_us);
+            p_cost->charge_nc = (uint32_t) (charge / 1000000U);
+            p_cost->sleep_na = BME280_SLEEP_NA;
+
+            switch (p_config->mode)
+            {
+                case RD_SENSOR_CFG_DEFAULT:
+                case RD_SENSOR_CFG_NO_CHANGE:
+                case RD_SENSOR_CFG_SLEEP:
+                    p_cost->average_na = p_cost->sleep_na;
+                    break;
+
+                case RD_SENSOR_CFG_SINGLE:
+                    p_cost->average_na = rd_sensor_cost_average_na (p_cost, interval_us);
+                    break;
+
+                case RD_SENSOR_CFG_CONTINUOUS:
+                    // Normal mode cycles measurement and standby.
+                    normal = *p_cost;
+                    normal.sleep_na = BME280_STANDBY_NA;
+                    p_cost->average_na = rd_sensor_cost_average_na (&normal,
+                                         interval_us + p_cost->conversion_us);
+                    break;
+
+                default:
+                    err_code = RD_ERROR_NOT_SUPPORTED;
+                    break;
+            }
+        }
+        else
+        {
+            err_code = RD_ERROR_NOT_SUPPORTED;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t dsp_set (bme280_instance_t * const p_inst, uint8_t * dsp,
+                            uint8_t * parameter)
+{
+    struct bme280_dev * const p_dev = p_inst->p_dev;
+    rd_status_t err_code = RD_SUCCESS;
     uint8_t settings_sel = 0U;
 
     if ( (NULL == dsp) || (NULL == parameter))
@@ -608,7 +642,7 @@ rd_status_t ri_bme280_dsp_set (uint8_t * dsp, uint8_t * parameter)
     }
     else
     {
-        err_code = bme280_verify_sensor_sleep();
+        err_code = bme280_verify_sensor_sleep (p_inst);
 
         if (RD_SUCCESS == err_code)
         {
@@ -638,7 +672,7 @@ rd_status_t ri_bme280_dsp_set (uint8_t * dsp, uint8_t * parameter)
 
             if (RD_SUCCESS == err_code)
             {
-                err_code = ri_bme280_dsp_setup (&settings_sel, dsp, parameter);
+                err_code = dsp_setup (p_dev, &settings_sel, dsp, parameter);
             }
         }
     }
@@ -646,24 +680,25 @@ rd_status_t ri_bme280_dsp_set (uint8_t * dsp, uint8_t * parameter)
     if (RD_SUCCESS == err_code)
     {
         //Write configuration
-        err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_settings (settings_sel, &dev));
+        err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_settings (settings_sel, p_dev));
     }
 
     return err_code;
 }
 
-static void ri_bme280_dsp_get_param (uint8_t * dsp, uint8_t * parameter)
+static void dsp_get_param (const struct bme280_dev * const p_dev, uint8_t * dsp,
+                           uint8_t * parameter)
 {
     // Assume default / 0,
     *dsp       = RD_SENSOR_CFG_DEFAULT;
     *parameter = RD_SENSOR_CFG_DEFAULT;
 
     // Check if IIR has been set. If yes, read DSP param from there.
-    if (BME280_FILTER_COEFF_OFF != dev.settings.filter)
+    if (BME280_FILTER_COEFF_OFF != p_dev->settings.filter)
     {
         *dsp |= RD_SENSOR_DSP_LOW_PASS;
 
-        switch (dev.settings.filter)
+        switch (p_dev->settings.filter)
         {
             case BME280_FILTER_COEFF_2:
                 *parameter = BME280_DSP_MODE_1;
@@ -690,12 +725,12 @@ static void ri_bme280_dsp_get_param (uint8_t * dsp, uint8_t * parameter)
     // Check if OS has been set. If yes, read DSP param from there.
     // Param should be same for OS and IIR if it is >1.
     // OSR is same for every element.
-    if ( (BME280_NO_OVERSAMPLING != dev.settings.osr_h)
-            && (BME280_OVERSAMPLING_1X != dev.settings.osr_h))
+    if ( (BME280_NO_OVERSAMPLING != p_dev->settings.osr_h)
+            && (BME280_OVERSAMPLING_1X != p_dev->settings.osr_h))
     {
         *dsp |= RD_SENSOR_DSP_OS;
 
-        switch (dev.settings.osr_h)
+        switch (p_dev->settings.osr_h)
         {
             case BME280_OVERSAMPLING_2X:
                 *parameter = BME280_DSP_MODE_1;
@@ -721,8 +756,10 @@ static void ri_bme280_dsp_get_param (uint8_t * dsp, uint8_t * parameter)
 }
 
 // Read configuration
-rd_status_t ri_bme280_dsp_get (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_get (bme280_instance_t * const p_inst, uint8_t * dsp,
+                            uint8_t * parameter)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if ( (NULL == dsp) || (NULL == parameter))
@@ -731,23 +768,40 @@ rd_status_t ri_bme280_dsp_get (uint8_t * dsp, uint8_t * parameter)
     }
     else
     {
-        err_code |= BME_TO_RUUVI_ERROR (bme280_get_sensor_settings (&dev));
+        err_code |= BME_TO_RUUVI_ERROR (bme280_get_sensor_settings (p_dev));
 
         if (RD_SUCCESS == err_code)
         {
-            ri_bme280_dsp_get_param (dsp, parameter);
+            dsp_get_param (p_dev, dsp, parameter);
         }
     }
 
     return err_code;
 }
 
-static rd_status_t ri_bme280_mode_set_single (uint8_t * mode)
+/** @brief Maximum duration of forced measurement with current oversampling. */
+static uint32_t forced_meas_time (const struct bme280_dev * const p_dev)
 {
+    // We assume that dev struct is in sync with the state of the BME280 and underlying interface
+    // which has the number of settings as 2^OSR is not changed.
+    // We also assume that each element runs same OSR
+    uint8_t samples = 1U;
+
+    if (p_dev->settings.osr_h > 0U)
+    {
+        samples = (uint8_t) (1U << (p_dev->settings.osr_h - 1U));
+    }
+
+    return bme280_max_meas_time (samples);
+}
+
+static rd_status_t mode_set_single (bme280_instance_t * const p_inst, uint8_t * mode)
+{
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
     uint8_t current_mode = RD_SENSOR_CFG_SLEEP;
     // Do nothing if sensor is in continuous mode
-    ri_bme280_mode_get (&current_mode);
+    mode_get (p_inst, &current_mode);
 
     if (RD_SENSOR_CFG_CONTINUOUS == current_mode)
     {
@@ -756,13 +810,10 @@ static rd_status_t ri_bme280_mode_set_single (uint8_t * mode)
     }
     else
     {
-        err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_FORCED_MODE, &dev));
-        // We assume that dev struct is in sync with the state of the BME280 and underlying interface
-        // which has the number of settings as 2^OSR is not changed.
-        // We also assume that each element runs same OSR
-        uint8_t samples = (uint8_t) (1U << (dev.settings.osr_h - 1U));
-        ri_delay_ms (bme280_max_meas_time (samples));
-        tsample = rd_sensor_timestamp_get();
+        err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_FORCED_MODE, p_dev));
+        ri_delay_ms (forced_meas_time (p_dev));
+        p_inst->tsample = rd_sensor_timestamp_get();
+        p_inst->measuring = false;
         // BME280 returns to SLEEP after forced sample
         *mode = RD_SENSOR_CFG_SLEEP;
     }
@@ -770,8 +821,9 @@ static rd_status_t ri_bme280_mode_set_single (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_bme280_mode_set (uint8_t * mode)
+static rd_status_t mode_set (bme280_instance_t * const p_inst, uint8_t * mode)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == mode)
@@ -783,15 +835,16 @@ rd_status_t ri_bme280_mode_set (uint8_t * mode)
         switch (*mode)
         {
             case RD_SENSOR_CFG_SLEEP:
-                err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_SLEEP_MODE, &dev));
+                err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_SLEEP_MODE, p_dev));
+                p_inst->measuring = false;
                 break;
 
             case RD_SENSOR_CFG_SINGLE:
-                err_code = ri_bme280_mode_set_single (mode);
+                err_code = mode_set_single (p_inst, mode);
                 break;
 
             case RD_SENSOR_CFG_CONTINUOUS:
-                err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_NORMAL_MODE, &dev));
+                err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_NORMAL_MODE, p_dev));
                 break;
 
             default:
@@ -803,8 +856,9 @@ rd_status_t ri_bme280_mode_set (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_bme280_mode_get (uint8_t * mode)
+static rd_status_t mode_get (bme280_instance_t * const p_inst, uint8_t * mode)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == mode)
@@ -814,7 +868,7 @@ rd_status_t ri_bme280_mode_get (uint8_t * mode)
     else
     {
         uint8_t bme_mode = 0U;
-        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_mode (&bme_mode, &dev));
+        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_mode (&bme_mode, p_dev));
 
         if (RD_SUCCESS == err_code)
         {
@@ -842,6 +896,83 @@ rd_status_t ri_bme280_mode_get (uint8_t * mode)
     return err_code;
 }
 
+static rd_status_t measurement_start (bme280_instance_t * const p_inst,
+                                      uint64_t * const p_ready_ms)
+{
+    struct bme280_dev * const p_dev = p_inst->p_dev;
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_ready_ms)
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else if (p_inst->measuring || (RD_SUCCESS != bme280_verify_sensor_sleep (p_inst)))
+    {
+        err_code = RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        const uint64_t now = rd_sensor_timestamp_get();
+
+        if (RD_UINT64_INVALID == now)
+        {
+            // Ready time cannot be known.
+            err_code = RD_ERROR_INVALID_STATE;
+        }
+        else
+        {
+            err_code = BME_TO_RUUVI_ERROR (bme280_set_sensor_mode (BME280_FORCED_MODE,
+                                           p_dev));
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            p_inst->ready_ms = now + forced_meas_time (p_dev);
+            p_inst->tsample = RD_UINT64_INVALID;
+            p_inst->measuring = true;
+            *p_ready_ms = p_inst->ready_ms;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t measurement_complete (bme280_instance_t * const p_inst)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t mode = RD_SENSOR_CFG_SINGLE;
+
+    if (!p_inst->measuring)
+    {
+        err_code = RD_ERROR_INVALID_STATE;
+    }
+    else if (rd_sensor_timestamp_get() < p_inst->ready_ms)
+    {
+        err_code = RD_ERROR_BUSY;
+    }
+    else
+    {
+        // BME280 returns to SLEEP after forced sample.
+        err_code = mode_get (p_inst, &mode);
+
+        if ( (RD_SUCCESS == err_code) && (RD_SENSOR_CFG_SLEEP != mode))
+        {
+            err_code = RD_ERROR_BUSY;
+        }
+        else if (RD_SUCCESS == err_code)
+        {
+            p_inst->tsample = p_inst->ready_ms;
+            p_inst->measuring = false;
+        }
+        else
+        {
+            // Bus error, sample is retried.
+        }
+    }
+
+    return err_code;
+}
+
 static void ri_bme280_check_humiduty (float * p_value)
 {
     if (*p_value > BME280_HUMIDITY_MAX_VALUE)
@@ -850,28 +981,33 @@ static void ri_bme280_check_humiduty (float * p_value)
     }
 }
 
-rd_status_t ri_bme280_data_get (rd_sensor_data_t * const
-                                p_data)
+static rd_status_t data_get (bme280_instance_t * const p_inst,
+                             rd_sensor_data_t * const p_data)
 {
+    struct bme280_dev * const p_dev = p_inst->p_dev;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == p_data)
     {
         err_code = RD_ERROR_NULL;
     }
+    else if (p_inst->measuring && (RD_SUCCESS != measurement_complete (p_inst)))
+    {
+        // Split-phase sample is not ready, there is no valid data.
+    }
     else
     {
         struct bme280_data comp_data;
-        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_data (BME280_ALL, &comp_data, &dev));
+        err_code = BME_TO_RUUVI_ERROR (bme280_get_sensor_data (BME280_ALL, &comp_data, p_dev));
 
         if (RD_SUCCESS == err_code)
         {
             // Write tsample if we're in single mode, current time if we're in continuous mode
             // Leave sample time as invalid if forced mode is ongoing.
             uint8_t mode = 0U;
-            err_code |= ri_bme280_mode_get (&mode);
+            err_code |= mode_get (p_inst, &mode);
 
-            if (RD_SENSOR_CFG_SLEEP == mode)           { p_data->timestamp_ms = tsample; }
+            if (RD_SENSOR_CFG_SLEEP == mode)           { p_data->timestamp_ms = p_inst->tsample; }
             else if (RD_SENSOR_CFG_CONTINUOUS == mode) { p_data->timestamp_ms = rd_sensor_timestamp_get(); }
             else { RD_ERROR_CHECK (RD_ERROR_INTERNAL, ~RD_ERROR_FATAL); }
 
@@ -900,5 +1036,332 @@ rd_status_t ri_bme280_data_get (rd_sensor_data_t * const
 
     return err_code;
 }
+
+rd_status_t ri_bme280_samplerate_set (uint8_t * samplerate)
+{
+    return samplerate_set (&m_instance[0], samplerate);
+}
+
+rd_status_t ri_bme280_samplerate_get (uint8_t * samplerate)
+{
+    return samplerate_get (&m_instance[0], samplerate);
+}
+
+rd_status_t ri_bme280_resolution_set (uint8_t * resolution)
+{
+    return resolution_set (&m_instance[0], resolution);
+}
+
+rd_status_t ri_bme280_scale_set (uint8_t * scale)
+{
+    return scale_set (&m_instance[0], scale);
+}
+
+rd_status_t ri_bme280_dsp_set (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_set (&m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_bme280_dsp_get (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_get (&m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_bme280_mode_set (uint8_t * mode)
+{
+    return mode_set (&m_instance[0], mode);
+}
+
+rd_status_t ri_bme280_mode_get (uint8_t * mode)
+{
+    return mode_get (&m_instance[0], mode);
+}
+
+rd_status_t ri_bme280_data_get (rd_sensor_data_t * const
+                                p_data)
+{
+    return data_get (&m_instance[0], p_data);
+}
+
+rd_status_t ri_bme280_measurement_start (uint64_t * const p_ready_ms)
+{
+    return measurement_start (&m_instance[0], p_ready_ms);
+}
+
+rd_status_t ri_bme280_measurement_complete (void)
+{
+    return measurement_complete (&m_instance[0]);
+}
+
+/** @brief Functions of one instance which depend on state of the instance. */
+typedef struct
+{
+    rd_sensor_setup_fp samplerate_set;
+    rd_sensor_setup_fp samplerate_get;
+    rd_sensor_setup_fp resolution_set;
+    rd_sensor_setup_fp scale_set;
+    rd_sensor_dsp_fp   dsp_set;
+    rd_sensor_dsp_fp   dsp_get;
+    rd_sensor_setup_fp mode_set;
+    rd_sensor_setup_fp mode_get;
+    rd_sensor_data_fp  data_get;
+    rd_sensor_measurement_start_fp measurement_start;
+    rd_sensor_measurement_complete_fp measurement_complete;
+} bme280_api_t;
+
+/** @brief Define functions of instance n, public functions are instance 0. */
+#define BME280_INSTANCE_DEFINE(n)                                                  \
+    RD_SENSOR_SETUP_BIND (samplerate_set_##n, samplerate_set, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (samplerate_get_##n, samplerate_get, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (resolution_set_##n, resolution_set, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (scale_set_##n, scale_set, &m_instance[n])              \
+    RD_SENSOR_DSP_BIND (dsp_set_##n, dsp_set, &m_instance[n])                    \
+    RD_SENSOR_DSP_BIND (dsp_get_##n, dsp_get, &m_instance[n])                    \
+    RD_SENSOR_SETUP_BIND (mode_set_##n, mode_set, &m_instance[n])                \
+    RD_SENSOR_SETUP_BIND (mode_get_##n, mode_get, &m_instance[n])                \
+    RD_SENSOR_DATA_BIND (data_get_##n, data_get, &m_instance[n])                 \
+    RD_SENSOR_MEASUREMENT_START_BIND (measurement_start_##n, measurement_start,   \
+                                      &m_instance[n])                             \
+    RD_SENSOR_MEASUREMENT_COMPLETE_BIND (measurement_complete_##n,                \
+                                         measurement_complete, &m_instance[n])
+
+/** @brief Functions of instance n defined by @ref BME280_INSTANCE_DEFINE. */
+#define BME280_INSTANCE_API(n)                                                     \
+    {                                                                              \
+        samplerate_set_##n, samplerate_get_##n, resolution_set_##n, scale_set_##n, \
+        dsp_set_##n, dsp_get_##n, mode_set_##n, mode_get_##n, data_get_##n,        \
+        measurement_start_##n, measurement_complete_##n                            \
+    }
+
+#if RI_BME280_MAX_INSTANCES > 1
+BME280_INSTANCE_DEFINE (1)
+#endif
+#if RI_BME280_MAX_INSTANCES > 2
+BME280_INSTANCE_DEFINE (2)
+#endif
+#if RI_BME280_MAX_INSTANCES > 3
+BME280_INSTANCE_DEFINE (3)
+#endif
+
+static const bme280_api_t m_api[RI_BME280_MAX_INSTANCES] =
+{
+    {
+        ri_bme280_samplerate_set, ri_bme280_samplerate_get, ri_bme280_resolution_set,
+        ri_bme280_scale_set, ri_bme280_dsp_set, ri_bme280_dsp_get,
+        ri_bme280_mode_set, ri_bme280_mode_get, ri_bme280_data_get,
+        ri_bme280_measurement_start, ri_bme280_measurement_complete
+    },
+#if RI_BME280_MAX_INSTANCES > 1
+    BME280_INSTANCE_API (1),
+#endif
+#if RI_BME280_MAX_INSTANCES > 2
+    BME280_INSTANCE_API (2),
+#endif
+#if RI_BME280_MAX_INSTANCES > 3
+    BME280_INSTANCE_API (3),
+#endif
+};
+
+/**
+ * @brief Find instance bound to sensor or a free instance.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor if it has one, otherwise index of
+ *         first free instance. @ref RI_BME280_MAX_INSTANCES if none is found.
+ */
+static uint8_t instance_find (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_BME280_MAX_INSTANCES;
+    uint8_t free = RI_BME280_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_BME280_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+        else if ( (NULL == m_owner[ii]) && (RI_BME280_MAX_INSTANCES == free))
+        {
+            free = ii;
+        }
+        else
+        {
+            // Instance belongs to other sensor.
+        }
+    }
+
+    return (RI_BME280_MAX_INSTANCES == own) ? free : own;
+}
+
+/**
+ * @brief Find instance bound to sensor.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor, @ref RI_BME280_MAX_INSTANCES if
+ *         sensor has no instance.
+ */
+static uint8_t instance_owned (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_BME280_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_BME280_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+    }
+
+    return own;
+}
+
+/** @brief Bosch driver state held by driver for instance. */
+static struct bme280_dev * dev_pool (const uint8_t instance)
+{
+#if RI_BME280_MAX_INSTANCES > 1
+    return (0U == instance) ? &dev : &m_dev[instance - 1U];
+#else
+    (void) instance;
+    return &dev;
+#endif
+}
+
+static void bme280_ri_setup (rd_sensor_t * const environmental_sensor,
+                             const uint8_t instance)
+{
+    const bme280_api_t * const p_api = &m_api[instance];
+    environmental_sensor->init              = ri_bme280_init;
+    environmental_sensor->uninit            = ri_bme280_uninit;
+    environmental_sensor->samplerate_set    = p_api->samplerate_set;
+    environmental_sensor->samplerate_get    = p_api->samplerate_get;
+    environmental_sensor->resolution_set    = p_api->resolution_set;
+    environmental_sensor->resolution_get    = ri_bme280_resolution_get;
+    environmental_sensor->scale_set         = p_api->scale_set;
+    environmental_sensor->scale_get         = ri_bme280_scale_get;
+    environmental_sensor->dsp_set           = p_api->dsp_set;
+    environmental_sensor->dsp_get           = p_api->dsp_get;
+    environmental_sensor->mode_set          = p_api->mode_set;
+    environmental_sensor->mode_get          = p_api->mode_get;
+    environmental_sensor->data_get          = p_api->data_get;
+    environmental_sensor->measurement_start    = p_api->measurement_start;
+    environmental_sensor->measurement_complete = p_api->measurement_complete;
+    environmental_sensor->cost_get          = ri_bme280_cost_get;
+    environmental_sensor->configuration_set = rd_sensor_configuration_set;
+    environmental_sensor->configuration_get = rd_sensor_configuration_get;
+    environmental_sensor->provides.datas.temperature_c = 1;
+    environmental_sensor->provides.datas.humidity_rh = 1;
+    environmental_sensor->provides.datas.pressure_pa = 1;
+    m_instance[instance].tsample = RD_UINT64_INVALID;
+    m_instance[instance].measuring = false;
+}
+
+/** Initialize BME280 into low-power mode **/
+rd_status_t ri_bme280_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t instance = RI_BME280_MAX_INSTANCES;
+
+    if (NULL == p_sensor)
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else if (rd_sensor_is_init (p_sensor))
+    {
+        err_code = RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        instance = instance_find (p_sensor);
+
+        if (RI_BME280_MAX_INSTANCES <= instance)
+        {
+            err_code = RD_ERROR_RESOURCES;
+        }
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        bme280_instance_t * const p_inst = &m_instance[instance];
+        rd_sensor_initialize (p_sensor);
+        p_sensor->name = m_sensor_name;
+        // Instance stays bound on error so that uninit can release it.
+        m_owner[instance] = p_sensor;
+
+        if (NULL == p_sensor->p_ctx)
+        {
+            p_sensor->p_ctx = dev_pool (instance);
+        }
+
+        p_inst->p_dev = p_sensor->p_ctx;
+
+        if (RD_BUS_SPI == bus)
+        {
+            err_code |= bme280_spi_init (p_inst->p_dev, handle);
+        }
+        else if (RD_BUS_I2C == bus)
+        {
+            err_code |= bme280_i2c_init (p_inst->p_dev, handle);
+        }
+        else
+        {
+            err_code |= RD_ERROR_INVALID_PARAM;
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= BME_TO_RUUVI_ERROR (bme280_soft_reset (p_inst->p_dev));
+            // Setup Oversampling 1 to enable sensor
+            uint8_t dsp = RD_SENSOR_DSP_OS;
+            uint8_t dsp_parameter = 1;
+            err_code |= dsp_set (p_inst, &dsp, &dsp_parameter);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            bme280_ri_setup (p_sensor, instance);
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_bme280_uninit (rd_sensor_t * sensor,
+                              rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    (void) bus;
+    (void) handle;
+
+    if (NULL == sensor)
+    {
+        err_code = RD_ERROR_NULL;
+    }
+    else
+    {
+        // Sensor which was never initialized has no device to reset.
+        const uint8_t instance = instance_owned (sensor);
+        rd_sensor_uninitialize (sensor);
+
+        if (RI_BME280_MAX_INSTANCES > instance)
+        {
+            bme280_instance_t * const p_inst = &m_instance[instance];
+            err_code = BME_TO_RUUVI_ERROR (bme280_soft_reset (p_inst->p_dev));
+            // Instance is released even if reset fails.
+            memset (p_inst->p_dev, 0, sizeof (struct bme280_dev));
+
+            if (dev_pool (instance) == sensor->p_ctx)
+            {
+                sensor->p_ctx = NULL;
+            }
+
+            p_inst->p_dev = dev_pool (instance);
+            p_inst->tsample = RD_UINT64_INVALID;
+            p_inst->measuring = false;
+            m_owner[instance] = NULL;
+        }
+    }
+
+    return err_code;
+}
 /*@}*/
 #endif
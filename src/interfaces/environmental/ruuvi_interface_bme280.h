@@ -55,7 +55,19 @@
  */
 void bosch_delay_ms (uint32_t time_ms);
 
-/** @brief @ref rd_sensor_init_fp */
+/**
+ * @brief @ref rd_sensor_init_fp
+ *
+ * Up to @ref RI_BME280_MAX_INSTANCES sensors can be initialized at once,
+ * each with own handle. Function pointers of the initialized sensor operate
+ * on that sensor. Functions ri_bme280_* below operate on instance 0, which
+ * is taken by first sensor initialized while it is free.
+ *
+ * Give a struct bme280_dev in p_ctx of sensor to keep state of Bosch driver in
+ * application memory. If p_ctx is NULL, a context is taken from driver.
+ *
+ * @retval RD_ERROR_RESOURCES if all instances are in use.
+ */
 rd_status_t ri_bme280_init (rd_sensor_t *
                             environmental_sensor, rd_bus_t bus, uint8_t handle);
 /** @brief @ref rd_sensor_init_fp */
@@ -81,14 +93,47 @@ rd_status_t ri_bme280_dsp_get (uint8_t * dsp, uint8_t * parameter);
 rd_status_t ri_bme280_mode_set (uint8_t * mode);
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_bme280_mode_get (uint8_t * mode);
-/** @brief @ref rd_sensor_data_fp */
+/**
+ * @brief @ref rd_sensor_data_fp
+ *
+ * Returns no data while measurement started by @ref ri_bme280_measurement_start
+ * is running.
+ */
 rd_status_t ri_bme280_data_get (rd_sensor_data_t * const
                                 data);
+/**
+ * @brief Start a forced measurement without waiting for it.
+ *
+ * Measurement time follows datasheet Appendix B for current oversampling.
+ *
+ * @param[out] p_ready_ms Value of @ref rd_sensor_timestamp_get when result is ready.
+ * @retval RD_SUCCESS if measurement was started.
+ * @retval RD_ERROR_NULL if p_ready_ms is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is not sleeping, measurement is running
+ *         or timestamp is not available.
+ */
+rd_status_t ri_bme280_measurement_start (uint64_t * const p_ready_ms);
+/**
+ * @brief Collect result of @ref ri_bme280_measurement_start.
+ *
+ * @retval RD_SUCCESS if result can be read with data_get.
+ * @retval RD_ERROR_BUSY if measurement is not ready yet.
+ * @retval RD_ERROR_INVALID_STATE if no measurement was started.
+ */
+rd_status_t ri_bme280_measurement_complete (void);
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Samplerate and DSP are evaluated like in @ref ri_bme280_samplerate_set and
+ * @ref ri_bme280_dsp_set, all of humidity, pressure and temperature are measured.
+ */
+rd_status_t ri_bme280_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost);
 
 #ifdef CEEDLING
 #include "bme280_defs.h"
-rd_status_t bme280_i2c_init (const struct bme280_dev * const p_dev, const uint8_t handle);
-rd_status_t bme280_spi_init (const struct bme280_dev * const p_dev, const uint8_t handle);
+rd_status_t bme280_i2c_init (struct bme280_dev * const p_dev, const uint8_t handle);
+rd_status_t bme280_spi_init (struct bme280_dev * const p_dev, const uint8_t handle);
 rd_status_t ri2bme_rate (struct bme280_dev * p_dev, uint8_t * const samplerate);
 uint32_t bme280_max_meas_time (const uint8_t oversampling);
 #endif
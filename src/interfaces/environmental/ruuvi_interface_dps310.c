@@ -16,14 +16,32 @@ static void dps_sleep (const uint32_t ms)
     (void) ri_delay_ms (ms);
 }
 
-// Singleton access for compatibility with other driver implementations.
-static uint8_t spi_comm_handle;
-static dps310_ctx_t singleton_ctx_spi =
-{
-    .write = &ri_spi_dps310_write,
-    .read  = &ri_spi_dps310_read,
-    .sleep = &dps_sleep,
-    .comm_ctx = &spi_comm_handle
+#if RI_DPS310_MAX_INSTANCES > 4
+#   error "Over 4 instances of DPS310 is not supported"
+#endif
+
+/** @brief Context of SPI DPS310, used if application does not give a context. */
+#define DPS310_SPI_CTX(n)                \
+    {                                    \
+        .write = &ri_spi_dps310_write,   \
+        .read  = &ri_spi_dps310_read,    \
+        .sleep = &dps_sleep,             \
+        .comm_ctx = &m_spi_handle[n]     \
+    }
+
+static uint8_t m_spi_handle[RI_DPS310_MAX_INSTANCES];
+static dps310_ctx_t m_spi_ctx[RI_DPS310_MAX_INSTANCES] =
+{
+    DPS310_SPI_CTX (0),
+#if RI_DPS310_MAX_INSTANCES > 1
+    DPS310_SPI_CTX (1),
+#endif
+#if RI_DPS310_MAX_INSTANCES > 2
+    DPS310_SPI_CTX (2),
+#endif
+#if RI_DPS310_MAX_INSTANCES > 3
+    DPS310_SPI_CTX (3),
+#endif
 };
 
 static const char * const name = "DPS310";
@@ -32,113 +50,56 @@ const rd_sensor_data_fields_t dps_fields =
     .datas.temperature_c = 1,
     .datas.pressure_pa = 1
 };
-static float last_values[2];
-static rd_sensor_data_t last_data;
-
-static __attribute__ ( (nonnull)) void
-dps310_singleton_spi_setup (rd_sensor_t * const p_sensor,
-                            const uint8_t handle)
-{
-    p_sensor->p_ctx = &singleton_ctx_spi;
-    spi_comm_handle = handle;
-}
-
-static __attribute__ ( (nonnull))
-void dps310_fp_setup (rd_sensor_t * const p_sensor)
-{
-    p_sensor->init = &ri_dps310_init;
-    p_sensor->uninit = &ri_dps310_uninit;
-    p_sensor->samplerate_set = &ri_dps310_samplerate_set;
-    p_sensor->samplerate_get = &ri_dps310_samplerate_get;
-    p_sensor->resolution_set = &ri_dps310_resolution_set;
-    p_sensor->resolution_get = &ri_dps310_resolution_get;
-    p_sensor->scale_set = &ri_dps310_scale_set;
-    p_sensor->scale_get = &ri_dps310_scale_get;
-    p_sensor->dsp_set = &ri_dps310_dsp_set;
-    p_sensor->dsp_get = &ri_dps310_dsp_get;
-    p_sensor->mode_set = &ri_dps310_mode_set;
-    p_sensor->mode_get = &ri_dps310_mode_get;
-    p_sensor->data_get = &ri_dps310_data_get;
-    p_sensor->configuration_set = &rd_sensor_configuration_set;
-    p_sensor->configuration_get = &rd_sensor_configuration_get;
-    return;
-}
 
-rd_status_t ri_dps310_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
+/** @brief State of one sensor. */
+typedef struct
 {
-    rd_status_t err_code = RD_SUCCESS;
-    dps310_status_t dps_status = DPS310_SUCCESS;
-
-    if (NULL == p_sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-    }
-    else if (rd_sensor_is_init (p_sensor))
-    {
-        err_code |= RD_ERROR_INVALID_STATE;
-    }
-    else
-    {
-        rd_sensor_initialize (p_sensor);
-        p_sensor->name = name;
-
-        if (NULL == p_sensor->p_ctx)
-        {
-            if (RD_BUS_SPI == bus)
-            {
-                dps310_singleton_spi_setup (p_sensor, handle);
-            }
-            else if (RD_BUS_I2C == bus)
-            {
-                err_code |= RD_ERROR_NOT_IMPLEMENTED;
-            }
-            else
-            {
-                err_code |= RD_ERROR_NOT_SUPPORTED;
-            }
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            dps_status = dps310_init (p_sensor->p_ctx);
-
-            if (DPS310_SUCCESS == dps_status)
-            {
-                dps310_fp_setup (p_sensor);
-                p_sensor->name = name;
-                p_sensor->provides = dps_fields;
-                memset (&last_data, 0, sizeof (last_data));
-            }
-            else
-            {
-                err_code |= RD_ERROR_NOT_FOUND;
-            }
-        }
-    }
-
-    return err_code;
-}
-
-rd_status_t ri_dps310_uninit (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
+    dps310_ctx_t * p_dps;       //!< Context of DPS310 library, p_ctx of sensor.
+    float last_values[2];       //!< Values of last_data.
+    rd_sensor_data_t last_data; //!< Latest sample.
+    uint64_t single_ready_ms;   //!< Time when split-phase result is ready.
+    uint64_t single_timeout_ms; //!< Time after which split-phase result is abandoned.
+    bool single_pending;        //!< Split-phase single measurement is running.
+} dps310_instance_t;
+
+/** @brief Instances, a free instance uses SPI context of same index. */
+static dps310_instance_t m_instance[RI_DPS310_MAX_INSTANCES] =
 {
-    rd_status_t err_code = RD_SUCCESS;
-
-    if (NULL == sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-    }
-    else
-    {
-        // Error code can be ignored.
-        (void) dps310_uninit (sensor->p_ctx);
-        rd_sensor_uninitialize (sensor);
-    }
-
-    return err_code;
-}
+    { .p_dps = &m_spi_ctx[0] },
+#if RI_DPS310_MAX_INSTANCES > 1
+    { .p_dps = &m_spi_ctx[1] },
+#endif
+#if RI_DPS310_MAX_INSTANCES > 2
+    { .p_dps = &m_spi_ctx[2] },
+#endif
+#if RI_DPS310_MAX_INSTANCES > 3
+    { .p_dps = &m_spi_ctx[3] },
+#endif
+};
 
-rd_status_t ri_dps310_samplerate_set (uint8_t * samplerate)
+/** @brief Sensor bound to each instance, NULL if instance is free. */
+static const rd_sensor_t * m_owner[RI_DPS310_MAX_INSTANCES];
+
+/** @brief Fixed part of conversion time, us. */
+#define DPS310_CONVERSION_BASE_US   (2000U)
+/** @brief Conversion time per oversampled measurement, us. */
+#define DPS310_CONVERSION_PER_OS_US (1600U)
+/** @brief Measurement configuration register, holds result ready flags. */
+#define DPS310_REG_MEAS_CFG         (0x08U)
+/** @brief New temperature result is available. */
+#define DPS310_MEAS_CFG_TMP_RDY     (1U << 5U)
+/** @brief New pressure result is available. */
+#define DPS310_MEAS_CFG_PRS_RDY     (1U << 4U)
+
+static rd_status_t samplerate_get (dps310_instance_t * const p_inst,
+                                   uint8_t * samplerate);
+static rd_status_t dsp_get (dps310_instance_t * const p_inst, uint8_t * dsp,
+                            uint8_t * parameter);
+static rd_status_t mode_get (dps310_instance_t * const p_inst, uint8_t * mode);
+
+static rd_status_t samplerate_set (dps310_instance_t * const p_inst, uint8_t * samplerate)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     dps310_status_t dps_status = DPS310_SUCCESS;
 
@@ -146,7 +107,7 @@ rd_status_t ri_dps310_samplerate_set (uint8_t * samplerate)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (DPS310_READY != singleton_ctx_spi.device_status)
+    else if (DPS310_READY != p_dps->device_status)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -156,93 +117,93 @@ rd_status_t ri_dps310_samplerate_set (uint8_t * samplerate)
     }
     else if (RD_SENSOR_CFG_DEFAULT == *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_DEFAULT_MR,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_DEFAULT_MR,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if ( (RD_SENSOR_CFG_MIN == *samplerate) || (1U == *samplerate))
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_1,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_1,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (RD_SENSOR_CFG_MAX == *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_128,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_128,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (2U == *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_2,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_2,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (4U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_4,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_4,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (8U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_8,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_8,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (16U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_16,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_16,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (32U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_32,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_32,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (64U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_64,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_64,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else if (128U >= *samplerate)
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
+        dps_status |= dps310_config_temp (p_dps,
                                           DPS310_MR_128,
-                                          singleton_ctx_spi.temp_osr);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
+                                          p_dps->temp_osr);
+        dps_status |= dps310_config_pres (p_dps,
                                           DPS310_MR_128,
-                                          singleton_ctx_spi.pres_osr);
+                                          p_dps->pres_osr);
     }
     else
     {
@@ -251,7 +212,7 @@ rd_status_t ri_dps310_samplerate_set (uint8_t * samplerate)
 
     if ( (DPS310_SUCCESS == dps_status) && (RD_SUCCESS == err_code))
     {
-        err_code |= ri_dps310_samplerate_get (samplerate);
+        err_code |= samplerate_get (p_inst, samplerate);
     }
     else if (RD_SUCCESS == err_code)
     {
@@ -311,8 +272,9 @@ static uint8_t dps310_mr_to_samplerate (const dps310_mr_t mr)
     return rate;
 }
 
-rd_status_t ri_dps310_samplerate_get (uint8_t * samplerate)
+static rd_status_t samplerate_get (dps310_instance_t * const p_inst, uint8_t * samplerate)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     uint8_t rate = 0U;
 
@@ -324,7 +286,7 @@ rd_status_t ri_dps310_samplerate_get (uint8_t * samplerate)
     {
         // Separate rates for temperature and pressure aren't supported
         // by interface, so can check only temperature rate.
-        rate = dps310_mr_to_samplerate (singleton_ctx_spi.temp_mr);
+        rate = dps310_mr_to_samplerate (p_dps->temp_mr);
 
         if (0U == rate)
         {
@@ -339,15 +301,16 @@ rd_status_t ri_dps310_samplerate_get (uint8_t * samplerate)
     return err_code;
 }
 
-rd_status_t ri_dps310_resolution_set (uint8_t * resolution)
+static rd_status_t resolution_set (dps310_instance_t * const p_inst, uint8_t * resolution)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == resolution)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (DPS310_READY != singleton_ctx_spi.device_status)
+    else if (DPS310_READY != p_dps->device_status)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -383,15 +346,16 @@ rd_status_t ri_dps310_resolution_get (uint8_t * resolution)
     return err_code;
 }
 
-rd_status_t ri_dps310_scale_set (uint8_t * scale)
+static rd_status_t scale_set (dps310_instance_t * const p_inst, uint8_t * scale)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == scale)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (DPS310_READY != singleton_ctx_spi.device_status)
+    else if (DPS310_READY != p_dps->device_status)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -427,8 +391,10 @@ rd_status_t ri_dps310_scale_get (uint8_t * scale)
     return err_code;
 }
 
-rd_status_t ri_dps310_dsp_set (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_set (dps310_instance_t * const p_inst, uint8_t * dsp,
+                            uint8_t * parameter)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     dps310_status_t dps_status = DPS310_SUCCESS;
 
@@ -436,18 +402,18 @@ rd_status_t ri_dps310_dsp_set (uint8_t * dsp, uint8_t * parameter)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (DPS310_READY != singleton_ctx_spi.device_status)
+    else if (DPS310_READY != p_dps->device_status)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
     else if ( (RD_SENSOR_DSP_LAST == *dsp)
               || (RD_SENSOR_CFG_DEFAULT == *dsp))
     {
-        dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                          singleton_ctx_spi.temp_mr,
+        dps_status |= dps310_config_temp (p_dps,
+                                          p_dps->temp_mr,
                                           DPS310_OS_1);
-        dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                          singleton_ctx_spi.pres_mr,
+        dps_status |= dps310_config_pres (p_dps,
+                                          p_dps->pres_mr,
                                           DPS310_OS_1);
     }
     else if (RD_SENSOR_DSP_OS == *dsp)
@@ -458,92 +424,92 @@ rd_status_t ri_dps310_dsp_set (uint8_t * dsp, uint8_t * parameter)
         }
         else if (RD_SENSOR_CFG_DEFAULT == *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_DEFAULT_OS);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_DEFAULT_OS);
         }
         else if ( (RD_SENSOR_CFG_MIN == *parameter) || (1U == *parameter))
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_1);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_1);
         }
         else if (RD_SENSOR_CFG_MAX == *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_128);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_128);
         }
         else if (2U == *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_2);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_2);
         }
         else if (4U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_4);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_4);
         }
         else if (8U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_8);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_8);
         }
         else if (16U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_16);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_16);
         }
         else if (32U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_32);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_32);
         }
         else if (64U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_64);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_64);
         }
         else if (128U >= *parameter)
         {
-            dps_status |= dps310_config_temp (&singleton_ctx_spi,
-                                              singleton_ctx_spi.temp_mr,
+            dps_status |= dps310_config_temp (p_dps,
+                                              p_dps->temp_mr,
                                               DPS310_OS_128);
-            dps_status |= dps310_config_pres (&singleton_ctx_spi,
-                                              singleton_ctx_spi.pres_mr,
+            dps_status |= dps310_config_pres (p_dps,
+                                              p_dps->pres_mr,
                                               DPS310_OS_128);
         }
         else
@@ -554,7 +520,7 @@ rd_status_t ri_dps310_dsp_set (uint8_t * dsp, uint8_t * parameter)
 
     if (DPS310_SUCCESS == dps_status)
     {
-        err_code |= ri_dps310_dsp_get (dsp, parameter);
+        err_code |= dsp_get (p_inst, dsp, parameter);
     }
     else
     {
@@ -610,8 +576,10 @@ static uint8_t dps310_os_to_samplerate (const dps310_os_t os)
     return rate;
 }
 
-rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_get (dps310_instance_t * const p_inst, uint8_t * dsp,
+                            uint8_t * parameter)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     uint8_t sampling = 0;
 
@@ -621,9 +589,9 @@ rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (singleton_ctx_spi.temp_osr > DPS310_OS_1)
+    else if (p_dps->temp_osr > DPS310_OS_1)
     {
-        sampling = dps310_os_to_samplerate (singleton_ctx_spi.temp_osr);
+        sampling = dps310_os_to_samplerate (p_dps->temp_osr);
 
         if (sampling > 1)
         {
@@ -635,7 +603,7 @@ rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter)
             err_code = RD_ERROR_INTERNAL;
         }
     }
-    else if (singleton_ctx_spi.temp_osr == DPS310_OS_1)
+    else if (p_dps->temp_osr == DPS310_OS_1)
     {
         *dsp = RD_SENSOR_CFG_DEFAULT;
         *parameter = 1U;
@@ -648,18 +616,20 @@ rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter)
     return err_code;
 }
 
-static void last_sample_update (const float temp, const float pres, const uint64_t ts)
+static void last_sample_update (dps310_instance_t * const p_inst, const float temp,
+                                const float pres, const uint64_t ts)
 {
-    memset (&last_data, 0, sizeof (last_data));
-    last_data.fields = dps_fields;
-    last_data.data = last_values;
-    last_data.timestamp_ms = ts;
-    rd_sensor_data_set (&last_data, RD_SENSOR_PRES_FIELD, pres);
-    rd_sensor_data_set (&last_data, RD_SENSOR_TEMP_FIELD, temp);
+    memset (&p_inst->last_data, 0, sizeof (p_inst->last_data));
+    p_inst->last_data.fields = dps_fields;
+    p_inst->last_data.data = p_inst->last_values;
+    p_inst->last_data.timestamp_ms = ts;
+    rd_sensor_data_set (&p_inst->last_data, RD_SENSOR_PRES_FIELD, pres);
+    rd_sensor_data_set (&p_inst->last_data, RD_SENSOR_TEMP_FIELD, temp);
 }
 
-rd_status_t ri_dps310_mode_set (uint8_t * mode)
+static rd_status_t mode_set (dps310_instance_t * const p_inst, uint8_t * mode)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     dps310_status_t dps_status = DPS310_SUCCESS;
 
@@ -670,9 +640,11 @@ rd_status_t ri_dps310_mode_set (uint8_t * mode)
     else if ( (RD_SENSOR_CFG_SLEEP == *mode)
               || (RD_SENSOR_CFG_DEFAULT == *mode))
     {
-        dps_status = dps310_standby (&singleton_ctx_spi);
+        // Cancels split-phase measurement.
+        dps_status = dps310_standby (p_dps);
+        p_inst->single_pending = false;
     }
-    else if (DPS310_READY != singleton_ctx_spi.device_status)
+    else if (DPS310_READY != p_dps->device_status)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -680,13 +652,13 @@ rd_status_t ri_dps310_mode_set (uint8_t * mode)
     {
         float temperature;
         float pressure;
-        dps_status |= dps310_measure_temp_once_sync (&singleton_ctx_spi, &temperature);
-        dps_status |= dps310_measure_pres_once_sync (&singleton_ctx_spi, &pressure);
-        last_sample_update (temperature, pressure, rd_sensor_timestamp_get());
+        dps_status |= dps310_measure_temp_once_sync (p_dps, &temperature);
+        dps_status |= dps310_measure_pres_once_sync (p_dps, &pressure);
+        last_sample_update (p_inst, temperature, pressure, rd_sensor_timestamp_get());
     }
     else if (RD_SENSOR_CFG_CONTINUOUS == *mode)
     {
-        dps_status |= dps310_measure_continuous_async (&singleton_ctx_spi);
+        dps_status |= dps310_measure_continuous_async (p_dps);
     }
     else
     {
@@ -698,21 +670,27 @@ rd_status_t ri_dps310_mode_set (uint8_t * mode)
         err_code |= RD_ERROR_INTERNAL;
     }
 
-    err_code |= ri_dps310_mode_get (mode);
+    err_code |= mode_get (p_inst, mode);
     return err_code;
 }
 
-rd_status_t ri_dps310_mode_get (uint8_t * mode)
+static rd_status_t mode_get (dps310_instance_t * const p_inst, uint8_t * mode)
 {
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
 
     if (NULL == mode)
     {
         err_code |= RD_ERROR_NULL;
     }
+    // Sensor returns to sleep once split-phase result is collected.
+    else if (p_inst->single_pending)
+    {
+        *mode = RD_SENSOR_CFG_SLEEP;
+    }
     else
     {
-        switch (singleton_ctx_spi.device_status)
+        switch (p_dps->device_status)
         {
             case DPS310_READY:
                 *mode = RD_SENSOR_CFG_SLEEP;
@@ -730,29 +708,293 @@ rd_status_t ri_dps310_mode_get (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_dps310_data_get (rd_sensor_data_t * const data)
+/**
+ * @brief Time of one conversion with given oversampling, us.
+ *
+ * Follows measurement time table of datasheet: 3.6 ms at OS 1, 206.8 ms at OS 128.
+ */
+static uint32_t dps310_conversion_time_us (const dps310_os_t os)
+{
+    return DPS310_CONVERSION_BASE_US
+           + (DPS310_CONVERSION_PER_OS_US * dps310_os_to_samplerate (os));
+}
+
+/** @brief Measurement rate of samplerate in Hz, 0 if samplerate is not supported. */
+static uint32_t dps310_cost_rate (const uint8_t samplerate)
+{
+    uint32_t rate = 0;
+
+    if ( (RD_SENSOR_CFG_DEFAULT == samplerate) || (RD_SENSOR_CFG_NO_CHANGE == samplerate))
+    {
+        rate = dps310_mr_to_samplerate (DPS310_DEFAULT_MR);
+    }
+    else if ( (RD_SENSOR_CFG_MIN == samplerate) || (1U == samplerate))
+    {
+        rate = 1U;
+    }
+    else if ( (RD_SENSOR_CFG_MAX == samplerate) || ( (128U >= samplerate)
+              && (2U <= samplerate)))
+    {
+        rate = 2U;
+
+        while ( (rate < samplerate) && (rate < 128U))
+        {
+            rate *= 2U;
+        }
+    }
+    else
+    {
+        // Not supported.
+    }
+
+    return rate;
+}
+
+/** @brief Oversampling ratio of DSP setting, 0 if DSP is not supported. */
+static uint32_t dps310_cost_os (const uint8_t dsp, const uint8_t parameter)
+{
+    uint32_t os = 0;
+
+    if ( (RD_SENSOR_DSP_LAST == dsp) || (RD_SENSOR_CFG_NO_CHANGE == dsp))
+    {
+        os = 1U;
+    }
+    else if (RD_SENSOR_DSP_OS != dsp)
+    {
+        // Not supported.
+    }
+    else if ( (RD_SENSOR_CFG_DEFAULT == parameter)
+              || (RD_SENSOR_CFG_NO_CHANGE == parameter))
+    {
+        os = dps310_os_to_samplerate (DPS310_DEFAULT_OS);
+    }
+    else if ( (RD_SENSOR_CFG_MIN == parameter) || (1U == parameter))
+    {
+        os = 1U;
+    }
+    else if ( (RD_SENSOR_CFG_MAX == parameter) || ( (128U >= parameter)
+              && (2U <= parameter)))
+    {
+        os = 2U;
+
+        while ( (os < parameter) && (os < 128U))
+        {
+            os *= 2U;
+        }
+    }
+    else
+    {
+        // Not supported.
+    }
+
+    return os;
+}
+
+rd_status_t ri_dps310_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        const uint32_t rate = dps310_cost_rate (p_config->samplerate);
+        const uint32_t os = dps310_cost_os (p_config->dsp_function,
+                                           p_config->dsp_parameter);
+
+        if ( (0U == rate) || (0U == os))
+        {
+            err_code |= RD_ERROR_NOT_SUPPORTED;
+        }
+        else
+        {
+            // Temperature and pressure are converted on each sample.
+            const uint32_t active_us = 2U * (DPS310_CONVERSION_BASE_US
+                                             + (DPS310_CONVERSION_PER_OS_US * os));
+            p_cost->conversion_us = active_us;
+            p_cost->charge_nc = (uint32_t) ( ( (uint64_t) DPS310_ACTIVE_NA * active_us)
+                                             / 1000000U);
+            p_cost->sleep_na = DPS310_STANDBY_NA;
+
+            switch (p_config->mode)
+            {
+                case RD_SENSOR_CFG_DEFAULT:
+                case RD_SENSOR_CFG_NO_CHANGE:
+                case RD_SENSOR_CFG_SLEEP:
+                    p_cost->average_na = p_cost->sleep_na;
+                    break;
+
+                case RD_SENSOR_CFG_SINGLE:
+                case RD_SENSOR_CFG_CONTINUOUS:
+                    p_cost->average_na = rd_sensor_cost_average_na (p_cost,
+                                         1000000U / rate);
+                    break;
+
+                default:
+                    err_code |= RD_ERROR_NOT_SUPPORTED;
+                    break;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+/** @brief Stop split-phase measurement and put sensor to standby. */
+static void measurement_abort (dps310_instance_t * const p_inst)
 {
+    // Error code can be ignored, there is no result to recover.
+    (void) dps310_standby (p_inst->p_dps);
+    p_inst->single_pending = false;
+}
+
+static rd_status_t measurement_start (dps310_instance_t * const p_inst,
+                                      uint64_t * const p_ready_ms)
+{
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
+    rd_status_t err_code = RD_SUCCESS;
+    dps310_status_t dps_status = DPS310_SUCCESS;
+    uint64_t now = RD_UINT64_INVALID;
+
+    if (NULL == p_ready_ms)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (DPS310_READY != p_dps->device_status) || p_inst->single_pending
+              || (RD_UINT64_INVALID == (now = rd_sensor_timestamp_get())))
+    {
+        // Ready time cannot be known without timestamp.
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        // Background mode converts temperature and pressure without
+        // blocking, sensor is put back to standby when result is collected.
+        dps_status |= dps310_measure_continuous_async (p_dps);
+
+        if (DPS310_SUCCESS == dps_status)
+        {
+            const uint32_t conversion_us =
+                dps310_conversion_time_us (p_dps->temp_osr)
+                + dps310_conversion_time_us (p_dps->pres_osr);
+            const uint32_t conversion_ms = (conversion_us + 999U) / 1000U;
+            p_inst->single_ready_ms = now + conversion_ms;
+            // Conversion which has not finished in twice the nominal time has failed.
+            p_inst->single_timeout_ms = p_inst->single_ready_ms + conversion_ms;
+            p_inst->single_pending = true;
+            *p_ready_ms = p_inst->single_ready_ms;
+        }
+        else
+        {
+            // Do not leave sensor converting in background if start failed halfway.
+            measurement_abort (p_inst);
+            err_code |= RD_ERROR_INTERNAL;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t measurement_complete (dps310_instance_t * const p_inst)
+{
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
+    rd_status_t err_code = RD_SUCCESS;
+
+    uint64_t now = 0;
+    uint8_t meas_cfg = 0;
+    const uint8_t ready_mask = DPS310_MEAS_CFG_TMP_RDY | DPS310_MEAS_CFG_PRS_RDY;
+
+    if (p_inst->single_pending)
+    {
+        now = rd_sensor_timestamp_get();
+    }
+
+    if (!p_inst->single_pending)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (now < p_inst->single_ready_ms)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else if (DPS310_SUCCESS != p_dps->read (p_dps->comm_ctx, DPS310_REG_MEAS_CFG,
+                                            &meas_cfg, 1U))
+    {
+        measurement_abort (p_inst);
+        err_code |= RD_ERROR_INTERNAL;
+    }
+    // Nominal conversion time is not guaranteed, wait for both results.
+    else if ( (ready_mask != (meas_cfg & ready_mask))
+              && (now < p_inst->single_timeout_ms))
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else if (ready_mask != (meas_cfg & ready_mask))
+    {
+        measurement_abort (p_inst);
+        err_code |= RD_ERROR_TIMEOUT;
+    }
+    else
+    {
+        float temperature;
+        float pressure;
+        dps310_status_t dps_status = dps310_get_last_result (p_dps,
+                                     &temperature, &pressure);
+        dps_status |= dps310_standby (p_dps);
+        p_inst->single_pending = false;
+
+        if (DPS310_SUCCESS == dps_status)
+        {
+            last_sample_update (p_inst, temperature, pressure, p_inst->single_ready_ms);
+        }
+        else
+        {
+            err_code |= RD_ERROR_INTERNAL;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t data_get (dps310_instance_t * const p_inst,
+                             rd_sensor_data_t * const data)
+{
+    dps310_ctx_t * const p_dps = p_inst->p_dps;
     rd_status_t err_code = RD_SUCCESS;
     uint8_t mode = RD_SENSOR_CFG_DEFAULT;
-    (void) ri_dps310_mode_get (&mode);
+    (void) mode_get (p_inst, &mode);
 
     if (NULL == data)
     {
         err_code |= RD_ERROR_NULL;
     }
+    // Collect split-phase result if ready, previous sample is returned until then.
+    else if (p_inst->single_pending)
+    {
+        err_code |= measurement_complete (p_inst);
+        err_code &= ~RD_ERROR_BUSY;
+
+        if (p_inst->last_data.timestamp_ms > 0)
+        {
+            rd_sensor_data_populate (data, &p_inst->last_data, dps_fields);
+        }
+    }
     // Use cached last value if sensor is sleeping, verify there is a valid sample.
-    else if ( (mode == RD_SENSOR_CFG_SLEEP) && (last_data.timestamp_ms > 0))
+    else if ( (mode == RD_SENSOR_CFG_SLEEP) && (p_inst->last_data.timestamp_ms > 0))
     {
-        rd_sensor_data_populate (data, &last_data, dps_fields);
+        rd_sensor_data_populate (data, &p_inst->last_data, dps_fields);
     }
     else if (mode == RD_SENSOR_CFG_CONTINUOUS)
     {
         float temperature;
         float pressure;
-        dps310_status_t dps_status = dps310_get_last_result (&singleton_ctx_spi,
+        dps310_status_t dps_status = dps310_get_last_result (p_dps,
                                      &temperature, &pressure);
-        last_sample_update (temperature, pressure, rd_sensor_timestamp_get());
-        rd_sensor_data_populate (data, &last_data, dps_fields);
+        last_sample_update (p_inst, temperature, pressure, rd_sensor_timestamp_get());
+        rd_sensor_data_populate (data, &p_inst->last_data, dps_fields);
 
         if (DPS310_SUCCESS != dps_status)
         {
@@ -767,4 +1009,303 @@ rd_status_t ri_dps310_data_get (rd_sensor_data_t * const data)
     return err_code;
 }
 
+rd_status_t ri_dps310_samplerate_set (uint8_t * samplerate)
+{
+    return samplerate_set (&m_instance[0], samplerate);
+}
+
+rd_status_t ri_dps310_samplerate_get (uint8_t * samplerate)
+{
+    return samplerate_get (&m_instance[0], samplerate);
+}
+
+rd_status_t ri_dps310_resolution_set (uint8_t * resolution)
+{
+    return resolution_set (&m_instance[0], resolution);
+}
+
+rd_status_t ri_dps310_scale_set (uint8_t * scale)
+{
+    return scale_set (&m_instance[0], scale);
+}
+
+rd_status_t ri_dps310_dsp_set (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_set (&m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_get (&m_instance[0], dsp, parameter);
+}
+
+rd_status_t ri_dps310_mode_set (uint8_t * mode)
+{
+    return mode_set (&m_instance[0], mode);
+}
+
+rd_status_t ri_dps310_mode_get (uint8_t * mode)
+{
+    return mode_get (&m_instance[0], mode);
+}
+
+rd_status_t ri_dps310_measurement_start (uint64_t * const p_ready_ms)
+{
+    return measurement_start (&m_instance[0], p_ready_ms);
+}
+
+rd_status_t ri_dps310_measurement_complete (void)
+{
+    return measurement_complete (&m_instance[0]);
+}
+
+rd_status_t ri_dps310_data_get (rd_sensor_data_t * const data)
+{
+    return data_get (&m_instance[0], data);
+}
+
+/** @brief Functions of an instance. Resolution and scale are fixed and shared. */
+typedef struct
+{
+    rd_sensor_setup_fp samplerate_set;
+    rd_sensor_setup_fp samplerate_get;
+    rd_sensor_setup_fp resolution_set;
+    rd_sensor_setup_fp scale_set;
+    rd_sensor_dsp_fp   dsp_set;
+    rd_sensor_dsp_fp   dsp_get;
+    rd_sensor_setup_fp mode_set;
+    rd_sensor_setup_fp mode_get;
+    rd_sensor_data_fp  data_get;
+    rd_sensor_measurement_start_fp measurement_start;
+    rd_sensor_measurement_complete_fp measurement_complete;
+} dps310_api_t;
+
+/** @brief Define functions of instance n, public functions are instance 0. */
+#define DPS310_INSTANCE_DEFINE(n)                                                  \
+    RD_SENSOR_SETUP_BIND (samplerate_set_##n, samplerate_set, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (samplerate_get_##n, samplerate_get, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (resolution_set_##n, resolution_set, &m_instance[n])    \
+    RD_SENSOR_SETUP_BIND (scale_set_##n, scale_set, &m_instance[n])              \
+    RD_SENSOR_DSP_BIND (dsp_set_##n, dsp_set, &m_instance[n])                    \
+    RD_SENSOR_DSP_BIND (dsp_get_##n, dsp_get, &m_instance[n])                    \
+    RD_SENSOR_SETUP_BIND (mode_set_##n, mode_set, &m_instance[n])                \
+    RD_SENSOR_SETUP_BIND (mode_get_##n, mode_get, &m_instance[n])                \
+    RD_SENSOR_DATA_BIND (data_get_##n, data_get, &m_instance[n])                \
+    RD_SENSOR_MEASUREMENT_START_BIND (measurement_start_##n, measurement_start,  \
+                                      &m_instance[n])                            \
+    RD_SENSOR_MEASUREMENT_COMPLETE_BIND (measurement_complete_##n,               \
+                                         measurement_complete, &m_instance[n])
+
+/** @brief Functions of instance n defined by @ref DPS310_INSTANCE_DEFINE. */
+#define DPS310_INSTANCE_API(n)                                                     \
+    {                                                                              \
+        samplerate_set_##n, samplerate_get_##n, resolution_set_##n, scale_set_##n, \
+        dsp_set_##n, dsp_get_##n, mode_set_##n, mode_get_##n, data_get_##n,        \
+        measurement_start_##n, measurement_complete_##n                            \
+    }
+
+#if RI_DPS310_MAX_INSTANCES > 1
+DPS310_INSTANCE_DEFINE (1)
+#endif
+#if RI_DPS310_MAX_INSTANCES > 2
+DPS310_INSTANCE_DEFINE (2)
+#endif
+#if RI_DPS310_MAX_INSTANCES > 3
+DPS310_INSTANCE_DEFINE (3)
+#endif
+
+static const dps310_api_t m_api[RI_DPS310_MAX_INSTANCES] =
+{
+    {
+        ri_dps310_samplerate_set, ri_dps310_samplerate_get, ri_dps310_resolution_set,
+        ri_dps310_scale_set, ri_dps310_dsp_set, ri_dps310_dsp_get,
+        ri_dps310_mode_set, ri_dps310_mode_get, ri_dps310_data_get,
+        ri_dps310_measurement_start, ri_dps310_measurement_complete
+    },
+#if RI_DPS310_MAX_INSTANCES > 1
+    DPS310_INSTANCE_API (1),
+#endif
+#if RI_DPS310_MAX_INSTANCES > 2
+    DPS310_INSTANCE_API (2),
+#endif
+#if RI_DPS310_MAX_INSTANCES > 3
+    DPS310_INSTANCE_API (3),
+#endif
+};
+
+/**
+ * @brief Find instance bound to sensor or a free instance.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor if it has one, otherwise index of
+ *         first free instance. @ref RI_DPS310_MAX_INSTANCES if none is found.
+ */
+static uint8_t instance_find (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_DPS310_MAX_INSTANCES;
+    uint8_t free = RI_DPS310_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_DPS310_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+        else if ( (NULL == m_owner[ii]) && (RI_DPS310_MAX_INSTANCES == free))
+        {
+            free = ii;
+        }
+        else
+        {
+            // Instance belongs to other sensor.
+        }
+    }
+
+    return (RI_DPS310_MAX_INSTANCES == own) ? free : own;
+}
+
+static __attribute__ ( (nonnull)) void
+dps310_spi_setup (rd_sensor_t * const p_sensor, const uint8_t instance,
+                  const uint8_t handle)
+{
+    p_sensor->p_ctx = &m_spi_ctx[instance];
+    m_spi_handle[instance] = handle;
+}
+
+static __attribute__ ( (nonnull))
+void dps310_fp_setup (rd_sensor_t * const p_sensor, const dps310_api_t * const p_api)
+{
+    p_sensor->init = &ri_dps310_init;
+    p_sensor->uninit = &ri_dps310_uninit;
+    p_sensor->samplerate_set = p_api->samplerate_set;
+    p_sensor->samplerate_get = p_api->samplerate_get;
+    p_sensor->resolution_set = p_api->resolution_set;
+    p_sensor->resolution_get = &ri_dps310_resolution_get;
+    p_sensor->scale_set = p_api->scale_set;
+    p_sensor->scale_get = &ri_dps310_scale_get;
+    p_sensor->dsp_set = p_api->dsp_set;
+    p_sensor->dsp_get = p_api->dsp_get;
+    p_sensor->mode_set = p_api->mode_set;
+    p_sensor->mode_get = p_api->mode_get;
+    p_sensor->data_get = p_api->data_get;
+    p_sensor->measurement_start = p_api->measurement_start;
+    p_sensor->measurement_complete = p_api->measurement_complete;
+    p_sensor->cost_get = &ri_dps310_cost_get;
+    p_sensor->configuration_set = &rd_sensor_configuration_set;
+    p_sensor->configuration_get = &rd_sensor_configuration_get;
+    return;
+}
+
+rd_status_t ri_dps310_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    dps310_status_t dps_status = DPS310_SUCCESS;
+    uint8_t instance = RI_DPS310_MAX_INSTANCES;
+
+    if (NULL == p_sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (rd_sensor_is_init (p_sensor))
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        instance = instance_find (p_sensor);
+
+        if (RI_DPS310_MAX_INSTANCES <= instance)
+        {
+            err_code |= RD_ERROR_RESOURCES;
+        }
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        dps310_instance_t * const p_inst = &m_instance[instance];
+        rd_sensor_initialize (p_sensor);
+        p_sensor->name = name;
+        // Instance stays bound on error so that uninit can release it.
+        m_owner[instance] = p_sensor;
+
+        if (NULL == p_sensor->p_ctx)
+        {
+            if (RD_BUS_SPI == bus)
+            {
+                dps310_spi_setup (p_sensor, instance, handle);
+            }
+            else if (RD_BUS_I2C == bus)
+            {
+                err_code |= RD_ERROR_NOT_IMPLEMENTED;
+            }
+            else
+            {
+                err_code |= RD_ERROR_NOT_SUPPORTED;
+            }
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            p_inst->p_dps = p_sensor->p_ctx;
+            dps_status = dps310_init (p_inst->p_dps);
+
+            if (DPS310_SUCCESS == dps_status)
+            {
+                dps310_fp_setup (p_sensor, &m_api[instance]);
+                p_sensor->name = name;
+                p_sensor->provides = dps_fields;
+                memset (&p_inst->last_data, 0, sizeof (p_inst->last_data));
+                p_inst->single_pending = false;
+            }
+            else
+            {
+                err_code |= RD_ERROR_NOT_FOUND;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_dps310_uninit (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        const uint8_t instance = instance_find (sensor);
+
+        // Stop background conversion of split-phase measurement.
+        if ( (RI_DPS310_MAX_INSTANCES > instance) && (sensor == m_owner[instance])
+                && m_instance[instance].single_pending)
+        {
+            measurement_abort (&m_instance[instance]);
+        }
+
+        // Error code can be ignored.
+        (void) dps310_uninit (sensor->p_ctx);
+        rd_sensor_uninitialize (sensor);
+
+        if ( (RI_DPS310_MAX_INSTANCES > instance) && (sensor == m_owner[instance]))
+        {
+            dps310_instance_t * const p_inst = &m_instance[instance];
+
+            if (&m_spi_ctx[instance] == sensor->p_ctx)
+            {
+                sensor->p_ctx = NULL;
+            }
+
+            p_inst->p_dps = &m_spi_ctx[instance];
+            p_inst->single_pending = false;
+            m_owner[instance] = NULL;
+        }
+    }
+
+    return err_code;
+}
+
 #endif
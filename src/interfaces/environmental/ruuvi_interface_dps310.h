@@ -44,6 +44,11 @@
  * @endcode
  */
 
+// Datasheet 4.2, typical values. Active current is derived from 1.7 uA
+// average of 1 Hz low precision measurement with 3.6 ms measurement time.
+#define DPS310_ACTIVE_NA  (345000U) //!< Current during conversion.
+#define DPS310_STANDBY_NA (500U)    //!< Current in standby and between conversions.
+
 /** @brief @ref rd_sensor_init_fp */
 rd_status_t ri_dps310_init (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle);
 /** @brief @ref rd_sensor_init_fp */
@@ -68,8 +73,56 @@ rd_status_t ri_dps310_dsp_get (uint8_t * dsp, uint8_t * parameter);
 rd_status_t ri_dps310_mode_set (uint8_t * mode);
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_dps310_mode_get (uint8_t * mode);
-/** @brief @ref rd_sensor_data_fp */
+/** @brief @ref rd_sensor_data_fp
+ *
+ * Collects result of @ref ri_dps310_measurement_start if it is ready.
+ */
 rd_status_t ri_dps310_data_get (rd_sensor_data_t * const data);
 
+/**
+ * @brief Start a single measurement without waiting for it.
+ *
+ * Unlike mode_set(RD_SENSOR_CFG_SINGLE), this returns as soon as conversion
+ * has been started. Conversion time depends on oversampling set with
+ * @ref ri_dps310_dsp_set, from 8 ms at OS 1 to over 400 ms at OS 128.
+ * Collect the result at ready time with @ref ri_dps310_measurement_complete
+ * or data_get, e.g. from a timer, and sleep or serve radio meanwhile.
+ * Sensor reports sleep mode while measurement is running and returns to sleep
+ * when result is collected.
+ *
+ * @param[out] p_ready_ms Value of @ref rd_sensor_timestamp_get when result is ready.
+ * @retval RD_SUCCESS if measurement was started.
+ * @retval RD_ERROR_NULL if p_ready_ms is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is not sleeping, measurement is running
+ *         or timestamp is not available.
+ * @retval RD_ERROR_INTERNAL if sensor could not be started, sensor is put to sleep.
+ */
+rd_status_t ri_dps310_measurement_start (uint64_t * const p_ready_ms);
+
+/**
+ * @brief Collect result of @ref ri_dps310_measurement_start and put sensor to sleep.
+ *
+ * Result is available through data_get. Result ready flags of sensor are
+ * checked after ready time, measurement is abandoned and sensor put to sleep
+ * if results are not ready at twice the nominal conversion time.
+ *
+ * @retval RD_SUCCESS if result was collected.
+ * @retval RD_ERROR_BUSY if conversion is not ready yet.
+ * @retval RD_ERROR_INVALID_STATE if no measurement was started.
+ * @retval RD_ERROR_TIMEOUT if sensor did not finish conversion.
+ * @retval RD_ERROR_INTERNAL if result could not be read.
+ */
+rd_status_t ri_dps310_measurement_complete (void);
+
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Measurement rate and oversampling are evaluated like in
+ * @ref ri_dps310_samplerate_set and @ref ri_dps310_dsp_set, each sample
+ * converts both temperature and pressure.
+ */
+rd_status_t ri_dps310_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost);
+
 /** @} */
 #endif // RUUVI_INTERFACE_DPS310_H
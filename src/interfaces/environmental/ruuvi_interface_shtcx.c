@@ -58,6 +58,9 @@ static bool m_autorefresh;           //!< Flag to refresh data on data_get.
 static int32_t m_temperature;        //!< Last measured temperature.
 static int32_t m_humidity;           //!< Last measured humidity.
 static bool m_is_init;               //!< Flag, is sensor init.
+static bool m_measuring;             //!< Measurement started, result not read.
+static uint64_t m_measure_start;     //!< Timestamp of measurement start.
+static uint64_t m_ready_ms;          //!< Timestamp when measurement result is ready.
 static const char m_sensor_name[] = "SHTCX"; //!< Human-readable name of the sensor.
 
 #define STATUS_OK 0                  //!< SHTC driver ok
@@ -145,12 +148,16 @@ rd_status_t ri_shtcx_init (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
             sensor->mode_set          = ri_shtcx_mode_set;
             sensor->mode_get          = ri_shtcx_mode_get;
             sensor->data_get          = ri_shtcx_data_get;
+            sensor->measurement_start    = ri_shtcx_measurement_start;
+            sensor->measurement_complete = ri_shtcx_measurement_complete;
+            sensor->cost_get          = ri_shtcx_cost_get;
             sensor->configuration_set = rd_sensor_configuration_set;
             sensor->configuration_get = rd_sensor_configuration_get;
             sensor->provides.datas.temperature_c = 1;
             sensor->provides.datas.humidity_rh = 1;
             err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
             m_tsample = RD_UINT64_INVALID;
+            m_measuring = false;
             m_is_init = true;
         }
     }
@@ -158,6 +165,50 @@ rd_status_t ri_shtcx_init (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
     return err_code;
 }
 
+/**
+ * @brief Read result of running measurement and put sensor to sleep.
+ *
+ * Sensor must have finished conversion, it does not accept commands before.
+ */
+static rd_status_t measurement_read (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    int32_t temperature;
+    int32_t humidity;
+    m_measuring = false;
+    err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_read (&temperature, &humidity));
+
+    if (RD_SUCCESS == err_code)
+    {
+        m_temperature = temperature;
+        m_humidity = humidity;
+        m_tsample = m_measure_start;
+    }
+
+    err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
+    return err_code;
+}
+
+/**
+ * @brief Wait for running conversion to end, read result and put sensor to sleep.
+ *
+ * Blocks at most for conversion time.
+ */
+static rd_status_t measurement_finish (void)
+{
+    const uint64_t now = rd_sensor_timestamp_get();
+
+    if (now < m_ready_ms)
+    {
+        // Conversion started before now, it cannot take longer than this.
+        const uint64_t wait_us = (m_ready_ms - now) * 1000U;
+        sensirion_sleep_usec ( (wait_us < RI_SHTCX_MEASUREMENT_US) ?
+                               (uint32_t) wait_us : RI_SHTCX_MEASUREMENT_US);
+    }
+
+    return measurement_read();
+}
+
 rd_status_t ri_shtcx_uninit (rd_sensor_t * sensor,
                              rd_bus_t bus, uint8_t handle)
 {
@@ -165,13 +216,24 @@ rd_status_t ri_shtcx_uninit (rd_sensor_t * sensor,
 
     rd_status_t err_code = RD_SUCCESS;
     shtc1_enable_low_power_mode (1);
-    err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
+
+    // Sensor does not accept sleep command during conversion.
+    if (m_measuring)
+    {
+        err_code |= measurement_finish();
+    }
+    else
+    {
+        err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
+    }
+
     rd_sensor_uninitialize (sensor);
     m_tsample = RD_UINT64_INVALID;
     m_temperature = RD_INT32_INVALID;
     m_humidity = RD_INT32_INVALID;
     m_is_init = false;
     m_autorefresh = false;
+    m_measuring = false;
     return err_code;
 }
 
@@ -279,7 +341,16 @@ rd_status_t ri_shtcx_mode_set (uint8_t * mode)
     {
         m_autorefresh = false;
         *mode = RD_SENSOR_CFG_SLEEP;
-        err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
+
+        // Sensor does not accept sleep command during conversion.
+        if (m_measuring)
+        {
+            err_code |= measurement_finish();
+        }
+        else
+        {
+            err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_sleep());
+        }
     }
     else if (RD_SENSOR_CFG_SINGLE == *mode)
     {
@@ -293,6 +364,13 @@ rd_status_t ri_shtcx_mode_set (uint8_t * mode)
             return RD_ERROR_INVALID_STATE;
         }
 
+        // Sensor does not accept commands during conversion.
+        if (m_measuring)
+        {
+            *mode = RD_SENSOR_CFG_SLEEP;
+            return RD_ERROR_INVALID_STATE;
+        }
+
         // Enter sleep after measurement
         m_autorefresh = false;
         *mode = RD_SENSOR_CFG_SLEEP;
@@ -306,8 +384,14 @@ rd_status_t ri_shtcx_mode_set (uint8_t * mode)
     }
     else if (RD_SENSOR_CFG_CONTINUOUS == *mode)
     {
+        // Start first measurement, data_get collects it and starts next.
         m_autorefresh = true;
-        err_code |= RD_SUCCESS;
+
+        if (!m_measuring)
+        {
+            uint64_t ready_ms;
+            err_code |= ri_shtcx_measurement_start (&ready_ms);
+        }
     }
     else
     {
@@ -334,6 +418,108 @@ rd_status_t ri_shtcx_mode_get (uint8_t * mode)
     return RD_SUCCESS;
 }
 
+rd_status_t ri_shtcx_measurement_start (uint64_t * const p_ready_ms)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t now = RD_UINT64_INVALID;
+
+    if (NULL == p_ready_ms)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (!m_is_init) || m_measuring
+              || (RD_UINT64_INVALID == (now = rd_sensor_timestamp_get())))
+    {
+        // Ready time cannot be known without timestamp.
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_measure_start = now;
+        err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_wake_up());
+        sensirion_sleep_usec (RI_SHTCX_WAKEUP_US);
+        err_code |= SHTCX_TO_RUUVI_ERROR (shtc1_measure());
+
+        if (RD_SUCCESS == err_code)
+        {
+            m_measuring = true;
+            m_ready_ms = m_measure_start + US_TO_MS_ROUNDUP (RI_SHTCX_MEASUREMENT_US);
+            *p_ready_ms = m_ready_ms;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_shtcx_measurement_complete (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_measuring)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (rd_sensor_timestamp_get() < m_ready_ms)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else
+    {
+        err_code |= measurement_read();
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_shtcx_cost_get (const rd_sensor_configuration_t * const p_config,
+                               rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( ( (RD_SENSOR_CFG_DEFAULT != p_config->samplerate)
+                && (RD_SENSOR_CFG_NO_CHANGE != p_config->samplerate)
+                && (RD_SENSOR_CFG_MIN != p_config->samplerate)
+                && (RD_SENSOR_CFG_MAX != p_config->samplerate))
+              || ( (RD_SENSOR_DSP_LAST != p_config->dsp_function)
+                   && (RD_SENSOR_CFG_NO_CHANGE != p_config->dsp_function)))
+    {
+        err_code |= RD_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        // Charge of wakeup at idle current is negligible compared to conversion.
+        p_cost->conversion_us = RI_SHTCX_WAKEUP_US + RI_SHTCX_MEASUREMENT_US;
+        p_cost->charge_nc = (uint32_t) ( ( (uint64_t) RI_SHTCX_ACTIVE_NA
+                                           * RI_SHTCX_MEASUREMENT_TYP_US) / 1000000U);
+        p_cost->sleep_na = RI_SHTCX_SLEEP_NA;
+
+        switch (p_config->mode)
+        {
+            case RD_SENSOR_CFG_DEFAULT:
+            case RD_SENSOR_CFG_NO_CHANGE:
+            case RD_SENSOR_CFG_SLEEP:
+                p_cost->average_na = p_cost->sleep_na;
+                break;
+
+            case RD_SENSOR_CFG_SINGLE:
+            case RD_SENSOR_CFG_CONTINUOUS:
+                p_cost->average_na = rd_sensor_cost_average_na (p_cost,
+                                     RI_SHTCX_COST_INTERVAL_US);
+                break;
+
+            default:
+                err_code |= RD_ERROR_NOT_SUPPORTED;
+                break;
+        }
+    }
+
+    return err_code;
+}
+
 rd_status_t ri_shtcx_data_get (rd_sensor_data_t * const p_data)
 {
     rd_status_t err_code = RD_SUCCESS;
@@ -344,14 +530,18 @@ rd_status_t ri_shtcx_data_get (rd_sensor_data_t * const p_data)
     }
     else
     {
-        if (m_autorefresh)
+        // Collect finished measurement, previous sample is returned until then.
+        if (m_measuring)
+        {
+            err_code |= ri_shtcx_measurement_complete();
+            err_code &= ~RD_ERROR_BUSY;
+        }
+
+        // Start next measurement without waiting for it.
+        if (m_autorefresh && !m_measuring && (RD_SUCCESS == err_code))
         {
-            // Set autorefresh to false to take a single sample
-            m_autorefresh = false;
-            uint8_t mode = RD_SENSOR_CFG_SINGLE;
-            err_code |= ri_shtcx_mode_set (&mode);
-            // Restore autorefresh
-            m_autorefresh = true;
+            uint64_t ready_ms;
+            err_code |= ri_shtcx_measurement_start (&ready_ms);
         }
 
         if ( (RD_SUCCESS == err_code) && (RD_UINT64_INVALID != m_tsample))
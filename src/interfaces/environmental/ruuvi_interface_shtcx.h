@@ -46,6 +46,11 @@
  */
 
 #define RI_SHTCX_WAKEUP_US (240U) //!< Time from wakeup cmd to rdy.
+#define RI_SHTCX_MEASUREMENT_US (12100U) //!< Maximum conversion time in normal mode.
+#define RI_SHTCX_MEASUREMENT_TYP_US (10800U) //!< Typical conversion time in normal mode.
+#define RI_SHTCX_ACTIVE_NA (430000U) //!< Typical current during measurement.
+#define RI_SHTCX_SLEEP_NA (300U) //!< Typical current in sleep.
+#define RI_SHTCX_COST_INTERVAL_US (1000000U) //!< Sample interval assumed by cost estimate.
 
 /** @brief @ref rd_sensor_init_fp */
 rd_status_t ri_shtcx_init (rd_sensor_t *
@@ -68,12 +73,61 @@ rd_status_t ri_shtcx_scale_get (uint8_t * scale);
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_shtcx_dsp_set (uint8_t * dsp, uint8_t * parameter);
 rd_status_t ri_shtcx_dsp_get (uint8_t * dsp, uint8_t * parameter);
-/** @brief @ref rd_sensor_setup_fp */
+/** @brief @ref rd_sensor_setup_fp
+ *
+ * Sensor does not accept commands during conversion. Entering sleep while a
+ * measurement is running waits for the conversion, at most
+ * @ref RI_SHTCX_MEASUREMENT_US, and stores the result as latest sample.
+ */
 rd_status_t ri_shtcx_mode_set (uint8_t *);
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_shtcx_mode_get (uint8_t *);
-/** @brief @ref rd_sensor_data_fp */
+/** @brief @ref rd_sensor_data_fp
+ *
+ * Does not wait for conversion. Collects result of a started measurement
+ * once it is ready, in continuous mode also starts the next measurement.
+ * In continuous mode data is therefore the sample started on previous call,
+ * one polling interval old. Previous sample is returned while conversion is
+ * not ready, e.g. on first call after entering continuous mode.
+ */
 rd_status_t ri_shtcx_data_get (rd_sensor_data_t * const
                                p_data);
+
+/**
+ * @brief Start a measurement without waiting for conversion.
+ *
+ * Wakes the sensor and sends measure command. Collect the result at ready time
+ * with @ref ri_shtcx_measurement_complete or data_get, e.g. from a timer.
+ *
+ * @param[out] p_ready_ms Value of @ref rd_sensor_timestamp_get when result is ready.
+ * @retval RD_SUCCESS if measurement was started.
+ * @retval RD_ERROR_NULL if p_ready_ms is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is not initialized, measurement is running
+ *         or timestamp is not available.
+ * @return Error code from sensor if measurement could not be started.
+ */
+rd_status_t ri_shtcx_measurement_start (uint64_t * const p_ready_ms);
+
+/**
+ * @brief Read result of @ref ri_shtcx_measurement_start and put sensor to sleep.
+ *
+ * Result is available through data_get.
+ *
+ * @retval RD_SUCCESS if result was read.
+ * @retval RD_ERROR_BUSY if conversion is not ready yet.
+ * @retval RD_ERROR_INVALID_STATE if no measurement was started.
+ * @return Error code from sensor if result could not be read.
+ */
+rd_status_t ri_shtcx_measurement_complete (void);
+
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Sensor has no internal samplerate, it samples when application calls
+ * mode_set(RD_SENSOR_CFG_SINGLE) or data_get in continuous mode. Average current
+ * is estimated for one sample per @ref RI_SHTCX_COST_INTERVAL_US.
+ */
+rd_status_t ri_shtcx_cost_get (const rd_sensor_configuration_t * const p_config,
+                               rd_sensor_cost_t * const p_cost);
 /*@}*/
 #endif
\ No newline at end of file
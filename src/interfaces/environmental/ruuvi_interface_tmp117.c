@@ -28,13 +28,29 @@
 #define TMP117_CC_RETRIES_MAX    (5U)
 #define TMP117_CC_RETRY_DELAY_MS (10U)
 
-static uint8_t  m_address;
-static uint16_t ms_per_sample;
-static uint16_t ms_per_cc;
-static float    m_temperature;
-static uint64_t m_timestamp;
 static const char m_sensor_name[] = "TMP117";
-static bool m_continuous = false;
+
+/** @brief Contexts of instances which are not given a context by application. */
+static ri_tmp117_ctx_t m_ctx_pool[RI_TMP117_MAX_INSTANCES];
+/** @brief Context of each instance, NULL if instance is not in use. */
+static ri_tmp117_ctx_t * m_ctx[RI_TMP117_MAX_INSTANCES];
+/** @brief Sensor bound to each instance, NULL if instance is free. */
+static const rd_sensor_t * m_owner[RI_TMP117_MAX_INSTANCES];
+
+static rd_status_t samplerate_get (ri_tmp117_ctx_t * const p_ctx, uint8_t * samplerate);
+static rd_status_t dsp_get (ri_tmp117_ctx_t * const p_ctx, uint8_t * dsp,
+                            uint8_t * parameter);
+
+/**
+ * @brief Get context of an instance.
+ *
+ * Public functions can be called before sensor is initialized, use pool
+ * context of a free instance so that they never dereference NULL.
+ */
+static inline ri_tmp117_ctx_t * instance_ctx (const uint8_t instance)
+{
+    return (NULL == m_ctx[instance]) ? &m_ctx_pool[instance] : m_ctx[instance];
+}
 
 static inline bool param_is_valid (const uint8_t param)
 {
@@ -44,21 +60,21 @@ static inline bool param_is_valid (const uint8_t param)
              || (RD_SENSOR_CFG_NO_CHANGE == param));
 }
 
-static rd_status_t tmp117_soft_reset (void)
+static rd_status_t tmp117_soft_reset (ri_tmp117_ctx_t * const p_ctx)
 {
     uint16_t reset = TMP117_MASK_RESET & 0xFFFF;
-    rd_status_t err_code = ri_i2c_tmp117_write (m_address,
+    rd_status_t err_code = ri_i2c_tmp117_write (p_ctx->address,
                            TMP117_REG_CONFIGURATION,
                            reset);
     ri_delay_ms (TMP117_CC_RESET_DELAY_MS);
     return err_code;
 }
 
-static rd_status_t tmp117_validate_id (void)
+static rd_status_t tmp117_validate_id (ri_tmp117_ctx_t * const p_ctx)
 {
     uint16_t id;
     rd_status_t err_code = RD_SUCCESS;
-    err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_DEVICE_ID, &id);
+    err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_DEVICE_ID, &id);
     id &= TMP117_MASK_ID;
 
     if (TMP117_VALUE_ID != id)
@@ -69,155 +85,170 @@ static rd_status_t tmp117_validate_id (void)
     return err_code;
 }
 
-static inline rd_status_t os_1_set (uint16_t * const reg_val)
+static inline rd_status_t os_1_set (ri_tmp117_ctx_t * const p_ctx,
+                                    uint16_t * const reg_val)
 {
     rd_status_t err_code = RD_SUCCESS;
     *reg_val |= TMP117_VALUE_OS_1;
 
-    if (TMP117_OS_1_TSAMPLE_MS > ms_per_cc)
+    if (TMP117_OS_1_TSAMPLE_MS > p_ctx->ms_per_cc)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
 
-    ms_per_sample = TMP117_OS_1_TSAMPLE_MS;
+    p_ctx->ms_per_sample = TMP117_OS_1_TSAMPLE_MS;
     return err_code;
 }
 
-static inline rd_status_t os_8_set (uint16_t * const reg_val)
+static inline rd_status_t os_8_set (ri_tmp117_ctx_t * const p_ctx,
+                                    uint16_t * const reg_val)
 {
     rd_status_t err_code = RD_SUCCESS;
     *reg_val |= TMP117_VALUE_OS_8;
 
-    if (TMP117_OS_8_TSAMPLE_MS > ms_per_cc)
+    if (TMP117_OS_8_TSAMPLE_MS > p_ctx->ms_per_cc)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
 
-    ms_per_sample = TMP117_OS_8_TSAMPLE_MS;
+    p_ctx->ms_per_sample = TMP117_OS_8_TSAMPLE_MS;
     return err_code;
 }
 
-static inline rd_status_t os_32_set (uint16_t * const reg_val)
+static inline rd_status_t os_32_set (ri_tmp117_ctx_t * const p_ctx,
+                                     uint16_t * const reg_val)
 {
     rd_status_t err_code = RD_SUCCESS;
     *reg_val |= TMP117_VALUE_OS_32;
 
-    if (TMP117_OS_32_TSAMPLE_MS > ms_per_cc)
+    if (TMP117_OS_32_TSAMPLE_MS > p_ctx->ms_per_cc)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
 
-    ms_per_sample = TMP117_OS_32_TSAMPLE_MS;
+    p_ctx->ms_per_sample = TMP117_OS_32_TSAMPLE_MS;
     return err_code;
 }
 
-static inline rd_status_t os_64_set (uint16_t * const reg_val)
+static inline rd_status_t os_64_set (ri_tmp117_ctx_t * const p_ctx,
+                                     uint16_t * const reg_val)
 {
     rd_status_t err_code = RD_SUCCESS;
     *reg_val |= TMP117_VALUE_OS_64;
 
-    if (TMP117_OS_64_TSAMPLE_MS > ms_per_cc)
+    if (TMP117_OS_64_TSAMPLE_MS > p_ctx->ms_per_cc)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
 
-    ms_per_sample = TMP117_OS_64_TSAMPLE_MS;
+    p_ctx->ms_per_sample = TMP117_OS_64_TSAMPLE_MS;
     return err_code;
 }
 
-static rd_status_t tmp117_oversampling_set (const uint8_t num_os)
+static rd_status_t tmp117_oversampling_set (ri_tmp117_ctx_t * const p_ctx,
+                                            const uint8_t num_os)
 {
     uint16_t reg_val;
     rd_status_t err_code = RD_SUCCESS;
-    err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                     &reg_val);
     reg_val &= ~TMP117_MASK_OS;
 
     switch (num_os)
     {
         case TMP117_VALUE_OS_1:
-            reg_val |= os_1_set (&reg_val);
+            reg_val |= os_1_set (p_ctx, &reg_val);
             break;
 
         case TMP117_VALUE_OS_8:
-            reg_val |= os_8_set (&reg_val);
+            reg_val |= os_8_set (p_ctx, &reg_val);
             break;
 
         case TMP117_VALUE_OS_32:
-            reg_val |= os_32_set (&reg_val);
+            reg_val |= os_32_set (p_ctx, &reg_val);
             break;
 
         case TMP117_VALUE_OS_64:
-            reg_val |= os_64_set (&reg_val);
+            reg_val |= os_64_set (p_ctx, &reg_val);
             break;
 
         default:
             err_code |= RD_ERROR_INVALID_PARAM;
     }
 
-    err_code |= ri_i2c_tmp117_write (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_write (p_ctx->address, TMP117_REG_CONFIGURATION,
                                      reg_val);
     return err_code;
 }
 
 static rd_status_t
-tmp117_cc_check (uint16_t * const reg, const uint16_t ts, const uint16_t reg_val)
+tmp117_cc_check (ri_tmp117_ctx_t * const p_ctx, uint16_t * const reg, const uint16_t ts,
+                 const uint16_t reg_val)
 {
     rd_status_t err_code = RD_SUCCESS;
 
-    if (ts < ms_per_sample)
+    if (ts < p_ctx->ms_per_sample)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
     else
     {
         *reg |= reg_val;
-        ms_per_cc = ts;
+        p_ctx->ms_per_cc = ts;
     }
 
     return err_code;
 }
 
-static rd_status_t tmp117_samplerate_set (const uint16_t num_os)
+static rd_status_t tmp117_samplerate_set (ri_tmp117_ctx_t * const p_ctx,
+                                          const uint16_t num_os)
 {
     uint16_t reg_val;
     rd_status_t err_code = RD_SUCCESS;
-    err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                     &reg_val);
     reg_val &= ~TMP117_MASK_CC;
 
     switch (num_os)
     {
         case TMP117_VALUE_CC_16_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_16_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_16_MS);
             break;
 
         case TMP117_VALUE_CC_125_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_125_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_125_MS);
             break;
 
         case TMP117_VALUE_CC_250_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_250_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_250_MS);
             break;
 
         case TMP117_VALUE_CC_500_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_500_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_500_MS);
             break;
 
         case TMP117_VALUE_CC_1000_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_1000_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_1000_MS);
             break;
 
         case TMP117_VALUE_CC_4000_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_4000_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_4000_MS);
             break;
 
         case TMP117_VALUE_CC_8000_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_8000_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_8000_MS);
             break;
 
         case TMP117_VALUE_CC_16000_MS:
-            err_code |= tmp117_cc_check (&reg_val, ms_per_sample, TMP117_VALUE_CC_16000_MS);
+            err_code |= tmp117_cc_check (p_ctx, &reg_val, p_ctx->ms_per_sample,
+                                         TMP117_VALUE_CC_16000_MS);
             break;
 
         default:
@@ -225,55 +256,55 @@ static rd_status_t tmp117_samplerate_set (const uint16_t num_os)
             break;
     }
 
-    err_code |= ri_i2c_tmp117_write (m_address, TMP117_REG_CONFIGURATION, reg_val);
+    err_code |= ri_i2c_tmp117_write (p_ctx->address, TMP117_REG_CONFIGURATION, reg_val);
     return err_code;
 }
 
-static rd_status_t tmp117_sleep (void)
+static rd_status_t tmp117_sleep (ri_tmp117_ctx_t * const p_ctx)
 {
     uint16_t reg_val;
     rd_status_t err_code;
-    err_code = ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+    err_code = ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                    &reg_val);
     reg_val &= ~TMP117_MASK_MODE;
     reg_val |= TMP117_VALUE_MODE_SLEEP;
-    err_code |= ri_i2c_tmp117_write (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_write (p_ctx->address, TMP117_REG_CONFIGURATION,
                                      reg_val);
     return  err_code;
 }
 
-static rd_status_t tmp117_sample (void)
+static rd_status_t tmp117_sample (ri_tmp117_ctx_t * const p_ctx)
 {
     uint16_t reg_val = 0;
     rd_status_t err_code = RD_SUCCESS;
-    err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                     &reg_val);
     reg_val &= ~TMP117_MASK_MODE;
     reg_val |= TMP117_VALUE_MODE_SINGLE;
-    err_code |= ri_i2c_tmp117_write (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_write (p_ctx->address, TMP117_REG_CONFIGURATION,
                                      reg_val);
-    m_timestamp = rd_sensor_timestamp_get();
+    p_ctx->timestamp = rd_sensor_timestamp_get();
     return  err_code;
 }
 
-static rd_status_t tmp117_continuous (void)
+static rd_status_t tmp117_continuous (ri_tmp117_ctx_t * const p_ctx)
 {
     uint16_t reg_val;
     rd_status_t err_code;
-    err_code = ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+    err_code = ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                    &reg_val);
     reg_val &= ~TMP117_MASK_MODE;
     reg_val |= TMP117_VALUE_MODE_CONT;
-    err_code |= ri_i2c_tmp117_write (m_address, TMP117_REG_CONFIGURATION,
+    err_code |= ri_i2c_tmp117_write (p_ctx->address, TMP117_REG_CONFIGURATION,
                                      reg_val);
     return  err_code;
 }
 
-static rd_status_t tmp117_read (float * const temperature)
+static rd_status_t tmp117_read (ri_tmp117_ctx_t * const p_ctx, float * const temperature)
 {
     uint16_t reg_val;
     rd_status_t err_code;
-    err_code = ri_i2c_tmp117_read (m_address, TMP117_REG_TEMP_RESULT, &reg_val);
+    err_code = ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_TEMP_RESULT, &reg_val);
     int32_t dec_temperature;
 
     if (reg_val > 0x7FFFU)
@@ -295,90 +326,7 @@ static rd_status_t tmp117_read (float * const temperature)
     return err_code;
 }
 
-rd_status_t
-ri_tmp117_init (rd_sensor_t * environmental_sensor, rd_bus_t bus, uint8_t handle)
-{
-    rd_status_t err_code = RD_SUCCESS;
-
-    if (NULL == environmental_sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-    }
-    else if (rd_sensor_is_init (environmental_sensor))
-    {
-        err_code |= RD_ERROR_INVALID_STATE;
-    }
-    else
-    {
-        rd_sensor_initialize (environmental_sensor);
-        environmental_sensor->name = m_sensor_name;
-        err_code = RD_SUCCESS;
-        m_address = handle;
-
-        if (RD_BUS_I2C == bus)
-        {
-            err_code |= tmp117_validate_id();
-        }
-        else
-        {
-            err_code |=  RD_ERROR_INVALID_PARAM;
-        }
-
-        if (RD_SUCCESS == err_code)
-        {
-            err_code |= tmp117_soft_reset();
-            environmental_sensor->init              = ri_tmp117_init;
-            environmental_sensor->uninit            = ri_tmp117_uninit;
-            environmental_sensor->samplerate_set    = ri_tmp117_samplerate_set;
-            environmental_sensor->samplerate_get    = ri_tmp117_samplerate_get;
-            environmental_sensor->resolution_set    = ri_tmp117_resolution_set;
-            environmental_sensor->resolution_get    = ri_tmp117_resolution_get;
-            environmental_sensor->scale_set         = ri_tmp117_scale_set;
-            environmental_sensor->scale_get         = ri_tmp117_scale_get;
-            environmental_sensor->dsp_set           = ri_tmp117_dsp_set;
-            environmental_sensor->dsp_get           = ri_tmp117_dsp_get;
-            environmental_sensor->mode_set          = ri_tmp117_mode_set;
-            environmental_sensor->mode_get          = ri_tmp117_mode_get;
-            environmental_sensor->data_get          = ri_tmp117_data_get;
-            environmental_sensor->configuration_set = rd_sensor_configuration_set;
-            environmental_sensor->configuration_get = rd_sensor_configuration_get;
-            environmental_sensor->provides.datas.temperature_c = 1;
-            m_timestamp = RD_UINT64_INVALID;
-            m_temperature = NAN;
-            ms_per_cc = 1000;
-            ms_per_sample = TMP117_OS_8_TSAMPLE_MS; //!< default OS setting
-            m_continuous = false;
-        }
-    }
-
-    return err_code;
-}
-
-rd_status_t ri_tmp117_uninit (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
-{
-    UNUSED_VARIABLE (bus);
-    UNUSED_VARIABLE (handle);
-    rd_status_t err_code = RD_SUCCESS;
-
-    if (NULL == sensor)
-    {
-        err_code |= RD_ERROR_NULL;
-    }
-    else
-    {
-        tmp117_sleep();
-        rd_sensor_uninitialize (sensor);
-        m_timestamp = RD_UINT64_INVALID;
-        m_temperature = NAN;
-        m_address = 0;
-        m_continuous = false;
-    }
-
-    return err_code;
-}
-
-
-rd_status_t ri_tmp117_samplerate_set (uint8_t * samplerate)
+static rd_status_t samplerate_set (ri_tmp117_ctx_t * const p_ctx, uint8_t * samplerate)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -386,54 +334,54 @@ rd_status_t ri_tmp117_samplerate_set (uint8_t * samplerate)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (m_continuous)
+    else if (p_ctx->continuous)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
     else if (RD_SENSOR_CFG_NO_CHANGE == *samplerate)
     {
-        err_code |= ri_tmp117_samplerate_get (samplerate);
+        err_code |= samplerate_get (p_ctx, samplerate);
     }
     else if ( (RD_SENSOR_CFG_DEFAULT == *samplerate)
               || (1 >= *samplerate))
     {
         *samplerate = 1;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_1000_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_1000_MS);
     }
     else if (2 >= *samplerate)
     {
         *samplerate = 2;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_500_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_500_MS);
     }
     else if (4 >= *samplerate)
     {
         *samplerate = 4;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_250_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_250_MS);
     }
     else if (8 >= *samplerate)
     {
         *samplerate = 8;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_125_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_125_MS);
     }
     else if (64 >= *samplerate ||
              RD_SENSOR_CFG_MAX == *samplerate)
     {
         *samplerate = 64;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_16_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_16_MS);
     }
     else if (RD_SENSOR_CFG_CUSTOM_1 == *samplerate)
     {
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_4000_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_4000_MS);
     }
     else if (RD_SENSOR_CFG_CUSTOM_2 == *samplerate)
     {
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_8000_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_8000_MS);
     }
     else if (RD_SENSOR_CFG_CUSTOM_3 == *samplerate ||
              RD_SENSOR_CFG_MIN == *samplerate)
     {
         *samplerate = RD_SENSOR_CFG_CUSTOM_3;
-        err_code |= tmp117_samplerate_set (TMP117_VALUE_CC_16000_MS);
+        err_code |= tmp117_samplerate_set (p_ctx, TMP117_VALUE_CC_16000_MS);
     }
     else
     {
@@ -443,7 +391,7 @@ rd_status_t ri_tmp117_samplerate_set (uint8_t * samplerate)
     return  err_code;
 }
 
-rd_status_t ri_tmp117_samplerate_get (uint8_t * samplerate)
+static rd_status_t samplerate_get (ri_tmp117_ctx_t * const p_ctx, uint8_t * samplerate)
 {
     rd_status_t err_code = RD_SUCCESS;
     uint16_t reg_val = 0;
@@ -454,7 +402,7 @@ rd_status_t ri_tmp117_samplerate_get (uint8_t * samplerate)
     }
     else
     {
-        err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+        err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                         &reg_val);
         reg_val &= TMP117_MASK_CC;
 
@@ -500,7 +448,7 @@ rd_status_t ri_tmp117_samplerate_get (uint8_t * samplerate)
     return err_code;
 }
 
-rd_status_t ri_tmp117_resolution_set (uint8_t * resolution)
+static rd_status_t resolution_set (ri_tmp117_ctx_t * const p_ctx, uint8_t * resolution)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -508,7 +456,7 @@ rd_status_t ri_tmp117_resolution_set (uint8_t * resolution)
     {
         err_code |=  RD_ERROR_NULL;
     }
-    else if (m_continuous)
+    else if (p_ctx->continuous)
     {
         err_code |=  RD_ERROR_INVALID_STATE;
     }
@@ -540,7 +488,7 @@ rd_status_t ri_tmp117_resolution_get (uint8_t * resolution)
     return err_code;
 }
 
-rd_status_t ri_tmp117_scale_set (uint8_t * scale)
+static rd_status_t scale_set (ri_tmp117_ctx_t * const p_ctx, uint8_t * scale)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -548,7 +496,7 @@ rd_status_t ri_tmp117_scale_set (uint8_t * scale)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (m_continuous)
+    else if (p_ctx->continuous)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -580,7 +528,8 @@ rd_status_t ri_tmp117_scale_get (uint8_t * scale)
     return err_code;
 }
 
-rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_set (ri_tmp117_ctx_t * const p_ctx, uint8_t * dsp,
+                            uint8_t * parameter)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -588,7 +537,7 @@ rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (m_continuous)
+    else if (p_ctx->continuous)
     {
         err_code |= RD_ERROR_INVALID_STATE;
     }
@@ -596,12 +545,12 @@ rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
     {
         if (RD_SENSOR_CFG_NO_CHANGE == * dsp)
         {
-            err_code |= ri_tmp117_dsp_get (dsp, parameter);
+            err_code |= dsp_get (p_ctx, dsp, parameter);
         }
         else if ( (RD_SENSOR_DSP_LAST == *dsp)
                   || (RD_SENSOR_CFG_DEFAULT == *dsp))
         {
-            err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_1);
+            err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_1);
             *parameter = 1;
         }
         else if (RD_SENSOR_DSP_OS == *dsp)
@@ -609,32 +558,32 @@ rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
             if (1 >= *parameter)
             {
                 *parameter = 1;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_1);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_1);
             }
             else if (8 >= *parameter)
             {
                 *parameter = 8;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_8);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_8);
             }
             else if (32 >= *parameter)
             {
                 *parameter = 32;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_32);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_32);
             }
             else if (64 >= *parameter)
             {
                 *parameter = 64;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_64);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_64);
             }
             else if (RD_SENSOR_CFG_MIN == *parameter)
             {
                 *parameter = 8;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_8);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_8);
             }
             else if (RD_SENSOR_CFG_MAX == *parameter)
             {
                 *parameter = 64;
-                err_code |= tmp117_oversampling_set (TMP117_VALUE_OS_64);
+                err_code |= tmp117_oversampling_set (p_ctx, TMP117_VALUE_OS_64);
             }
             else
             {
@@ -650,7 +599,8 @@ rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
     return err_code;
 }
 
-rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter)
+static rd_status_t dsp_get (ri_tmp117_ctx_t * const p_ctx, uint8_t * dsp,
+                            uint8_t * parameter)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -661,7 +611,7 @@ rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter)
     else
     {
         uint16_t reg_val = 0;
-        err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION,
+        err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION,
                                         &reg_val);
         reg_val &= TMP117_MASK_OS;
 
@@ -670,25 +620,25 @@ rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter)
             case TMP117_VALUE_OS_1:
                 *dsp = RD_SENSOR_DSP_LAST;
                 *parameter = 1;
-                ms_per_sample = TMP117_OS_1_TSAMPLE_MS;
+                p_ctx->ms_per_sample = TMP117_OS_1_TSAMPLE_MS;
                 break;
 
             case TMP117_VALUE_OS_8:
                 *dsp = RD_SENSOR_DSP_OS;
                 *parameter = 8;
-                ms_per_sample = TMP117_OS_8_TSAMPLE_MS;
+                p_ctx->ms_per_sample = TMP117_OS_8_TSAMPLE_MS;
                 break;
 
             case TMP117_VALUE_OS_32:
                 *dsp = RD_SENSOR_DSP_OS;
                 *parameter = 32;
-                ms_per_sample = TMP117_OS_32_TSAMPLE_MS;
+                p_ctx->ms_per_sample = TMP117_OS_32_TSAMPLE_MS;
                 break;
 
             case TMP117_VALUE_OS_64:
                 *dsp = RD_SENSOR_DSP_OS;
                 *parameter = 64;
-                ms_per_sample = TMP117_OS_64_TSAMPLE_MS;
+                p_ctx->ms_per_sample = TMP117_OS_64_TSAMPLE_MS;
                 break;
 
             default:
@@ -699,17 +649,18 @@ rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter)
     return err_code;
 }
 
-static rd_status_t tmp117_poll_drdy (bool * const drdy)
+static rd_status_t tmp117_poll_drdy (ri_tmp117_ctx_t * const p_ctx, bool * const drdy)
 {
     rd_status_t err_code = RD_SUCCESS;
     uint16_t cfg = 0;
-    err_code |= ri_i2c_tmp117_read (m_address, TMP117_REG_CONFIGURATION, &cfg);
+    err_code |= ri_i2c_tmp117_read (p_ctx->address, TMP117_REG_CONFIGURATION, &cfg);
     cfg &= TMP117_MASK_DRDY;
     *drdy = (cfg != 0);
     return err_code;
 }
 
-static rd_status_t tmp117_wait_for_sample (const uint16_t initial_delay_ms)
+static rd_status_t tmp117_wait_for_sample (ri_tmp117_ctx_t * const p_ctx,
+                                           const uint16_t initial_delay_ms)
 {
     rd_status_t err_code = RD_SUCCESS;
     bool drdy = false;
@@ -718,7 +669,7 @@ static rd_status_t tmp117_wait_for_sample (const uint16_t initial_delay_ms)
 
     while ( (RD_SUCCESS == err_code) && (!drdy) && (retries <= TMP117_CC_RETRIES_MAX))
     {
-        err_code |= tmp117_poll_drdy (&drdy);
+        err_code |= tmp117_poll_drdy (p_ctx, &drdy);
 
         if (!drdy)
         {
@@ -736,27 +687,27 @@ static rd_status_t tmp117_wait_for_sample (const uint16_t initial_delay_ms)
 }
 
 static rd_status_t __attribute__ ( (nonnull))
-tmp117_take_single_sample (uint8_t * const mode)
+tmp117_take_single_sample (ri_tmp117_ctx_t * const p_ctx, uint8_t * const mode)
 {
     rd_status_t err_code = RD_SUCCESS;
 
-    if (m_continuous)
+    if (p_ctx->continuous)
     {
         err_code |= RD_ERROR_INVALID_STATE;
         *mode = RD_SENSOR_CFG_CONTINUOUS;
     }
     else
     {
-        err_code |= tmp117_sample ();
+        err_code |= tmp117_sample (p_ctx);
 
         if (RD_SUCCESS == err_code)
         {
-            err_code |= tmp117_wait_for_sample (ms_per_sample);
+            err_code |= tmp117_wait_for_sample (p_ctx, p_ctx->ms_per_sample);
         }
 
         if (RD_SUCCESS == err_code)
         {
-            err_code |= tmp117_read (&m_temperature);
+            err_code |= tmp117_read (p_ctx, &p_ctx->temperature);
         }
 
         *mode = RD_SENSOR_CFG_SLEEP;
@@ -765,7 +716,7 @@ tmp117_take_single_sample (uint8_t * const mode)
     return err_code;
 }
 
-rd_status_t ri_tmp117_mode_set (uint8_t * mode)
+static rd_status_t mode_set (ri_tmp117_ctx_t * const p_ctx, uint8_t * mode)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -778,17 +729,19 @@ rd_status_t ri_tmp117_mode_set (uint8_t * mode)
         switch (*mode)
         {
             case RD_SENSOR_CFG_CONTINUOUS:
-                err_code |= tmp117_continuous();
-                m_continuous = true;
+                err_code |= tmp117_continuous (p_ctx);
+                p_ctx->continuous = true;
                 break;
 
             case RD_SENSOR_CFG_SINGLE:
-                err_code |= tmp117_take_single_sample (mode);
+                err_code |= tmp117_take_single_sample (p_ctx, mode);
+                p_ctx->measuring = false;
                 break;
 
             case RD_SENSOR_CFG_SLEEP:
-                err_code |= tmp117_sleep();
-                m_continuous = false;
+                err_code |= tmp117_sleep (p_ctx);
+                p_ctx->continuous = false;
+                p_ctx->measuring = false;
                 break;
 
             default:
@@ -800,7 +753,7 @@ rd_status_t ri_tmp117_mode_set (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_tmp117_mode_get (uint8_t * mode)
+static rd_status_t mode_get (ri_tmp117_ctx_t * const p_ctx, uint8_t * mode)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -808,7 +761,7 @@ rd_status_t ri_tmp117_mode_get (uint8_t * mode)
     {
         err_code |= RD_ERROR_NULL;
     }
-    else if (m_continuous)
+    else if (p_ctx->continuous)
     {
         *mode = RD_SENSOR_CFG_CONTINUOUS;
     }
@@ -820,7 +773,82 @@ rd_status_t ri_tmp117_mode_get (uint8_t * mode)
     return err_code;
 }
 
-rd_status_t ri_tmp117_data_get (rd_sensor_data_t * const data)
+static rd_status_t measurement_start (ri_tmp117_ctx_t * const p_ctx,
+                                      uint64_t * const p_ready_ms)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_ready_ms)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (p_ctx->continuous || p_ctx->measuring)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        // Previous sample stays valid until result is collected.
+        const uint64_t previous = p_ctx->timestamp;
+        err_code |= tmp117_sample (p_ctx);
+        p_ctx->measure_start = p_ctx->timestamp;
+        p_ctx->timestamp = previous;
+
+        if ( (RD_SUCCESS == err_code) && (RD_UINT64_INVALID == p_ctx->measure_start))
+        {
+            // Ready time is unknown. One-shot conversion ends in shutdown by itself.
+            err_code |= RD_ERROR_INVALID_STATE;
+        }
+        else if (RD_SUCCESS == err_code)
+        {
+            p_ctx->ready_ms = p_ctx->measure_start + p_ctx->ms_per_sample;
+            p_ctx->measuring = true;
+            *p_ready_ms = p_ctx->ready_ms;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t measurement_complete (ri_tmp117_ctx_t * const p_ctx)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    bool drdy = false;
+
+    if (!p_ctx->measuring)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (rd_sensor_timestamp_get() < p_ctx->ready_ms)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else
+    {
+        err_code |= tmp117_poll_drdy (p_ctx, &drdy);
+
+        if ( (RD_SUCCESS == err_code) && !drdy)
+        {
+            // Oscillator of sensor may run slower than nominal.
+            err_code |= RD_ERROR_BUSY;
+        }
+        else
+        {
+            // Sensor returns to shutdown after one-shot conversion.
+            p_ctx->measuring = false;
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= tmp117_read (p_ctx, &p_ctx->temperature);
+            p_ctx->timestamp = p_ctx->measure_start;
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t data_get (ri_tmp117_ctx_t * const p_ctx, rd_sensor_data_t * const data)
 {
     rd_status_t err_code = RD_SUCCESS;
 
@@ -829,21 +857,457 @@ rd_status_t ri_tmp117_data_get (rd_sensor_data_t * const data)
         err_code |= RD_ERROR_NULL;
     }
 
-    if (m_continuous)
+    // Collect split-phase result if ready, previous sample is returned until then.
+    if (p_ctx->measuring)
+    {
+        err_code |= measurement_complete (p_ctx);
+        err_code &= ~RD_ERROR_BUSY;
+    }
+
+    if (p_ctx->continuous)
     {
-        err_code |= tmp117_read (&m_temperature);
-        m_timestamp = rd_sensor_timestamp_get();
+        err_code |= tmp117_read (p_ctx, &p_ctx->temperature);
+        p_ctx->timestamp = rd_sensor_timestamp_get();
     }
 
-    if ( (RD_SUCCESS == err_code) && (RD_UINT64_INVALID != m_timestamp)
-            && !isnan (m_temperature))
+    if ( (RD_SUCCESS == err_code) && (RD_UINT64_INVALID != p_ctx->timestamp)
+            && !isnan (p_ctx->temperature))
     {
         rd_sensor_data_fields_t env_fields = {.bitfield = 0};
         env_fields.datas.temperature_c = 1;
         rd_sensor_data_set (data,
                             env_fields,
-                            m_temperature);
-        data->timestamp_ms = m_timestamp;
+                            p_ctx->temperature);
+        data->timestamp_ms = p_ctx->timestamp;
+    }
+
+    return err_code;
+}
+
+/** @brief Cycle time of samplerate in us, 0 if samplerate is not supported. */
+static uint32_t tmp117_cycle_us (const uint8_t samplerate)
+{
+    uint32_t cycle_us = 0;
+
+    if ( (RD_SENSOR_CFG_DEFAULT == samplerate) || (RD_SENSOR_CFG_NO_CHANGE == samplerate)
+            || (1U >= samplerate))
+    {
+        cycle_us = 1000000U;
+    }
+    else if (2U >= samplerate)
+    {
+        cycle_us = 500000U;
+    }
+    else if (4U >= samplerate)
+    {
+        cycle_us = 250000U;
+    }
+    else if (8U >= samplerate)
+    {
+        cycle_us = 125000U;
+    }
+    else if ( (64U >= samplerate) || (RD_SENSOR_CFG_MAX == samplerate))
+    {
+        cycle_us = 15500U;
+    }
+    else if (RD_SENSOR_CFG_CUSTOM_1 == samplerate)
+    {
+        cycle_us = 4000000U;
+    }
+    else if (RD_SENSOR_CFG_CUSTOM_2 == samplerate)
+    {
+        cycle_us = 8000000U;
+    }
+    else if ( (RD_SENSOR_CFG_CUSTOM_3 == samplerate) || (RD_SENSOR_CFG_MIN == samplerate))
+    {
+        cycle_us = 16000000U;
+    }
+    else
+    {
+        // Not supported.
+    }
+
+    return cycle_us;
+}
+
+/** @brief Number of averaged conversions, 0 if DSP is not supported. */
+static uint8_t tmp117_averages (const uint8_t dsp, const uint8_t parameter)
+{
+    uint8_t averages = 0;
+
+    if ( (RD_SENSOR_DSP_LAST == dsp) || (RD_SENSOR_CFG_NO_CHANGE == dsp))
+    {
+        averages = 1U;
+    }
+    else if (RD_SENSOR_DSP_OS != dsp)
+    {
+        // Not supported.
+    }
+    else if (1U >= parameter)
+    {
+        averages = 1U;
+    }
+    else if ( (8U >= parameter) || (RD_SENSOR_CFG_MIN == parameter))
+    {
+        averages = 8U;
+    }
+    else if (32U >= parameter)
+    {
+        averages = 32U;
+    }
+    else if ( (64U >= parameter) || (RD_SENSOR_CFG_MAX == parameter))
+    {
+        averages = 64U;
+    }
+    else
+    {
+        // Not supported.
+    }
+
+    return averages;
+}
+
+rd_status_t ri_tmp117_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_config) || (NULL == p_cost))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        const uint32_t cycle_us = tmp117_cycle_us (p_config->samplerate);
+        const uint8_t averages = tmp117_averages (p_config->dsp_function,
+                                 p_config->dsp_parameter);
+
+        if ( (0U == cycle_us) || (0U == averages))
+        {
+            err_code |= RD_ERROR_NOT_SUPPORTED;
+        }
+        else
+        {
+            rd_sensor_cost_t standby;
+            const uint32_t active_us = averages * TMP117_CONVERSION_US;
+            p_cost->conversion_us = active_us;
+            p_cost->charge_nc = (uint32_t) ( ( (uint64_t) TMP117_ACTIVE_NA * active_us)
+                                             / 1000000U);
+            p_cost->sleep_na = TMP117_SHUTDOWN_NA;
+
+            switch (p_config->mode)
+            {
+                case RD_SENSOR_CFG_DEFAULT:
+                case RD_SENSOR_CFG_NO_CHANGE:
+                case RD_SENSOR_CFG_SLEEP:
+                    p_cost->average_na = p_cost->sleep_na;
+                    break;
+
+                case RD_SENSOR_CFG_SINGLE:
+                    p_cost->average_na = rd_sensor_cost_average_na (p_cost, cycle_us);
+                    break;
+
+                case RD_SENSOR_CFG_CONTINUOUS:
+                    // Sensor stays in standby between conversions of cycle.
+                    standby = *p_cost;
+                    standby.sleep_na = TMP117_STANDBY_NA;
+                    p_cost->average_na = rd_sensor_cost_average_na (&standby, cycle_us);
+                    break;
+
+                default:
+                    err_code |= RD_ERROR_NOT_SUPPORTED;
+                    break;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_tmp117_samplerate_set (uint8_t * samplerate)
+{
+    return samplerate_set (instance_ctx (0U), samplerate);
+}
+
+rd_status_t ri_tmp117_samplerate_get (uint8_t * samplerate)
+{
+    return samplerate_get (instance_ctx (0U), samplerate);
+}
+
+rd_status_t ri_tmp117_resolution_set (uint8_t * resolution)
+{
+    return resolution_set (instance_ctx (0U), resolution);
+}
+
+rd_status_t ri_tmp117_scale_set (uint8_t * scale)
+{
+    return scale_set (instance_ctx (0U), scale);
+}
+
+rd_status_t ri_tmp117_dsp_set (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_set (instance_ctx (0U), dsp, parameter);
+}
+
+rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter)
+{
+    return dsp_get (instance_ctx (0U), dsp, parameter);
+}
+
+rd_status_t ri_tmp117_mode_set (uint8_t * mode)
+{
+    return mode_set (instance_ctx (0U), mode);
+}
+
+rd_status_t ri_tmp117_mode_get (uint8_t * mode)
+{
+    return mode_get (instance_ctx (0U), mode);
+}
+
+rd_status_t ri_tmp117_data_get (rd_sensor_data_t * const data)
+{
+    return data_get (instance_ctx (0U), data);
+}
+
+rd_status_t ri_tmp117_measurement_start (uint64_t * const p_ready_ms)
+{
+    return measurement_start (instance_ctx (0U), p_ready_ms);
+}
+
+rd_status_t ri_tmp117_measurement_complete (void)
+{
+    return measurement_complete (instance_ctx (0U));
+}
+
+/** @brief Functions of an instance. Resolution and scale are fixed and shared. */
+typedef struct
+{
+    rd_sensor_setup_fp samplerate_set;
+    rd_sensor_setup_fp samplerate_get;
+    rd_sensor_setup_fp resolution_set;
+    rd_sensor_setup_fp scale_set;
+    rd_sensor_dsp_fp   dsp_set;
+    rd_sensor_dsp_fp   dsp_get;
+    rd_sensor_setup_fp mode_set;
+    rd_sensor_setup_fp mode_get;
+    rd_sensor_data_fp  data_get;
+    rd_sensor_measurement_start_fp measurement_start;
+    rd_sensor_measurement_complete_fp measurement_complete;
+} tmp117_api_t;
+
+/** @brief Define functions of instance n, public functions are instance 0. */
+#define TMP117_INSTANCE_DEFINE(n)                                                 \
+    RD_SENSOR_SETUP_BIND (samplerate_set_##n, samplerate_set, instance_ctx (n)) \
+    RD_SENSOR_SETUP_BIND (samplerate_get_##n, samplerate_get, instance_ctx (n)) \
+    RD_SENSOR_SETUP_BIND (resolution_set_##n, resolution_set, instance_ctx (n)) \
+    RD_SENSOR_SETUP_BIND (scale_set_##n, scale_set, instance_ctx (n))           \
+    RD_SENSOR_DSP_BIND (dsp_set_##n, dsp_set, instance_ctx (n))                 \
+    RD_SENSOR_DSP_BIND (dsp_get_##n, dsp_get, instance_ctx (n))                 \
+    RD_SENSOR_SETUP_BIND (mode_set_##n, mode_set, instance_ctx (n))             \
+    RD_SENSOR_SETUP_BIND (mode_get_##n, mode_get, instance_ctx (n))             \
+    RD_SENSOR_DATA_BIND (data_get_##n, data_get, instance_ctx (n))             \
+    RD_SENSOR_MEASUREMENT_START_BIND (measurement_start_##n, measurement_start, \
+                                      instance_ctx (n))                         \
+    RD_SENSOR_MEASUREMENT_COMPLETE_BIND (measurement_complete_##n,              \
+                                         measurement_complete, instance_ctx (n))
+
+/** @brief Functions of instance n defined by @ref TMP117_INSTANCE_DEFINE. */
+#define TMP117_INSTANCE_API(n)                                                    \
+    {                                                                             \
+        samplerate_set_##n, samplerate_get_##n, resolution_set_##n, scale_set_##n, \
+        dsp_set_##n, dsp_get_##n, mode_set_##n, mode_get_##n, data_get_##n,       \
+        measurement_start_##n, measurement_complete_##n                           \
+    }
+
+#if RI_TMP117_MAX_INSTANCES > 4
+#   error "Over 4 instances of TMP117 is not supported"
+#endif
+#if RI_TMP117_MAX_INSTANCES > 1
+TMP117_INSTANCE_DEFINE (1)
+#endif
+#if RI_TMP117_MAX_INSTANCES > 2
+TMP117_INSTANCE_DEFINE (2)
+#endif
+#if RI_TMP117_MAX_INSTANCES > 3
+TMP117_INSTANCE_DEFINE (3)
+#endif
+
+static const tmp117_api_t m_api[RI_TMP117_MAX_INSTANCES] =
+{
+    {
+        ri_tmp117_samplerate_set, ri_tmp117_samplerate_get, ri_tmp117_resolution_set,
+        ri_tmp117_scale_set, ri_tmp117_dsp_set, ri_tmp117_dsp_get,
+        ri_tmp117_mode_set, ri_tmp117_mode_get, ri_tmp117_data_get,
+        ri_tmp117_measurement_start, ri_tmp117_measurement_complete
+    },
+#if RI_TMP117_MAX_INSTANCES > 1
+    TMP117_INSTANCE_API (1),
+#endif
+#if RI_TMP117_MAX_INSTANCES > 2
+    TMP117_INSTANCE_API (2),
+#endif
+#if RI_TMP117_MAX_INSTANCES > 3
+    TMP117_INSTANCE_API (3),
+#endif
+};
+
+/**
+ * @brief Find instance bound to sensor or a free instance.
+ *
+ * @param[in] p_sensor Sensor to look up.
+ * @return Index of instance of sensor if it has one, otherwise index of
+ *         first free instance. @ref RI_TMP117_MAX_INSTANCES if none is found.
+ */
+static uint8_t instance_find (const rd_sensor_t * const p_sensor)
+{
+    uint8_t own = RI_TMP117_MAX_INSTANCES;
+    uint8_t free = RI_TMP117_MAX_INSTANCES;
+
+    for (uint8_t ii = 0; ii < RI_TMP117_MAX_INSTANCES; ii++)
+    {
+        if (p_sensor == m_owner[ii])
+        {
+            own = ii;
+        }
+        else if ( (NULL == m_owner[ii]) && (RI_TMP117_MAX_INSTANCES == free))
+        {
+            free = ii;
+        }
+        else
+        {
+            // Instance belongs to other sensor.
+        }
+    }
+
+    return (RI_TMP117_MAX_INSTANCES == own) ? free : own;
+}
+
+rd_status_t
+ri_tmp117_init (rd_sensor_t * environmental_sensor, rd_bus_t bus, uint8_t handle)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t instance = RI_TMP117_MAX_INSTANCES;
+
+    if (NULL == environmental_sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (rd_sensor_is_init (environmental_sensor))
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        instance = instance_find (environmental_sensor);
+    }
+
+    if (RD_SUCCESS != err_code)
+    {
+        // Nothing to do.
+    }
+    else if (RI_TMP117_MAX_INSTANCES <= instance)
+    {
+        err_code |= RD_ERROR_RESOURCES;
+    }
+    else
+    {
+        // Instance stays bound on error so that uninit can release it.
+        if (NULL == environmental_sensor->p_ctx)
+        {
+            environmental_sensor->p_ctx = &m_ctx_pool[instance];
+        }
+
+        m_owner[instance] = environmental_sensor;
+        m_ctx[instance] = environmental_sensor->p_ctx;
+        ri_tmp117_ctx_t * const p_ctx = m_ctx[instance];
+        const tmp117_api_t * const p_api = &m_api[instance];
+        rd_sensor_initialize (environmental_sensor);
+        environmental_sensor->name = m_sensor_name;
+        err_code = RD_SUCCESS;
+        p_ctx->address = handle;
+
+        if (RD_BUS_I2C == bus)
+        {
+            err_code |= tmp117_validate_id (p_ctx);
+        }
+        else
+        {
+            err_code |=  RD_ERROR_INVALID_PARAM;
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= tmp117_soft_reset (p_ctx);
+            environmental_sensor->init              = ri_tmp117_init;
+            environmental_sensor->uninit            = ri_tmp117_uninit;
+            environmental_sensor->samplerate_set    = p_api->samplerate_set;
+            environmental_sensor->samplerate_get    = p_api->samplerate_get;
+            environmental_sensor->resolution_set    = p_api->resolution_set;
+            environmental_sensor->resolution_get    = ri_tmp117_resolution_get;
+            environmental_sensor->scale_set         = p_api->scale_set;
+            environmental_sensor->scale_get         = ri_tmp117_scale_get;
+            environmental_sensor->dsp_set           = p_api->dsp_set;
+            environmental_sensor->dsp_get           = p_api->dsp_get;
+            environmental_sensor->mode_set          = p_api->mode_set;
+            environmental_sensor->mode_get          = p_api->mode_get;
+            environmental_sensor->data_get          = p_api->data_get;
+            environmental_sensor->measurement_start    = p_api->measurement_start;
+            environmental_sensor->measurement_complete = p_api->measurement_complete;
+            environmental_sensor->cost_get          = ri_tmp117_cost_get;
+            environmental_sensor->configuration_set = rd_sensor_configuration_set;
+            environmental_sensor->configuration_get = rd_sensor_configuration_get;
+            environmental_sensor->provides.datas.temperature_c = 1;
+            p_ctx->timestamp = RD_UINT64_INVALID;
+            p_ctx->temperature = NAN;
+            p_ctx->ms_per_cc = 1000;
+            p_ctx->ms_per_sample = TMP117_OS_8_TSAMPLE_MS; //!< default OS setting
+            p_ctx->continuous = false;
+            p_ctx->measuring = false;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_tmp117_uninit (rd_sensor_t * sensor, rd_bus_t bus, uint8_t handle)
+{
+    UNUSED_VARIABLE (bus);
+    UNUSED_VARIABLE (handle);
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == sensor)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        const uint8_t instance = instance_find (sensor);
+        const bool owned = (RI_TMP117_MAX_INSTANCES > instance)
+                           && (sensor == m_owner[instance]);
+
+        if (owned)
+        {
+            ri_tmp117_ctx_t * const p_ctx = m_ctx[instance];
+            tmp117_sleep (p_ctx);
+            rd_sensor_uninitialize (sensor);
+            p_ctx->timestamp = RD_UINT64_INVALID;
+            p_ctx->temperature = NAN;
+            p_ctx->address = 0;
+            p_ctx->continuous = false;
+            p_ctx->measuring = false;
+
+            if (&m_ctx_pool[instance] == p_ctx)
+            {
+                sensor->p_ctx = NULL;
+            }
+
+            m_ctx[instance] = NULL;
+            m_owner[instance] = NULL;
+        }
+        else
+        {
+            rd_sensor_uninitialize (sensor);
+        }
     }
 
     return err_code;
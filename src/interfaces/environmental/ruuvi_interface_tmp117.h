@@ -91,10 +91,45 @@ ADDRESS TYPE RESET ACRONYM       REGISTER NAME
 #define TMP117_OS_32_TSAMPLE_MS  (500U)
 #define TMP117_OS_64_TSAMPLE_MS  (1000U)
 
+// Datasheet 7.5, typical values.
+#define TMP117_CONVERSION_US     (15500U)  //!< Active time of one conversion.
+#define TMP117_ACTIVE_NA         (135000U) //!< Current during active conversion.
+#define TMP117_STANDBY_NA        (1250U)   //!< Current between continuous conversions.
+#define TMP117_SHUTDOWN_NA       (150U)    //!< Current in shutdown mode.
+
 // POR reset 1.5 ms, soft reset 2 ms, margin.
 #define TMP117_CC_RESET_DELAY_MS (4U)
 
-/** @brief @ref rd_sensor_init_fp */
+/**
+ * @brief State of one TMP117.
+ *
+ * Give a context in p_ctx of sensor before calling @ref ri_tmp117_init to
+ * keep state in application memory. If p_ctx is NULL, a context is taken
+ * from driver.
+ */
+typedef struct
+{
+    uint64_t timestamp;     //!< Time of latest sample.
+    uint64_t measure_start; //!< Start of split-phase measurement.
+    uint64_t ready_ms;      //!< Time when split-phase result is ready.
+    float    temperature;   //!< Latest sample, NAN if not available.
+    uint16_t ms_per_sample; //!< Conversion time with current oversampling.
+    uint16_t ms_per_cc;     //!< Conversion cycle time.
+    uint8_t  address;       //!< I2C address.
+    bool     continuous;    //!< True if sensor is in continuous mode.
+    bool     measuring;     //!< Split-phase measurement is running.
+} ri_tmp117_ctx_t;
+
+/**
+ * @brief @ref rd_sensor_init_fp
+ *
+ * Up to @ref RI_TMP117_MAX_INSTANCES sensors can be initialized at once,
+ * each with own handle. Function pointers of the initialized sensor operate
+ * on that sensor. Functions ri_tmp117_* below operate on instance 0, which
+ * is taken by first sensor initialized while it is free.
+ *
+ * @retval RD_ERROR_RESOURCES if all instances are in use.
+ */
 rd_status_t ri_tmp117_init (rd_sensor_t *
                             environmental_sensor, rd_bus_t bus, uint8_t handle);
 /** @brief @ref rd_sensor_init_fp */
@@ -120,8 +155,50 @@ rd_status_t ri_tmp117_dsp_get (uint8_t * dsp, uint8_t * parameter);
 rd_status_t ri_tmp117_mode_set (uint8_t * mode);
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_tmp117_mode_get (uint8_t * mode);
-/** @brief @ref rd_sensor_data_fp */
+/**
+ * @brief @ref rd_sensor_data_fp
+ *
+ * Collects result of @ref ri_tmp117_measurement_start if it is ready.
+ */
 rd_status_t ri_tmp117_data_get (rd_sensor_data_t * const
                                 data);
+
+/**
+ * @brief Start a one-shot conversion without waiting for it.
+ *
+ * Unlike mode_set(RD_SENSOR_CFG_SINGLE), returns as soon as conversion has
+ * been started. Conversion time depends on oversampling set with
+ * @ref ri_tmp117_dsp_set, from 16 ms at OS 1 to 1 s at OS 64.
+ * Previous sample is returned by data_get until result is collected.
+ *
+ * @param[out] p_ready_ms Value of @ref rd_sensor_timestamp_get when result is ready.
+ * @retval RD_SUCCESS if conversion was started.
+ * @retval RD_ERROR_NULL if p_ready_ms is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is in continuous mode, conversion
+ *                                is running or timestamp is not available.
+ * @return error code from I2C if conversion could not be started.
+ */
+rd_status_t ri_tmp117_measurement_start (uint64_t * const p_ready_ms);
+
+/**
+ * @brief Collect result of @ref ri_tmp117_measurement_start.
+ *
+ * Result is available through data_get.
+ *
+ * @retval RD_SUCCESS if result was read.
+ * @retval RD_ERROR_BUSY if conversion is not ready yet.
+ * @retval RD_ERROR_INVALID_STATE if no conversion was started.
+ * @return error code from I2C if result could not be read.
+ */
+rd_status_t ri_tmp117_measurement_complete (void);
+
+/**
+ * @brief @ref rd_sensor_cost_fp
+ *
+ * Conversion cycle time and oversampling are evaluated like in
+ * @ref ri_tmp117_samplerate_set and @ref ri_tmp117_dsp_set.
+ */
+rd_status_t ri_tmp117_cost_get (const rd_sensor_configuration_t * const p_config,
+                                rd_sensor_cost_t * const p_cost);
 /** @} */
 #endif
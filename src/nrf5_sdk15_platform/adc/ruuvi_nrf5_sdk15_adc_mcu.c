@@ -47,6 +47,7 @@
 #include "ruuvi_interface_adc_mcu.h"
 #if RUUVI_NRF5_SDK15_ADC_ENABLED
 #include "ruuvi_driver_error.h"
+#include "ruuvi_interface_yield.h"
 #include "ruuvi_nrf5_sdk15_error.h"
 
 #include "nrf_drv_saadc.h"
@@ -73,6 +74,13 @@
 #define ADC_BITS_RESOLUTION_14 14
 #define ADC_BITS_RESOLUTION_NUM 4
 
+#define ADC_STREAM_CLOCK_HZ       16000000U //!< Clock of SAADC internal sample timer.
+#define ADC_STREAM_CC_MIN         80U       //!< Smallest sample timer compare value.
+#define ADC_STREAM_CC_MAX         2047U     //!< Largest sample timer compare value.
+
+/** @brief Longest scan time of one channel: 256x oversampled 40 us acquisition and 2 us conversion. */
+#define ADC_SCAN_TIMEOUT_US_PER_CH (11000U)
+
 static float pre_scaling_values[ADC_PRE_SCALING_NUM] =
 {
     ADC_PRE_SCALING_COMPENSATION_1_6,
@@ -92,6 +100,9 @@ static nrf_saadc_channel_config_t * p_channel_configs[NRF_SAADC_CHANNEL_COUNT] =
     NULL, NULL, NULL, NULL
 };
 static bool m_adc_is_init = false;
+static volatile bool m_scan_done = false; //!< Set by SAADC driver at end of scan.
+static volatile bool m_streaming = false; //!< Buffers are filled continuously.
+static ri_adc_stream_fp_t m_stream_full = NULL; //!< Called with filled buffers.
 static nrf_drv_saadc_config_t adc_config = NRF_DRV_SAADC_DEFAULT_CONFIG;
 
 static uint8_t bits_resolution[ADC_BITS_RESOLUTION_NUM] =
@@ -276,7 +287,7 @@ static float raw_adc_to_ratio (uint8_t channel_num,
 
 /**
  * @brief Function handling events from 'nrf_drv_saadc.c'.
- * No implementation needed
+ * Marks end of a scan, single conversions are blocking.
  *
  * @param[in] p_evt SAADC event.
  */
@@ -284,6 +295,14 @@ static void saadc_event_handler (nrf_drv_saadc_evt_t const * p_evt)
 {
     if (p_evt->type == NRF_DRV_SAADC_EVT_DONE)
     {
+        if (m_streaming)
+        {
+            m_stream_full (p_evt->data.done.p_buffer, p_evt->data.done.size);
+        }
+        else
+        {
+            m_scan_done = true;
+        }
     }
 }
 
@@ -488,6 +507,33 @@ rd_status_t ri_adc_get_raw_data (uint8_t channel_num,
     return status;
 }
 
+/**
+ * @brief check that channel is configured and output config is valid.
+ */
+static rd_status_t nrf5_adc_check_config (uint8_t channel_num,
+        ri_adc_get_data_t * p_config)
+{
+    rd_status_t status = RD_SUCCESS;
+    nrf_saadc_channel_config_t * p_ch_config = NULL;
+
+    if (NRF_SAADC_CHANNEL_COUNT > channel_num)
+    {
+        p_ch_config = p_channel_configs[channel_num];
+    }
+
+    if ( (NULL == p_ch_config) ||
+            (p_config->vdd == ADC_REF_VOLTAGE_INVALID) ||
+            (p_config->divider == ADC_REF_DIVIDER_INVALID) ||
+            (isnan (p_config->divider)) ||
+            (isnan (p_config->vdd) && (RI_ADC_VREF_EXTERNAL ==
+                                       nrf_to_ruuvi_vref (p_ch_config->reference))))
+    {
+        status |= RD_ERROR_INVALID_PARAM;
+    }
+
+    return status;
+}
+
 /**
  * @brief get raw adc reading.
  */
@@ -503,19 +549,9 @@ static rd_status_t nrf5_adc_get_raw (uint8_t channel_num,
     }
     else
     {
-        nrf_saadc_channel_config_t * p_ch_config =
-            p_channel_configs[channel_num];
+        status |= nrf5_adc_check_config (channel_num, p_config);
 
-        if ( (NULL == p_ch_config) ||
-                (p_config->vdd == ADC_REF_VOLTAGE_INVALID) ||
-                (p_config->divider == ADC_REF_DIVIDER_INVALID) ||
-                (isnan (p_config->divider)) ||
-                (isnan (p_config->vdd) && (RI_ADC_VREF_EXTERNAL ==
-                                           nrf_to_ruuvi_vref (p_ch_config->reference))))
-        {
-            status |= RD_ERROR_INVALID_PARAM;
-        }
-        else
+        if (RD_SUCCESS == status)
         {
             status |= ri_adc_get_raw_data (channel_num, p_data);
         }
@@ -556,6 +592,203 @@ rd_status_t ri_adc_get_data_ratio (uint8_t channel_num,
     return status;
 }
 
+rd_status_t ri_adc_scan_raw_data (int16_t * const p_data, const size_t count)
+{
+    rd_status_t status = RD_SUCCESS;
+    size_t configured = 0;
+
+    for (uint8_t i = 0; i < NRF_SAADC_CHANNEL_COUNT; i++)
+    {
+        if (NULL != p_channel_configs[i])
+        {
+            configured++;
+        }
+    }
+
+    if (NULL == p_data)
+    {
+        status |= RD_ERROR_NULL;
+    }
+    else if (false == ri_adc_is_init())
+    {
+        status |= RD_ERROR_INVALID_STATE;
+    }
+    else if ( (0U == count) || (configured != count))
+    {
+        status |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        // SAADC converts all enabled channels on one SAMPLE task
+        // and writes results into buffer in order of channel number.
+        m_scan_done = false;
+        ret_code_t err_code = nrf_drv_saadc_buffer_convert (p_data,
+                              (uint16_t) count);
+
+        if (NRF_SUCCESS == err_code)
+        {
+            err_code = nrf_drv_saadc_sample();
+        }
+
+        status |= ruuvi_nrf5_sdk15_to_ruuvi_error (err_code);
+        volatile uint32_t timeout = 0;
+
+        // Scan takes tens of microseconds, busy-wait for interrupt.
+        while ( (RD_SUCCESS == status) && (false == m_scan_done)
+                && (timeout < (ADC_SCAN_TIMEOUT_US_PER_CH * count)))
+        {
+            timeout++;
+            ri_delay_us (1);
+        }
+
+        if ( (RD_SUCCESS == status) && (false == m_scan_done))
+        {
+            // Release buffer so that next scan can start.
+            nrf_drv_saadc_abort();
+            status |= RD_ERROR_TIMEOUT;
+        }
+    }
+
+    return status;
+}
+
+rd_status_t ri_adc_raw_to_absolute (const uint8_t channel_num,
+                                    ri_adc_get_data_t * const p_config,
+                                    const int16_t raw, float * const p_data)
+{
+    rd_status_t status = RD_SUCCESS;
+    int16_t data = raw;
+
+    if ( (NULL == p_config) || (NULL == p_data))
+    {
+        status |= RD_ERROR_NULL;
+    }
+    else
+    {
+        status |= nrf5_adc_check_config (channel_num, p_config);
+
+        if (RD_SUCCESS == status)
+        {
+            (*p_data) = raw_adc_to_volts (channel_num, p_config, &data);
+        }
+    }
+
+    return status;
+}
+
+rd_status_t ri_adc_raw_to_ratio (const uint8_t channel_num,
+                                 ri_adc_get_data_t * const p_config,
+                                 const int16_t raw, float * const p_data)
+{
+    rd_status_t status = RD_SUCCESS;
+    int16_t data = raw;
+
+    if ( (NULL == p_config) || (NULL == p_data))
+    {
+        status |= RD_ERROR_NULL;
+    }
+    else
+    {
+        status |= nrf5_adc_check_config (channel_num, p_config);
+
+        if (RD_SUCCESS == status)
+        {
+            (*p_data) = raw_adc_to_ratio (channel_num, p_config, &data);
+        }
+    }
+
+    return status;
+}
+
+rd_status_t ri_adc_stream_start (const uint8_t channel_num,
+                                 uint32_t * const p_samplerate_hz,
+                                 const ri_adc_stream_fp_t on_full)
+{
+    rd_status_t status = RD_SUCCESS;
+    bool only_channel = (NRF_SAADC_CHANNEL_COUNT > channel_num)
+                        && (NULL != p_channel_configs[channel_num]);
+
+    for (uint8_t i = 0; i < NRF_SAADC_CHANNEL_COUNT; i++)
+    {
+        if ( (i != channel_num) && (NULL != p_channel_configs[i]))
+        {
+            only_channel = false;
+        }
+    }
+
+    if ( (NULL == p_samplerate_hz) || (NULL == on_full))
+    {
+        status |= RD_ERROR_NULL;
+    }
+    else if ( (false == ri_adc_is_init()) || m_streaming)
+    {
+        status |= RD_ERROR_INVALID_STATE;
+    }
+    else if (!only_channel)
+    {
+        // Internal sample timer can only be used with one channel.
+        status |= RD_ERROR_INVALID_PARAM;
+    }
+    else if ( (0U == *p_samplerate_hz)
+              || ( (ADC_STREAM_CLOCK_HZ / *p_samplerate_hz) < ADC_STREAM_CC_MIN)
+              || ( (ADC_STREAM_CLOCK_HZ / *p_samplerate_hz) > ADC_STREAM_CC_MAX))
+    {
+        status |= RD_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        const uint16_t cc = (uint16_t) (ADC_STREAM_CLOCK_HZ / *p_samplerate_hz);
+        *p_samplerate_hz = ADC_STREAM_CLOCK_HZ / cc;
+        m_stream_full = on_full;
+        m_streaming = true;
+        nrf_saadc_continuous_mode_enable (cc);
+        // First SAMPLE task starts the internal timer.
+        status |= ruuvi_nrf5_sdk15_to_ruuvi_error (nrf_drv_saadc_sample());
+
+        if (RD_SUCCESS != status)
+        {
+            nrf_saadc_continuous_mode_disable();
+            m_streaming = false;
+        }
+    }
+
+    return status;
+}
+
+rd_status_t ri_adc_stream_buffer_put (int16_t * const p_buffer, const size_t count)
+{
+    rd_status_t status = RD_SUCCESS;
+
+    if (NULL == p_buffer)
+    {
+        status |= RD_ERROR_NULL;
+    }
+    else if ( (0U == count) || (UINT16_MAX < count))
+    {
+        status |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        status |= ruuvi_nrf5_sdk15_to_ruuvi_error (nrf_drv_saadc_buffer_convert (p_buffer,
+                  (uint16_t) count));
+    }
+
+    return status;
+}
+
+rd_status_t ri_adc_stream_stop (void)
+{
+    m_streaming = false;
+    nrf_saadc_continuous_mode_disable();
+
+    if (ri_adc_is_init())
+    {
+        nrf_drv_saadc_abort();
+    }
+
+    return RD_SUCCESS;
+}
+
 bool ri_adc_mcu_is_valid_ch (const uint8_t ch)
 {
     return ch < NRF_SAADC_CHANNEL_COUNT;
@@ -18,7 +18,7 @@
 #define RUUVI_DRIVER_ENABLED_MODULES_H
 
 /** @brief SemVer string, must match latest tag. */
-#define RUUVI_DRIVERS_SEMVER "3.9.2"
+#define RUUVI_DRIVERS_SEMVER "3.10.0"
 
 #ifdef CEEDLING
 #  define ENABLE_DEFAULT 1
@@ -70,6 +70,21 @@ data payload length is the maximum length */
 #  define RT_ADC_ENABLED ENABLE_DEFAULT
 #endif
 
+#if RT_ADC_ENABLED
+#   ifndef RT_ADC_VDD_MAX_AGE_MS
+/**
+ * @brief Age after which cached VDD is refreshed on next ADC read, 0 to disable.
+ *
+ * Cache is opt-in, e.g. 60000 refreshes VDD at most once per minute.
+ */
+#       define RT_ADC_VDD_MAX_AGE_MS (0U)
+#   endif
+#   ifndef RT_ADC_VDD_THRESHOLD_V
+/** @brief Change of VDD which replaces cached value, smaller changes only renew age. */
+#       define RT_ADC_VDD_THRESHOLD_V (0.010F)
+#   endif
+#endif
+
 #ifndef RI_COMM_ENABLED
 /** @brief Enable communication helper compilation. */
 #  define RI_COMM_ENABLED ENABLE_DEFAULT
@@ -115,6 +130,21 @@ data payload length is the maximum length */
 #  define RT_FLASH_ENABLED ENABLE_DEFAULT
 #endif
 
+#ifndef RT_FLASH_BATCH_ENABLED
+/** @brief Enable batching of log records compilation. */
+#  define RT_FLASH_BATCH_ENABLED ENABLE_DEFAULT
+#endif
+
+#ifndef RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE
+/** @brief Largest entry of time series log, bytes. */
+#  define RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE (144U)
+#endif
+
+#ifndef RT_FLASH_CODEC_ENABLED
+/** @brief Enable compression of logged sample blocks compilation. */
+#  define RT_FLASH_CODEC_ENABLED ENABLE_DEFAULT
+#endif
+
 #ifndef RT_GATT_ENABLED
 /** @brief Enable GATT task compilation. */
 #  define RT_GATT_ENABLED ENABLE_DEFAULT
@@ -206,6 +236,87 @@ data payload length is the maximum length */
 #   define RI_SPI_ENABLED ENABLE_DEFAULT
 #endif
 
+#ifndef RT_STREAM_ENABLED
+/** @brief Enable flow-controlled record streaming task compilation. */
+#  define RT_STREAM_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_STREAM_ENABLED
+#  if !(RI_COMM_ENABLED)
+#    error "Stream task requires communication interface."
+#  endif
+#  ifndef RT_STREAM_WINDOW_MAX
+/** @brief Maximum number of notifications a stream keeps in flight. */
+#    define RT_STREAM_WINDOW_MAX (8U)
+#  endif
+#endif
+
+#ifndef RT_MACRONIX_QUEUE_ENABLED
+/** @brief Enable non-blocking Macronix flash operation queue compilation. */
+#  define RT_MACRONIX_QUEUE_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_MACRONIX_QUEUE_ENABLED
+#  if !(RI_SCHEDULER_ENABLED)
+#    error "Macronix queue requires scheduler."
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_LENGTH
+/** @brief Number of flash operations which can be queued. */
+#    define RT_MACRONIX_QUEUE_LENGTH (8U)
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_PROGRAM_POLL_MS
+/** @brief Interval of polling write in progress during page program. */
+#    define RT_MACRONIX_QUEUE_PROGRAM_POLL_MS (1U)
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_ERASE_POLL_MS
+/** @brief Interval of polling write in progress during sector erase. */
+#    define RT_MACRONIX_QUEUE_ERASE_POLL_MS (10U)
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_PROGRAM_TIMEOUT_MS
+/** @brief Time to poll page program before failing, twice the maximum program time. */
+#    define RT_MACRONIX_QUEUE_PROGRAM_TIMEOUT_MS (20U)
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS
+/** @brief Time to poll sector erase before failing, twice the maximum erase time. */
+#    define RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS (480U)
+#  endif
+#  ifndef RT_MACRONIX_QUEUE_READ_CHUNK
+/** @brief Bytes read per scheduler event, larger reads are split. */
+#    define RT_MACRONIX_QUEUE_READ_CHUNK (256U)
+#  endif
+#endif
+
+#ifndef RT_MACRONIX_PREERASE_ENABLED
+/** @brief Enable background pre-erase of Macronix log sectors compilation. */
+#  define RT_MACRONIX_PREERASE_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_MACRONIX_PREERASE_ENABLED
+#  ifndef RT_MACRONIX_PREERASE_MAX_SECTORS
+/** @brief Largest partition in 4 kB sectors, one bit of RAM per sector. */
+#    define RT_MACRONIX_PREERASE_MAX_SECTORS (2048U)
+#  endif
+#endif
+
+#ifndef RT_MACRONIX_GOVERNOR_ENABLED
+/** @brief Enable Macronix high performance / low power governor compilation. */
+#  define RT_MACRONIX_GOVERNOR_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_MACRONIX_GOVERNOR_ENABLED
+#  if !(RI_SCHEDULER_ENABLED)
+#    error "Macronix governor requires scheduler."
+#  endif
+#  ifndef RT_MACRONIX_GOVERNOR_BATCH_OPS
+/** @brief Pending page programs or sector erases to switch to high performance. */
+#    define RT_MACRONIX_GOVERNOR_BATCH_OPS (4U)
+#  endif
+#  ifndef RT_MACRONIX_GOVERNOR_IDLE_MS
+/** @brief Idle time after last operation to switch back to low power. */
+#    define RT_MACRONIX_GOVERNOR_IDLE_MS (1000U)
+#  endif
+#endif
+
 #if RI_TIMER_ENABLED
 #  ifndef RI_TIMER_MAX_INSTANCES
 #    define RI_TIMER_MAX_INSTANCES (10U)
@@ -229,6 +340,49 @@ data payload length is the maximum length */
 #   define RT_SENSOR_ENABLED ENABLE_DEFAULT
 #endif
 
+#ifndef RT_SENSOR_MEASURE_ENABLED
+/** @brief Enable parallel single-shot sensor measurement task compilation. */
+#   define RT_SENSOR_MEASURE_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_SENSOR_MEASURE_ENABLED
+#   if !(RT_SENSOR_ENABLED && RI_SCHEDULER_ENABLED)
+#       error "Sensor measurement task requires sensor task and scheduler."
+#   endif
+#   ifndef RT_SENSOR_MEASURE_MAX_SENSORS
+/** @brief Maximum number of sensors measured in parallel, at most 32. */
+#       define RT_SENSOR_MEASURE_MAX_SENSORS (8U)
+#   endif
+#   ifndef RT_SENSOR_MEASURE_RETRY_MS
+/** @brief Delay before polling again a sensor which was not ready in time. */
+#       define RT_SENSOR_MEASURE_RETRY_MS (2U)
+#   endif
+#   ifndef RT_SENSOR_MEASURE_RETRIES_MAX
+/** @brief Number of polls after expected ready time before giving up. */
+#       define RT_SENSOR_MEASURE_RETRIES_MAX (5U)
+#   endif
+#endif
+
+#ifndef RT_SENSOR_DSP_ENABLED
+/** @brief Enable software DSP stage for sensors. */
+#   define RT_SENSOR_DSP_ENABLED ENABLE_DEFAULT
+#endif
+
+#if RT_SENSOR_DSP_ENABLED
+#   ifndef RT_SENSOR_DSP_MAX_FIELDS
+/** @brief Number of data fields filtered by one DSP stage, at most 32. */
+#       define RT_SENSOR_DSP_MAX_FIELDS (4U)
+#   endif
+#   ifndef RT_SENSOR_DSP_MAX_SAMPLES
+/** @brief Largest oversampling ratio of DSP stage, size of ring of each field. */
+#       define RT_SENSOR_DSP_MAX_SAMPLES (16U)
+#   endif
+#   ifndef RT_SENSOR_DSP_FRAC_BITS
+/** @brief Fractional bits of fixed-point values in DSP stage. */
+#       define RT_SENSOR_DSP_FRAC_BITS (10U)
+#   endif
+#endif
+
 #ifndef RI_BME280_ENABLED
 #   define RI_BME280_ENABLED ENABLE_DEFAULT
 #   ifndef RI_BME280_SPI_ENABLED
@@ -257,6 +411,44 @@ data payload length is the maximum length */
 #   define RI_TMP117_ENABLED ENABLE_DEFAULT
 #endif
 
+#ifndef RI_SENSOR_MAX_INSTANCES
+/**
+ * @brief Default number of sensors of same type a driver can run at once, 1 ... 4.
+ *
+ * Applies to drivers which support several instances, e.g. two TMP117 on
+ * different I2C addresses.
+ */
+#  ifdef CEEDLING
+#    define RI_SENSOR_MAX_INSTANCES (2U)
+#  else
+#    define RI_SENSOR_MAX_INSTANCES (1U)
+#  endif
+#endif
+
+#if RI_BME280_ENABLED
+#  ifndef RI_BME280_MAX_INSTANCES
+#    define RI_BME280_MAX_INSTANCES RI_SENSOR_MAX_INSTANCES
+#  endif
+#endif
+
+#if RI_DPS310_ENABLED
+#  ifndef RI_DPS310_MAX_INSTANCES
+#    define RI_DPS310_MAX_INSTANCES RI_SENSOR_MAX_INSTANCES
+#  endif
+#endif
+
+#if RI_LIS2DH12_ENABLED
+#  ifndef RI_LIS2DH12_MAX_INSTANCES
+#    define RI_LIS2DH12_MAX_INSTANCES RI_SENSOR_MAX_INSTANCES
+#  endif
+#endif
+
+#if RI_TMP117_ENABLED
+#  ifndef RI_TMP117_MAX_INSTANCES
+#    define RI_TMP117_MAX_INSTANCES RI_SENSOR_MAX_INSTANCES
+#  endif
+#endif
+
 #ifndef RI_SHTCX_ENABLED
 #   define RI_SHTCX_ENABLED ENABLE_DEFAULT
 #endif
@@ -52,12 +52,12 @@ rd_status_t rd_sensor_timestamp_function_set (
     return RD_SUCCESS;
 }
 
-// Calls the timestamp function and returns it's value. returns 0 if timestamp function is NULL
+// Calls the timestamp function and returns it's value. returns RD_UINT64_INVALID if timestamp function is NULL
 uint64_t rd_sensor_timestamp_get (void)
 {
     if (NULL == millis)
     {
-        return 0;
+        return RD_UINT64_INVALID;
     }
 
     return millis();
@@ -78,6 +78,27 @@ static rd_status_t rd_fifo_read_ni (size_t * num_elements, rd_sensor_data_t * da
     return RD_ERROR_NOT_INITIALIZED;
 }
 
+static rd_status_t rd_fifo_block_read_ni (rd_sensor_fifo_block_t * const p_block)
+{
+    return RD_ERROR_NOT_INITIALIZED;
+}
+
+static rd_status_t rd_measurement_start_ni (uint64_t * const p_ready_ms)
+{
+    return RD_ERROR_NOT_INITIALIZED;
+}
+
+static rd_status_t rd_measurement_complete_ni (void)
+{
+    return RD_ERROR_NOT_INITIALIZED;
+}
+
+static rd_status_t rd_cost_ni (const rd_sensor_configuration_t * const p_config,
+                               rd_sensor_cost_t * const p_cost)
+{
+    return RD_ERROR_NOT_INITIALIZED;
+}
+
 static rd_status_t rd_data_get_ni (rd_sensor_data_t * const data)
 {
     return RD_ERROR_NOT_INITIALIZED;
@@ -120,15 +141,19 @@ void rd_sensor_initialize (rd_sensor_t * const p_sensor)
 
     p_sensor->configuration_get     = rd_sensor_configuration_ni;
     p_sensor->configuration_set     = rd_sensor_configuration_ni;
+    p_sensor->cost_get              = rd_cost_ni;
     p_sensor->data_get              = rd_data_get_ni;
     p_sensor->dsp_get               = rd_dsp_ni;
     p_sensor->dsp_set               = rd_dsp_ni;
     p_sensor->fifo_enable           = rd_fifo_enable_ni;
     p_sensor->fifo_interrupt_enable = rd_fifo_interrupt_enable_ni;
     p_sensor->fifo_read             = rd_fifo_read_ni;
+    p_sensor->fifo_block_read       = rd_fifo_block_read_ni;
     p_sensor->init                  = rd_init_ni;
     p_sensor->uninit                = rd_init_ni;
     p_sensor->level_interrupt_set   = rd_level_interrupt_use_ni;
+    p_sensor->measurement_start     = rd_measurement_start_ni;
+    p_sensor->measurement_complete  = rd_measurement_complete_ni;
     p_sensor->mode_get              = rd_setup_ni;
     p_sensor->mode_set              = rd_setup_ni;
     p_sensor->resolution_get        = rd_setup_ni;
@@ -146,30 +171,38 @@ void rd_sensor_uninitialize (rd_sensor_t * const p_sensor)
     rd_sensor_initialize (p_sensor);
 }
 
-static inline uint8_t get_index_of_field (const rd_sensor_data_t * const target,
-        const rd_sensor_data_fields_t field)
+/** @brief Index of field at given bit in data with given fields. */
+static inline uint8_t index_of_bit (const rd_sensor_data_fields_t fields,
+                                    const uint8_t bit)
 {
-    // Null bits higher than target
-    uint8_t leading_zeros = (uint8_t) __builtin_clz (field.bitfield);
-    uint32_t mask = UINT32_MAX;
-    uint8_t bitfield_size = sizeof (field.bitfield) * BITS_PER_BYTE;
-    uint8_t target_bit = (bitfield_size - leading_zeros);
-
-    if (target_bit < bitfield_size)
-    {
-        mask = (1U << target_bit) - 1U;
-    }
+    return (uint8_t) __builtin_popcount (fields.bitfield & ( (1U << bit) - 1U));
+}
 
-    // Count set bits in nulled bitfield to find index.
-    uint8_t index = (uint8_t) (__builtin_popcount (target->fields.bitfield & mask) - 1);
+/**
+ * @brief Bit of field at given index in data with given fields.
+ *
+ * Binary search on popcount of lower half of remaining bits, constant number
+ * of steps regardless of index. Index must be less than number of fields.
+ */
+static inline uint8_t bit_of_index (const rd_sensor_data_fields_t fields,
+                                    uint8_t index)
+{
+    uint8_t bit = 0U;
 
-    // return 0 if we don't have a valid result.
-    if (index > bitfield_size)
+    for (uint8_t width = (sizeof (fields.bitfield) * BITS_PER_BYTE) / 2U;
+            width > 0U; width /= 2U)
     {
-        index = 0;
+        const uint32_t lower = (fields.bitfield >> bit) & ( (1U << width) - 1U);
+        const uint8_t count = (uint8_t) __builtin_popcount (lower);
+
+        if (count <= index)
+        {
+            index -= count;
+            bit += width;
+        }
     }
 
-    return index;
+    return bit;
 }
 
 float rd_sensor_data_parse (const rd_sensor_data_t * const provided,
@@ -182,7 +215,8 @@ float rd_sensor_data_parse (const rd_sensor_data_t * const provided,
             && (0 != (provided->valid.bitfield & requested.bitfield))
             && (1 == __builtin_popcount (requested.bitfield)))
     {
-        rvalue = provided->data[get_index_of_field (provided, requested)];
+        rvalue = provided->data[index_of_bit (provided->fields,
+                                              (uint8_t) __builtin_ctz (requested.bitfield))];
     }
 
     return rvalue;
@@ -209,7 +243,8 @@ void rd_sensor_data_set (rd_sensor_data_t * const target,
     else
     {
         // Set value to appropriate index
-        target->data[get_index_of_field (target, field)] = value;
+        target->data[index_of_bit (target->fields,
+                                   (uint8_t) __builtin_ctz (field.bitfield))] = value;
         // Mark data as valid
         target->valid.bitfield |= field.bitfield;
     }
@@ -218,32 +253,12 @@ void rd_sensor_data_set (rd_sensor_data_t * const target,
 bool rd_sensor_has_valid_data (const rd_sensor_data_t * const target,
                                const uint8_t index)
 {
-    uint8_t fieldcount = 0;
-    rd_sensor_data_fields_t check = {0};
-    uint8_t target_index = 0U;
-    uint32_t mask = 0U;
     bool valid = false;
 
-    if (NULL != target)
-    {
-        fieldcount = rd_sensor_data_fieldcount (target);
-        check = target->fields;
-    }
-
     // Verify bounds
-    if (fieldcount > index)
+    if ( (NULL != target) && (rd_sensor_data_fieldcount (target) > index))
     {
-        // Find target field
-        for (uint8_t ii = 0U; ii < index; ii++)
-        {
-            // Null trailing fields
-            target_index = (uint8_t) __builtin_ctz (check.bitfield);
-            mask = 1U << target_index;
-            check.bitfield &= ~mask;
-        }
-
-        target_index = (uint8_t) __builtin_ctz (check.bitfield);
-        mask = 1U << target_index;
+        const uint32_t mask = 1U << bit_of_index (target->fields, index);
         // Check if field at given index is marked valid, convert to bool.
         valid = !! (target->valid.bitfield & mask);
     }
@@ -254,78 +269,195 @@ bool rd_sensor_has_valid_data (const rd_sensor_data_t * const target,
 rd_sensor_data_bitfield_t rd_sensor_field_type (const rd_sensor_data_t * const target,
         const uint8_t index)
 {
-    uint8_t fieldcount = 0;
     rd_sensor_data_fields_t check = {0};
-    uint8_t target_index = 0U;
-    uint32_t mask = 0U;
-
-    if (NULL != target)
-    {
-        fieldcount = rd_sensor_data_fieldcount (target);
-    }
 
     // Verify bounds
-    if (fieldcount > index)
+    if ( (NULL != target) && (rd_sensor_data_fieldcount (target) > index))
     {
-        check = target->fields;
-
-        // Find target field
-        for (uint8_t ii = 0U; ii < index; ii++)
-        {
-            // Null trailing fields
-            target_index = (uint8_t) __builtin_ctz (check.bitfield);
-            mask = 1U << target_index;
-            check.bitfield &= ~mask;
-        }
-
-        target_index = (uint8_t) __builtin_ctz (check.bitfield);
-        mask = 1U << target_index;
-        check.bitfield &= mask;
+        check.bitfield = 1U << bit_of_index (target->fields, index);
     }
 
     // return given bitfield
     return check.datas;
 }
 
+/**
+ * @brief Fields which can be copied from provided to target.
+ *
+ * Updates target timestamp if there is not already a valid timestamp.
+ */
+static uint32_t populate_available (rd_sensor_data_t * const target,
+                                    const rd_sensor_data_t * const provided,
+                                    const rd_sensor_data_fields_t requested)
+{
+    // Compare provided data to requested data not yet valid.
+    const uint32_t available = (provided->valid).bitfield
+                               & (requested.bitfield & ~ (target->valid.bitfield));
+
+    // Update timestamp if there is not already a valid timestamp
+    if ( (0 != available)
+            && ( (0 == target->timestamp_ms)
+                 || (RD_SENSOR_INVALID_TIMSTAMP == target->timestamp_ms)))
+    {
+        target->timestamp_ms = provided->timestamp_ms;
+    }
+
+    // Fields must have a slot in both data.
+    return available & target->fields.bitfield & provided->fields.bitfield;
+}
+
 void rd_sensor_data_populate (rd_sensor_data_t * const target,
                               const rd_sensor_data_t * const provided,
                               const rd_sensor_data_fields_t requested)
 {
     if ( (NULL != target) && (NULL != provided))
     {
-        // Compare provided data to requested data not yet valid.
-        rd_sensor_data_fields_t available =
+        uint32_t available = populate_available (target, provided, requested);
+        target->valid.bitfield |= available;
+
+        // We have the available, requested fields. Fill the target struct with those
+        while (available)
+        {
+            // read rightmost field
+            const uint8_t bit = (uint8_t) __builtin_ctz (available);
+            target->data[index_of_bit (target->fields, bit)] =
+                provided->data[index_of_bit (provided->fields, bit)];
+            // set rightmost bit of available to 0
+            available &= (available - 1U);
+        }
+    }
+}
+
+/** @brief Fields which provider can copy to target. */
+static inline uint32_t provider_fields (const rd_sensor_data_t * const target,
+                                        const rd_sensor_data_t * const provided)
+{
+    return (NULL == provided) ? 0U : (provided->valid.bitfield
+                                      & provided->fields.bitfield
+                                      & target->fields.bitfield);
+}
+
+void rd_sensor_data_populate_many (rd_sensor_data_t * const target,
+                                   const rd_sensor_data_provider_t * const p_providers,
+                                   const size_t provider_count,
+                                   const rd_sensor_data_fields_t requested)
+{
+    if ( (NULL != target) && (NULL != p_providers))
+    {
+        const uint32_t open = requested.bitfield & ~ (target->valid.bitfield);
+        uint32_t preferred = 0;
+        const rd_sensor_data_t * p_timestamp = NULL;
+
+        // Fields some provider prefers are not given to providers in general order.
+        for (size_t ii = 0; ii < provider_count; ii++)
         {
-            .bitfield = (provided->valid).bitfield
-            & (requested.bitfield & ~ (target->valid.bitfield))
-        };
+            preferred |= provider_fields (target, p_providers[ii].p_data)
+                         & p_providers[ii].preferred.bitfield;
+        }
 
-        // Update timestamp if there is not already a valid timestamp
-        if ( (0 != available.bitfield)
+        uint32_t open_general = open & ~preferred;
+        uint32_t open_preferred = open & preferred;
+
+        for (size_t ii = 0; ii < provider_count; ii++)
+        {
+            const rd_sensor_data_t * const provided = p_providers[ii].p_data;
+            const uint32_t offered = provider_fields (target, provided);
+            uint32_t take = offered & open_preferred & p_providers[ii].preferred.bitfield;
+            open_preferred &= ~take;
+            const uint32_t general = offered & open_general;
+            open_general &= ~general;
+            take |= general;
+
+            if ( (0U != take) && (NULL == p_timestamp))
+            {
+                p_timestamp = provided;
+            }
+
+            target->valid.bitfield |= take;
+
+            while (take)
+            {
+                const uint8_t bit = (uint8_t) __builtin_ctz (take);
+                target->data[index_of_bit (target->fields, bit)] =
+                    provided->data[index_of_bit (provided->fields, bit)];
+                take &= (take - 1U);
+            }
+        }
+
+        if ( (NULL != p_timestamp)
                 && ( (0 == target->timestamp_ms)
                      || (RD_SENSOR_INVALID_TIMSTAMP == target->timestamp_ms)))
         {
-            target->timestamp_ms = provided->timestamp_ms;
+            target->timestamp_ms = p_timestamp->timestamp_ms;
         }
+    }
+}
 
-        // We have the available, requested fields. Fill the target struct with those
-        while (available.bitfield)
-        {
-            // read rightmost field
-            const uint8_t index = (uint8_t) __builtin_ctz (available.bitfield);
+rd_status_t rd_sensor_data_layout_compile (rd_sensor_data_layout_t * const p_layout,
+        const rd_sensor_data_fields_t fields)
+{
+    rd_status_t err_code = RD_SUCCESS;
 
-            if (index < sizeof (requested.bitfield) * BITS_PER_BYTE)
+    if (NULL == p_layout)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (0 != (fields.bitfield >> RD_SENSOR_DATA_FIELD_COUNT))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        uint8_t count = 0;
+        p_layout->fields = fields;
+
+        for (uint8_t bit = 0; bit < RD_SENSOR_DATA_FIELD_COUNT; bit++)
+        {
+            if (fields.bitfield & (1U << bit))
             {
-                rd_sensor_data_fields_t next =
-                {
-                    .bitfield = (1U << index)
-                };
-                float value = rd_sensor_data_parse (provided, next);
-                rd_sensor_data_set (target, next, value);
+                p_layout->index[bit] = count;
+                p_layout->bit[count] = bit;
+                count++;
             }
+            else
+            {
+                p_layout->index[bit] = RD_SENSOR_DATA_NO_INDEX;
+            }
+        }
 
-            // set rightmost bit of available to 0
-            available.bitfield &= (available.bitfield - 1U);
+        p_layout->count = count;
+    }
+
+    return err_code;
+}
+
+void rd_sensor_data_layout_populate (rd_sensor_data_t * const target,
+                                     const rd_sensor_data_layout_t * const p_target_layout,
+                                     const rd_sensor_data_t * const provided,
+                                     const rd_sensor_data_layout_t * const p_provided_layout,
+                                     const rd_sensor_data_fields_t requested)
+{
+    if ( (NULL == target) || (NULL == provided))
+    {
+        // No action needed
+    }
+    else if ( (NULL == p_target_layout) || (NULL == p_provided_layout)
+              || (p_target_layout->fields.bitfield != target->fields.bitfield)
+              || (p_provided_layout->fields.bitfield != provided->fields.bitfield))
+    {
+        rd_sensor_data_populate (target, provided, requested);
+    }
+    else
+    {
+        uint32_t available = populate_available (target, provided, requested);
+        target->valid.bitfield |= available;
+
+        while (available)
+        {
+            const uint8_t bit = (uint8_t) __builtin_ctz (available);
+            target->data[p_target_layout->index[bit]] =
+                provided->data[p_provided_layout->index[bit]];
+            available &= (available - 1U);
         }
     }
 }
@@ -394,6 +526,35 @@ rd_status_t validate_default_input_get (uint8_t * const input)
     return err_code;
 }
 
+uint32_t rd_sensor_cost_average_na (const rd_sensor_cost_t * const p_cost,
+                                    const uint32_t interval_us)
+{
+    uint64_t average = 0;
+
+    if (NULL == p_cost)
+    {
+        // No cost.
+    }
+    else if ( (interval_us <= p_cost->conversion_us) && (0U != p_cost->conversion_us))
+    {
+        // nC / us * 1e6 = nA.
+        average = ( (uint64_t) p_cost->charge_nc * 1000000U) / p_cost->conversion_us;
+    }
+    else if (interval_us > p_cost->conversion_us)
+    {
+        const uint64_t sleep_us = interval_us - p_cost->conversion_us;
+        average = ( (uint64_t) p_cost->charge_nc * 1000000U)
+                  + ( (uint64_t) p_cost->sleep_na * sleep_us);
+        average /= interval_us;
+    }
+    else
+    {
+        average = p_cost->sleep_na;
+    }
+
+    return (average > UINT32_MAX) ? UINT32_MAX : (uint32_t) average;
+}
+
 bool rd_sensor_is_init (const rd_sensor_t * const sensor)
 {
     bool init = false;
@@ -221,6 +221,64 @@ typedef struct rd_sensor_data_t
     float * data;
 } rd_sensor_data_t;
 
+/**
+ * @brief Sensor data offered for merging into a sample.
+ *
+ * @ref rd_sensor_data_populate_many fills each field from the first provider
+ * which prefers the field, and if none does, from the first provider which has the field.
+ */
+typedef struct
+{
+    const rd_sensor_data_t * p_data;   //!< Data provided by sensor. NULL to skip provider.
+    rd_sensor_data_fields_t preferred; //!< Fields this provider has priority on.
+} rd_sensor_data_provider_t;
+
+/** @brief Number of data fields defined in @ref rd_sensor_data_bitfield_t. */
+#define RD_SENSOR_DATA_FIELD_COUNT (22U)
+/** @brief Index of a field which is not in @ref rd_sensor_data_layout_t. */
+#define RD_SENSOR_DATA_NO_INDEX (0xFFU)
+
+/**
+ * @brief Compiled layout of sensor data.
+ *
+ * Position of each field in data array depends on all fields of the data.
+ * Layout stores the positions once for given fields, so that fields can be
+ * looked up without counting bits on every access.
+ */
+typedef struct
+{
+    rd_sensor_data_fields_t fields; //!< Fields layout was compiled for.
+    uint8_t count;                  //!< Number of fields, i.e. floats in data.
+    /** @brief Data index of each field bit, RD_SENSOR_DATA_NO_INDEX if not in fields. */
+    uint8_t index[RD_SENSOR_DATA_FIELD_COUNT];
+    /** @brief Field bit at each data index, valid up to count. */
+    uint8_t bit[RD_SENSOR_DATA_FIELD_COUNT];
+} rd_sensor_data_layout_t;
+
+/** @brief Maximum number of samples in @ref rd_sensor_fifo_block_t. */
+#define RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES (32U)
+
+/**
+ * @brief Compact block of 3-axis samples read from sensor FIFO.
+ *
+ * Samples are stored as struct of arrays with a common timestamp and interval
+ * instead of one @ref rd_sensor_data_t per sample. Values are integer
+ * milli-units of the quantity, e.g. milli-g for acceleration.
+ * The block has no pointers and can be stored as-is, e.g. to flash.
+ */
+typedef struct __attribute__ ( (packed, aligned (4)))
+{
+    uint64_t timestamp_ms; //!< Timestamp of first sample, @ref rd_sensor_timestamp_get.
+    uint32_t interval_us;  //!< Time between consecutive samples, microseconds.
+    uint8_t  count;        //!< Number of valid samples in x, y, z.
+    uint8_t  reserved0;    //!< Reserved for future use.
+    uint8_t  reserved1;    //!< Reserved for future use.
+    uint8_t  reserved2;    //!< Reserved for future use.
+    int16_t  x[RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES]; //!< X-axis samples, oldest first.
+    int16_t  y[RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES]; //!< Y-axis samples, oldest first.
+    int16_t  z[RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES]; //!< Z-axis samples, oldest first.
+} rd_sensor_fifo_block_t;
+
 /** @brief Forward declare type definition of sensor structure */
 typedef struct rd_sensor_t rd_sensor_t;
 
@@ -321,6 +379,22 @@ typedef rd_status_t (*rd_configuration_fp) (
 typedef rd_status_t (*rd_sensor_fifo_read_fp) (size_t * const num_elements,
         rd_sensor_data_t * const data);
 
+/**
+* @brief Read First-in-first-out (FIFO) buffer in sensor into a compact block.
+*
+* Reads up to @ref RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES samples from FIFO.
+* Count, timestamp and interval of block are set by the sensor.
+*
+* @param[out] p_block Block to fill.
+* @retval RD_SUCCESS on success.
+* @retval RD_ERROR_NULL if p_block is NULL.
+* @retval RD_ERROR_INVALID_STATE if FIFO is not in use.
+* @retval RD_ERROR_NOT_SUPPORTED if the sensor does not have FIFO.
+* @return error code from stack on error.
+*/
+typedef rd_status_t (*rd_sensor_fifo_block_read_fp) (rd_sensor_fifo_block_t * const
+        p_block);
+
 /**
 * @brief Enable FIFO or FIFO interrupt full interrupt on sensor.
 * FIFO interrupt Triggers an interrupt once FIFO is filled.
@@ -361,6 +435,72 @@ typedef rd_status_t (*rd_sensor_fifo_enable_fp) (const bool enable);
 typedef rd_status_t (*rd_sensor_level_interrupt_use_fp) (const bool enable,
         float * limit_g);
 
+/**
+ * @brief Start a single measurement without waiting for it to complete.
+ *
+ * Unlike mode_set(RD_SENSOR_CFG_SINGLE), returns as soon as conversion has
+ * been started. Ready time is estimated by the driver from conversion time
+ * of current configuration, e.g. oversampling. Collect the result at ready
+ * time with @ref rd_sensor_measurement_complete_fp.
+ *
+ * @param[out] p_ready_ms Value of @ref rd_sensor_timestamp_get when result is ready.
+ * @retval RD_SUCCESS if measurement was started.
+ * @retval RD_ERROR_NULL if p_ready_ms is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is not sleeping or measurement is running.
+ * @retval RD_ERROR_NOT_INITIALIZED if sensor does not support split-phase measurement.
+ * @return error code from stack on error.
+ */
+typedef rd_status_t (*rd_sensor_measurement_start_fp) (uint64_t * const p_ready_ms);
+
+/**
+ * @brief Collect result of @ref rd_sensor_measurement_start_fp.
+ *
+ * Sensor is back in sleep and result is available through data_get afterwards.
+ *
+ * @retval RD_SUCCESS if result was collected.
+ * @retval RD_ERROR_BUSY if result is not ready yet.
+ * @retval RD_ERROR_INVALID_STATE if no measurement was started.
+ * @return error code from stack on error.
+ */
+typedef rd_status_t (*rd_sensor_measurement_complete_fp) (void);
+
+/**
+ * @brief Estimated time and charge of sampling a sensor.
+ *
+ * Values are typical values from datasheet of the sensor.
+ */
+typedef struct
+{
+    uint32_t conversion_us; //!< Time from start of a sample to result, us.
+    uint32_t charge_nc;     //!< Charge drawn by one sample, nC.
+    uint32_t sleep_na;      //!< Current drawn while sensor sleeps, nA.
+    uint32_t average_na;    //!< Average current with given mode and samplerate, nA.
+} rd_sensor_cost_t;
+
+/**
+ * @brief Estimate time and current consumption of a configuration.
+ *
+ * Configuration is evaluated, not applied to the sensor, so the function
+ * can be used to compare candidate configurations.
+ * Samplerate, resolution, scale and DSP values are interpreted like in the
+ * setters of the sensor. @ref RD_SENSOR_CFG_NO_CHANGE is evaluated as
+ * @ref RD_SENSOR_CFG_DEFAULT.
+ *
+ * Average current depends on mode:
+ *  - RD_SENSOR_CFG_SLEEP: current of sleeping sensor.
+ *  - RD_SENSOR_CFG_SINGLE: application triggers a single sample at samplerate.
+ *  - RD_SENSOR_CFG_CONTINUOUS: sensor samples at samplerate on its own.
+ *
+ * @param[in] p_config Configuration to evaluate.
+ * @param[out] p_cost Estimated cost of configuration.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_NOT_SUPPORTED if sensor does not support configuration.
+ * @retval RD_ERROR_NOT_INITIALIZED if sensor does not provide estimates.
+ */
+typedef rd_status_t (*rd_sensor_cost_fp) (const rd_sensor_configuration_t * const
+        p_config, rd_sensor_cost_t * const p_cost);
+
 /**
  * @brief Return number of milliseconds since the start of RTC.
  *
@@ -418,10 +558,115 @@ typedef struct rd_sensor_t
     rd_sensor_fifo_enable_fp fifo_interrupt_enable;
     /** @brief @®ef rd_sensor_level_interrupt_use_fp */
     rd_sensor_fifo_read_fp   fifo_read;
+    /** @brief @ref rd_sensor_fifo_block_read_fp */
+    rd_sensor_fifo_block_read_fp fifo_block_read;
     /** @brief @®ef rd_sensor_level_interrupt_use_fp */
     rd_sensor_level_interrupt_use_fp level_interrupt_set;
+    /** @brief @ref rd_sensor_measurement_start_fp */
+    rd_sensor_measurement_start_fp measurement_start;
+    /** @brief @ref rd_sensor_measurement_complete_fp */
+    rd_sensor_measurement_complete_fp measurement_complete;
+    /** @brief @ref rd_sensor_cost_fp */
+    rd_sensor_cost_fp cost_get;
 } rd_sensor_t;
 
+/**
+ * @brief Define static functions which bind sensor functions to an instance.
+ *
+ * Sensor function pointers do not take a context, a driver which supports
+ * several sensors of same type defines a set of functions for each instance.
+ * Each defined function calls fn with context of the instance as first argument.
+ *
+ * @code{.c}
+ * static rd_status_t mode_set (drv_ctx_t * const p_ctx, uint8_t * mode);
+ * RD_SENSOR_SETUP_BIND (mode_set_1, mode_set, &m_ctx[1])
+ * @endcode
+ *
+ * @param name Name of function to define.
+ * @param fn Function which takes the context and arguments of sensor function.
+ * @param p_ctx Expression which evaluates to context of instance.
+ */
+#define RD_SENSOR_SETUP_BIND(name, fn, p_ctx)                                \
+    static rd_status_t name (uint8_t * parameter)                            \
+    {                                                                        \
+        return fn ((p_ctx), parameter);                                      \
+    }
+
+/** @brief Define @ref rd_sensor_dsp_fp of an instance, see @ref RD_SENSOR_SETUP_BIND. */
+#define RD_SENSOR_DSP_BIND(name, fn, p_ctx)                                  \
+    static rd_status_t name (uint8_t * dsp_function, uint8_t * dsp_parameter) \
+    {                                                                        \
+        return fn ((p_ctx), dsp_function, dsp_parameter);                    \
+    }
+
+/** @brief Define @ref rd_sensor_data_fp of an instance, see @ref RD_SENSOR_SETUP_BIND. */
+#define RD_SENSOR_DATA_BIND(name, fn, p_ctx)                                 \
+    static rd_status_t name (rd_sensor_data_t * const p_data)                \
+    {                                                                        \
+        return fn ((p_ctx), p_data);                                         \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_fifo_enable_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_FIFO_ENABLE_BIND(name, fn, p_ctx)                          \
+    static rd_status_t name (const bool enable)                              \
+    {                                                                        \
+        return fn ((p_ctx), enable);                                         \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_fifo_read_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_FIFO_READ_BIND(name, fn, p_ctx)                            \
+    static rd_status_t name (size_t * const num_elements,                    \
+                             rd_sensor_data_t * const data)                  \
+    {                                                                        \
+        return fn ((p_ctx), num_elements, data);                             \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_fifo_block_read_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_FIFO_BLOCK_READ_BIND(name, fn, p_ctx)                      \
+    static rd_status_t name (rd_sensor_fifo_block_t * const p_block)         \
+    {                                                                        \
+        return fn ((p_ctx), p_block);                                        \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_level_interrupt_use_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_LEVEL_INTERRUPT_BIND(name, fn, p_ctx)                      \
+    static rd_status_t name (const bool enable, float * limit_g)             \
+    {                                                                        \
+        return fn ((p_ctx), enable, limit_g);                                \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_measurement_start_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_MEASUREMENT_START_BIND(name, fn, p_ctx)                    \
+    static rd_status_t name (uint64_t * const p_ready_ms)                    \
+    {                                                                        \
+        return fn ((p_ctx), p_ready_ms);                                     \
+    }
+
+/**
+ * @brief Define @ref rd_sensor_measurement_complete_fp of an instance,
+ *        see @ref RD_SENSOR_SETUP_BIND.
+ */
+#define RD_SENSOR_MEASUREMENT_COMPLETE_BIND(name, fn, p_ctx)                 \
+    static rd_status_t name (void)                                           \
+    {                                                                        \
+        return fn ((p_ctx));                                                 \
+    }
+
 /**
  * @brief Implementation of ref rd_configuration_fp
  */
@@ -471,6 +716,19 @@ void rd_sensor_initialize (rd_sensor_t * const p_sensor);
  */
 void rd_sensor_uninitialize (rd_sensor_t * const p_sensor);
 
+/**
+ * @brief Average current of a sensor sampled at given interval.
+ *
+ * Sensor is assumed to sleep between samples. If interval is shorter than
+ * conversion time, sensor converts back-to-back.
+ *
+ * @param[in] p_cost Cost of one sample, conversion_us, charge_nc and sleep_na are used.
+ * @param[in] interval_us Time between starts of samples, us.
+ * @return Average current in nA, 0 if p_cost is NULL.
+ */
+uint32_t rd_sensor_cost_average_na (const rd_sensor_cost_t * const p_cost,
+                                    const uint32_t interval_us);
+
 /**
  * @brief Check if given sensor structure is already initialized.
  *
@@ -514,6 +772,36 @@ void rd_sensor_data_populate (rd_sensor_data_t * const target,
                               const rd_sensor_data_t * const provided,
                               const rd_sensor_data_fields_t requested);
 
+/**
+ * @brief Populate target with data of several sensors in one pass.
+ *
+ * Priority of a field is resolved before any data is copied:
+ * the first provider which has the field valid and in its preferred fields wins,
+ * otherwise the first provider which has the field valid. Fields already valid in
+ * target are not overwritten. Timestamp is taken from the highest priority
+ * provider which gives any data, if target does not have a valid timestamp.
+ *
+ * Typical usage:
+ * @code
+ * const rd_sensor_data_provider_t providers[] =
+ * {
+ *     {.p_data = &shtcx_data, .preferred = RD_SENSOR_HUMI_FIELD},
+ *     {.p_data = &bme280_data},
+ *     {.p_data = &lis2dh12_data}
+ * };
+ * rd_sensor_data_populate_many (&sample, providers, 3, sample.fields);
+ * @endcode
+ *
+ * @param[out] target Data to be populated.
+ * @param[in]  p_providers Providers in descending priority.
+ * @param[in]  provider_count Number of providers.
+ * @param[in]  requested Fields to be filled if possible.
+ */
+void rd_sensor_data_populate_many (rd_sensor_data_t * const target,
+                                   const rd_sensor_data_provider_t * const p_providers,
+                                   const size_t provider_count,
+                                   const rd_sensor_data_fields_t requested);
+
 /**
  * @brief Parse data from provided struct.
  *
@@ -621,5 +909,49 @@ bool rd_sensor_has_valid_data (const rd_sensor_data_t * const target,
 rd_sensor_data_bitfield_t rd_sensor_field_type (const rd_sensor_data_t * const target,
         const uint8_t index);
 
+/**
+ * @brief Compile layout of data with given fields.
+ *
+ * Typical usage:
+ * @code
+ * static rd_sensor_data_layout_t layout;
+ * rd_sensor_data_layout_compile (&layout, p_data->fields);
+ * for(uint8_t ii = 0; ii < layout.count; ii++)
+ * {
+ *     if(p_data->valid.bitfield & (1U << layout.bit[ii]))
+ *     {
+ *        do_stuff(p_data->data[ii], layout.bit[ii]);
+ *     }
+ * }
+ * @endcode
+ *
+ * @param[out] p_layout Layout to compile.
+ * @param[in]  fields Fields of data.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_layout is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if fields has reserved bits set.
+ */
+rd_status_t rd_sensor_data_layout_compile (rd_sensor_data_layout_t * const p_layout,
+        const rd_sensor_data_fields_t fields);
+
+/**
+ * @brief Populate target with all requested fields of provided data in one pass.
+ *
+ * Equivalent to @ref rd_sensor_data_populate, but field positions are taken
+ * from compiled layouts. If a layout does not match fields of its data,
+ * falls back to @ref rd_sensor_data_populate.
+ *
+ * @param[out] target Data to be populated.
+ * @param[in]  p_target_layout Layout of target fields.
+ * @param[in]  provided Data provided by sensor.
+ * @param[in]  p_provided_layout Layout of provided fields.
+ * @param[in]  requested Fields to be filled if possible.
+ */
+void rd_sensor_data_layout_populate (rd_sensor_data_t * const target,
+                                     const rd_sensor_data_layout_t * const p_target_layout,
+                                     const rd_sensor_data_t * const provided,
+                                     const rd_sensor_data_layout_t * const p_provided_layout,
+                                     const rd_sensor_data_fields_t requested);
+
 /** @} */
 #endif
@@ -14,6 +14,7 @@
 
 #include "ruuvi_task_adc.h"
 
+#include <math.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -21,6 +22,7 @@
 #include "ruuvi_driver_sensor.h"
 #include "ruuvi_interface_adc_mcu.h"
 #include "ruuvi_interface_atomic.h"
+#include "ruuvi_interface_scheduler.h"
 
 #define RD_ADC_USE_DIVIDER      1.00f
 #define RD_ADC_USE_VDD          3.30f
@@ -34,6 +36,7 @@
 #define RD_ADC_INIT_BYTE        0
 
 #define RT_ADC_CH_UNUSED        (0xFFU) //!< Channel not assigned.
+#define RT_ADC_STREAM_BUFFERS   (2U)    //!< Ping-pong buffers of stream.
 
 static ri_atomic_t m_is_init;
 static bool m_is_configured;
@@ -45,6 +48,18 @@ static uint8_t m_handle; //!< handle of last ADC used.
 static uint8_t m_channel[RI_ADC_CH_NUM]; //!< Channel assigment for handles.
 static uint8_t m_next_channel; //!< Next channel to be assigned.
 
+static bool m_vdd_cached;       //!< options.vdd holds a measured value.
+static uint64_t m_vdd_cache_ms; //!< Time of last VDD reading.
+static uint32_t m_vdd_max_age_ms = RT_ADC_VDD_MAX_AGE_MS;
+static float m_vdd_threshold = RT_ADC_VDD_THRESHOLD_V;
+
+static bool m_streaming;
+static rt_adc_stream_fp_t m_stream_cb; //!< Application handler of full buffers.
+static int16_t * m_stream_buffers[RT_ADC_STREAM_BUFFERS];
+static size_t m_stream_count; //!< Samples per buffer.
+static volatile bool m_stream_held[RT_ADC_STREAM_BUFFERS]; //!< Buffer is at application.
+static volatile uint32_t m_stream_overruns;
+
 /**
  * @brief assign ADC channel for a handle
  *
@@ -104,6 +119,61 @@ static ri_adc_get_data_t options =
     .divider = RD_ADC_USE_DIVIDER,
 };
 
+/** @brief Store a VDD reading, used by all following conversions. */
+static void vdd_cache_update (const float vdd, const uint64_t now)
+{
+    if ( (!m_vdd_cached) || (fabsf (vdd - options.vdd) > m_vdd_threshold))
+    {
+        options.vdd = vdd;
+    }
+
+    m_vdd_cached = true;
+    m_vdd_cache_ms = now;
+}
+
+/** @brief Cache is opt-in, disabled cache leaves conversions at nominal VDD. */
+static inline bool vdd_cache_is_enabled (void)
+{
+    return (0U != m_vdd_max_age_ms);
+}
+
+/** @brief Check if VDD should be read. Age is unknown without timestamps. */
+static bool vdd_cache_is_stale (const uint64_t now)
+{
+    return (!m_vdd_cached)
+           || ( (RD_UINT64_INVALID != now) && (RD_UINT64_INVALID != m_vdd_cache_ms)
+                && ( (now < m_vdd_cache_ms) || ( (now - m_vdd_cache_ms) > m_vdd_max_age_ms)));
+}
+
+/**
+ * @brief Read VDD on the ADC session which is already open.
+ *
+ * Failure is not fatal, conversions keep using previous value.
+ */
+static void vdd_cache_refresh (void)
+{
+    rd_status_t err_code = channel_assign (RI_ADC_AINVDD);
+
+    if ( (RD_SUCCESS == err_code) && (RT_ADC_CH_UNUSED != m_channel[RI_ADC_AINVDD]))
+    {
+        ri_adc_pins_config_t vdd_pins = pins_config;
+        ri_adc_channel_config_t vdd_config = absolute_config;
+        float vdd = 0;
+        vdd_pins.p_pin.channel = RI_ADC_AINVDD;
+        err_code |= ri_adc_configure (m_channel[RI_ADC_AINVDD], &vdd_pins, &vdd_config);
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= ri_adc_get_data_absolute (m_channel[RI_ADC_AINVDD], &options, &vdd);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            vdd_cache_update (vdd, rd_sensor_timestamp_get());
+        }
+    }
+}
+
 static rd_status_t rt_adc_mcu_data_get (rd_sensor_data_t * const
                                         p_data)
 {
@@ -120,6 +190,12 @@ static rd_status_t rt_adc_mcu_data_get (rd_sensor_data_t * const
         rd_sensor_data_fields_t adc_fields = {.bitfield = RD_ADC_DEFAULT_BITFIELD};
         float adc_values[RD_ADC_DATA_COUNTER] = {0};
 
+        if (vdd_cache_is_enabled() && (RI_ADC_AINVDD != m_handle)
+                && vdd_cache_is_stale (rd_sensor_timestamp_get()))
+        {
+            vdd_cache_refresh();
+        }
+
         if (false == m_ratio)
         {
             status = ri_adc_get_data_absolute (m_channel[m_handle],
@@ -143,6 +219,11 @@ static rd_status_t rt_adc_mcu_data_get (rd_sensor_data_t * const
                                      &d_adc,
                                      p_data->fields);
             p_data->timestamp_ms = rd_sensor_timestamp_get();
+
+            if (vdd_cache_is_enabled() && (RI_ADC_AINVDD == m_handle) && (false == m_ratio))
+            {
+                vdd_cache_update (adc_values[RD_ADC_DATA_START], p_data->timestamp_ms);
+            }
         }
     }
 
@@ -420,5 +501,342 @@ rd_status_t rt_adc_ratiometric_sample (rd_sensor_configuration_t * const configu
     *sample = rd_sensor_data_parse (&d_adc, d_adc.fields);
     return err_code;
 }
+
+/** @brief Pass full buffer to application and give it back to ADC. */
+static void stream_handler (void * p_event_data, uint16_t event_size)
+{
+    uint8_t index = 0;
+    memcpy (&index, p_event_data, sizeof (index));
+
+    // Buffers of a stopped stream are discarded.
+    if (m_streaming && m_stream_held[index])
+    {
+        m_stream_cb (m_stream_buffers[index], m_stream_count);
+        m_stream_held[index] = false;
+        rd_status_t err_code = ri_adc_stream_buffer_put (m_stream_buffers[index],
+                               m_stream_count);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+/** @brief Called by ADC in interrupt context when a buffer is full. */
+static void stream_isr (int16_t * const p_buffer, const size_t count)
+{
+    const uint8_t index = (p_buffer == m_stream_buffers[1]) ? 1U : 0U;
+    const uint8_t other = (uint8_t) (1U - index);
+
+    // ADC had no buffer to continue into, samples were lost.
+    if (m_stream_held[other])
+    {
+        m_stream_overruns++;
+    }
+
+    m_stream_held[index] = true;
+
+    if (RD_SUCCESS != ri_scheduler_event_put (&index, sizeof (index), &stream_handler))
+    {
+        // Drop samples to keep stream running.
+        m_stream_held[index] = false;
+        m_stream_overruns++;
+        (void) ri_adc_stream_buffer_put (p_buffer, count);
+    }
+}
+
+/** @brief Assign and configure a channel for each handle of scan. */
+static rd_status_t scan_configure (const rt_adc_scan_channel_t * const p_channels,
+                                   const size_t count)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    for (size_t ii = 0; (ii < count) && (RD_SUCCESS == err_code); ii++)
+    {
+        const uint8_t handle = p_channels[ii].handle;
+
+        if ( (RI_ADC_GND == handle) || (RI_ADC_CH_NUM <= handle)
+                || (RT_ADC_CH_UNUSED != m_channel[handle]))
+        {
+            err_code |= RD_ERROR_INVALID_PARAM;
+        }
+        else
+        {
+            err_code |= channel_assign (handle);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            ri_adc_pins_config_t scan_pins = pins_config;
+            ri_adc_channel_config_t scan_config = absolute_config;
+            scan_pins.p_pin.channel = handle;
+            // Uninit stops channel of last handle.
+            m_handle = handle;
+
+            if (RATIOMETRIC == p_channels[ii].mode)
+            {
+                scan_config.vref = RI_ADC_VREF_EXTERNAL;
+            }
+
+            err_code |= ri_adc_configure (m_channel[handle], &scan_pins, &scan_config);
+        }
+    }
+
+    return err_code;
+}
+
+/** @brief Convert raw results of scan, VDD first so it is available for others. */
+static rd_status_t scan_convert (const rt_adc_scan_channel_t * const p_channels,
+                                 const size_t count, const int16_t * const p_raw,
+                                 float * const p_samples, bool * const p_vdd_scanned)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    ri_adc_get_data_t scan_options = options;
+
+    for (size_t ii = 0; ii < count; ii++)
+    {
+        if ( (RI_ADC_AINVDD == p_channels[ii].handle) && (ABSOLUTE == p_channels[ii].mode))
+        {
+            scan_options.divider = p_channels[ii].divider;
+            err_code |= ri_adc_raw_to_absolute (m_channel[RI_ADC_AINVDD], &scan_options,
+                                                p_raw[m_channel[RI_ADC_AINVDD]],
+                                                &p_samples[ii]);
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_vdd = p_samples[ii];
+                *p_vdd_scanned = true;
+                scan_options.vdd = m_vdd;
+            }
+        }
+    }
+
+    for (size_t ii = 0; ii < count; ii++)
+    {
+        const uint8_t channel = m_channel[p_channels[ii].handle];
+        scan_options.divider = p_channels[ii].divider;
+
+        if (RATIOMETRIC == p_channels[ii].mode)
+        {
+            err_code |= ri_adc_raw_to_ratio (channel, &scan_options, p_raw[channel],
+                                             &p_samples[ii]);
+        }
+        else if (RI_ADC_AINVDD != p_channels[ii].handle)
+        {
+            err_code |= ri_adc_raw_to_absolute (channel, &scan_options, p_raw[channel],
+                                                &p_samples[ii]);
+        }
+        else
+        {
+            // VDD was converted first.
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_scan_sample (rd_sensor_configuration_t * const configuration,
+                                const rt_adc_scan_channel_t * const p_channels,
+                                const size_t count, float * const p_samples)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == configuration) || (NULL == p_channels) || (NULL == p_samples))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == count) || (RI_ADC_CH_NUM < count))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0; ii < count; ii++)
+        {
+            p_samples[ii] = RD_FLOAT_INVALID;
+        }
+
+        err_code |= rt_adc_init();
+
+        if (RD_SUCCESS == err_code)
+        {
+            int16_t raw[RI_ADC_CH_NUM] = {0};
+            bool vdd_scanned = false;
+            err_code |= scan_configure (p_channels, count);
+
+            if (RD_SUCCESS == err_code)
+            {
+                err_code |= ri_adc_scan_raw_data (raw, count);
+            }
+
+            if (RD_SUCCESS == err_code)
+            {
+                err_code |= scan_convert (p_channels, count, raw, p_samples, &vdd_scanned);
+            }
+
+            err_code |= rt_adc_uninit();
+            // Uninit clears VDD sample.
+            m_vdd_sampled = vdd_scanned;
+
+            if (vdd_scanned && vdd_cache_is_enabled())
+            {
+                vdd_cache_update (m_vdd, rd_sensor_timestamp_get());
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_vdd_cache_configure (const uint32_t max_age_ms, const float threshold_v)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (threshold_v < 0.0F) || isnan (threshold_v))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        m_vdd_max_age_ms = max_age_ms;
+        m_vdd_threshold = threshold_v;
+        m_vdd_cached = false;
+        m_vdd_cache_ms = RD_UINT64_INVALID;
+        options.vdd = RD_ADC_USE_VDD;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_vdd_cache_get (float * const vdd)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == vdd)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (!m_vdd_cached)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        *vdd = options.vdd;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_stream_start (rd_sensor_configuration_t * const configuration,
+                                 const uint8_t handle, const rt_adc_mode_t mode,
+                                 uint32_t * const p_samplerate_hz,
+                                 int16_t * const p_buffers, const size_t count,
+                                 const rt_adc_stream_fp_t on_buffer)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == configuration) || (NULL == p_samplerate_hz) || (NULL == p_buffers)
+            || (NULL == on_buffer))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (0U == count)
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        err_code |= rt_adc_init();
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= rt_adc_configure_se (configuration, handle, mode);
+            m_stream_cb = on_buffer;
+            m_stream_count = count;
+            m_stream_overruns = 0;
+
+            for (size_t ii = 0; ii < RT_ADC_STREAM_BUFFERS; ii++)
+            {
+                m_stream_buffers[ii] = &p_buffers[ii * count];
+                m_stream_held[ii] = false;
+
+                if (RD_SUCCESS == err_code)
+                {
+                    err_code |= ri_adc_stream_buffer_put (m_stream_buffers[ii], count);
+                }
+            }
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_streaming = true;
+                err_code |= ri_adc_stream_start (m_channel[m_handle], p_samplerate_hz,
+                                                 &stream_isr);
+            }
+
+            if (RD_SUCCESS != err_code)
+            {
+                m_streaming = false;
+                err_code |= ri_adc_stream_stop();
+                err_code |= rt_adc_uninit();
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_stream_stop (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_streaming)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_streaming = false;
+        err_code |= ri_adc_stream_stop();
+        err_code |= rt_adc_uninit();
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adc_stream_convert (const int16_t * const p_raw, float * const p_values,
+                                   const size_t count)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_raw) || (NULL == p_values))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (!m_streaming)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        for (size_t ii = 0; (ii < count) && (RD_SUCCESS == err_code); ii++)
+        {
+            if (m_ratio)
+            {
+                err_code |= ri_adc_raw_to_ratio (m_channel[m_handle], &options, p_raw[ii],
+                                                 &p_values[ii]);
+            }
+            else
+            {
+                err_code |= ri_adc_raw_to_absolute (m_channel[m_handle], &options, p_raw[ii],
+                                                    &p_values[ii]);
+            }
+        }
+    }
+
+    return err_code;
+}
+
+uint32_t rt_adc_stream_overrun_count (void)
+{
+    return m_stream_overruns;
+}
 #endif
 /** @}*/
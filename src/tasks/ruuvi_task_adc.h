@@ -55,6 +55,8 @@
 #include "ruuvi_driver_error.h"
 #include "ruuvi_driver_sensor.h"
 #include "ruuvi_interface_log.h"
+#include <stddef.h>
+#include <stdint.h>
 
 typedef enum
 {
@@ -62,6 +64,23 @@ typedef enum
     ABSOLUTE        //!< ADC measures absolute voltage in volts
 } rt_adc_mode_t;  //!< ADC against absolute reference or ratio to VDD
 
+/** @brief One channel of @ref rt_adc_scan_sample. */
+typedef struct
+{
+    uint8_t handle;       //!< Handle to ADC, i.e. ADC pin.
+    rt_adc_mode_t mode;   //!< Sample in volts or as a ratio to VDD.
+    float divider;        //!< Voltage divider in front of pin, 1.0 if none.
+} rt_adc_scan_channel_t;
+
+/**
+ * @brief Called in scheduler context with a full buffer of stream.
+ *
+ * @param[in] p_samples Raw samples, valid until function returns.
+ *                      Convert with @ref rt_adc_stream_convert.
+ * @param[in] count Number of samples.
+ */
+typedef void (*rt_adc_stream_fp_t) (const int16_t * const p_samples, const size_t count);
+
 /**
  * @brief Reserve ADC
  *
@@ -179,6 +198,40 @@ rd_status_t rt_adc_vdd_sample (void);
  */
 rd_status_t rt_adc_vdd_get (float * const vdd);
 
+/**
+ * @brief Configure cache of VDD used to compensate conversions.
+ *
+ * Cache is disabled by default, conversions use nominal 3.3 V as before.
+ * When enabled, every VDD reading, e.g. @ref rt_adc_vdd_sample, absolute sample
+ * of RI_ADC_AINVDD or a scan including VDD, updates the cache. Absolute and
+ * ratiometric conversions use cached VDD. If cache is older than max_age_ms
+ * when a conversion is made, VDD is read once on the same ADC session before the
+ * conversion. Without timestamp source cache never expires.
+ *
+ * Configuration discards cached value, conversions use nominal 3.3 V until VDD is read.
+ * Defaults are @ref RT_ADC_VDD_MAX_AGE_MS and @ref RT_ADC_VDD_THRESHOLD_V.
+ *
+ * @param[in] max_age_ms Age after which VDD is read before next conversion,
+ *                       0 to disable cache.
+ * @param[in] threshold_v Cached VDD is replaced only if new reading differs
+ *                        by more than threshold, smaller changes only renew age.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_PARAM if threshold is negative or NaN.
+ */
+rd_status_t rt_adc_vdd_cache_configure (const uint32_t max_age_ms,
+                                        const float threshold_v);
+
+/**
+ * @brief Get VDD used to compensate conversions.
+ *
+ * @param[out] vdd Cached VDD in volts.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if vdd is NULL.
+ * @retval RD_ERROR_INVALID_STATE if cache is disabled or VDD has not been read
+ *                                 since configuration.
+ */
+rd_status_t rt_adc_vdd_cache_get (float * const vdd);
+
 /**
  * @brief Get absolute Voltage Sample from selected ADC handle
  *
@@ -210,5 +263,123 @@ rd_status_t rt_adc_absolute_sample (rd_sensor_configuration_t * const configurat
  */
 rd_status_t rt_adc_ratiometric_sample (rd_sensor_configuration_t * const configuration,
                                        const uint8_t handle, float * const sample);
+
+/**
+ * @brief Sample several ADC handles in one scan.
+ *
+ * This function initializes ADC, configures all channels, samples them in one scan
+ * and releases ADC. ADC is enabled and settled once regardless of the number of
+ * channels, e.g. battery, NTC and photodiode readings are taken together:
+ *
+ * @code{.c}
+ *  const rt_adc_scan_channel_t channels[] =
+ *  {
+ *      {.handle = RI_ADC_AINVDD, .mode = ABSOLUTE, .divider = 1.0F},
+ *      {.handle = RI_ADC_NTC_CHANNEL, .mode = RATIOMETRIC, .divider = 1.0F},
+ *      {.handle = RI_ADC_PHOTO_CHANNEL, .mode = ABSOLUTE, .divider = RI_ADC_PHOTO_DIVIDER}
+ *  };
+ *  float samples[3];
+ *  err_code = rt_adc_scan_sample (&configuration, channels, 3U, samples);
+ * @endcode
+ *
+ * Ratiometric channels are sampled against VDD. If VDD is scanned in absolute mode,
+ * value returned by @ref rt_adc_vdd_get is updated.
+ *
+ * @param[in] configuration Configuration of ADC.
+ * @param[in] p_channels Channels to sample, each handle at most once.
+ * @param[in] count Number of channels.
+ * @param[out] p_samples One sample per channel in order of p_channels,
+ *                       RD_FLOAT_INVALID if channel could not be sampled.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if count is 0 or handles are invalid or repeated.
+ * @retval RD_ERROR_INVALID_STATE if ADC is already initialized.
+ * @retval RD_ERROR_RESOURCES if there are more channels than ADC can scan.
+ * @retval RD_ERROR_TIMEOUT if ADC does not complete the scan.
+ * @return error code from stack on error.
+ */
+rd_status_t rt_adc_scan_sample (rd_sensor_configuration_t * const configuration,
+                                const rt_adc_scan_channel_t * const p_channels,
+                                const size_t count, float * const p_samples);
+
+/**
+ * @brief Sample one ADC handle continuously into ping-pong buffers.
+ *
+ * ADC fills one half of p_buffers while application processes the other half.
+ * Full halves are passed to on_buffer in scheduler context and returned to ADC
+ * after on_buffer returns. If application has not returned previous half when
+ * ADC fills next one, samples are lost until the half is returned, see
+ * @ref rt_adc_stream_overrun_count. ADC is reserved until @ref rt_adc_stream_stop.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  static int16_t buffers[2 * 256];
+ *  static void on_buffer (const int16_t * const p_samples, const size_t count)
+ *  {
+ *      float volts[256];
+ *      err_code = rt_adc_stream_convert (p_samples, volts, count);
+ *      // process e.g. vibration spectrum.
+ *  }
+ *
+ *  uint32_t rate = 10000;
+ *  err_code = rt_adc_stream_start (&configuration, RI_ADC_AIN1, ABSOLUTE, &rate,
+ *                                  buffers, 256, &on_buffer);
+ * @endcode
+ *
+ * @param[in] configuration Configuration of ADC.
+ * @param[in] handle Handle to ADC, i.e. ADC pin.
+ * @param[in] mode Sampling mode, @ref rt_adc_mode_t.
+ * @param[in,out] p_samplerate_hz Requested sample rate, actual rate on return.
+ * @param[in] p_buffers Buffer of 2 * count samples, must stay valid while streaming.
+ * @param[in] count Number of samples in each half of buffer.
+ * @param[in] on_buffer Called with each full half.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if count is 0.
+ * @retval RD_ERROR_INVALID_STATE if ADC is already initialized.
+ * @retval RD_ERROR_NOT_SUPPORTED if sample rate cannot be reached.
+ * @return error code from stack on error.
+ */
+rd_status_t rt_adc_stream_start (rd_sensor_configuration_t * const configuration,
+                                 const uint8_t handle, const rt_adc_mode_t mode,
+                                 uint32_t * const p_samplerate_hz,
+                                 int16_t * const p_buffers, const size_t count,
+                                 const rt_adc_stream_fp_t on_buffer);
+
+/**
+ * @brief Stop stream and release ADC.
+ *
+ * Buffers which are not processed yet are discarded.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if stream is not running.
+ * @return error code from stack on error.
+ */
+rd_status_t rt_adc_stream_stop (void);
+
+/**
+ * @brief Convert raw stream samples to volts or ratio to VDD by mode of stream.
+ *
+ * @param[in] p_raw Raw samples given to @ref rt_adc_stream_fp_t.
+ * @param[out] p_values Converted samples.
+ * @param[in] count Number of samples.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if either pointer is NULL.
+ * @retval RD_ERROR_INVALID_STATE if stream is not running.
+ * @return error code from stack on error.
+ */
+rd_status_t rt_adc_stream_convert (const int16_t * const p_raw, float * const p_values,
+                                   const size_t count);
+
+/**
+ * @brief Get number of times samples were lost since stream was started.
+ *
+ * Samples are lost if application processes buffers slower than ADC fills them
+ * or if scheduler queue is full.
+ *
+ * @return Number of overruns.
+ */
+uint32_t rt_adc_stream_overrun_count (void);
 /** @} */
 #endif // TASK_ADC_H
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_flash_batch.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_FLASH_BATCH_ENABLED
+
+#include "ruuvi_task_flash_batch.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#define AGE_MAX_MS (0xFFFFU) //!< Largest age representable in header.
+
+static inline rt_flash_batch_header_t * header (rt_flash_batch_t * const p_batch)
+{
+    return (rt_flash_batch_header_t *) p_batch->p_buffer;
+}
+
+static inline bool is_due (const rt_flash_batch_t * const p_batch, const uint64_t now)
+{
+    return (0U != p_batch->count)
+           && (0U != p_batch->max_age_ms)
+           && (now >= p_batch->first_ms)
+           && ( (now - p_batch->first_ms) >= p_batch->max_age_ms);
+}
+
+static rd_status_t batch_write (rt_flash_batch_t * const p_batch, const uint64_t now)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (0U != p_batch->count)
+    {
+        uint64_t age_ms = (now > p_batch->first_ms) ? (now - p_batch->first_ms) : 0U;
+
+        if (age_ms > AGE_MAX_MS)
+        {
+            age_ms = AGE_MAX_MS;
+        }
+
+        header (p_batch)->record_size = p_batch->record_size;
+        header (p_batch)->count = p_batch->count;
+        header (p_batch)->age_ms = (uint16_t) age_ms;
+        const size_t size = RT_FLASH_BATCH_BUFFER_SIZE (p_batch->record_size,
+                            p_batch->count);
+        err_code |= p_batch->write ( (uint16_t) size, p_batch->p_buffer);
+
+        if (RD_SUCCESS == err_code)
+        {
+            p_batch->count = 0;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_batch_init (rt_flash_batch_t * const p_batch,
+                                 uint8_t * const p_buffer, const size_t buffer_size,
+                                 const uint8_t record_size, const uint32_t max_age_ms,
+                                 const rt_flash_batch_write_fp write)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_batch) || (NULL == p_buffer) || (NULL == write))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == record_size)
+              || (buffer_size < RT_FLASH_BATCH_BUFFER_SIZE (record_size, 1U))
+              || (RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE < RT_FLASH_BATCH_BUFFER_SIZE (record_size, 1U)))
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        size_t max_records = (buffer_size - sizeof (rt_flash_batch_header_t)) / record_size;
+        // Log rejects entries larger than its maximum entry size.
+        const size_t entry_records = (RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE
+                                      - sizeof (rt_flash_batch_header_t)) / record_size;
+
+        if (max_records > entry_records)
+        {
+            max_records = entry_records;
+        }
+
+        if (max_records > RT_FLASH_BATCH_MAX_RECORDS)
+        {
+            max_records = RT_FLASH_BATCH_MAX_RECORDS;
+        }
+
+        memset (p_batch, 0, sizeof (rt_flash_batch_t));
+        p_batch->p_buffer = p_buffer;
+        p_batch->write = write;
+        p_batch->max_age_ms = max_age_ms;
+        p_batch->record_size = record_size;
+        p_batch->max_records = (uint8_t) max_records;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_batch_append (rt_flash_batch_t * const p_batch,
+                                   const void * const p_record)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_batch) || (NULL == p_record))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (NULL == p_batch->p_buffer)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        const uint64_t now = rd_sensor_timestamp_get();
+
+        // Previous write failed, try to make room.
+        if (p_batch->count >= p_batch->max_records)
+        {
+            err_code |= batch_write (p_batch, now);
+        }
+
+        if (p_batch->count >= p_batch->max_records)
+        {
+            err_code |= RD_ERROR_NO_MEM;
+        }
+        else
+        {
+            if (0U == p_batch->count)
+            {
+                p_batch->first_ms = now;
+            }
+
+            memcpy (p_batch->p_buffer + RT_FLASH_BATCH_BUFFER_SIZE (p_batch->record_size,
+                    p_batch->count), p_record, p_batch->record_size);
+            p_batch->count++;
+
+            if ( (p_batch->count >= p_batch->max_records) || is_due (p_batch, now))
+            {
+                err_code |= batch_write (p_batch, now);
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_batch_poll (rt_flash_batch_t * const p_batch)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_batch)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        const uint64_t now = rd_sensor_timestamp_get();
+
+        if (is_due (p_batch, now))
+        {
+            err_code |= batch_write (p_batch, now);
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_batch_flush (rt_flash_batch_t * const p_batch)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_batch)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (NULL == p_batch->p_buffer)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        err_code |= batch_write (p_batch, rd_sensor_timestamp_get());
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_batch_unpack (const void * const p_entry, const size_t entry_size,
+                                   const rt_flash_batch_record_fp handler,
+                                   void * const p_context)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_entry) || (NULL == handler))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (entry_size < sizeof (rt_flash_batch_header_t))
+    {
+        err_code |= RD_ERROR_INVALID_DATA;
+    }
+    else
+    {
+        rt_flash_batch_header_t head;
+        memcpy (&head, p_entry, sizeof (head));
+        const uint8_t * const p_records = (const uint8_t *) p_entry + sizeof (head);
+
+        if ( (0U == head.record_size)
+                || (entry_size != RT_FLASH_BATCH_BUFFER_SIZE (head.record_size, head.count)))
+        {
+            err_code |= RD_ERROR_INVALID_DATA;
+        }
+
+        for (size_t ii = 0; (ii < head.count) && (RD_SUCCESS == err_code); ii++)
+        {
+            err_code |= handler (p_records + (ii * head.record_size), head.record_size,
+                                 p_context);
+        }
+    }
+
+    return err_code;
+}
+
+/** @} */
+#endif
@@ -0,0 +1,172 @@
+#ifndef  RUUVI_TASK_FLASH_BATCH_H
+#define  RUUVI_TASK_FLASH_BATCH_H
+
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_flash_batch.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Stage fixed-size records in RAM and write them to log as one entry.
+ *
+ * Each entry appended to time series log costs a flash program and an index
+ * entry. Batching N records into one entry divides that cost by N.
+ * Batch is written when it is full, when oldest record is older than
+ * configured maximum age or when flushed explicitly.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  static uint8_t buffer[RT_FLASH_BATCH_BUFFER_SIZE (sizeof (record_t), 16)];
+ *  static rt_flash_batch_t batch;
+ *  rd_status_t err_code = RD_SUCCESS;
+ *  err_code = rt_flash_batch_init (&batch, buffer, sizeof (buffer), sizeof (record_t),
+ *                                  60000U, &rt_flash_ringbuffer_write);
+ *  RD_ERROR_CHECK(err_code, RD_SUCCESS);
+ *  err_code = rt_flash_batch_append (&batch, &record);
+ *  RD_ERROR_CHECK(err_code, RD_SUCCESS);
+ *  // Before going offline
+ *  err_code = rt_flash_batch_flush (&batch);
+ *
+ *  // In log read callback
+ *  err_code = rt_flash_batch_unpack (blob, blob_size, &record_handler, p_context);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Header of a batch entry in log. */
+typedef struct __attribute__ ( (packed))
+{
+    uint8_t record_size; //!< Size of each record, bytes.
+    uint8_t count;       //!< Number of records following the header.
+    uint16_t age_ms;     //!< Time from first record to write, saturates at 0xFFFF.
+} rt_flash_batch_header_t;
+
+/** @brief Bytes of buffer required for given number of records. */
+#define RT_FLASH_BATCH_BUFFER_SIZE(record_size, records) \
+    (sizeof (rt_flash_batch_header_t) + ((record_size) * (records)))
+
+/** @brief Maximum number of records in one batch. */
+#define RT_FLASH_BATCH_MAX_RECORDS (255U)
+
+/**
+ * @brief Write a batch entry to log, signature of @ref rt_flash_ringbuffer_write.
+ *
+ * @param[in] size Size of entry.
+ * @param[in] data Entry.
+ * @return RD_SUCCESS if entry was written, error code otherwise.
+ */
+typedef rd_status_t (*rt_flash_batch_write_fp) (const uint16_t size, const void * data);
+
+/**
+ * @brief Handle one record unpacked from a batch.
+ *
+ * @param[in] p_record Record.
+ * @param[in] record_size Size of record.
+ * @param[in] p_context Context given to @ref rt_flash_batch_unpack.
+ * @return RD_SUCCESS to continue, error code to stop unpacking.
+ */
+typedef rd_status_t (*rt_flash_batch_record_fp) (const void * const p_record,
+        const size_t record_size, void * const p_context);
+
+/** @brief State of a batch. Members are private, use functions of this module. */
+typedef struct
+{
+    uint8_t * p_buffer;            //!< Header and staged records.
+    rt_flash_batch_write_fp write; //!< Writes batch to log.
+    uint64_t first_ms;             //!< Time of first staged record.
+    uint32_t max_age_ms;           //!< Write batch once first record is this old, 0 to disable.
+    uint8_t record_size;           //!< Size of each record.
+    uint8_t max_records;           //!< Records fitting in buffer.
+    uint8_t count;                 //!< Records staged.
+} rt_flash_batch_t;
+
+/**
+ * @brief Initialize a batch.
+ *
+ * @param[out] p_batch Batch to initialize.
+ * @param[in] p_buffer Buffer for staged records. Must live as long as batch.
+ * @param[in] buffer_size Size of p_buffer, @ref RT_FLASH_BATCH_BUFFER_SIZE. Records
+ *                        beyond @ref RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE of batch
+ *                        entry are not used.
+ * @param[in] record_size Size of each record.
+ * @param[in] max_age_ms Maximum time a record is kept in RAM, 0 for no limit.
+ * @param[in] write Function to write batch to log, e.g. @ref rt_flash_ringbuffer_write.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_LENGTH if record_size is 0 or buffer or log entry
+ *                                 cannot hold one record.
+ */
+rd_status_t rt_flash_batch_init (rt_flash_batch_t * const p_batch,
+                                 uint8_t * const p_buffer, const size_t buffer_size,
+                                 const uint8_t record_size, const uint32_t max_age_ms,
+                                 const rt_flash_batch_write_fp write);
+
+/**
+ * @brief Stage a record, write batch if it becomes full or too old.
+ *
+ * @param[in,out] p_batch Batch to append to.
+ * @param[in] p_record Record of record_size bytes.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_STATE if batch is not initialized.
+ * @retval RD_ERROR_NO_MEM if batch is full and cannot be written. Record is not staged.
+ * @return Error code of write function if batch could not be written.
+ *         Record is staged and write is retried on next append or flush.
+ */
+rd_status_t rt_flash_batch_append (rt_flash_batch_t * const p_batch,
+                                   const void * const p_record);
+
+/**
+ * @brief Write batch if first staged record is older than maximum age.
+ *
+ * Call periodically if records are appended rarely.
+ *
+ * @param[in,out] p_batch Batch to check.
+ * @retval RD_SUCCESS if batch was not due or was written.
+ * @retval RD_ERROR_NULL if p_batch is NULL.
+ * @return Error code of write function if batch could not be written.
+ */
+rd_status_t rt_flash_batch_poll (rt_flash_batch_t * const p_batch);
+
+/**
+ * @brief Write all staged records now.
+ *
+ * @param[in,out] p_batch Batch to write.
+ * @retval RD_SUCCESS if batch was written or there was nothing to write.
+ * @retval RD_ERROR_NULL if p_batch is NULL.
+ * @retval RD_ERROR_INVALID_STATE if batch is not initialized.
+ * @return Error code of write function if batch could not be written.
+ *         Records stay staged.
+ */
+rd_status_t rt_flash_batch_flush (rt_flash_batch_t * const p_batch);
+
+/**
+ * @brief Call handler for each record of a batch entry read from log.
+ *
+ * @param[in] p_entry Entry as written by batch.
+ * @param[in] entry_size Size of entry.
+ * @param[in] handler Called for each record, oldest first.
+ * @param[in] p_context Passed to handler.
+ *
+ * @retval RD_SUCCESS if all records were handled.
+ * @retval RD_ERROR_NULL if p_entry or handler is NULL.
+ * @retval RD_ERROR_INVALID_DATA if entry size does not match header.
+ * @return Error code of handler if handler stopped unpacking.
+ */
+rd_status_t rt_flash_batch_unpack (const void * const p_entry, const size_t entry_size,
+                                   const rt_flash_batch_record_fp handler,
+                                   void * const p_context);
+
+/** @} */
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_flash_codec.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_FLASH_CODEC_ENABLED
+
+#include "ruuvi_task_flash_codec.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#define NUM_AXIS          (3U)    //!< X, Y, Z.
+#define VARINT_DATA_BITS  (7U)    //!< Payload bits in each varint byte.
+#define VARINT_DATA_MASK  (0x7FU) //!< Payload of varint byte.
+#define VARINT_MORE       (0x80U) //!< Varint continues on next byte.
+
+static inline uint16_t zigzag (const int16_t value)
+{
+    return (uint16_t) ( ( (uint16_t) value << 1U) ^ (uint16_t) (value >> 15U));
+}
+
+static inline int16_t unzigzag (const uint16_t value)
+{
+    return (int16_t) ( (uint16_t) (value >> 1U) ^ (uint16_t) (0U - (value & 1U)));
+}
+
+/**
+ * Difference of each sample to previous, zig-zag mapped. First sample is
+ * difference to 0. Differences wrap around in 16 bits, decoder wraps back.
+ * Kept free of branches so that compiler can vectorize it.
+ */
+static void axis_deltas (const int16_t * const p_in, uint16_t * const p_out,
+                         const size_t count)
+{
+    if (count > 0U)
+    {
+        p_out[0] = zigzag (p_in[0]);
+    }
+
+    for (size_t ii = 1U; ii < count; ii++)
+    {
+        p_out[ii] = zigzag ( (int16_t) (uint16_t) ( (uint16_t) p_in[ii] - (uint16_t) p_in[ii - 1U]));
+    }
+}
+
+static size_t varint_put (uint8_t * const p_out, uint32_t value)
+{
+    size_t len = 0;
+
+    while (value > VARINT_DATA_MASK)
+    {
+        p_out[len++] = (uint8_t) ( (value & VARINT_DATA_MASK) | VARINT_MORE);
+        value >>= VARINT_DATA_BITS;
+    }
+
+    p_out[len++] = (uint8_t) value;
+    return len;
+}
+
+/** Returns number of bytes consumed, 0 if varint is truncated or too long. */
+static size_t varint_get (const uint8_t * const p_in, const size_t size,
+                          uint32_t * const p_value)
+{
+    uint32_t value = 0;
+    size_t len = 0;
+    bool more = true;
+
+    while (more && (len < size) && (len < RT_FLASH_CODEC_VARINT_MAX))
+    {
+        value |= (uint32_t) (p_in[len] & VARINT_DATA_MASK) << (VARINT_DATA_BITS * len);
+        more = (0U != (p_in[len] & VARINT_MORE));
+        len++;
+    }
+
+    *p_value = value;
+    return more ? 0U : len;
+}
+
+rd_status_t rt_flash_codec_encode (const rd_sensor_fifo_block_t * const p_block,
+                                   uint8_t * const p_out, size_t * const p_size,
+                                   uint8_t * const p_encoded)
+{
+    if ( (NULL == p_block) || (NULL == p_out) || (NULL == p_size) || (NULL == p_encoded))
+    {
+        return RD_ERROR_NULL;
+    }
+
+    if (p_block->count > RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES)
+    {
+        return RD_ERROR_INVALID_PARAM;
+    }
+
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t header[RT_FLASH_CODEC_HEADER_SIZE + RT_FLASH_CODEC_VARINT_MAX];
+    const uint64_t timestamp_ms = p_block->timestamp_ms;
+    size_t pos = 0;
+    header[pos++] = RT_FLASH_CODEC_FORMAT;
+    header[pos++] = 0;
+
+    for (size_t ii = 0; ii < sizeof (timestamp_ms); ii++)
+    {
+        header[pos++] = (uint8_t) (timestamp_ms >> (8U * ii));
+    }
+
+    pos += varint_put (&header[pos], p_block->interval_us);
+    *p_encoded = 0;
+
+    if (*p_size < (pos + ( (p_block->count > 0U) ? RT_FLASH_CODEC_SAMPLE_MAX : 0U)))
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        int16_t axis[NUM_AXIS][RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES];
+        uint16_t deltas[NUM_AXIS][RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES];
+        memcpy (axis[0], &p_block->x[0], sizeof (axis[0]));
+        memcpy (axis[1], &p_block->y[0], sizeof (axis[1]));
+        memcpy (axis[2], &p_block->z[0], sizeof (axis[2]));
+
+        for (size_t aa = 0; aa < NUM_AXIS; aa++)
+        {
+            axis_deltas (axis[aa], deltas[aa], p_block->count);
+        }
+
+        memcpy (p_out, header, pos);
+        uint8_t count = 0;
+
+        for (; count < p_block->count; count++)
+        {
+            uint8_t sample[RT_FLASH_CODEC_SAMPLE_MAX];
+            size_t len = 0;
+
+            for (size_t aa = 0; aa < NUM_AXIS; aa++)
+            {
+                len += varint_put (&sample[len], deltas[aa][count]);
+            }
+
+            if ( (pos + len) > *p_size)
+            {
+                err_code |= RD_ERROR_DATA_SIZE;
+                break;
+            }
+
+            memcpy (&p_out[pos], sample, len);
+            pos += len;
+        }
+
+        p_out[1] = count;
+        *p_encoded = count;
+        *p_size = pos;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_flash_codec_decode (const uint8_t * const p_in, const size_t size,
+                                   rd_sensor_fifo_block_t * const p_block)
+{
+    if ( (NULL == p_in) || (NULL == p_block))
+    {
+        return RD_ERROR_NULL;
+    }
+
+    if ( (size < (RT_FLASH_CODEC_HEADER_SIZE + 1U))
+            || (RT_FLASH_CODEC_FORMAT != p_in[0])
+            || (p_in[1] > RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES))
+    {
+        return RD_ERROR_INVALID_DATA;
+    }
+
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t timestamp_ms = 0;
+    uint32_t value = 0;
+    size_t pos = 2U;
+    size_t len = 0;
+
+    for (size_t ii = 0; ii < sizeof (timestamp_ms); ii++)
+    {
+        timestamp_ms |= (uint64_t) p_in[pos++] << (8U * ii);
+    }
+
+    memset (p_block, 0, sizeof (rd_sensor_fifo_block_t));
+    p_block->timestamp_ms = timestamp_ms;
+    len = varint_get (&p_in[pos], size - pos, &value);
+    p_block->interval_us = value;
+    pos += len;
+
+    if (0U == len)
+    {
+        err_code |= RD_ERROR_INVALID_DATA;
+    }
+
+    int16_t previous[NUM_AXIS] = {0};
+    int16_t axis[NUM_AXIS][RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES] = {0};
+
+    for (size_t ii = 0; (ii < p_in[1]) && (RD_SUCCESS == err_code); ii++)
+    {
+        for (size_t aa = 0; (aa < NUM_AXIS) && (RD_SUCCESS == err_code); aa++)
+        {
+            len = varint_get (&p_in[pos], size - pos, &value);
+            pos += len;
+
+            if ( (0U == len) || (value > UINT16_MAX))
+            {
+                err_code |= RD_ERROR_INVALID_DATA;
+            }
+            else
+            {
+                previous[aa] = (int16_t) (uint16_t) ( (uint16_t) previous[aa]
+                                                      + (uint16_t) unzigzag ( (uint16_t) value));
+                axis[aa][ii] = previous[aa];
+            }
+        }
+    }
+
+    if ( (RD_SUCCESS == err_code) && (pos != size))
+    {
+        err_code |= RD_ERROR_INVALID_DATA;
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        p_block->count = p_in[1];
+        memcpy (&p_block->x[0], axis[0], sizeof (axis[0]));
+        memcpy (&p_block->y[0], axis[1], sizeof (axis[1]));
+        memcpy (&p_block->z[0], axis[2], sizeof (axis[2]));
+    }
+
+    return err_code;
+}
+
+/** @} */
+#endif
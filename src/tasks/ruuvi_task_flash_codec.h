@@ -0,0 +1,94 @@
+#ifndef  RUUVI_TASK_FLASH_CODEC_H
+#define  RUUVI_TASK_FLASH_CODEC_H
+
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_flash_codec.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Compress blocks of 3-axis samples for logging.
+ *
+ * Consecutive samples of accelerometer are close to each other, so each axis
+ * is stored as difference to previous sample. Differences are zig-zag mapped
+ * to unsigned and written as variable length integers, 7 bits per byte.
+ * Sensor at rest compresses to about one byte per axis per sample,
+ * worst case is three bytes.
+ *
+ * Encoded format, little endian:
+ * | Bytes | Content                                         |
+ * |-------|-------------------------------------------------|
+ * | 1     | Format, @ref RT_FLASH_CODEC_FORMAT              |
+ * | 1     | Number of samples                               |
+ * | 8     | Timestamp of first sample, ms                   |
+ * | 1...5 | Sample interval, us, varint                     |
+ * | 3...9 | Per sample X, Y, Z delta to previous, varint    |
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+ *  size_t size = sizeof (encoded);
+ *  uint8_t samples = 0;
+ *  err_code = rt_flash_codec_encode (&block, encoded, &size, &samples);
+ *  ...
+ *  err_code = rt_flash_codec_decode (encoded, size, &block);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RT_FLASH_CODEC_FORMAT       (1U)  //!< Format identifier of encoded block.
+#define RT_FLASH_CODEC_HEADER_SIZE  (10U) //!< Format, count and timestamp.
+#define RT_FLASH_CODEC_VARINT_MAX   (5U)  //!< Largest 32-bit varint.
+#define RT_FLASH_CODEC_SAMPLE_MAX   (9U)  //!< Largest encoded sample, 3 x 3 bytes.
+/** @brief Size needed to encode any block. */
+#define RT_FLASH_CODEC_MAX_SIZE (RT_FLASH_CODEC_HEADER_SIZE + RT_FLASH_CODEC_VARINT_MAX \
+                                 + (RT_FLASH_CODEC_SAMPLE_MAX * RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES))
+
+/**
+ * @brief Encode a block.
+ *
+ * Encodes as many samples as fit in output, oldest first. If not all samples
+ * fit, encode the rest as a new block starting from sample p_encoded.
+ *
+ * @param[in] p_block Block to encode.
+ * @param[out] p_out Output buffer.
+ * @param[in,out] p_size Input: size of p_out. Output: bytes written.
+ * @param[out] p_encoded Number of samples encoded.
+ *
+ * @retval RD_SUCCESS if all samples were encoded.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if block has more than
+ *                                RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES samples.
+ * @retval RD_ERROR_DATA_SIZE if some samples did not fit, output is valid.
+ * @retval RD_ERROR_NO_MEM if output cannot hold header and one sample.
+ */
+rd_status_t rt_flash_codec_encode (const rd_sensor_fifo_block_t * const p_block,
+                                   uint8_t * const p_out, size_t * const p_size,
+                                   uint8_t * const p_encoded);
+
+/**
+ * @brief Decode a block.
+ *
+ * @param[in] p_in Encoded block.
+ * @param[in] size Size of encoded block.
+ * @param[out] p_block Decoded block.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_DATA if encoded block is malformed or truncated.
+ */
+rd_status_t rt_flash_codec_decode (const uint8_t * const p_in, const size_t size,
+                                   rd_sensor_fifo_block_t * const p_block);
+
+/** @} */
+#endif
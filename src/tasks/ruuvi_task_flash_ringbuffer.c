@@ -11,8 +11,15 @@
 #include "ruuvi_driver_sensor.h"
 #include "ruuvi_interface_communication.h"
 #include "ruuvi_task_flash.h"
+#include "ruuvi_task_flash_codec.h"
 #include "ruuvi_task_flash_ringbuffer.h"
 #include "ruuvi_task_flashdb.h"
+#if RT_STREAM_ENABLED
+#include "ruuvi_task_stream.h"
+#endif
+#if RT_MACRONIX_GOVERNOR_ENABLED
+#include "ruuvi_task_macronix_governor.h"
+#endif
 #include "fds.h"
 #include <string.h>
 
@@ -48,6 +55,9 @@ static inline void LOGDf (const char * const msg, ...)
 #endif
 
 
+/* Maximum size of one ringbuffer entry */
+#define RINGBUFFER_ENTRY_MAX_SIZE RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE
+
 /* TSDB object */
 static struct fdb_tsdb tsdb;
 
@@ -59,7 +69,7 @@ rd_status_t rt_flash_ringbuffer_create (const char *partition, fdb_get_time get_
   /* Time Series database initialization
    */
   memset(&tsdb, 0, sizeof(tsdb));
-  fdb_err_t result = fdb_tsdb_init(&tsdb, "acceleration_data", partition, get_time, 144, NULL);
+  fdb_err_t result = fdb_tsdb_init(&tsdb, "acceleration_data", partition, get_time, RINGBUFFER_ENTRY_MAX_SIZE, NULL);
 
   // Log result
   if (result==FDB_NO_ERR) {
@@ -85,7 +95,14 @@ rd_status_t rt_flash_ringbuffer_write (const uint16_t size, const void* data)
   fdb_err_t result;
   struct fdb_blob blob;
   
+#if RT_MACRONIX_GOVERNOR_ENABLED
+  // Single append does not switch mode, but keeps high performance mode of a batch alive.
+  (void) rt_macronix_governor_work_begin(1U);
+#endif
   result = fdb_tsl_append(&tsdb, fdb_blob_make(&blob, data, size));
+#if RT_MACRONIX_GOVERNOR_ENABLED
+  (void) rt_macronix_governor_work_end(1U);
+#endif
 
   // Log result
   if (result!=FDB_NO_ERR) {
@@ -95,12 +112,245 @@ rd_status_t rt_flash_ringbuffer_write (const uint16_t size, const void* data)
   return rt_flashdb_to_ruuvi_error(result);
 }
 
+rd_status_t rt_flash_ringbuffer_write_block (const rd_sensor_fifo_block_t * const p_block)
+{
+  if(NULL == p_block) {
+    return RD_ERROR_NULL;
+  }
+
+  rd_status_t err_code = RD_SUCCESS;
+  rd_sensor_fifo_block_t remaining;
+  size_t written = 0;
+  memcpy(&remaining, p_block, sizeof(remaining));
+
+  do {
+    uint8_t encoded[RINGBUFFER_ENTRY_MAX_SIZE];
+    size_t size = sizeof(encoded);
+    uint8_t samples = 0;
+    rd_status_t codec_err = rt_flash_codec_encode(&remaining, encoded, &size, &samples);
+
+    // Partial block is fine, rest is written to next entry
+    if(RD_SUCCESS != (codec_err & ~RD_ERROR_DATA_SIZE)) {
+      err_code |= codec_err;
+      break;
+    }
+
+    err_code |= rt_flash_ringbuffer_write((uint16_t)size, encoded);
+
+    // Drop encoded samples from block, next entry starts at first remaining sample.
+    // Timestamp is computed from start of block to not accumulate truncation.
+    written += samples;
+    remaining.count -= samples;
+    remaining.timestamp_ms = p_block->timestamp_ms
+                             + (((uint64_t)written * p_block->interval_us) / 1000U);
+    memmove(&remaining.x[0], &remaining.x[samples], remaining.count * sizeof(remaining.x[0]));
+    memmove(&remaining.y[0], &remaining.y[samples], remaining.count * sizeof(remaining.y[0]));
+    memmove(&remaining.z[0], &remaining.z[samples], remaining.count * sizeof(remaining.z[0]));
+  } while((RD_SUCCESS == err_code) && (remaining.count > 0));
+
+  return err_code;
+}
+
+rd_status_t rt_flash_ringbuffer_read_block (fdb_tsl_t tsl, rd_sensor_fifo_block_t * const p_block)
+{
+  if((NULL == tsl) || (NULL == p_block)) {
+    return RD_ERROR_NULL;
+  }
+
+  if(tsl->log_len > RINGBUFFER_ENTRY_MAX_SIZE) {
+    return RD_ERROR_INVALID_DATA;
+  }
+
+  uint8_t encoded[RINGBUFFER_ENTRY_MAX_SIZE];
+  struct fdb_blob blob;
+  size_t size = fdb_blob_read((fdb_db_t)&tsdb, fdb_tsl_to_blob(tsl, fdb_blob_make(&blob, encoded, tsl->log_len)));
+
+  return rt_flash_codec_decode(encoded, size, p_block);
+}
+
 void rt_flash_ringbuffer_read (const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc) 
 {
   void *args[3] = { &tsdb, reply_fp, crc };
   fdb_tsl_iter(&tsdb, callback, args );
 }
 
+/* State of one range read, given to range_cb */
+typedef struct
+{
+  rt_flash_ringbuffer_cursor_t * p_cursor;
+  fdb_tsl_cb callback;
+  void ** args;
+  uint32_t seen;  // Entries at p_cursor->next_ms seen during this read
+  bool stopped;
+} range_read_t;
+
+static bool range_cb (fdb_tsl_t tsl, void * arg)
+{
+  range_read_t * const p_read = (range_read_t *) arg;
+  rt_flash_ringbuffer_cursor_t * const p_cursor = p_read->p_cursor;
+  bool stop = false;
+
+  if((tsl->time == p_cursor->next_ms) && (p_read->seen < p_cursor->delivered)) {
+    // Delivered before interruption
+    p_read->seen++;
+  } else if(p_read->callback(tsl, p_read->args)) {
+    p_read->stopped = true;
+    stop = true;
+  } else if(tsl->time == p_cursor->next_ms) {
+    p_read->seen++;
+    p_cursor->delivered++;
+  } else {
+    p_cursor->next_ms = tsl->time;
+    p_cursor->delivered = 1;
+    p_read->seen = 1;
+  }
+
+  return stop;
+}
+
+/* Deliver entries from cursor to callback until callback stops or range ends */
+static rd_status_t cursor_read (rt_flash_ringbuffer_cursor_t * const p_cursor,
+    const fdb_tsl_cb callback, void ** const args)
+{
+  range_read_t read = {
+    .p_cursor = p_cursor,
+    .callback = callback,
+    .args = args,
+    .seen = 0,
+    .stopped = false
+  };
+
+  fdb_tsl_iter_by_time(&tsdb, p_cursor->next_ms, p_cursor->to_ms, range_cb, &read);
+  p_cursor->complete = !read.stopped;
+
+  return read.stopped ? RD_STATUS_MORE_AVAILABLE : RD_SUCCESS;
+}
+
+rd_status_t rt_flash_ringbuffer_cursor_init (rt_flash_ringbuffer_cursor_t * const p_cursor,
+    const fdb_time_t from_ms, const fdb_time_t to_ms)
+{
+  if(NULL == p_cursor) {
+    return RD_ERROR_NULL;
+  }
+
+  // Reverse iteration would break resuming
+  if(from_ms > to_ms) {
+    return RD_ERROR_INVALID_PARAM;
+  }
+
+  memset(p_cursor, 0, sizeof(rt_flash_ringbuffer_cursor_t));
+  p_cursor->next_ms = from_ms;
+  p_cursor->to_ms = to_ms;
+
+  return RD_SUCCESS;
+}
+
+rd_status_t rt_flash_ringbuffer_read_range (const fdb_time_t from_ms, const fdb_time_t to_ms,
+    const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc)
+{
+  rt_flash_ringbuffer_cursor_t cursor;
+  rd_status_t err_code = rt_flash_ringbuffer_cursor_init(&cursor, from_ms, to_ms);
+
+  if(RD_SUCCESS == err_code) {
+    err_code |= rt_flash_ringbuffer_read_cursor(&cursor, callback, reply_fp, crc);
+  }
+
+  return err_code;
+}
+
+rd_status_t rt_flash_ringbuffer_read_cursor (rt_flash_ringbuffer_cursor_t * const p_cursor,
+    const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc)
+{
+  if((NULL == p_cursor) || (NULL == callback)) {
+    return RD_ERROR_NULL;
+  }
+
+  if(p_cursor->complete) {
+    return RD_SUCCESS;
+  }
+
+  void *args[3] = { &tsdb, reply_fp, crc };
+
+  return cursor_read(p_cursor, callback, args);
+}
+
+#if RT_STREAM_ENABLED
+/* Destination of one entry read for stream */
+typedef struct
+{
+  uint8_t * p_record;
+  size_t * p_size;
+  rd_status_t err_code;
+  bool read;
+} stream_entry_t;
+
+/* Read first entry given, stop on the next one */
+static bool stream_entry_cb (fdb_tsl_t tsl, void * arg)
+{
+  void ** const args = (void **) arg;
+  stream_entry_t * const p_entry = (stream_entry_t *) args[1];
+  bool stop = true;
+
+  if(p_entry->read) {
+    // Next entry is read on next call.
+  } else if(tsl->log_len > *p_entry->p_size) {
+    p_entry->err_code |= RD_ERROR_DATA_SIZE;
+  } else {
+    struct fdb_blob blob;
+    *p_entry->p_size = fdb_blob_read((fdb_db_t) args[0],
+                                     fdb_tsl_to_blob(tsl, fdb_blob_make(&blob, p_entry->p_record, tsl->log_len)));
+    p_entry->read = true;
+    stop = false;
+  }
+
+  return stop;
+}
+
+rd_status_t rt_flash_ringbuffer_stream_read (void * const p_context,
+    rt_stream_position_t * const p_position, uint8_t * const p_record, size_t * const p_size)
+{
+  if((NULL == p_context) || (NULL == p_position) || (NULL == p_record) || (NULL == p_size)) {
+    return RD_ERROR_NULL;
+  }
+
+  const rt_flash_ringbuffer_stream_t * const p_range = (const rt_flash_ringbuffer_stream_t *) p_context;
+
+  if(p_range->from_ms > p_range->to_ms) {
+    return RD_ERROR_INVALID_PARAM;
+  }
+
+  // Position is offset of cursor timestamp from start of range and entries delivered at it.
+  rt_flash_ringbuffer_cursor_t cursor = {
+    .next_ms = (fdb_time_t)((int64_t)p_range->from_ms + (int64_t)(*p_position >> 32U)),
+    .to_ms = p_range->to_ms,
+    .delivered = (uint32_t)(*p_position & UINT32_MAX),
+    .complete = false
+  };
+  stream_entry_t entry = {
+    .p_record = p_record,
+    .p_size = p_size,
+    .err_code = RD_SUCCESS,
+    .read = false
+  };
+  void *args[2] = { &tsdb, &entry };
+
+  (void) cursor_read(&cursor, stream_entry_cb, args);
+
+  if(RD_SUCCESS != entry.err_code) {
+    return entry.err_code;
+  }
+
+  if(!entry.read) {
+    return RD_ERROR_NOT_FOUND;
+  }
+
+  *p_position = ((uint64_t)(uint32_t)((int64_t)cursor.next_ms - p_range->from_ms) << 32U)
+                | cursor.delivered;
+
+  return RD_SUCCESS;
+}
+#endif
+
 rd_status_t rt_flash_ringbuffer_clear (void) {
 
   // change to high performance mode during flashDB initialization for quicker setup
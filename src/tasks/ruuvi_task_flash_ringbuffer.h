@@ -11,9 +11,14 @@
 
 #if APP_SENSOR_LOGGING
 
+#include "ruuvi_driver_enabled_modules.h"
 #include "ruuvi_driver_error.h"
 #include "ruuvi_driver_sensor.h"
+#include "ruuvi_interface_communication.h"
 #include "flashdb.h"
+#if RT_STREAM_ENABLED
+#include "ruuvi_task_stream.h"
+#endif
 
 /*
  *  Creates a new ringbuffer, reserves the pages in flash and initializes the state
@@ -34,15 +39,126 @@ rd_status_t rt_flash_ringbuffer_write (
     const void* data
 );
 
+/*
+ *  Compress and write a block of 3-axis samples to ringbuffer.
+ *  Block is split to several entries if compressed block does not fit one entry.
+ *
+ * @param[in] p_block Block of samples, e.g. from LIS2DH12 FIFO.
+ */
+rd_status_t rt_flash_ringbuffer_write_block (const rd_sensor_fifo_block_t * const p_block);
+
+/*
+ *  Decode an entry written by rt_flash_ringbuffer_write_block.
+ *  To be used in callback of rt_flash_ringbuffer_read.
+ *
+ * @param[in] tsl Entry given to read callback.
+ * @param[out] p_block Decoded block.
+ */
+rd_status_t rt_flash_ringbuffer_read_block (fdb_tsl_t tsl, rd_sensor_fifo_block_t * const p_block);
+
 /*
  *  Read the whole ringbuffer
  *
+ *  Entries are given to callback as stored. Ringbuffer holds both records of
+ *  rt_flash_ringbuffer_write and compressed blocks of
+ *  rt_flash_ringbuffer_write_block, callback which knows the entry is a block
+ *  decodes it with rt_flash_ringbuffer_read_block.
+ *
  * @param[in] callback Callback function which processes the data
  * @param[in] reply_fp reply function for transmitting the data
  * @param[in] crc Pointer to CRC which gets calculated during sending the data
  */
 void rt_flash_ringbuffer_read (const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc);
 
+/*
+ *  Position of a range read, allows continuing an interrupted transfer.
+ *  Entries are identified by timestamp and the number of entries with the same
+ *  timestamp already delivered, as several entries may share a timestamp.
+ */
+typedef struct
+{
+  fdb_time_t next_ms;   //!< Timestamp of next entry to deliver.
+  fdb_time_t to_ms;     //!< Last timestamp of range, inclusive.
+  uint32_t delivered;   //!< Entries with timestamp next_ms already delivered.
+  bool complete;        //!< All entries of range have been delivered.
+} rt_flash_ringbuffer_cursor_t;
+
+/*
+ *  Initialize cursor to read entries between given timestamps.
+ *
+ * @param[out] p_cursor Cursor to initialize.
+ * @param[in] from_ms First timestamp to read, inclusive.
+ * @param[in] to_ms Last timestamp to read, inclusive.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_cursor is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if from_ms is after to_ms.
+ */
+rd_status_t rt_flash_ringbuffer_cursor_init (rt_flash_ringbuffer_cursor_t * const p_cursor,
+    const fdb_time_t from_ms, const fdb_time_t to_ms);
+
+/*
+ *  Read entries between given timestamps.
+ *  Only sectors overlapping the range are read.
+ *
+ * @param[in] from_ms First timestamp to read, inclusive.
+ * @param[in] to_ms Last timestamp to read, inclusive.
+ * @param[in] callback Callback function which processes the data, same as in rt_flash_ringbuffer_read.
+ * @param[in] reply_fp reply function for transmitting the data
+ * @param[in] crc Pointer to CRC which gets calculated during sending the data
+ * @retval RD_SUCCESS if all entries in range were processed.
+ * @retval RD_STATUS_MORE_AVAILABLE if callback stopped the read.
+ * @retval RD_ERROR_INVALID_PARAM if from_ms is after to_ms.
+ */
+rd_status_t rt_flash_ringbuffer_read_range (const fdb_time_t from_ms, const fdb_time_t to_ms,
+    const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc);
+
+/*
+ *  Continue reading entries from cursor.
+ *  Entry counts as delivered when callback returns false. If callback returns
+ *  true, e.g. because link was lost, read stops and the same entry is given
+ *  to callback first on next call.
+ *
+ * @param[in,out] p_cursor Cursor from rt_flash_ringbuffer_cursor_init.
+ * @param[in] callback Callback function which processes the data, same as in rt_flash_ringbuffer_read.
+ * @param[in] reply_fp reply function for transmitting the data
+ * @param[in] crc Pointer to CRC which gets calculated during sending the data
+ * @retval RD_SUCCESS if all entries in range have been delivered.
+ * @retval RD_STATUS_MORE_AVAILABLE if callback stopped the read.
+ * @retval RD_ERROR_NULL if p_cursor or callback is NULL.
+ */
+rd_status_t rt_flash_ringbuffer_read_cursor (rt_flash_ringbuffer_cursor_t * const p_cursor,
+    const fdb_tsl_cb callback, const ri_comm_xfer_fp_t reply_fp, uint16_t* crc);
+
+#if RT_STREAM_ENABLED
+/*
+ *  Range of log to stream, context of rt_flash_ringbuffer_stream_read.
+ */
+typedef struct
+{
+  fdb_time_t from_ms;   //!< First timestamp to stream, inclusive.
+  fdb_time_t to_ms;     //!< Last timestamp to stream, inclusive.
+} rt_flash_ringbuffer_stream_t;
+
+/*
+ *  Read log entries of a range to rt_stream, signature of rt_stream_read_fp.
+ *  Stream position holds a cursor of the range, each read continues from
+ *  previous entry with rt_flash_ringbuffer_read_cursor instead of counting
+ *  entries from start of range.
+ *
+ * @param[in] p_context Range, rt_flash_ringbuffer_stream_t.
+ * @param[in,out] p_position Cursor, RT_STREAM_POSITION_START for start of range.
+ * @param[out] p_record Entry.
+ * @param[in,out] p_size Input: space in p_record. Output: size of entry.
+ * @retval RD_SUCCESS if entry was read.
+ * @retval RD_ERROR_NOT_FOUND if there are no more entries in range.
+ * @retval RD_ERROR_DATA_SIZE if entry does not fit p_record.
+ * @retval RD_ERROR_INVALID_PARAM if from_ms is after to_ms.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ */
+rd_status_t rt_flash_ringbuffer_stream_read (void * const p_context,
+    rt_stream_position_t * const p_position, uint8_t * const p_record, size_t * const p_size);
+#endif
+
 /*
  *  Clears the contents of the ringbuffer
  */
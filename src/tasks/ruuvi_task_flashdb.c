@@ -8,6 +8,10 @@
 #include "ruuvi_task_flashdb.h"
 #include "ruuvi_interface_log.h"
 #include "macronix_flash.h"
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_MACRONIX_GOVERNOR_ENABLED
+#include "ruuvi_task_macronix_governor.h"
+#endif
 
 #if RI_LOG_ENABLED
 #include <stdio.h>
@@ -107,7 +111,18 @@ rd_status_t rt_macronix_flash_exists(void) {
 
 void rt_macronix_high_performance_switch(const bool enable) {
   if(rt_macronix_flash_exists()==RD_SUCCESS) {
-    mx_high_performance_switch(enable);
+    rd_status_t err_code = RD_ERROR_INVALID_STATE;
+#if RT_MACRONIX_GOVERNOR_ENABLED
+    // Governor holds high performance mode until idle timeout after last batch.
+    if(enable) {
+      err_code = rt_macronix_governor_work_begin(RT_MACRONIX_GOVERNOR_BATCH_OPS);
+    } else {
+      err_code = rt_macronix_governor_work_end(RT_MACRONIX_GOVERNOR_BATCH_OPS);
+    }
+#endif
+    if(RD_ERROR_INVALID_STATE == err_code) {
+      mx_high_performance_switch(enable);
+    }
   }
 }
 
@@ -29,9 +29,11 @@ rd_status_t rt_macronix_flash_exists(void);
 rd_status_t rt_reset_macronix_flash(void);
 
 /*
- *  This function checks if Macronix Flash Chip is available.
+ *  This function switches Macronix Flash Chip to high performance or low power mode.
+ *  If governor is initialized, switch is reported to it as a batch of work and
+ *  low power mode is restored after idle timeout.
  *
- *  @param[in] err_code Error code of FlashDB.
+ *  @param[in] enable True to enter high performance mode, false to leave it.
  */
 void rt_macronix_high_performance_switch(const bool enable);
 
@@ -0,0 +1,167 @@
+/**
+ * @addtogroup flash_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_macronix_governor.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_MACRONIX_GOVERNOR_ENABLED
+
+#include "ruuvi_task_macronix_governor.h"
+#include "macronix_flash.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
+
+static ri_timer_id_t m_timer = NULL;
+static uint32_t m_pending;   //!< Reported operations which are not done.
+static bool m_high_performance;
+static bool m_init;
+
+static void governor_idle_handler (void * p_event_data, uint16_t event_size);
+
+/** Switch mode in scheduler context, retry later if scheduler queue is full. */
+static void governor_isr (void * const p_context)
+{
+    rd_status_t err_code = ri_scheduler_event_put (NULL, 0U, &governor_idle_handler);
+
+    if (RD_SUCCESS != err_code)
+    {
+        err_code = ri_timer_start (m_timer, RT_MACRONIX_GOVERNOR_IDLE_MS, NULL);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+/** Restart idle timeout. */
+static rd_status_t governor_arm (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= ri_timer_stop (m_timer);
+    err_code |= ri_timer_start (m_timer, RT_MACRONIX_GOVERNOR_IDLE_MS, NULL);
+    return err_code;
+}
+
+static void governor_idle_handler (void * p_event_data, uint16_t event_size)
+{
+    if (m_init && m_high_performance && (0U == m_pending))
+    {
+        // Operation which was not reported may still be running.
+        if (RD_ERROR_BUSY == mx_busy())
+        {
+            rd_status_t err_code = governor_arm();
+            RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+        }
+        else if (RD_SUCCESS == mx_high_performance_switch (false))
+        {
+            m_high_performance = false;
+        }
+        else
+        {
+            // Try again on next idle timeout.
+            rd_status_t err_code = governor_arm();
+            RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+        }
+    }
+}
+
+rd_status_t rt_macronix_governor_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        if (!ri_timer_is_init())
+        {
+            err_code |= ri_timer_init();
+        }
+
+        // Timer is kept over uninit, timers cannot be deleted.
+        if ( (RD_SUCCESS == err_code) && (NULL == m_timer))
+        {
+            err_code |= ri_timer_create (&m_timer, RI_TIMER_MODE_SINGLE_SHOT,
+                                         &governor_isr);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= mx_high_performance_switch (false);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            m_pending = 0U;
+            m_high_performance = false;
+            m_init = true;
+        }
+    }
+
+    return err_code;
+}
+
+void rt_macronix_governor_uninit (void)
+{
+    if (m_init)
+    {
+        (void) ri_timer_stop (m_timer);
+        m_init = false;
+    }
+}
+
+rd_status_t rt_macronix_governor_work_begin (const uint32_t ops)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_pending += ops;
+
+        if ( (!m_high_performance) && (RT_MACRONIX_GOVERNOR_BATCH_OPS <= m_pending))
+        {
+            err_code |= mx_high_performance_switch (true);
+            m_high_performance = (RD_SUCCESS == err_code);
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_governor_work_end (const uint32_t ops)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_pending = (ops < m_pending) ? (m_pending - ops) : 0U;
+
+        if (m_high_performance && (0U == m_pending))
+        {
+            err_code |= governor_arm();
+        }
+    }
+
+    return err_code;
+}
+
+bool rt_macronix_governor_is_high_performance (void)
+{
+    return m_init && m_high_performance;
+}
+
+/*@}*/
+#endif
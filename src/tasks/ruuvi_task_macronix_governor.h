@@ -0,0 +1,85 @@
+#ifndef  RUUVI_TASK_MACRONIX_GOVERNOR_H
+#define  RUUVI_TASK_MACRONIX_GOVERNOR_H
+
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_macronix_governor.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Switch Macronix flash between high performance and low power mode by load.
+ *
+ * Users of flash report work before starting it and when it is done, in
+ * page programs or sector erases. When RT_MACRONIX_GOVERNOR_BATCH_OPS
+ * operations are pending, flash is switched to high performance mode.
+ * After no work has been pending for RT_MACRONIX_GOVERNOR_IDLE_MS flash is
+ * switched back to low power mode in scheduler context. Batches arriving
+ * within idle time do not switch mode again.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  err_code = rt_macronix_governor_init();
+ *  err_code |= rt_macronix_governor_work_begin (sectors);
+ *  // Erase sectors.
+ *  err_code |= rt_macronix_governor_work_end (sectors);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Initialize governor. Flash is switched to low power mode.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if governor is already initialized.
+ * @return Error code from timer or flash driver.
+ */
+rd_status_t rt_macronix_governor_init (void);
+
+/**
+ * @brief Uninitialize governor, flash is left in its current mode.
+ */
+void rt_macronix_governor_uninit (void);
+
+/**
+ * @brief Report work which is about to start.
+ *
+ * Switches flash to high performance mode if batch size of work is pending.
+ * Switch is blocking, flash is busy for WRSR cycle after it.
+ *
+ * @param[in] ops Number of page programs or sector erases.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if governor is not initialized.
+ * @return Error code from flash driver.
+ */
+rd_status_t rt_macronix_governor_work_begin (const uint32_t ops);
+
+/**
+ * @brief Report work which was reported with rt_macronix_governor_work_begin as done.
+ *
+ * Starts idle timeout when no work is pending.
+ *
+ * @param[in] ops Number of page programs or sector erases.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if governor is not initialized.
+ * @return Error code from timer.
+ */
+rd_status_t rt_macronix_governor_work_end (const uint32_t ops);
+
+/**
+ * @brief Check if governor has switched flash to high performance mode.
+ */
+bool rt_macronix_governor_is_high_performance (void);
+
+/** @} */
+#endif
@@ -0,0 +1,270 @@
+/**
+ * @addtogroup flash_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_macronix_preerase.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_MACRONIX_PREERASE_ENABLED
+
+#include "ruuvi_task_macronix_preerase.h"
+#include "macronix_flash.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_yield.h"
+
+#include <string.h>
+
+#define PREERASE_NONE (UINT32_MAX) //!< No sector.
+
+static uint8_t m_erased[ (RT_MACRONIX_PREERASE_MAX_SECTORS + 7U) / 8U];
+static rt_macronix_preerase_stats_t m_stats;
+static uint32_t m_base;
+static uint32_t m_sectors;
+static uint32_t m_cursor;    //!< Sector of write position.
+static uint32_t m_inflight;  //!< Sector of running background erase.
+static uint8_t m_ahead;
+static bool m_init;
+
+static bool preerase_is_erased (const uint32_t sector)
+{
+    return (0U != (m_erased[sector / 8U] & (1U << (sector % 8U))));
+}
+
+static void preerase_mark (const uint32_t sector, const bool erased)
+{
+    if (erased)
+    {
+        m_erased[sector / 8U] |= (uint8_t) (1U << (sector % 8U));
+    }
+    else
+    {
+        m_erased[sector / 8U] &= (uint8_t) ~ (1U << (sector % 8U));
+    }
+}
+
+static bool preerase_in_partition (const uint32_t address, const uint32_t length)
+{
+    const uint32_t size = m_sectors * MX_SECTOR_SIZE;
+    return (address >= m_base) && ( (address - m_base) <= size)
+           && (length <= (size - (address - m_base)));
+}
+
+static void preerase_wait_ready (void)
+{
+    while (RD_ERROR_BUSY == mx_busy())
+    {
+        ri_yield();
+    }
+}
+
+/** Wait for background erase, if any, and record its sector as erased. */
+static void preerase_finish (void)
+{
+    if (PREERASE_NONE != m_inflight)
+    {
+        if (RD_ERROR_BUSY == mx_busy())
+        {
+            m_stats.waits++;
+            preerase_wait_ready();
+        }
+
+        preerase_mark (m_inflight, true);
+        m_stats.erases_background++;
+        m_inflight = PREERASE_NONE;
+    }
+}
+
+/** Start erase of a sector, erase takes milliseconds so WIP must be set after. */
+static rd_status_t preerase_start (const uint32_t sector)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= mx_write_enable();
+    err_code |= mx_sector_erase (m_base + (sector * MX_SECTOR_SIZE));
+
+    if ( (RD_SUCCESS == err_code) && (RD_ERROR_BUSY != mx_busy()))
+    {
+        err_code |= RD_ERROR_INTERNAL;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_preerase_init (const uint32_t base, const uint32_t size,
+                                       const uint8_t ahead)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const uint32_t sectors = size / MX_SECTOR_SIZE;
+
+    if ( (0U != (base % MX_SECTOR_SIZE)) || (0U != (size % MX_SECTOR_SIZE))
+            || (0U == sectors) || (RT_MACRONIX_PREERASE_MAX_SECTORS < sectors)
+            || (0U == ahead) || (ahead >= sectors))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        memset (m_erased, 0, sizeof (m_erased));
+        memset (&m_stats, 0, sizeof (m_stats));
+        m_base = base;
+        m_sectors = sectors;
+        m_ahead = ahead;
+        m_cursor = PREERASE_NONE;
+        m_inflight = PREERASE_NONE;
+        m_init = true;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_preerase_read (const uint32_t address, uint8_t * const p_data,
+                                       const uint32_t length)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        // Flash ignores reads while erasing.
+        preerase_finish();
+        err_code |= mx_read (address, p_data, length);
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_preerase_write (const uint32_t address,
+                                        const uint8_t * const p_data,
+                                        const uint32_t length)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (!preerase_in_partition (address, length))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else if (0U < length)
+    {
+        const uint32_t first = (address - m_base) / MX_SECTOR_SIZE;
+        const uint32_t last = (address - m_base + length - 1U) / MX_SECTOR_SIZE;
+        preerase_finish();
+
+        for (uint32_t sector = first; sector <= last; sector++)
+        {
+            preerase_mark (sector, false);
+        }
+
+        m_cursor = last;
+        err_code |= mx_write (address, p_data, length);
+    }
+    else
+    {
+        // Nothing to write.
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_preerase_erase (const uint32_t address, const uint32_t length)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if ( (!preerase_in_partition (address, length))
+              || (0U != ( (address - m_base) % MX_SECTOR_SIZE))
+              || (0U != (length % MX_SECTOR_SIZE)))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const uint32_t first = (address - m_base) / MX_SECTOR_SIZE;
+        preerase_finish();
+
+        for (uint32_t sector = first; (RD_SUCCESS == err_code)
+                && (sector < (first + (length / MX_SECTOR_SIZE))); sector++)
+        {
+            if (preerase_is_erased (sector))
+            {
+                m_stats.erases_skipped++;
+            }
+            else
+            {
+                preerase_wait_ready();
+                err_code |= preerase_start (sector);
+                preerase_wait_ready();
+                preerase_mark (sector, RD_SUCCESS == err_code);
+                m_stats.erases_blocking++;
+            }
+
+            m_cursor = sector;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_macronix_preerase_idle (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (RD_ERROR_BUSY == mx_busy())
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else if (PREERASE_NONE != m_cursor)
+    {
+        uint32_t next = PREERASE_NONE;
+        preerase_finish();
+
+        for (uint32_t ii = 1U; (ii <= m_ahead) && (PREERASE_NONE == next); ii++)
+        {
+            const uint32_t sector = (m_cursor + ii) % m_sectors;
+
+            if (!preerase_is_erased (sector))
+            {
+                next = sector;
+            }
+        }
+
+        if (PREERASE_NONE != next)
+        {
+            err_code |= preerase_start (next);
+            m_inflight = (RD_SUCCESS == err_code) ? next : PREERASE_NONE;
+        }
+    }
+    else
+    {
+        // Write position is not known before first write or erase.
+    }
+
+    return err_code;
+}
+
+void rt_macronix_preerase_stats_get (rt_macronix_preerase_stats_t * const p_stats)
+{
+    if (NULL != p_stats)
+    {
+        *p_stats = m_stats;
+    }
+}
+
+/*@}*/
+#endif
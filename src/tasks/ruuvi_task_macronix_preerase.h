@@ -0,0 +1,127 @@
+#ifndef  RUUVI_TASK_MACRONIX_PREERASE_H
+#define  RUUVI_TASK_MACRONIX_PREERASE_H
+
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_macronix_preerase.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Keep sectors ahead of log write position erased in background.
+ *
+ * Time series log erases next sector when it rolls over, and the append waits
+ * for the whole sector erase. This module tracks which sectors of a log
+ * partition are known to be erased. The idle hook starts erasing sectors
+ * ahead of the write position. Erase requests of the log then return at once
+ * for sectors which were already erased.
+ *
+ * Flash port of the log partition routes its read, write and erase through
+ * this module, and application calls idle hook before sleeping:
+ *
+ * @code{.c}
+ *  static int fal_read (long offset, uint8_t * buf, size_t size)
+ *  {
+ *      return rt_macronix_preerase_read (PART_BASE + offset, buf, size);
+ *  }
+ *
+ *  static int fal_write (long offset, const uint8_t * buf, size_t size)
+ *  {
+ *      return rt_macronix_preerase_write (PART_BASE + offset, buf, size);
+ *  }
+ *
+ *  static int fal_erase (long offset, size_t size)
+ *  {
+ *      return rt_macronix_preerase_erase (PART_BASE + offset, size);
+ *  }
+ *
+ *  err_code = rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U);
+ *  // Main loop
+ *  (void) rt_macronix_preerase_idle();
+ *  ri_yield();
+ * @endcode
+ *
+ * Sectors ahead of write position hold the oldest records of a ring log,
+ * pre-erasing drops them up to ahead sectors before the log would.
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include <stdint.h>
+
+/** @brief Erase statistics since init. */
+typedef struct
+{
+    uint32_t erases_blocking;   //!< Erases which log waited on in full.
+    uint32_t erases_skipped;    //!< Erase requests of already erased sectors.
+    uint32_t erases_background; //!< Sectors erased by idle hook.
+    uint32_t waits;             //!< Accesses which waited for a background erase.
+} rt_macronix_preerase_stats_t;
+
+/**
+ * @brief Initialize tracking of a partition. All sectors are unknown state.
+ *
+ * @param[in] base First address of partition, sector-aligned.
+ * @param[in] size Size of partition, multiple of sectors.
+ * @param[in] ahead Number of sectors kept erased ahead of write position.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_PARAM if partition is not sector-aligned, larger than
+ *                                RT_MACRONIX_PREERASE_MAX_SECTORS or ahead is
+ *                                0 or not smaller than partition.
+ */
+rd_status_t rt_macronix_preerase_init (const uint32_t base, const uint32_t size,
+                                       const uint8_t ahead);
+
+/**
+ * @brief Read from partition, waits for background erase.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if module is not initialized.
+ * @return Error code from flash driver.
+ */
+rd_status_t rt_macronix_preerase_read (const uint32_t address, uint8_t * const p_data,
+                                       const uint32_t length);
+
+/**
+ * @brief Program partition. Written sectors are no longer erased.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if module is not initialized.
+ * @retval RD_ERROR_INVALID_PARAM if range is outside partition.
+ * @return Error code from flash driver.
+ */
+rd_status_t rt_macronix_preerase_write (const uint32_t address,
+                                        const uint8_t * const p_data,
+                                        const uint32_t length);
+
+/**
+ * @brief Erase sectors of partition, skip sectors which are already erased.
+ *
+ * Waits if background erase of requested sector is running. Last erased
+ * sector becomes the write position.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if module is not initialized.
+ * @retval RD_ERROR_INVALID_PARAM if range is not sector-aligned or outside partition.
+ * @return Error code from flash driver.
+ */
+rd_status_t rt_macronix_preerase_erase (const uint32_t address, const uint32_t length);
+
+/**
+ * @brief Finish background erase and start next one, does not wait.
+ *
+ * @retval RD_SUCCESS if erase was started or all sectors ahead are erased.
+ * @retval RD_ERROR_BUSY if flash is busy, call again later.
+ * @retval RD_ERROR_INVALID_STATE if module is not initialized.
+ * @retval RD_ERROR_INTERNAL if flash did not start erase.
+ */
+rd_status_t rt_macronix_preerase_idle (void);
+
+void rt_macronix_preerase_stats_get (rt_macronix_preerase_stats_t * const p_stats);
+
+/** @} */
+#endif
@@ -0,0 +1,420 @@
+/**
+ * @addtogroup flash_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_macronix_queue.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_MACRONIX_QUEUE_ENABLED
+
+#include "ruuvi_task_macronix_queue.h"
+#include "macronix_flash.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
+#if RT_MACRONIX_GOVERNOR_ENABLED
+#include "ruuvi_task_macronix_governor.h"
+#endif
+
+static rt_macronix_op_t m_queue[RT_MACRONIX_QUEUE_LENGTH];
+static size_t m_head;
+static size_t m_count;
+static uint32_t m_progress;  //!< Bytes of first operation done or started.
+static uint32_t m_poll_ms;   //!< Poll interval of running flash operation.
+static uint32_t m_polls;     //!< Busy polls of running flash operation.
+static uint32_t m_polls_max; //!< Busy polls before running flash operation has failed.
+static ri_timer_id_t m_timer = NULL;
+static bool m_init;
+static bool m_running;       //!< Handler is queued, running or waiting on timer.
+static size_t m_reported;    //!< Operations from head reported to governor.
+
+static void queue_handler (void * p_event_data, uint16_t event_size);
+
+/** Run handler in scheduler context, retry later if scheduler queue is full. */
+static void queue_isr (void * const p_context)
+{
+    rd_status_t err_code = ri_scheduler_event_put (NULL, 0U, &queue_handler);
+
+    if (RD_SUCCESS != err_code)
+    {
+        err_code = ri_timer_start (m_timer, m_poll_ms, NULL);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+/** Continue in next scheduler event so that other events run between read chunks. */
+static void queue_yield (void)
+{
+    rd_status_t err_code = ri_scheduler_event_put (NULL, 0U, &queue_handler);
+
+    if (RD_SUCCESS != err_code)
+    {
+        err_code = ri_timer_start (m_timer, m_poll_ms, NULL);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+/** Poll again after flash should have progressed. */
+static void queue_arm (void)
+{
+    rd_status_t err_code = ri_timer_start (m_timer, m_poll_ms, NULL);
+
+    if (RD_SUCCESS != err_code)
+    {
+        err_code = ri_scheduler_event_put (NULL, 0U, &queue_handler);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+#if RT_MACRONIX_GOVERNOR_ENABLED
+/** Page programs or sector erases of an operation. */
+static uint32_t queue_units (const rt_macronix_op_t * const p_op)
+{
+    uint32_t units = 1U;
+
+    if (RT_MACRONIX_OP_PROGRAM == p_op->type)
+    {
+        units = ( (p_op->address % MX_PAGE_SIZE) + p_op->length + MX_PAGE_SIZE - 1U)
+                / MX_PAGE_SIZE;
+    }
+    else if (RT_MACRONIX_OP_ERASE == p_op->type)
+    {
+        units = p_op->length / MX_SECTOR_SIZE;
+    }
+    else
+    {
+        // Read is one transfer.
+    }
+
+    return units;
+}
+#endif
+
+/** True if operations were queued after last report to governor. */
+static bool queue_has_unreported (void)
+{
+#if RT_MACRONIX_GOVERNOR_ENABLED
+    return (m_reported < m_count);
+#else
+    return false;
+#endif
+}
+
+/**
+ * Report queued operations to governor, done in handler to keep submit off the bus.
+ *
+ * Governor may switch flash mode, which waits for flash and leaves it busy
+ * for WRSR. Report only while flash is idle.
+ */
+static void queue_report (void)
+{
+#if RT_MACRONIX_GOVERNOR_ENABLED
+    uint32_t units = 0U;
+
+    while (m_reported < m_count)
+    {
+        units += queue_units (&m_queue[ (m_head + m_reported) % RT_MACRONIX_QUEUE_LENGTH]);
+        m_reported++;
+    }
+
+    if (0U < units)
+    {
+        (void) rt_macronix_governor_work_begin (units);
+    }
+
+#endif
+}
+
+/** Report operations from head as done to governor. */
+static void queue_report_done (const size_t ops)
+{
+#if RT_MACRONIX_GOVERNOR_ENABLED
+    uint32_t units = 0U;
+
+    for (size_t ii = 0; (ii < ops) && (0U < m_reported); ii++)
+    {
+        units += queue_units (&m_queue[ (m_head + ii) % RT_MACRONIX_QUEUE_LENGTH]);
+        m_reported--;
+    }
+
+    if (0U < units)
+    {
+        (void) rt_macronix_governor_work_end (units);
+    }
+
+#endif
+}
+
+/** Poll unknown busy time like a sector erase. */
+static void queue_poll_reset (void)
+{
+    m_poll_ms = RT_MACRONIX_QUEUE_ERASE_POLL_MS;
+    m_polls = 0U;
+    m_polls_max = RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS / RT_MACRONIX_QUEUE_ERASE_POLL_MS;
+}
+
+/** Remove first operation and report it. Callback may submit more operations. */
+static void queue_complete (const rd_status_t result)
+{
+    const rt_macronix_op_t op = m_queue[m_head];
+    queue_report_done (1U);
+    m_head = (m_head + 1U) % RT_MACRONIX_QUEUE_LENGTH;
+    m_count--;
+    m_progress = 0U;
+    queue_poll_reset();
+
+    if (NULL != op.done)
+    {
+        op.done (&op, result);
+    }
+}
+
+/** Set write enable latch, flash ignores WREN while it is busy. */
+static rd_status_t queue_write_enable (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t status = 0U;
+    err_code |= mx_write_enable();
+    err_code |= mx_read_status_register (&status);
+
+    if ( (RD_SUCCESS == err_code) && (0U == (status & (1U << REG_SR_BIT_WEL))))
+    {
+        err_code |= RD_ERROR_INTERNAL;
+    }
+
+    return err_code;
+}
+
+/** Verify that program or erase started, flash ignores e.g. protected addresses. */
+static rd_status_t queue_check_started (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t status = 0U;
+    err_code |= mx_read_status_register (&status);
+
+    if ( (RD_SUCCESS == err_code) && (0U == (status & (1U << REG_SR_BIT_WIP))))
+    {
+        err_code |= RD_ERROR_INTERNAL;
+    }
+
+    return err_code;
+}
+
+/** Start next page program or sector erase, or read next chunk. */
+static rd_status_t queue_step (const rt_macronix_op_t * const p_op)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const uint32_t address = p_op->address + m_progress;
+    const uint32_t left = p_op->length - m_progress;
+
+    if (RT_MACRONIX_OP_READ == p_op->type)
+    {
+        const uint32_t chunk = (left < RT_MACRONIX_QUEUE_READ_CHUNK) ?
+                               left : RT_MACRONIX_QUEUE_READ_CHUNK;
+        err_code |= mx_read (address, &p_op->p_data[m_progress], chunk);
+        m_progress += chunk;
+    }
+    else if (RT_MACRONIX_OP_PROGRAM == p_op->type)
+    {
+        const uint32_t page_left = MX_PAGE_SIZE - (address % MX_PAGE_SIZE);
+        const uint32_t chunk = (left < page_left) ? left : page_left;
+        err_code |= queue_write_enable();
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= mx_program (address, &p_op->p_data[m_progress], chunk);
+            err_code |= queue_check_started();
+        }
+
+        m_progress += chunk;
+        m_poll_ms = RT_MACRONIX_QUEUE_PROGRAM_POLL_MS;
+        m_polls = 0U;
+        m_polls_max = RT_MACRONIX_QUEUE_PROGRAM_TIMEOUT_MS / RT_MACRONIX_QUEUE_PROGRAM_POLL_MS;
+    }
+    else
+    {
+        err_code |= queue_write_enable();
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= mx_sector_erase (address);
+            err_code |= queue_check_started();
+        }
+
+        m_progress += MX_SECTOR_SIZE;
+        m_poll_ms = RT_MACRONIX_QUEUE_ERASE_POLL_MS;
+        m_polls = 0U;
+        m_polls_max = RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS / RT_MACRONIX_QUEUE_ERASE_POLL_MS;
+    }
+
+    return err_code;
+}
+
+static void queue_handler (void * p_event_data, uint16_t event_size)
+{
+    bool waiting = false;
+    bool yielding = false;
+
+    while ( (!waiting) && (!yielding) && (0U < m_count))
+    {
+        const rt_macronix_op_t * const p_op = &m_queue[m_head];
+        rd_status_t err_code = RD_SUCCESS;
+
+        if (RD_ERROR_BUSY == mx_busy())
+        {
+            m_polls++;
+            waiting = (m_polls <= m_polls_max);
+            err_code |= (waiting) ? RD_SUCCESS : RD_ERROR_TIMEOUT;
+        }
+        // Busy is checked again on next round, mode switch may have started WRSR.
+        else if (queue_has_unreported())
+        {
+            queue_report();
+        }
+        else if (m_progress < p_op->length)
+        {
+            err_code |= queue_step (p_op);
+            waiting = (RT_MACRONIX_OP_READ != p_op->type);
+            yielding = (!waiting) && (m_progress < p_op->length);
+        }
+        else
+        {
+            queue_complete (RD_SUCCESS);
+        }
+
+        if (RD_SUCCESS != err_code)
+        {
+            waiting = false;
+            yielding = false;
+            queue_complete (err_code);
+        }
+    }
+
+    if (waiting)
+    {
+        queue_arm();
+    }
+    else if (yielding)
+    {
+        queue_yield();
+    }
+    else
+    {
+        m_running = false;
+    }
+}
+
+rd_status_t rt_macronix_queue_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        if (!ri_timer_is_init())
+        {
+            err_code |= ri_timer_init();
+        }
+
+        // Timer is kept over uninit, timers cannot be deleted.
+        if ( (RD_SUCCESS == err_code) && (NULL == m_timer))
+        {
+            err_code |= ri_timer_create (&m_timer, RI_TIMER_MODE_SINGLE_SHOT, &queue_isr);
+        }
+
+        if (RD_SUCCESS == err_code)
+        {
+            m_head = 0U;
+            m_count = 0U;
+            m_progress = 0U;
+            m_reported = 0U;
+            queue_poll_reset();
+            m_running = false;
+            m_init = true;
+        }
+    }
+
+    return err_code;
+}
+
+void rt_macronix_queue_uninit (void)
+{
+    if (m_init)
+    {
+        (void) ri_timer_stop (m_timer);
+        queue_report_done (m_count);
+        m_count = 0U;
+        m_running = false;
+        m_init = false;
+    }
+}
+
+rd_status_t rt_macronix_queue_submit (const rt_macronix_op_t * const p_op)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_op)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (!m_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if ( (RT_MACRONIX_OP_ERASE != p_op->type) && (NULL == p_op->p_data))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == p_op->length) || (RT_MACRONIX_OP_ERASE < p_op->type)
+              || ( (RT_MACRONIX_OP_ERASE == p_op->type)
+                   && ( (0U != (p_op->address % MX_SECTOR_SIZE))
+                        || (0U != (p_op->length % MX_SECTOR_SIZE)))))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else if (RT_MACRONIX_QUEUE_LENGTH <= m_count)
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        m_queue[ (m_head + m_count) % RT_MACRONIX_QUEUE_LENGTH] = *p_op;
+        m_count++;
+
+        if (!m_running)
+        {
+            err_code |= ri_scheduler_event_put (NULL, 0U, &queue_handler);
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_running = true;
+            }
+            else
+            {
+                m_count--;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+bool rt_macronix_queue_is_idle (void)
+{
+    return (0U == m_count);
+}
+
+size_t rt_macronix_queue_pending (void)
+{
+    return m_count;
+}
+
+/*@}*/
+#endif
@@ -0,0 +1,122 @@
+#ifndef  RUUVI_TASK_MACRONIX_QUEUE_H
+#define  RUUVI_TASK_MACRONIX_QUEUE_H
+
+/**
+ * @addtogroup flash_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_macronix_queue.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Run external Macronix flash operations without blocking the application.
+ *
+ * Read, program and erase operations are queued and run one at a time in
+ * scheduler context. After each page program or sector erase is started,
+ * write in progress is polled from a timer instead of spinning, so sensors
+ * and radio keep running while flash is busy. Reads are split into
+ * RT_MACRONIX_QUEUE_READ_CHUNK byte transfers in separate scheduler events.
+ * Completion callback runs in scheduler context.
+ *
+ * Blocking macronix_flash.h functions must not be used while queue is busy,
+ * they share the bus with the queue.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  static void on_erased (const rt_macronix_op_t * const p_op, const rd_status_t result)
+ *  {
+ *      RD_ERROR_CHECK (result, RD_SUCCESS);
+ *  }
+ *
+ *  rt_macronix_op_t op = {
+ *      .type = RT_MACRONIX_OP_ERASE,
+ *      .address = 0x10000U,
+ *      .length = 4U * MX_SECTOR_SIZE,
+ *      .done = &on_erased
+ *  };
+ *  err_code = rt_macronix_queue_init();
+ *  err_code |= rt_macronix_queue_submit (&op);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Type of queued operation. */
+typedef enum
+{
+    RT_MACRONIX_OP_READ,    //!< Read length bytes to p_data.
+    RT_MACRONIX_OP_PROGRAM, //!< Program length bytes from p_data, any alignment.
+    RT_MACRONIX_OP_ERASE    //!< Erase sector-aligned range of length bytes.
+} rt_macronix_op_type_t;
+
+typedef struct rt_macronix_op_t rt_macronix_op_t;
+
+/**
+ * @brief Called in scheduler context when operation is done.
+ *
+ * @param[in] p_op Copy of submitted operation.
+ * @param[in] result RD_SUCCESS on success.
+ *                   RD_ERROR_INTERNAL if flash did not accept write enable,
+ *                   program or erase.
+ *                   RD_ERROR_TIMEOUT if flash stayed busy past
+ *                   RT_MACRONIX_QUEUE_PROGRAM_TIMEOUT_MS or
+ *                   RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS.
+ *                   Error of flash driver otherwise.
+ */
+typedef void (*rt_macronix_op_fp_t) (const rt_macronix_op_t * const p_op,
+                                     const rd_status_t result);
+
+/** @brief Flash operation. Data must stay valid until callback. */
+struct rt_macronix_op_t
+{
+    rt_macronix_op_type_t type; //!< Operation.
+    uint32_t address;           //!< Flash address.
+    uint8_t * p_data;           //!< Source or destination, unused in erase.
+    uint32_t length;            //!< Bytes to read, program or erase.
+    rt_macronix_op_fp_t done;   //!< Completion callback, optional.
+    void * p_context;           //!< Passed back to callback untouched.
+};
+
+/**
+ * @brief Initialize queue, create polling timer.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if queue is already initialized.
+ * @return Error code from timer on other error.
+ */
+rd_status_t rt_macronix_queue_init (void);
+
+/**
+ * @brief Stop polling and drop queued operations without callbacks.
+ *
+ * Operation running in flash is not aborted.
+ */
+void rt_macronix_queue_uninit (void);
+
+/**
+ * @brief Queue an operation. Operation is copied, data is not.
+ *
+ * @retval RD_SUCCESS if operation was queued.
+ * @retval RD_ERROR_NULL if p_op is NULL or data of read or program is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if length is 0 or erase range is not sector-aligned.
+ * @retval RD_ERROR_INVALID_STATE if queue is not initialized.
+ * @retval RD_ERROR_NO_MEM if queue is full.
+ * @return Error code from scheduler if queue could not be started.
+ */
+rd_status_t rt_macronix_queue_submit (const rt_macronix_op_t * const p_op);
+
+/** @brief True if no operation is queued or running. */
+bool rt_macronix_queue_is_idle (void);
+
+/** @brief Number of operations queued or running. */
+size_t rt_macronix_queue_pending (void);
+
+/** @} */
+#endif
@@ -220,4 +220,146 @@ rt_sensor_ctx_t * rt_sensor_find_provider (rt_sensor_ctx_t * const
 
     return p_sensor;
 }
+
+uint32_t rt_sensor_budget_na (const uint32_t capacity_mah, const uint32_t life_days)
+{
+    uint64_t budget_na = 0;
+
+    if (0U != life_days)
+    {
+        // mAh -> nAh, days -> hours.
+        budget_na = ( (uint64_t) capacity_mah * 1000000U) / ( (uint64_t) life_days * 24U);
+    }
+
+    return (budget_na > UINT32_MAX) ? UINT32_MAX : (uint32_t) budget_na;
+}
+
+/** @brief Average current of a candidate, false if sensor does not support it. */
+static bool plan_cost (const rt_sensor_plan_t * const p_plan, const size_t index,
+                       uint32_t * const p_average_na)
+{
+    const rd_sensor_t * const p_sensor = &p_plan->p_sensor->sensor;
+    rd_sensor_cost_t cost = {0};
+    const rd_status_t err_code = p_sensor->cost_get (&p_plan->p_candidates[index], &cost);
+    *p_average_na = cost.average_na;
+    return (RD_SUCCESS == err_code);
+}
+
+/** @brief Find first candidate after current one which is cheaper than current. */
+static bool plan_next (const rt_sensor_plan_t * const p_plan, size_t * const p_index,
+                       uint32_t * const p_average_na)
+{
+    bool found = false;
+
+    for (size_t ii = p_plan->selected + 1U; (ii < p_plan->count) && !found; ii++)
+    {
+        if (plan_cost (p_plan, ii, p_average_na) && (*p_average_na < p_plan->average_na))
+        {
+            *p_index = ii;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+rd_status_t rt_sensor_plan (rt_sensor_plan_t * const p_plans, const size_t count,
+                            const uint32_t budget_na, uint32_t * const p_total_na)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t total_na = 0;
+
+    if (NULL == p_plans)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (0U == count)
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0; (ii < count) && (RD_SUCCESS == err_code); ii++)
+        {
+            rt_sensor_plan_t * const p_plan = &p_plans[ii];
+            bool supported = false;
+
+            if ( (NULL == p_plan->p_sensor) || (NULL == p_plan->p_candidates))
+            {
+                err_code |= RD_ERROR_NULL;
+            }
+            else if (0U == p_plan->count)
+            {
+                err_code |= RD_ERROR_INVALID_PARAM;
+            }
+            else
+            {
+                for (size_t jj = 0; (jj < p_plan->count) && !supported; jj++)
+                {
+                    supported = plan_cost (p_plan, jj, &p_plan->average_na);
+                    p_plan->selected = jj;
+                }
+
+                if (supported)
+                {
+                    total_na += p_plan->average_na;
+                }
+                else
+                {
+                    err_code |= RD_ERROR_NOT_SUPPORTED;
+                }
+            }
+        }
+    }
+
+    while ( (RD_SUCCESS == err_code) && (total_na > budget_na))
+    {
+        rt_sensor_plan_t * p_best = NULL;
+        size_t best_index = 0;
+        uint32_t best_na = 0;
+
+        for (size_t ii = 0; ii < count; ii++)
+        {
+            size_t index;
+            uint32_t average_na;
+
+            if (plan_next (&p_plans[ii], &index, &average_na)
+                    && ( (NULL == p_best)
+                         || ( (p_plans[ii].average_na - average_na)
+                              > (p_best->average_na - best_na))))
+            {
+                p_best = &p_plans[ii];
+                best_index = index;
+                best_na = average_na;
+            }
+        }
+
+        if (NULL == p_best)
+        {
+            err_code |= RD_ERROR_NOT_FOUND;
+        }
+        else
+        {
+            total_na -= (p_best->average_na - best_na);
+            p_best->selected = best_index;
+            p_best->average_na = best_na;
+        }
+    }
+
+    if ( (NULL != p_total_na) && (NULL != p_plans))
+    {
+        *p_total_na = (total_na > UINT32_MAX) ? UINT32_MAX : (uint32_t) total_na;
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        for (size_t ii = 0; ii < count; ii++)
+        {
+            p_plans[ii].p_sensor->configuration =
+                p_plans[ii].p_candidates[p_plans[ii].selected];
+        }
+    }
+
+    return err_code;
+}
 #endif
\ No newline at end of file
@@ -32,6 +32,16 @@ typedef struct
     ri_gpio_id_t level_pin;                   //!< Level interrupt.
 } rt_sensor_ctx_t;
 
+/** @brief Candidate configurations of a sensor for @ref rt_sensor_plan. */
+typedef struct
+{
+    rt_sensor_ctx_t * p_sensor;                     //!< Sensor to plan.
+    const rd_sensor_configuration_t * p_candidates; //!< Candidates, preferred first.
+    size_t count;                                   //!< Number of candidates.
+    size_t selected;                                //!< Out: Index of selected candidate.
+    uint32_t average_na;                            //!< Out: Average current of selected.
+} rt_sensor_plan_t;
+
 /** @brief Initialize sensor CTX
  *
  * To initialize a sensor, initialization function, sensor bus and sensor handle must
@@ -107,5 +117,44 @@ rt_sensor_ctx_t * rt_sensor_find_backend (rt_sensor_ctx_t * const
 rt_sensor_ctx_t * rt_sensor_find_provider (rt_sensor_ctx_t * const
         sensor_list, const size_t count, rd_sensor_data_fields_t values);
 
+/**
+ * @brief Average current which drains a battery in given time.
+ *
+ * Subtract current of MCU, radio and other loads from the result to get the
+ * budget of sensors for @ref rt_sensor_plan.
+ *
+ * @param[in] capacity_mah Usable capacity of battery, mAh.
+ * @param[in] life_days Target battery life, days.
+ * @return Average current in nA, 0 if life_days is 0.
+ */
+uint32_t rt_sensor_budget_na (const uint32_t capacity_mah, const uint32_t life_days);
+
+/**
+ * @brief Select configurations of sensors which fit in a current budget.
+ *
+ * Starts from the preferred candidate of each sensor. While total average
+ * current is over budget, the sensor whose next cheaper candidate saves the most
+ * current is degraded. Candidates are evaluated with cost_get of the sensor,
+ * candidates which the sensor does not support are skipped.
+ *
+ * On success selected candidate is copied to configuration of each sensor,
+ * apply it with @ref rt_sensor_configure.
+ *
+ * @param[in,out] p_plans Sensors and their candidates. Selection is written back.
+ * @param[in] count Number of sensors.
+ * @param[in] budget_na Allowed total average current of sensors, nA.
+ * @param[out] p_total_na Total average current of selection, may be NULL.
+ *                        Lowest possible total if budget cannot be met.
+ *
+ * @retval RD_SUCCESS if selection fits in the budget.
+ * @retval RD_ERROR_NULL if p_plans, sensor or candidates of a sensor is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if count or count of candidates is 0.
+ * @retval RD_ERROR_NOT_SUPPORTED if a sensor supports none of its candidates.
+ * @retval RD_ERROR_NOT_FOUND if no selection fits in the budget,
+ *                            configurations of sensors are not modified.
+ */
+rd_status_t rt_sensor_plan (rt_sensor_plan_t * const p_plans, const size_t count,
+                            const uint32_t budget_na, uint32_t * const p_total_na);
+
 /*@}*/
 #endif
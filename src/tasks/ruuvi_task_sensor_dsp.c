@@ -0,0 +1,351 @@
+/**
+ * @addtogroup sensor_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_sensor_dsp.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_SENSOR_DSP_ENABLED
+
+#include "ruuvi_task_sensor_dsp.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+
+#include <math.h>
+#include <string.h>
+
+#if (RT_SENSOR_DSP_MAX_FIELDS > 32) || (RT_SENSOR_DSP_MAX_FIELDS < 1)
+#   error "DSP stage supports 1 ... 32 fields"
+#endif
+
+#if (RT_SENSOR_DSP_MAX_SAMPLES > 128) || (RT_SENSOR_DSP_MAX_SAMPLES < 1)
+#   error "DSP stage supports oversampling of 1 ... 128 samples"
+#endif
+
+#define DSP_IIR_MAX_PARAMETER  (128U) //!< Largest IIR coefficient, 2^7.
+#define DSP_DEFAULT_PARAMETER  (4U)   //!< Parameter of RD_SENSOR_CFG_DEFAULT.
+#define DSP_FIXED_ONE          (1L << RT_SENSOR_DSP_FRAC_BITS)
+
+/** @brief Convert a value to fixed point, saturate at range of int32_t. */
+static int32_t dsp_to_fixed (const float value)
+{
+    const float scaled = value * (float) DSP_FIXED_ONE;
+    int32_t fixed;
+
+    if (scaled >= (float) INT32_MAX)
+    {
+        fixed = INT32_MAX;
+    }
+    else if (scaled <= (float) INT32_MIN)
+    {
+        fixed = INT32_MIN;
+    }
+    else
+    {
+        fixed = (int32_t) lrintf (scaled);
+    }
+
+    return fixed;
+}
+
+static float dsp_to_float (const int32_t fixed)
+{
+    return (float) fixed / (float) DSP_FIXED_ONE;
+}
+
+static void dsp_reset (rt_sensor_dsp_t * const p_dsp)
+{
+    memset (p_dsp->state, 0, sizeof (p_dsp->state));
+    memset (p_dsp->ring, 0, sizeof (p_dsp->ring));
+    memset (p_dsp->output, 0, sizeof (p_dsp->output));
+    memset (p_dsp->head, 0, sizeof (p_dsp->head));
+    memset (p_dsp->fill, 0, sizeof (p_dsp->fill));
+    p_dsp->timestamp_ms = RD_UINT64_INVALID;
+}
+
+static bool dsp_is_software (const uint8_t function)
+{
+    return (RD_SENSOR_DSP_LOW_PASS == function)
+           || (RD_SENSOR_DSP_HIGH_PASS == function)
+           || (RD_SENSOR_DSP_OS == function);
+}
+
+/** @brief Resolve parameter of software function, 0 if not supported. */
+static uint8_t dsp_parameter (const uint8_t function, const uint8_t parameter)
+{
+    const uint8_t max = (RD_SENSOR_DSP_OS == function) ? RT_SENSOR_DSP_MAX_SAMPLES
+                        : DSP_IIR_MAX_PARAMETER;
+    uint8_t resolved = 0;
+
+    if ( (RD_SENSOR_CFG_DEFAULT == parameter) || (RD_SENSOR_CFG_NO_CHANGE == parameter))
+    {
+        resolved = (DSP_DEFAULT_PARAMETER < max) ? DSP_DEFAULT_PARAMETER : max;
+    }
+    else if (RD_SENSOR_CFG_MIN == parameter)
+    {
+        resolved = 1U;
+    }
+    else if (RD_SENSOR_CFG_MAX == parameter)
+    {
+        resolved = max;
+    }
+    else if (max >= parameter)
+    {
+        resolved = parameter;
+    }
+    else
+    {
+        // Not supported.
+    }
+
+    if ( (0U != resolved) && (RD_SENSOR_DSP_OS != function))
+    {
+        uint8_t rounded = 1U;
+
+        while (rounded < resolved)
+        {
+            rounded = (uint8_t) (rounded << 1U);
+        }
+
+        resolved = rounded;
+    }
+
+    return resolved;
+}
+
+/** @brief Run filter of one field on a new sample. */
+static int32_t dsp_filter (rt_sensor_dsp_t * const p_dsp, const uint8_t slot,
+                           const int32_t sample)
+{
+    int64_t * const p_state = &p_dsp->state[slot];
+    int32_t output;
+
+    if (RD_SENSOR_DSP_OS == p_dsp->function)
+    {
+        int32_t * const p_oldest = &p_dsp->ring[slot][p_dsp->head[slot]];
+
+        if (p_dsp->fill[slot] < p_dsp->parameter)
+        {
+            p_dsp->fill[slot]++;
+        }
+        else
+        {
+            *p_state -= *p_oldest;
+        }
+
+        *p_oldest = sample;
+        *p_state += sample;
+        p_dsp->head[slot] = (uint8_t) ( (p_dsp->head[slot] + 1U) % p_dsp->parameter);
+        output = (int32_t) (*p_state / p_dsp->fill[slot]);
+    }
+    else
+    {
+        // Accumulator holds low pass value scaled by parameter, so rounding
+        // error does not build up in state.
+        if (0U == p_dsp->fill[slot])
+        {
+            *p_state = (int64_t) sample * (1LL << p_dsp->shift);
+            p_dsp->fill[slot] = 1U;
+        }
+        else
+        {
+            *p_state += sample - (*p_state >> p_dsp->shift);
+        }
+
+        output = (int32_t) (*p_state >> p_dsp->shift);
+
+        if (RD_SENSOR_DSP_HIGH_PASS == p_dsp->function)
+        {
+            const int64_t high = (int64_t) sample - output;
+
+            if (high > INT32_MAX)
+            {
+                output = INT32_MAX;
+            }
+            else if (high < INT32_MIN)
+            {
+                output = INT32_MIN;
+            }
+            else
+            {
+                output = (int32_t) high;
+            }
+        }
+    }
+
+    return output;
+}
+
+rd_status_t rt_sensor_dsp_attach (rt_sensor_dsp_t * const p_dsp,
+                                  const rt_sensor_dsp_api_t * const p_api,
+                                  rd_sensor_t * const p_sensor)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_dsp) || (NULL == p_api) || (NULL == p_sensor))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (!rd_sensor_is_init (p_sensor)) || (p_api->data_get == p_sensor->data_get))
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        uint32_t fields = p_sensor->provides.bitfield;
+        memset (p_dsp, 0, sizeof (rt_sensor_dsp_t));
+        p_dsp->data_get = p_sensor->data_get;
+        p_dsp->dsp_set = p_sensor->dsp_set;
+        p_dsp->dsp_get = p_sensor->dsp_get;
+        p_dsp->function = RD_SENSOR_DSP_LAST;
+
+        for (uint8_t ii = 0; (ii < RT_SENSOR_DSP_MAX_FIELDS) && (0U != fields); ii++)
+        {
+            const uint32_t lowest = fields & (~fields + 1U);
+            p_dsp->fields.bitfield |= lowest;
+            fields &= ~lowest;
+        }
+
+        dsp_reset (p_dsp);
+        p_sensor->data_get = p_api->data_get;
+        p_sensor->dsp_set = p_api->dsp_set;
+        p_sensor->dsp_get = p_api->dsp_get;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_sensor_dsp_data_get (rt_sensor_dsp_t * const p_dsp,
+                                    rd_sensor_data_t * const p_data)
+{
+    rd_status_t err_code = p_dsp->data_get (p_data);
+
+    if ( (RD_SUCCESS == err_code) && (RD_SENSOR_DSP_LAST != p_dsp->function))
+    {
+        const bool new_sample = (p_data->timestamp_ms != p_dsp->timestamp_ms);
+        uint32_t fields = p_dsp->fields.bitfield;
+
+        for (uint8_t slot = 0; 0U != fields; slot++)
+        {
+            rd_sensor_data_fields_t field = {0};
+            field.bitfield = fields & (~fields + 1U);
+            fields &= ~field.bitfield;
+            const float value = rd_sensor_data_parse (p_data, field);
+
+            if (!isnan (value))
+            {
+                if (new_sample)
+                {
+                    p_dsp->output[slot] = dsp_filter (p_dsp, slot, dsp_to_fixed (value));
+                }
+
+                if (0U != p_dsp->fill[slot])
+                {
+                    rd_sensor_data_set (p_data, field, dsp_to_float (p_dsp->output[slot]));
+                }
+            }
+        }
+
+        p_dsp->timestamp_ms = p_data->timestamp_ms;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_sensor_dsp_set (rt_sensor_dsp_t * const p_dsp, uint8_t * dsp,
+                               uint8_t * parameter)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == dsp) || (NULL == parameter))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (RD_SENSOR_CFG_NO_CHANGE == *dsp)
+    {
+        err_code |= rt_sensor_dsp_get (p_dsp, dsp, parameter);
+    }
+    else
+    {
+        const uint8_t function = *dsp;
+        const uint8_t requested = *parameter;
+        err_code |= p_dsp->dsp_set (dsp, parameter);
+
+        if ( (RD_ERROR_NOT_SUPPORTED == err_code) && dsp_is_software (function))
+        {
+            const uint8_t resolved = dsp_parameter (function, requested);
+
+            if (0U == resolved)
+            {
+                *dsp = RD_SENSOR_DSP_LAST;
+                *parameter = RD_SENSOR_ERR_NOT_SUPPORTED;
+                p_dsp->function = RD_SENSOR_DSP_LAST;
+            }
+            else if (RD_UINT64_INVALID == rd_sensor_timestamp_get())
+            {
+                // New samples are detected by timestamp, filter would never run.
+                err_code = RD_ERROR_INVALID_STATE;
+                p_dsp->function = RD_SENSOR_DSP_LAST;
+            }
+            else
+            {
+                // Sensor passes raw samples to software filter.
+                uint8_t last = RD_SENSOR_DSP_LAST;
+                uint8_t last_parameter = RD_SENSOR_CFG_DEFAULT;
+                err_code = p_dsp->dsp_set (&last, &last_parameter);
+
+                if (RD_SUCCESS == err_code)
+                {
+                    p_dsp->function = function;
+                    p_dsp->parameter = resolved;
+                    p_dsp->shift = 0U;
+
+                    while ( (1U << p_dsp->shift) < resolved)
+                    {
+                        p_dsp->shift++;
+                    }
+
+                    *dsp = function;
+                    *parameter = resolved;
+                }
+            }
+        }
+        else
+        {
+            p_dsp->function = RD_SENSOR_DSP_LAST;
+        }
+
+        dsp_reset (p_dsp);
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_sensor_dsp_get (rt_sensor_dsp_t * const p_dsp, uint8_t * dsp,
+                               uint8_t * parameter)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == dsp) || (NULL == parameter))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (RD_SENSOR_DSP_LAST != p_dsp->function)
+    {
+        *dsp = p_dsp->function;
+        *parameter = p_dsp->parameter;
+    }
+    else
+    {
+        err_code |= p_dsp->dsp_get (dsp, parameter);
+    }
+
+    return err_code;
+}
+
+/*@}*/
+#endif
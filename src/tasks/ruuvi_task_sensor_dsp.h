@@ -0,0 +1,159 @@
+#ifndef RUUVI_TASK_SENSOR_DSP_H
+#define RUUVI_TASK_SENSOR_DSP_H
+/**
+ * @addtogroup sensor_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_sensor_dsp.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Software DSP stage for sensors which lack hardware filtering.
+ *
+ * The stage replaces data_get, dsp_set and dsp_get of a sensor. DSP functions
+ * are first offered to the sensor. If sensor returns RD_ERROR_NOT_SUPPORTED,
+ * the stage runs the filter on data of the sensor:
+ *  - RD_SENSOR_DSP_LOW_PASS: IIR low pass, y += (x - y) / parameter.
+ *  - RD_SENSOR_DSP_HIGH_PASS: x - low pass of x.
+ *  - RD_SENSOR_DSP_OS: moving average of last parameter samples.
+ *
+ * Parameter is rounded up to a power of two for IIR filters.
+ * @ref RD_SENSOR_CFG_MIN is 1, @ref RD_SENSOR_CFG_DEFAULT is 4 and
+ * @ref RD_SENSOR_CFG_MAX is the largest supported parameter:
+ * 128 for IIR filters and @ref RT_SENSOR_DSP_MAX_SAMPLES for oversampling.
+ *
+ * Filter state is updated once per new sample, i.e. when timestamp of data changes,
+ * so calling data_get several times on same sample returns the same result.
+ * Software filter therefore requires a timestamp source.
+ * Values are filtered in fixed point with @ref RT_SENSOR_DSP_FRAC_BITS fractional
+ * bits and saturate at range of the fixed-point value. The stage does not allocate
+ * memory, all state is in @ref rt_sensor_dsp_t.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  RT_SENSOR_DSP_DEFINE (m_ntc_dsp);
+ *
+ *  err_code = ri_adc_ntc_init (&ntc, RD_BUS_NONE, RI_ADC_AIN1);
+ *  err_code = RT_SENSOR_DSP_ATTACH (m_ntc_dsp, &ntc);
+ *  uint8_t dsp = RD_SENSOR_DSP_LOW_PASS;
+ *  uint8_t parameter = 8U;
+ *  err_code = ntc.dsp_set (&dsp, &parameter);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+#include <stdint.h>
+
+/** @brief Functions which bind sensor functions to a stage, see @ref RT_SENSOR_DSP_DEFINE. */
+typedef struct
+{
+    rd_sensor_data_fp data_get; //!< Calls @ref rt_sensor_dsp_data_get.
+    rd_sensor_dsp_fp dsp_set;   //!< Calls @ref rt_sensor_dsp_set.
+    rd_sensor_dsp_fp dsp_get;   //!< Calls @ref rt_sensor_dsp_get.
+} rt_sensor_dsp_api_t;
+
+/** @brief State of a DSP stage, treat as opaque. */
+typedef struct
+{
+    rd_sensor_data_fp data_get; //!< Data function of sensor.
+    rd_sensor_dsp_fp dsp_set;   //!< DSP setter of sensor.
+    rd_sensor_dsp_fp dsp_get;   //!< DSP getter of sensor.
+    rd_sensor_data_fields_t fields; //!< Fields filtered by stage.
+    uint64_t timestamp_ms;      //!< Timestamp of last filtered sample.
+    int64_t state[RT_SENSOR_DSP_MAX_FIELDS]; //!< IIR accumulator or sum of ring.
+    int32_t ring[RT_SENSOR_DSP_MAX_FIELDS][RT_SENSOR_DSP_MAX_SAMPLES]; //!< Samples.
+    int32_t output[RT_SENSOR_DSP_MAX_FIELDS]; //!< Last filtered value.
+    uint8_t head[RT_SENSOR_DSP_MAX_FIELDS];   //!< Next ring slot.
+    uint8_t fill[RT_SENSOR_DSP_MAX_FIELDS];   //!< Samples in ring or IIR, 0 if empty.
+    uint8_t function;           //!< Software DSP function, RD_SENSOR_DSP_LAST if none.
+    uint8_t parameter;          //!< Parameter of software DSP function.
+    uint8_t shift;              //!< log2 of IIR parameter.
+} rt_sensor_dsp_t;
+
+/**
+ * @brief Define a DSP stage and functions which bind sensor functions to it.
+ *
+ * @param name Name of the stage, a static @ref rt_sensor_dsp_t.
+ */
+#define RT_SENSOR_DSP_DEFINE(name)                                              \
+    static rt_sensor_dsp_t name;                                                \
+    RD_SENSOR_DATA_BIND (name##_data_get, rt_sensor_dsp_data_get, &name)        \
+    RD_SENSOR_DSP_BIND (name##_dsp_set, rt_sensor_dsp_set, &name)               \
+    RD_SENSOR_DSP_BIND (name##_dsp_get, rt_sensor_dsp_get, &name)               \
+    static const rt_sensor_dsp_api_t name##_api =                               \
+    {                                                                           \
+        name##_data_get, name##_dsp_set, name##_dsp_get                         \
+    }
+
+/** @brief Attach stage defined with @ref RT_SENSOR_DSP_DEFINE to a sensor. */
+#define RT_SENSOR_DSP_ATTACH(name, p_sensor) \
+    rt_sensor_dsp_attach (&name, &name##_api, (p_sensor))
+
+/**
+ * @brief Attach a DSP stage to an initialized sensor.
+ *
+ * Stage filters first @ref RT_SENSOR_DSP_MAX_FIELDS fields the sensor provides.
+ * Software filter is off until DSP is set. Attach stage again after sensor
+ * has been initialized again.
+ *
+ * @param[out] p_dsp Stage to attach.
+ * @param[in] p_api Functions which bind to p_dsp.
+ * @param[in,out] p_sensor Sensor whose data_get, dsp_set and dsp_get are replaced.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_INVALID_STATE if sensor is not initialized or stage is
+ *                                already attached to it.
+ */
+rd_status_t rt_sensor_dsp_attach (rt_sensor_dsp_t * const p_dsp,
+                                  const rt_sensor_dsp_api_t * const p_api,
+                                  rd_sensor_t * const p_sensor);
+
+/**
+ * @brief Read data of sensor and run software filter on it.
+ *
+ * @param[in,out] p_dsp Stage of sensor.
+ * @param[out] p_data Filtered data.
+ * @return Error code from sensor.
+ */
+rd_status_t rt_sensor_dsp_data_get (rt_sensor_dsp_t * const p_dsp,
+                                    rd_sensor_data_t * const p_data);
+
+/**
+ * @brief Set DSP function on sensor or in software.
+ *
+ * Filter state is cleared.
+ *
+ * @param[in,out] p_dsp Stage of sensor.
+ * @param[in,out] dsp In: DSP function. Out: Applied function.
+ * @param[in,out] parameter In: Parameter of function. Out: Applied parameter.
+ * @retval RD_SUCCESS if sensor or software applied the function.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_NOT_SUPPORTED if parameter is out of range of software filter.
+ * @retval RD_ERROR_INVALID_STATE if software filter is needed but there is no
+ *         timestamp source, see @ref rd_sensor_timestamp_function_set.
+ * @return Error code from sensor if function is not a software DSP function.
+ */
+rd_status_t rt_sensor_dsp_set (rt_sensor_dsp_t * const p_dsp, uint8_t * dsp,
+                               uint8_t * parameter);
+
+/**
+ * @brief Get DSP function of sensor or software.
+ *
+ * @param[in] p_dsp Stage of sensor.
+ * @param[out] dsp Applied DSP function.
+ * @param[out] parameter Applied parameter.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @return Error code from sensor if software filter is off.
+ */
+rd_status_t rt_sensor_dsp_get (rt_sensor_dsp_t * const p_dsp, uint8_t * dsp,
+                               uint8_t * parameter);
+
+/*@}*/
+#endif
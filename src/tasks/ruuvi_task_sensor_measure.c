@@ -0,0 +1,293 @@
+/**
+ * @addtogroup sensor_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_sensor_measure.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_SENSOR_MEASURE_ENABLED
+
+#include "ruuvi_task_sensor_measure.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+#include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
+
+#include <string.h>
+
+#if RT_SENSOR_MEASURE_MAX_SENSORS > 32
+#   error "Over 32 sensors in parallel measurement is not supported"
+#endif
+
+static void measure_handler (void * p_event_data, uint16_t event_size);
+
+/** Run handler in scheduler context, retry later if scheduler queue is full. */
+static void measure_isr (void * const p_context)
+{
+    rt_sensor_measure_t * const p_measure = p_context;
+    rd_status_t err_code = ri_scheduler_event_put (&p_measure, sizeof (p_measure),
+                           &measure_handler);
+
+    if (RD_SUCCESS != err_code)
+    {
+        err_code = ri_timer_start (p_measure->timer, RT_SENSOR_MEASURE_RETRY_MS,
+                                   p_measure);
+        RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    }
+}
+
+/** Wake up at ready time of first pending sensor. */
+static rd_status_t measure_arm (rt_sensor_measure_t * const p_measure, const uint64_t now)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t next = UINT64_MAX;
+
+    for (size_t ii = 0; ii < p_measure->count; ii++)
+    {
+        if ( (p_measure->pending & (1UL << ii)) && (p_measure->ready_ms[ii] < next))
+        {
+            next = p_measure->ready_ms[ii];
+        }
+    }
+
+    if (next <= now)
+    {
+        err_code |= ri_scheduler_event_put (&p_measure, sizeof (p_measure),
+                                            &measure_handler);
+    }
+    else
+    {
+        err_code |= ri_timer_start (p_measure->timer, (uint32_t) (next - now), p_measure);
+    }
+
+    return err_code;
+}
+
+/** Report a sensor and end measurement after last sensor. */
+static void measure_report (rt_sensor_measure_t * const p_measure, const size_t index,
+                            const rd_status_t result)
+{
+    p_measure->pending &= ~ (1UL << index);
+    p_measure->result |= result;
+
+    if (NULL != p_measure->ready)
+    {
+        p_measure->ready (p_measure->p_sensors[index], result);
+    }
+}
+
+static void measure_handler (void * p_event_data, uint16_t event_size)
+{
+    rt_sensor_measure_t * p_measure = NULL;
+    rd_status_t err_code = RD_SUCCESS;
+    memcpy (&p_measure, p_event_data, sizeof (p_measure));
+    const uint64_t now = rd_sensor_timestamp_get();
+
+    for (size_t ii = 0; ii < p_measure->count; ii++)
+    {
+        if ( (p_measure->pending & (1UL << ii)) && (p_measure->ready_ms[ii] <= now))
+        {
+            rd_status_t result = RD_SUCCESS;
+
+            if (0U == (p_measure->blocking & (1UL << ii)))
+            {
+                result = p_measure->p_sensors[ii]->sensor.measurement_complete();
+            }
+
+            if (RD_ERROR_BUSY != result)
+            {
+                measure_report (p_measure, ii, result);
+            }
+            else if (p_measure->retries[ii] >= RT_SENSOR_MEASURE_RETRIES_MAX)
+            {
+                measure_report (p_measure, ii, RD_ERROR_TIMEOUT);
+            }
+            else
+            {
+                // Sensor clock may run slower than nominal.
+                p_measure->retries[ii]++;
+                p_measure->ready_ms[ii] = now + RT_SENSOR_MEASURE_RETRY_MS;
+            }
+        }
+    }
+
+    if (0U != p_measure->pending)
+    {
+        err_code |= measure_arm (p_measure, now);
+
+        if (RD_SUCCESS != err_code)
+        {
+            // Results of remaining sensors cannot be collected.
+            p_measure->result |= err_code;
+            p_measure->pending = 0U;
+        }
+    }
+
+    if ( (0U == p_measure->pending) && p_measure->running)
+    {
+        p_measure->running = false;
+
+        if (NULL != p_measure->done)
+        {
+            p_measure->done (p_measure->result);
+        }
+    }
+}
+
+rd_status_t rt_sensor_measure_init (rt_sensor_measure_t * const p_measure,
+                                    rt_sensor_ctx_t * const * const p_sensors,
+                                    const size_t count,
+                                    const rt_sensor_measure_ready_fp ready,
+                                    const rt_sensor_measure_done_fp done)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_measure) || (NULL == p_sensors))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == count) || (count > RT_SENSOR_MEASURE_MAX_SENSORS))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        // Timer is kept over re-init, timers cannot be deleted.
+        const ri_timer_id_t timer = p_measure->timer;
+        memset (p_measure, 0, sizeof (rt_sensor_measure_t));
+        p_measure->timer = timer;
+        p_measure->p_sensors = p_sensors;
+        p_measure->count = count;
+        p_measure->ready = ready;
+        p_measure->done = done;
+
+        if (!ri_timer_is_init())
+        {
+            err_code |= ri_timer_init();
+        }
+
+        if ( (RD_SUCCESS == err_code) && (NULL == p_measure->timer))
+        {
+            err_code |= ri_timer_create (&p_measure->timer, RI_TIMER_MODE_SINGLE_SHOT,
+                                         &measure_isr);
+        }
+    }
+
+    return err_code;
+}
+
+/** Start all sensors, sample blocking sensors and arm collection of results. */
+static rd_status_t measure_trigger (rt_sensor_measure_t * const p_measure,
+                                    const uint64_t now)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    p_measure->pending = 0U;
+    p_measure->blocking = 0U;
+    p_measure->result = RD_SUCCESS;
+    memset (p_measure->retries, 0, sizeof (p_measure->retries));
+
+    // Start all split-phase sensors before blocking on any sensor.
+    for (size_t ii = 0; ii < p_measure->count; ii++)
+    {
+        rd_sensor_t * const p_sensor = &p_measure->p_sensors[ii]->sensor;
+        rd_status_t start_code = RD_ERROR_INVALID_STATE;
+
+        if (rd_sensor_is_init (p_sensor))
+        {
+            start_code = p_sensor->measurement_start (&p_measure->ready_ms[ii]);
+        }
+
+        if (RD_SUCCESS == start_code)
+        {
+            p_measure->pending |= (1UL << ii);
+        }
+        else if (RD_ERROR_NOT_INITIALIZED == start_code)
+        {
+            p_measure->blocking |= (1UL << ii);
+        }
+        else
+        {
+            err_code |= start_code;
+        }
+    }
+
+    for (size_t ii = 0; ii < p_measure->count; ii++)
+    {
+        if (p_measure->blocking & (1UL << ii))
+        {
+            uint8_t mode = RD_SENSOR_CFG_SINGLE;
+            const rd_status_t sample_code =
+                p_measure->p_sensors[ii]->sensor.mode_set (&mode);
+
+            if (RD_SUCCESS == sample_code)
+            {
+                p_measure->ready_ms[ii] = 0U;
+                p_measure->pending |= (1UL << ii);
+            }
+            else
+            {
+                err_code |= sample_code;
+            }
+        }
+    }
+
+    if (0U != p_measure->pending)
+    {
+        const rd_status_t arm_code = measure_arm (p_measure, now);
+
+        if (RD_SUCCESS == arm_code)
+        {
+            p_measure->running = true;
+        }
+        else
+        {
+            p_measure->pending = 0U;
+            err_code |= arm_code;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_sensor_measure_start (rt_sensor_measure_t * const p_measure)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_measure)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (p_measure->running)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else
+    {
+        // Blocking samples queue the handler at once, it rearms with fresh time.
+        const uint64_t now = rd_sensor_timestamp_get();
+
+        // Ready times would never be reached.
+        if (RD_UINT64_INVALID == now)
+        {
+            err_code |= RD_ERROR_INVALID_STATE;
+        }
+        else
+        {
+            err_code |= measure_trigger (p_measure, now);
+        }
+    }
+
+    return err_code;
+}
+
+bool rt_sensor_measure_is_running (const rt_sensor_measure_t * const p_measure)
+{
+    return (NULL != p_measure) && p_measure->running;
+}
+
+/*@}*/
+#endif
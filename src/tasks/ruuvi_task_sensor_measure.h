@@ -0,0 +1,144 @@
+#ifndef RUUVI_TASK_SENSOR_MEASURE_H
+#define RUUVI_TASK_SENSOR_MEASURE_H
+/**
+ * @addtogroup sensor_tasks
+ */
+/*@{*/
+/**
+ * @file ruuvi_task_sensor_measure.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Take a single sample of several sensors in parallel.
+ *
+ * All sensors are triggered first and each result is collected as soon as
+ * the sensor reports it is ready, so total time of measurement is the longest
+ * conversion time rather than sum of conversion times.
+ *
+ * Sensors which implement @ref rd_sensor_measurement_start_fp report their
+ * ready time from current configuration, e.g. oversampling. Other sensors
+ * are sampled with blocking mode_set(RD_SENSOR_CFG_SINGLE) after split-phase
+ * sensors have been started.
+ *
+ * Results are collected in scheduler context, a timer wakes up the
+ * application when next sensor should be ready.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  static rt_sensor_ctx_t * const sensors[] = {&tmp117, &dps310, &shtcx};
+ *  static rt_sensor_measure_t measure;
+ *
+ *  static void on_ready (rt_sensor_ctx_t * const p_sensor, const rd_status_t result)
+ *  {
+ *      if (RD_SUCCESS == result)
+ *      {
+ *          err_code = p_sensor->sensor.data_get (&data);
+ *      }
+ *  }
+ *
+ *  err_code = rt_sensor_measure_init (&measure, sensors, 3U, &on_ready, &on_done);
+ *  err_code = rt_sensor_measure_start (&measure);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_timer.h"
+#include "ruuvi_task_sensor.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Called in scheduler context when result of a sensor is ready.
+ *
+ * @param[in] p_sensor Sensor which was sampled.
+ * @param[in] result RD_SUCCESS if new sample can be read with data_get,
+ *                   RD_ERROR_TIMEOUT if sensor did not finish in time,
+ *                   error code from sensor otherwise.
+ */
+typedef void (*rt_sensor_measure_ready_fp) (rt_sensor_ctx_t * const p_sensor,
+        const rd_status_t result);
+
+/**
+ * @brief Called in scheduler context when all sensors have been reported.
+ *
+ * @param[in] result Combined result of all sensors.
+ */
+typedef void (*rt_sensor_measure_done_fp) (const rd_status_t result);
+
+/** @brief State of a parallel measurement, treat as opaque. */
+typedef struct
+{
+    rt_sensor_ctx_t * const * p_sensors;  //!< Sensors to sample.
+    size_t count;                         //!< Number of sensors.
+    rt_sensor_measure_ready_fp ready;     //!< Called for each sensor, optional.
+    rt_sensor_measure_done_fp done;       //!< Called after last sensor, optional.
+    ri_timer_id_t timer;                  //!< Wakes up when next sensor is ready.
+    uint64_t ready_ms[RT_SENSOR_MEASURE_MAX_SENSORS]; //!< Expected ready times.
+    uint8_t retries[RT_SENSOR_MEASURE_MAX_SENSORS];   //!< Polls after ready time.
+    uint32_t pending;                     //!< Bitmask of sensors not reported.
+    uint32_t blocking;                    //!< Bitmask of sensors sampled blocking.
+    rd_status_t result;                   //!< Combined result of measurement.
+    bool running;                         //!< True while measurement is running.
+} rt_sensor_measure_t;
+
+/**
+ * @brief Initialize a parallel measurement.
+ *
+ * Initializes timer interface if required and creates a timer for the measurement.
+ * Timer is created on first init and reused when measurement is initialized
+ * again, so p_measure must be zeroed before first init, e.g. static.
+ * Sensors must be initialized and configured before measurement is started.
+ *
+ * @param[out] p_measure State of measurement.
+ * @param[in] p_sensors Array of sensors to sample, must stay valid while
+ *                      measurement exists.
+ * @param[in] count Number of sensors, at most @ref RT_SENSOR_MEASURE_MAX_SENSORS.
+ * @param[in] ready Called when result of each sensor is ready, may be NULL.
+ * @param[in] done Called when all sensors are ready, may be NULL.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_measure or p_sensors is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if count is 0 or over maximum.
+ * @return error code from timer if timer could not be created.
+ */
+rd_status_t rt_sensor_measure_init (rt_sensor_measure_t * const p_measure,
+                                    rt_sensor_ctx_t * const * const p_sensors,
+                                    const size_t count,
+                                    const rt_sensor_measure_ready_fp ready,
+                                    const rt_sensor_measure_done_fp done);
+
+/**
+ * @brief Trigger a single sample on all sensors.
+ *
+ * Returns after all split-phase sensors have been started and all other
+ * sensors have been sampled. Results are reported through callbacks.
+ * Sensors which cannot be started, e.g. because they are in continuous mode
+ * or not initialized, are left out of measurement. Ready times are compared
+ * to @ref rd_sensor_timestamp_get, so timestamp function must be set.
+ *
+ * @param[in,out] p_measure Measurement to start.
+ *
+ * @retval RD_SUCCESS if all sensors were started.
+ * @retval RD_ERROR_NULL if p_measure is NULL.
+ * @retval RD_ERROR_BUSY if measurement is already running.
+ * @retval RD_ERROR_INVALID_STATE if timestamp function is not set, no sensor
+ *                                is started.
+ * @return combined error code of sensors which could not be started,
+ *         rest of the sensors are still measured.
+ */
+rd_status_t rt_sensor_measure_start (rt_sensor_measure_t * const p_measure);
+
+/**
+ * @brief Check if measurement is running.
+ *
+ * @param[in] p_measure Measurement to check.
+ * @return True if some sensor has not been reported yet.
+ */
+bool rt_sensor_measure_is_running (const rt_sensor_measure_t * const p_measure);
+
+/*@}*/
+#endif
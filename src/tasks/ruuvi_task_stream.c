@@ -0,0 +1,259 @@
+/**
+ * @addtogroup communication_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_stream.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "ruuvi_driver_enabled_modules.h"
+#if RT_STREAM_ENABLED
+
+#include "ruuvi_task_stream.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication.h"
+
+#include <string.h>
+
+/**
+ * Read records and pack them into message until message is full or there
+ * are no more records. Record which does not fit is kept for next message.
+ */
+static rd_status_t stream_pack (rt_stream_t * const p_stream)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const size_t record_max = RT_STREAM_RECORD_MAX_SIZE (p_stream->payload);
+    bool full = false;
+
+    while ( (RD_SUCCESS == err_code) && !full
+            && ( (0U != p_stream->record_size) || !p_stream->exhausted))
+    {
+        if (0U == p_stream->record_size)
+        {
+            size_t size = record_max;
+            rt_stream_position_t position = p_stream->next;
+            err_code |= p_stream->read (p_stream->p_context, &position,
+                                        p_stream->record, &size);
+
+            if (RD_ERROR_NOT_FOUND == err_code)
+            {
+                p_stream->exhausted = true;
+                err_code = RD_SUCCESS;
+            }
+            else if ( (RD_SUCCESS == err_code) && ( (0U == size) || (size > record_max)))
+            {
+                err_code |= RD_ERROR_DATA_SIZE;
+                p_stream->running = false;
+            }
+            else if (RD_SUCCESS == err_code)
+            {
+                p_stream->record_size = (uint8_t) size;
+                p_stream->next = position;
+            }
+            else
+            {
+                // Read error, retried on next call.
+            }
+        }
+
+        if (0U == p_stream->record_size)
+        {
+            // Nothing to pack.
+        }
+        else if ( (p_stream->msg.data_length + RT_STREAM_RECORD_HEADER_SIZE
+                   + p_stream->record_size) > p_stream->payload)
+        {
+            full = true;
+        }
+        else
+        {
+            uint8_t * const p_dst = &p_stream->msg.data[p_stream->msg.data_length];
+            p_dst[0] = p_stream->record_size;
+            memcpy (&p_dst[RT_STREAM_RECORD_HEADER_SIZE], p_stream->record,
+                    p_stream->record_size);
+            p_stream->msg.data_length += RT_STREAM_RECORD_HEADER_SIZE + p_stream->record_size;
+            p_stream->msg_end = p_stream->next;
+            p_stream->record_size = 0;
+        }
+    }
+
+    return err_code;
+}
+
+/** Queue messages until window is full, channel is full or records run out. */
+static rd_status_t stream_fill (rt_stream_t * const p_stream)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    bool channel_full = false;
+
+    while ( (RD_SUCCESS == err_code) && p_stream->running && !channel_full
+            && (p_stream->in_flight < p_stream->window))
+    {
+        err_code |= stream_pack (p_stream);
+
+        if ( (RD_SUCCESS != err_code) || (0U == p_stream->msg.data_length))
+        {
+            break;
+        }
+
+        const rd_status_t send_code = p_stream->p_channel->send (&p_stream->msg);
+
+        if (RD_SUCCESS == send_code)
+        {
+            const uint8_t slot = (uint8_t) ( (p_stream->oldest + p_stream->in_flight)
+                                             % RT_STREAM_WINDOW_MAX);
+            p_stream->in_flight_end[slot] = p_stream->msg_end;
+            p_stream->in_flight++;
+            p_stream->msg.data_length = 0;
+        }
+        else if ( (RD_ERROR_NO_MEM == send_code) || (RD_ERROR_RESOURCES == send_code))
+        {
+            // Message is kept and sent when channel has room.
+            channel_full = true;
+        }
+        else
+        {
+            err_code |= send_code;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_stream_init (rt_stream_t * const p_stream,
+                            ri_comm_channel_t * const p_channel,
+                            const rt_stream_read_fp read, void * const p_context,
+                            const uint8_t window)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_stream) || (NULL == p_channel) || (NULL == read))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == window) || (window > RT_STREAM_WINDOW_MAX))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        memset (p_stream, 0, sizeof (rt_stream_t));
+        p_stream->p_channel = p_channel;
+        p_stream->read = read;
+        p_stream->p_context = p_context;
+        p_stream->window = window;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_stream_start (rt_stream_t * const p_stream,
+                             const rt_stream_position_t checkpoint,
+                             const uint8_t payload)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_stream)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (NULL == p_stream->read) || (NULL == p_stream->p_channel->send))
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if ( (payload <= RT_STREAM_RECORD_HEADER_SIZE)
+              || (payload > RI_COMM_MESSAGE_MAX_LENGTH))
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        rt_stream_stop (p_stream);
+        p_stream->checkpoint = checkpoint;
+        p_stream->next = checkpoint;
+        p_stream->payload = payload;
+        p_stream->exhausted = false;
+        p_stream->running = true;
+        err_code |= stream_fill (p_stream);
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_stream_on_sent (rt_stream_t * const p_stream)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_stream)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (p_stream->running)
+    {
+        if (p_stream->in_flight > 0U)
+        {
+            p_stream->checkpoint = p_stream->in_flight_end[p_stream->oldest];
+            p_stream->oldest = (uint8_t) ( (p_stream->oldest + 1U) % RT_STREAM_WINDOW_MAX);
+            p_stream->in_flight--;
+        }
+
+        err_code |= stream_fill (p_stream);
+    }
+    else
+    {
+        // Stopped, nothing to do.
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_stream_process (rt_stream_t * const p_stream)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_stream)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        err_code |= stream_fill (p_stream);
+    }
+
+    return err_code;
+}
+
+void rt_stream_stop (rt_stream_t * const p_stream)
+{
+    if (NULL != p_stream)
+    {
+        // Records read but not confirmed sent must be read again.
+        p_stream->exhausted = p_stream->exhausted
+                              && (p_stream->next == p_stream->checkpoint);
+        p_stream->running = false;
+        p_stream->next = p_stream->checkpoint;
+        p_stream->in_flight = 0;
+        p_stream->oldest = 0;
+        p_stream->msg.data_length = 0;
+        p_stream->msg.repeat_count = 1;
+        p_stream->msg_end = p_stream->checkpoint;
+        p_stream->record_size = 0;
+    }
+}
+
+rt_stream_position_t rt_stream_checkpoint_get (const rt_stream_t * const p_stream)
+{
+    return (NULL == p_stream) ? RT_STREAM_POSITION_START : p_stream->checkpoint;
+}
+
+bool rt_stream_is_complete (const rt_stream_t * const p_stream)
+{
+    return (NULL != p_stream)
+           && p_stream->exhausted
+           && (p_stream->next == p_stream->checkpoint);
+}
+
+/** @} */
+#endif
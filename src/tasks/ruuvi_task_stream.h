@@ -0,0 +1,207 @@
+#ifndef  RUUVI_TASK_STREAM_H
+#define  RUUVI_TASK_STREAM_H
+
+/**
+ * @addtogroup communication_tasks
+ */
+/** @{ */
+/**
+ * @file ruuvi_task_stream.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Stream records, e.g. a log, through a communication channel with flow control.
+ *
+ * Stream keeps up to a configured number of messages queued in the channel
+ * and queues more as channel reports @ref RI_COMM_SENT. Each message packs
+ * as many records as fit in the negotiated payload size, each record
+ * prefixed with its length in one byte.
+ *
+ * Records are read by position, which read function advances like a cursor.
+ * Checkpoint is the position after records in messages reported sent. After
+ * a disconnect the stream is restarted from checkpoint, records queued but
+ * not reported sent are streamed again.
+ *
+ * Stream expects to own the channel while it is running: every
+ * @ref RI_COMM_SENT is assumed to be for the oldest message of the stream.
+ *
+ * Typical usage:
+ *
+ * @code{.c}
+ *  static rt_stream_t stream;
+ *  err_code = rt_stream_init (&stream, &channel, &log_record_read, &log, 4U);
+ *  err_code = rt_stream_start (&stream, 0U, negotiated_payload);
+ *
+ *  // In channel event handler
+ *  case RI_COMM_SENT:
+ *      err_code = rt_stream_on_sent (&stream);
+ *      break;
+ *  case RI_COMM_DISCONNECTED:
+ *      checkpoint = rt_stream_checkpoint_get (&stream);
+ *      rt_stream_stop (&stream);
+ *      break;
+ *
+ *  // After reconnect
+ *  err_code = rt_stream_start (&stream, checkpoint, negotiated_payload);
+ * @endcode
+ */
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Bytes of header before each record in a message. */
+#define RT_STREAM_RECORD_HEADER_SIZE (1U)
+
+/** @brief Largest record which fits in a message of given payload size. */
+#define RT_STREAM_RECORD_MAX_SIZE(payload) ((payload) - RT_STREAM_RECORD_HEADER_SIZE)
+
+/**
+ * @brief Position of a record, meaning is defined by read function.
+ *
+ * Position lets read continue from previous record without scanning records
+ * from start, e.g. position may encode a log cursor.
+ * @ref RT_STREAM_POSITION_START is position of first record.
+ */
+typedef uint64_t rt_stream_position_t;
+
+/** @brief Position of first record. */
+#define RT_STREAM_POSITION_START (0U)
+
+/**
+ * @brief Read a record to be streamed.
+ *
+ * Records are read in increasing order. Position goes back only when stream
+ * is restarted from a checkpoint, to a position earlier returned by read.
+ *
+ * @param[in] p_context Context given to @ref rt_stream_init.
+ * @param[in,out] p_position Input: position of record to read.
+ *                           Output: position of next record. Unchanged if
+ *                           record was not read.
+ * @param[out] p_record Record.
+ * @param[in,out] p_size Input: space in p_record. Output: size of record.
+ * @retval RD_SUCCESS if record was read.
+ * @retval RD_ERROR_NOT_FOUND if there are no more records.
+ * @return Other error code to stop streaming.
+ */
+typedef rd_status_t (*rt_stream_read_fp) (void * const p_context,
+        rt_stream_position_t * const p_position,
+        uint8_t * const p_record, size_t * const p_size);
+
+/** @brief State of a stream. Members are private, use functions of this module. */
+typedef struct
+{
+    ri_comm_channel_t * p_channel;     //!< Channel to send messages through.
+    rt_stream_read_fp read;            //!< Reads records.
+    void * p_context;                  //!< Context of read.
+    ri_comm_message_t msg;             //!< Message being packed or waiting for space in channel.
+    uint8_t record[RI_COMM_MESSAGE_MAX_LENGTH]; //!< Record read, not yet packed.
+    rt_stream_position_t in_flight_end[RT_STREAM_WINDOW_MAX]; //!< Position after each queued message.
+    rt_stream_position_t checkpoint;   //!< Position after messages reported sent.
+    rt_stream_position_t next;         //!< Position of next record to read.
+    rt_stream_position_t msg_end;      //!< Position after last record packed in msg.
+    uint8_t record_size;               //!< Size of read record, 0 if none.
+    uint8_t window;                    //!< Maximum number of queued messages.
+    uint8_t in_flight;                 //!< Messages queued in channel.
+    uint8_t oldest;                    //!< Index of oldest queued message in in_flight_end.
+    uint8_t payload;                   //!< Maximum bytes per message.
+    bool running;                      //!< Stream has been started and not stopped.
+    bool exhausted;                    //!< Read has returned RD_ERROR_NOT_FOUND.
+} rt_stream_t;
+
+/**
+ * @brief Initialize a stream.
+ *
+ * @param[out] p_stream Stream to initialize.
+ * @param[in] p_channel Initialized channel, e.g. NUS. Must live as long as stream.
+ * @param[in] read Function to read records.
+ * @param[in] p_context Passed to read.
+ * @param[in] window Maximum number of messages queued at once,
+ *                   1 ... @ref RT_STREAM_WINDOW_MAX.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_stream, p_channel or read is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if window is out of range.
+ */
+rd_status_t rt_stream_init (rt_stream_t * const p_stream,
+                            ri_comm_channel_t * const p_channel,
+                            const rt_stream_read_fp read, void * const p_context,
+                            const uint8_t window);
+
+/**
+ * @brief Start streaming from given record and queue first messages.
+ *
+ * @param[in,out] p_stream Initialized stream.
+ * @param[in] checkpoint Position of first record to stream,
+ *                       @ref RT_STREAM_POSITION_START or value of
+ *                       @ref rt_stream_checkpoint_get.
+ * @param[in] payload Maximum bytes per message, e.g. negotiated MTU minus
+ *                    protocol overhead. At most @ref RI_COMM_MESSAGE_MAX_LENGTH.
+ *
+ * @retval RD_SUCCESS if stream was started.
+ * @retval RD_ERROR_NULL if p_stream is NULL.
+ * @retval RD_ERROR_INVALID_STATE if stream is not initialized.
+ * @retval RD_ERROR_INVALID_LENGTH if payload cannot hold a record.
+ * @return Error code of read or send if stream could not proceed.
+ */
+rd_status_t rt_stream_start (rt_stream_t * const p_stream,
+                             const rt_stream_position_t checkpoint,
+                             const uint8_t payload);
+
+/**
+ * @brief Handle @ref RI_COMM_SENT: advance checkpoint and queue more messages.
+ *
+ * @param[in,out] p_stream Stream.
+ * @retval RD_SUCCESS on success, also if stream is not running.
+ * @retval RD_ERROR_NULL if p_stream is NULL.
+ * @retval RD_ERROR_DATA_SIZE if a record does not fit in a message. Stream stops.
+ * @return Error code of read or send if stream could not proceed.
+ */
+rd_status_t rt_stream_on_sent (rt_stream_t * const p_stream);
+
+/**
+ * @brief Queue messages if there is room in window.
+ *
+ * Sent events drive the stream. Call this to retry if channel was full of
+ * other messages and no sent event for stream is pending.
+ *
+ * @param[in,out] p_stream Stream.
+ * @retval RD_SUCCESS on success, also if stream is not running.
+ * @retval RD_ERROR_NULL if p_stream is NULL.
+ * @return Error code of read or send if stream could not proceed.
+ */
+rd_status_t rt_stream_process (rt_stream_t * const p_stream);
+
+/**
+ * @brief Stop streaming, e.g. on disconnect.
+ *
+ * Messages queued but not reported sent are forgotten and will be streamed
+ * again when stream is started from checkpoint.
+ *
+ * @param[in,out] p_stream Stream.
+ */
+void rt_stream_stop (rt_stream_t * const p_stream);
+
+/**
+ * @brief Position after records in messages reported sent.
+ *
+ * @param[in] p_stream Stream.
+ * @return Position of first record not confirmed sent,
+ *         @ref RT_STREAM_POSITION_START if p_stream is NULL.
+ */
+rt_stream_position_t rt_stream_checkpoint_get (const rt_stream_t * const p_stream);
+
+/**
+ * @brief Check if all records have been sent.
+ *
+ * @param[in] p_stream Stream.
+ * @return True if read has no more records and all messages were reported sent.
+ */
+bool rt_stream_is_complete (const rt_stream_t * const p_stream);
+
+/** @} */
+#endif
@@ -380,3 +380,328 @@ void test_ruuvi_interface_lis2dh12_init_clear_fail (void)
     TEST_ASSERT (!strcmp (m_sensor.name, "LIS2DH12"));
     TEST_ASSERT (m_sensor.init == m_sensor_ni.init);
 }
+
+static void fifo_level_ok (const uint8_t level)
+{
+    static uint8_t enabled = PROPERTY_ENABLE;
+    static uint8_t fss;
+    fss = level;
+    lis2dh12_fifo_get_ExpectAndReturn (& (dev.ctx), NULL, RD_SUCCESS);
+    lis2dh12_fifo_get_IgnoreArg_val();
+    lis2dh12_fifo_get_ReturnThruPtr_val (&enabled);
+    lis2dh12_fifo_data_level_get_ExpectAndReturn (& (dev.ctx), NULL, RD_SUCCESS);
+    lis2dh12_fifo_data_level_get_IgnoreArg_val();
+    lis2dh12_fifo_data_level_get_ReturnThruPtr_val (&fss);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_null (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    err_code |= ri_lis2dh12_fifo_raw_read (NULL, raw);
+    TEST_ASSERT (RD_ERROR_NULL == err_code);
+    err_code = ri_lis2dh12_fifo_raw_read (&num_elements, NULL);
+    TEST_ASSERT (RD_ERROR_NULL == err_code);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_not_active (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    static uint8_t enabled = PROPERTY_DISABLE;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    lis2dh12_fifo_get_ExpectAndReturn (& (dev.ctx), NULL, RD_SUCCESS);
+    lis2dh12_fifo_get_IgnoreArg_val();
+    lis2dh12_fifo_get_ReturnThruPtr_val (&enabled);
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+    TEST_ASSERT (RI_LIS2DH12_FIFO_SIZE == num_elements);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_empty (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    fifo_level_ok (0);
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (0 == num_elements);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_full_single_burst (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    static uint8_t burst[RI_LIS2DH12_FIFO_SIZE * sizeof (axis3bit16_t)];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+
+    for (size_t ii = 0; ii < sizeof (burst); ii++)
+    {
+        burst[ii] = (uint8_t) ii;
+    }
+
+    fifo_level_ok (RI_LIS2DH12_FIFO_SIZE - 1U);
+    lis2dh12_read_reg_ExpectAndReturn (& (dev.ctx), LIS2DH12_OUT_X_L, raw[0].u8bit,
+                                       sizeof (burst), RD_SUCCESS);
+    lis2dh12_read_reg_ReturnArrayThruPtr_data (burst, sizeof (burst));
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (RI_LIS2DH12_FIFO_SIZE == num_elements);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (burst, raw, sizeof (burst));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_limited_by_buffer (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[4];
+    size_t num_elements = sizeof (raw) / sizeof (raw[0]);
+    fifo_level_ok (RI_LIS2DH12_FIFO_SIZE - 1U);
+    lis2dh12_read_reg_ExpectAndReturn (& (dev.ctx), LIS2DH12_OUT_X_L, raw[0].u8bit,
+                                       sizeof (raw), RD_SUCCESS);
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (4 == num_elements);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_raw_read_bus_error (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    fifo_level_ok (RI_LIS2DH12_FIFO_SIZE - 1U);
+    lis2dh12_read_reg_ExpectAnyArgsAndReturn (RD_ERROR_TIMEOUT);
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_ERROR_INTERNAL == err_code);
+}
+
+static rd_sensor_t m_sensor_2;
+static rd_sensor_t m_sensor_3;
+static const uint8_t m_handle_2 = 2;
+static lis2dh12_st_t m_st;
+static lis2dh12_odr_t m_odr;
+static uint8_t m_odr_handle;
+
+static int32_t device_id_get_cb (stmdev_ctx_t * ctx, uint8_t * buff, int cmock_num_calls)
+{
+    *buff = LIS2DH12_ID;
+    return RD_SUCCESS;
+}
+
+static int32_t self_test_set_cb (stmdev_ctx_t * ctx, lis2dh12_st_t val,
+                                 int cmock_num_calls)
+{
+    m_st = val;
+    return RD_SUCCESS;
+}
+
+// Self-test shifts each axis by 32 LSB of left-justified 10-bit data.
+static int32_t acceleration_raw_get_cb (stmdev_ctx_t * ctx, uint8_t * buff,
+                                        int cmock_num_calls)
+{
+    axis3bit16_t * const p_raw = (axis3bit16_t *) buff;
+    int16_t value = 0;
+
+    if (LIS2DH12_ST_POSITIVE == m_st) { value = 32 << 6; }
+    else if (LIS2DH12_ST_NEGATIVE == m_st) { value = - (32 << 6); }
+
+    for (size_t ii = 0; ii < NUM_AXIS; ii++)
+    {
+        p_raw->i16bit[ii] = value;
+    }
+
+    return RD_SUCCESS;
+}
+
+static int32_t data_rate_set_cb (stmdev_ctx_t * ctx, lis2dh12_odr_t val,
+                                 int cmock_num_calls)
+{
+    m_odr = val;
+    m_odr_handle = * ( (uint8_t *) ctx->handle);
+    return RD_SUCCESS;
+}
+
+static int32_t data_rate_get_cb (stmdev_ctx_t * ctx, lis2dh12_odr_t * val,
+                                 int cmock_num_calls)
+{
+    *val = m_odr;
+    return RD_SUCCESS;
+}
+
+/** Simulate a working sensor on any instance, bus writes are not verified. */
+static void sensor_model_use (void)
+{
+    lis2dh12_device_id_get_StubWithCallback (&device_id_get_cb);
+    lis2dh12_self_test_set_StubWithCallback (&self_test_set_cb);
+    lis2dh12_acceleration_raw_get_StubWithCallback (&acceleration_raw_get_cb);
+    lis2dh12_data_rate_set_StubWithCallback (&data_rate_set_cb);
+    lis2dh12_data_rate_get_StubWithCallback (&data_rate_get_cb);
+    lis2dh12_fifo_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_fifo_mode_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_pin_int1_config_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_high_pass_int_conf_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_int1_gen_conf_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_pin_int2_config_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_temperature_meas_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_block_data_update_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_high_pass_on_outputs_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_full_scale_set_IgnoreAndReturn (RD_SUCCESS);
+    lis2dh12_operating_mode_set_IgnoreAndReturn (RD_SUCCESS);
+    ri_delay_ms_IgnoreAndReturn (RD_SUCCESS);
+}
+
+static rd_status_t model_init (rd_sensor_t * const p_sensor, const uint8_t handle)
+{
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    rd_sensor_initialize_Expect (p_sensor);
+    return ri_lis2dh12_init (p_sensor, m_bus, handle);
+}
+
+static void model_uninit (rd_sensor_t * const p_sensor)
+{
+    rd_sensor_uninitialize_Expect (p_sensor);
+    TEST_ASSERT (RD_SUCCESS == p_sensor->uninit (p_sensor, m_bus, m_handle));
+    memset (p_sensor, 0, sizeof (rd_sensor_t));
+}
+
+void test_ruuvi_interface_lis2dh12_init_second_instance (void)
+{
+    sensor_model_use();
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor, m_handle));
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor_2, m_handle_2));
+    TEST_ASSERT (m_handle_2 == m_odr_handle);
+    TEST_ASSERT (m_sensor.samplerate_set != m_sensor_2.samplerate_set);
+    TEST_ASSERT (m_sensor.data_get != m_sensor_2.data_get);
+    TEST_ASSERT (m_sensor.init == m_sensor_2.init);
+    TEST_ASSERT (&ri_lis2dh12_cost_get == m_sensor_2.cost_get);
+    model_uninit (&m_sensor_2);
+    TEST_ASSERT (m_handle_2 == m_odr_handle);
+    TEST_ASSERT (LIS2DH12_POWER_DOWN == m_odr);
+    model_uninit (&m_sensor);
+    TEST_ASSERT (m_handle == m_odr_handle);
+}
+
+void test_ruuvi_interface_lis2dh12_uninit_not_initialized (void)
+{
+    sensor_model_use();
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor, m_handle));
+    rd_sensor_uninitialize_Expect (&m_sensor_2);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_uninit (&m_sensor_2, m_bus, m_handle_2));
+    // Free instance and instance of other sensor are untouched.
+    TEST_ASSERT (m_handle == m_odr_handle);
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor_2, m_handle_2));
+    model_uninit (&m_sensor_2);
+    model_uninit (&m_sensor);
+}
+
+void test_ruuvi_interface_lis2dh12_init_caller_context (void)
+{
+    ri_lis2dh12_dev ctx = {0};
+    uint8_t samplerate = 10U;
+    sensor_model_use();
+    m_sensor.p_ctx = &ctx;
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor, m_handle));
+    TEST_ASSERT (m_handle == ctx.handle);
+    TEST_ASSERT (0U == dev.handle);
+    // Public functions follow context of instance 0.
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_samplerate_set (&samplerate));
+    TEST_ASSERT (LIS2DH12_ODR_10Hz == ctx.samplerate);
+    rd_sensor_uninitialize_Expect (&m_sensor);
+    TEST_ASSERT (RD_SUCCESS == m_sensor.uninit (&m_sensor, m_bus, m_handle));
+    TEST_ASSERT (&ctx == m_sensor.p_ctx);
+    memset (&m_sensor, 0, sizeof (rd_sensor_t));
+}
+
+void test_ruuvi_interface_lis2dh12_instances_independent (void)
+{
+    uint8_t samplerate = 10U;
+    sensor_model_use();
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor, m_handle));
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor_2, m_handle_2));
+    TEST_ASSERT (RD_SUCCESS == m_sensor_2.samplerate_set (&samplerate));
+    TEST_ASSERT (m_handle_2 == m_odr_handle);
+    TEST_ASSERT (LIS2DH12_ODR_10Hz == m_odr);
+    TEST_ASSERT (LIS2DH12_POWER_DOWN == dev.samplerate);
+    TEST_ASSERT (10U == samplerate);
+    model_uninit (&m_sensor_2);
+    model_uninit (&m_sensor);
+}
+
+void test_ruuvi_interface_lis2dh12_init_no_free_instance (void)
+{
+    sensor_model_use();
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor, m_handle));
+    TEST_ASSERT (RD_SUCCESS == model_init (&m_sensor_2, m_handle_2));
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    TEST_ASSERT (RD_ERROR_RESOURCES == ri_lis2dh12_init (&m_sensor_3, m_bus, 3U));
+    TEST_ASSERT (NULL == m_sensor_3.init);
+    model_uninit (&m_sensor_2);
+    model_uninit (&m_sensor);
+}
+
+void test_ruuvi_interface_lis2dh12_cost_get_continuous (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 10U,
+        .resolution = 10U,
+        .mode = RD_SENSOR_CFG_CONTINUOUS
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (4000U, cost.average_na);
+    TEST_ASSERT_EQUAL_UINT32 (100000U, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (400U, cost.charge_nc);
+    config.resolution = RD_SENSOR_CFG_MIN;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (3000U, cost.average_na);
+    // Maximum data rate depends on operating mode.
+    config.samplerate = RD_SENSOR_CFG_MAX;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (186U, cost.conversion_us);
+    config.resolution = 12U;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (744U, cost.conversion_us);
+}
+
+void test_ruuvi_interface_lis2dh12_cost_get_single (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 1U,
+        .resolution = RD_SENSOR_CFG_DEFAULT,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    // 400 Hz for 18 ms once per second.
+    rd_sensor_cost_average_na_ExpectAndReturn (NULL, 1000000U, 1800U);
+    rd_sensor_cost_average_na_IgnoreArg_p_cost();
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (18000U, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (1314U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (RI_LIS2DH12_POWER_DOWN_NA, cost.sleep_na);
+    TEST_ASSERT_EQUAL_UINT32 (1800U, cost.average_na);
+}
+
+void test_ruuvi_interface_lis2dh12_cost_get_not_supported (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = RD_SENSOR_CFG_CUSTOM_2,
+        .resolution = 10U,
+        .mode = RD_SENSOR_CFG_CONTINUOUS
+    };
+    rd_sensor_cost_t cost = {0};
+    // 1620 Hz is available only in low-power mode.
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_lis2dh12_cost_get (&config, &cost));
+    config.resolution = 8U;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (100000U, cost.average_na);
+    config.resolution = 14U;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_lis2dh12_cost_get (&config, &cost));
+    config.resolution = 8U;
+    config.samplerate = RD_SENSOR_CFG_CUSTOM_4;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_lis2dh12_cost_get (&config, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_lis2dh12_cost_get (NULL, &cost));
+}
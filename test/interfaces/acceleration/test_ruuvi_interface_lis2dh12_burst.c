@@ -0,0 +1,144 @@
+#include "unity.h"
+
+#include "ruuvi_interface_lis2dh12.h"
+#include "ruuvi_interface_spi_lis2dh12.h"
+#include "mock_lis2dh12_reg.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_gpio.h"
+#include "mock_ruuvi_interface_spi.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file test_ruuvi_interface_lis2dh12_burst.c
+ * @brief Count SPI transactions of FIFO drain.
+ *
+ * STM driver is mocked, register accesses are forwarded to the real
+ * SPI wrapper of LIS2DH12 so that every call to ri_spi_xfer_blocking
+ * can be counted.
+ */
+
+#define BURST_HANDLE (1U)
+
+static size_t m_xfer_count;
+static size_t m_xfer_bytes;
+static uint8_t m_fifo_level;
+
+static rd_status_t xfer_count_cb (const uint8_t * const p_tx, const size_t tx_len,
+                                  uint8_t * const p_rx, const size_t rx_len,
+                                  const int cmock_num_calls)
+{
+    m_xfer_count++;
+    m_xfer_bytes += tx_len + rx_len;
+
+    // Fill received data with a pattern repeating per sample.
+    for (size_t ii = 0; ii < rx_len; ii++)
+    {
+        p_rx[ii] = (uint8_t) (ii % sizeof (axis3bit16_t));
+    }
+
+    return RD_SUCCESS;
+}
+
+static int32_t fifo_get_cb (stmdev_ctx_t * ctx, uint8_t * val, int cmock_num_calls)
+{
+    *val = PROPERTY_ENABLE;
+    return RD_SUCCESS;
+}
+
+static int32_t fifo_level_cb (stmdev_ctx_t * ctx, uint8_t * val, int cmock_num_calls)
+{
+    *val = m_fifo_level;
+    return RD_SUCCESS;
+}
+
+// Behaves as STM driver, i.e. passes register access to bus.
+static int32_t read_reg_cb (stmdev_ctx_t * ctx, uint8_t reg, uint8_t * data,
+                            uint16_t len, int cmock_num_calls)
+{
+    return ctx->read_reg (ctx->handle, reg, data, len);
+}
+
+static int32_t acceleration_raw_get_cb (stmdev_ctx_t * ctx, uint8_t * buff,
+                                        int cmock_num_calls)
+{
+    return ctx->read_reg (ctx->handle, LIS2DH12_OUT_X_L, buff, 6);
+}
+
+void setUp (void)
+{
+    memset (&dev, 0, sizeof (dev));
+    dev.handle = BURST_HANDLE;
+    dev.ctx.read_reg = &ri_spi_lis2dh12_read;
+    dev.ctx.write_reg = &ri_spi_lis2dh12_write;
+    dev.ctx.handle = &dev.handle;
+    m_xfer_count = 0;
+    m_xfer_bytes = 0;
+    m_fifo_level = RI_LIS2DH12_FIFO_SIZE - 1U;
+    ri_gpio_write_IgnoreAndReturn (RD_SUCCESS);
+    ri_spi_xfer_blocking_StubWithCallback (&xfer_count_cb);
+    lis2dh12_fifo_get_StubWithCallback (&fifo_get_cb);
+    lis2dh12_fifo_data_level_get_StubWithCallback (&fifo_level_cb);
+    lis2dh12_read_reg_StubWithCallback (&read_reg_cb);
+    lis2dh12_acceleration_raw_get_StubWithCallback (&acceleration_raw_get_cb);
+}
+
+void tearDown (void)
+{
+    memset (&dev, 0, sizeof (dev));
+}
+
+void test_ruuvi_interface_lis2dh12_burst_full_fifo_xfers (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (RI_LIS2DH12_FIFO_SIZE == num_elements);
+    // FIFO enable + FIFO level are mocked out, drain is register address + payload.
+    TEST_ASSERT_EQUAL (2, m_xfer_count);
+    TEST_ASSERT_EQUAL (1 + sizeof (raw), m_xfer_bytes);
+}
+
+void test_ruuvi_interface_lis2dh12_burst_matches_per_sample (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t burst[RI_LIS2DH12_FIFO_SIZE];
+    axis3bit16_t single[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, burst);
+    const size_t burst_xfers = m_xfer_count;
+    m_xfer_count = 0;
+
+    for (size_t ii = 0; ii < num_elements; ii++)
+    {
+        err_code |= ri_lis2dh12_acceleration_raw_get (single[ii].u8bit);
+    }
+
+    const size_t single_xfers = m_xfer_count;
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (single, burst, sizeof (burst));
+    TEST_ASSERT_EQUAL (2 * RI_LIS2DH12_FIFO_SIZE, single_xfers);
+    TEST_ASSERT (burst_xfers < single_xfers);
+    char msg[80];
+    snprintf (msg, sizeof (msg), "FIFO drain SPI transfers: per-sample %u, burst %u",
+              (unsigned int) single_xfers, (unsigned int) burst_xfers);
+    TEST_MESSAGE (msg);
+}
+
+void test_ruuvi_interface_lis2dh12_burst_partial_fifo_xfers (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    size_t num_elements = RI_LIS2DH12_FIFO_SIZE;
+    m_fifo_level = 7U;
+    err_code |= ri_lis2dh12_fifo_raw_read (&num_elements, raw);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL (8, num_elements);
+    TEST_ASSERT_EQUAL (2, m_xfer_count);
+    TEST_ASSERT_EQUAL (1 + (8 * sizeof (axis3bit16_t)), m_xfer_bytes);
+}
@@ -0,0 +1,346 @@
+#include "unity.h"
+
+#include "ruuvi_interface_lis2dh12.h"
+#include "mock_lis2dh12_reg.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_spi_lis2dh12.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file test_ruuvi_interface_lis2dh12_conversion.c
+ * @brief Verify and benchmark cached raw-to-g and raw-to-mg conversion against nested switch.
+ */
+
+#define BENCHMARK_SAMPLES (1000000U) //!< Samples converted in benchmark.
+
+static const uint8_t m_scales[] = {2U, 4U, 8U, 16U};
+static const uint8_t m_resolutions[] = {8U, 10U, 12U};
+
+static lis2dh12_fs_t m_scale;
+static lis2dh12_op_md_t m_resolution;
+
+static int32_t full_scale_set_cb (stmdev_ctx_t * ctx, lis2dh12_fs_t val,
+                                  int cmock_num_calls)
+{
+    m_scale = val;
+    return RD_SUCCESS;
+}
+
+static int32_t full_scale_get_cb (stmdev_ctx_t * ctx, lis2dh12_fs_t * val,
+                                  int cmock_num_calls)
+{
+    *val = m_scale;
+    return RD_SUCCESS;
+}
+
+static int32_t operating_mode_set_cb (stmdev_ctx_t * ctx, lis2dh12_op_md_t val,
+                                      int cmock_num_calls)
+{
+    m_resolution = val;
+    return RD_SUCCESS;
+}
+
+static int32_t operating_mode_get_cb (stmdev_ctx_t * ctx, lis2dh12_op_md_t * val,
+                                      int cmock_num_calls)
+{
+    *val = m_resolution;
+    return RD_SUCCESS;
+}
+
+/** @brief Conversion before caching: nested switch of STM driver formulas. */
+static float reference_mg (const lis2dh12_fs_t scale, const lis2dh12_op_md_t resolution,
+                           const int16_t lsb)
+{
+    float mg = RD_FLOAT_INVALID;
+
+    switch (scale)
+    {
+        case LIS2DH12_2g:
+            switch (resolution)
+            {
+                case LIS2DH12_LP_8bit:
+                    mg = ( (float) lsb / 256.0f) * 16.0f;
+                    break;
+
+                case LIS2DH12_NM_10bit:
+                    mg = ( (float) lsb / 64.0f) * 4.0f;
+                    break;
+
+                case LIS2DH12_HR_12bit:
+                    mg = ( (float) lsb / 16.0f) * 1.0f;
+                    break;
+
+                default:
+                    break;
+            }
+
+            break;
+
+        case LIS2DH12_4g:
+            switch (resolution)
+            {
+                case LIS2DH12_LP_8bit:
+                    mg = ( (float) lsb / 256.0f) * 32.0f;
+                    break;
+
+                case LIS2DH12_NM_10bit:
+                    mg = ( (float) lsb / 64.0f) * 8.0f;
+                    break;
+
+                case LIS2DH12_HR_12bit:
+                    mg = ( (float) lsb / 16.0f) * 2.0f;
+                    break;
+
+                default:
+                    break;
+            }
+
+            break;
+
+        case LIS2DH12_8g:
+            switch (resolution)
+            {
+                case LIS2DH12_LP_8bit:
+                    mg = ( (float) lsb / 256.0f) * 64.0f;
+                    break;
+
+                case LIS2DH12_NM_10bit:
+                    mg = ( (float) lsb / 64.0f) * 16.0f;
+                    break;
+
+                case LIS2DH12_HR_12bit:
+                    mg = ( (float) lsb / 16.0f) * 4.0f;
+                    break;
+
+                default:
+                    break;
+            }
+
+            break;
+
+        case LIS2DH12_16g:
+            switch (resolution)
+            {
+                case LIS2DH12_LP_8bit:
+                    mg = ( (float) lsb / 256.0f) * 192.0f;
+                    break;
+
+                case LIS2DH12_NM_10bit:
+                    mg = ( (float) lsb / 64.0f) * 48.0f;
+                    break;
+
+                case LIS2DH12_HR_12bit:
+                    mg = ( (float) lsb / 16.0f) * 12.0f;
+                    break;
+
+                default:
+                    break;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    return mg;
+}
+
+static uint8_t unused_bits (const lis2dh12_op_md_t resolution)
+{
+    uint8_t bits = 4U;
+
+    if (LIS2DH12_LP_8bit == resolution) { bits = 8U; }
+    else if (LIS2DH12_NM_10bit == resolution) { bits = 6U; }
+
+    return bits;
+}
+
+static void configure (const uint8_t scale, const uint8_t resolution)
+{
+    uint8_t cfg = scale;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_scale_set (&cfg));
+    TEST_ASSERT (scale == cfg);
+    cfg = resolution;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_resolution_set (&cfg));
+    TEST_ASSERT (resolution == cfg);
+}
+
+void setUp (void)
+{
+    memset (&dev, 0, sizeof (dev));
+    dev.mode = RD_SENSOR_CFG_SLEEP;
+    lis2dh12_full_scale_set_StubWithCallback (&full_scale_set_cb);
+    lis2dh12_full_scale_get_StubWithCallback (&full_scale_get_cb);
+    lis2dh12_operating_mode_set_StubWithCallback (&operating_mode_set_cb);
+    lis2dh12_operating_mode_get_StubWithCallback (&operating_mode_get_cb);
+}
+
+void tearDown (void)
+{
+    memset (&dev, 0, sizeof (dev));
+}
+
+void test_ruuvi_interface_lis2dh12_raw_to_mg_null (void)
+{
+    axis3bit16_t raw = {0};
+    int16_t mg[NUM_AXIS];
+    TEST_ASSERT (RD_ERROR_NULL == ri_lis2dh12_raw_to_mg (NULL, mg, 1));
+    TEST_ASSERT (RD_ERROR_NULL == ri_lis2dh12_raw_to_mg (&raw, NULL, 1));
+}
+
+void test_ruuvi_interface_lis2dh12_raw_to_mg_not_configured (void)
+{
+    axis3bit16_t raw = {0};
+    int16_t mg[NUM_AXIS];
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_lis2dh12_raw_to_mg (&raw, mg, 1));
+}
+
+void test_ruuvi_interface_lis2dh12_raw_to_mg_matches_reference (void)
+{
+    for (size_t ss = 0; ss < sizeof (m_scales); ss++)
+    {
+        for (size_t rr = 0; rr < sizeof (m_resolutions); rr++)
+        {
+            configure (m_scales[ss], m_resolutions[rr]);
+            const uint8_t shift = unused_bits (m_resolution);
+
+            for (int32_t value = INT16_MIN; value <= INT16_MAX; value += (1 << shift))
+            {
+                axis3bit16_t raw = {.i16bit = {(int16_t) value, (int16_t) - value, 0}};
+                int16_t mg[NUM_AXIS];
+                TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_raw_to_mg (&raw, mg, 1));
+                TEST_ASSERT_EQUAL_INT16 ( (int16_t) reference_mg (m_scale, m_resolution,
+                                          raw.i16bit[0]), mg[0]);
+                TEST_ASSERT_EQUAL_INT16 ( (int16_t) reference_mg (m_scale, m_resolution,
+                                          raw.i16bit[1]), mg[1]);
+                TEST_ASSERT_EQUAL_INT16 (0, mg[2]);
+            }
+        }
+    }
+}
+
+void test_ruuvi_interface_lis2dh12_get_refreshes_conversion (void)
+{
+    axis3bit16_t raw = {.i16bit = {1024, -1024, 0}};
+    int16_t mg[NUM_AXIS];
+    uint8_t cfg;
+    configure (2U, 12U);
+    // Sensor configuration changes behind the driver, e.g. after reset.
+    m_scale = LIS2DH12_16g;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_scale_get (&cfg));
+    TEST_ASSERT (16U == cfg);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_raw_to_mg (&raw, mg, 1));
+    TEST_ASSERT_EQUAL_INT16 ( (int16_t) reference_mg (m_scale, m_resolution,
+                              raw.i16bit[0]), mg[0]);
+    m_resolution = LIS2DH12_LP_8bit;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_resolution_get (&cfg));
+    TEST_ASSERT (8U == cfg);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_raw_to_mg (&raw, mg, 1));
+    TEST_ASSERT_EQUAL_INT16 ( (int16_t) reference_mg (m_scale, m_resolution,
+                              raw.i16bit[0]), mg[0]);
+    TEST_ASSERT_EQUAL_INT16 ( (int16_t) reference_mg (m_scale, m_resolution,
+                              raw.i16bit[1]), mg[1]);
+}
+
+void test_ruuvi_interface_lis2dh12_raw_to_g_matches_reference (void)
+{
+    for (size_t ss = 0; ss < sizeof (m_scales); ss++)
+    {
+        for (size_t rr = 0; rr < sizeof (m_resolutions); rr++)
+        {
+            configure (m_scales[ss], m_resolutions[rr]);
+            const uint8_t shift = unused_bits (m_resolution);
+
+            for (int32_t value = INT16_MIN; value <= INT16_MAX; value += (1 << shift))
+            {
+                axis3bit16_t raw = {.i16bit = {(int16_t) value, (int16_t) - value, 0}};
+                float g[NUM_AXIS];
+                TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_raw_to_g (&raw, g, 1));
+
+                for (size_t jj = 0; jj < NUM_AXIS; jj++)
+                {
+                    TEST_ASSERT_FLOAT_WITHIN (0.0001f, reference_mg (m_scale, m_resolution,
+                                              raw.i16bit[jj]) / 1000.0, g[jj]);
+                }
+            }
+        }
+    }
+}
+
+/** @brief Old float path of data_get: nested switch to mg, double division to g. */
+static void reference_to_g (const axis3bit16_t * const p_raw, float * const p_g)
+{
+    for (size_t ii = 0; ii < RI_LIS2DH12_FIFO_SIZE; ii++)
+    {
+        for (size_t jj = 0; jj < NUM_AXIS; jj++)
+        {
+            p_g[ (ii * NUM_AXIS) + jj] = reference_mg (m_scale, m_resolution,
+                                         p_raw[ii].i16bit[jj]) / 1000.0;
+        }
+    }
+}
+
+void test_ruuvi_interface_lis2dh12_raw_to_g_benchmark (void)
+{
+    axis3bit16_t raw[RI_LIS2DH12_FIFO_SIZE];
+    int16_t mg[RI_LIS2DH12_FIFO_SIZE * NUM_AXIS];
+    float g[RI_LIS2DH12_FIFO_SIZE * NUM_AXIS];
+    volatile float sink_ref = 0;
+    volatile float sink_new = 0;
+    volatile int32_t sink_fixed = 0;
+    configure (16U, 12U);
+
+    for (size_t ii = 0; ii < RI_LIS2DH12_FIFO_SIZE; ii++)
+    {
+        for (size_t jj = 0; jj < NUM_AXIS; jj++)
+        {
+            raw[ii].i16bit[jj] = (int16_t) ( (ii * 1031U + jj * 257U) << 4U);
+        }
+    }
+
+    const clock_t ref_start = clock();
+
+    for (size_t rounds = 0; rounds < (BENCHMARK_SAMPLES / RI_LIS2DH12_FIFO_SIZE); rounds++)
+    {
+        reference_to_g (raw, g);
+        sink_ref += g[rounds % (RI_LIS2DH12_FIFO_SIZE * NUM_AXIS)];
+    }
+
+    const clock_t ref_ticks = clock() - ref_start;
+    const clock_t new_start = clock();
+
+    for (size_t rounds = 0; rounds < (BENCHMARK_SAMPLES / RI_LIS2DH12_FIFO_SIZE); rounds++)
+    {
+        ri_lis2dh12_raw_to_g (raw, g, RI_LIS2DH12_FIFO_SIZE);
+        sink_new += g[rounds % (RI_LIS2DH12_FIFO_SIZE * NUM_AXIS)];
+    }
+
+    const clock_t new_ticks = clock() - new_start;
+    const clock_t fixed_start = clock();
+
+    for (size_t rounds = 0; rounds < (BENCHMARK_SAMPLES / RI_LIS2DH12_FIFO_SIZE); rounds++)
+    {
+        ri_lis2dh12_raw_to_mg (raw, mg, RI_LIS2DH12_FIFO_SIZE);
+        sink_fixed += mg[rounds % (RI_LIS2DH12_FIFO_SIZE * NUM_AXIS)];
+    }
+
+    const clock_t fixed_ticks = clock() - fixed_start;
+    char msg[160];
+    snprintf (msg, sizeof (msg),
+              "%u samples to g: nested switch %.1f ms, cached factor %.1f ms, "
+              "to mg fixed point %.1f ms",
+              BENCHMARK_SAMPLES,
+              1000.0 * (double) ref_ticks / CLOCKS_PER_SEC,
+              1000.0 * (double) new_ticks / CLOCKS_PER_SEC,
+              1000.0 * (double) fixed_ticks / CLOCKS_PER_SEC);
+    TEST_MESSAGE (msg);
+    (void) sink_ref;
+    (void) sink_new;
+    (void) sink_fixed;
+}
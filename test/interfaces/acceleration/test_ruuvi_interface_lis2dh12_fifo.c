@@ -0,0 +1,382 @@
+#include "unity.h"
+
+#include "ruuvi_interface_lis2dh12.h"
+#include "mock_lis2dh12_reg.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_spi_lis2dh12.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <string.h>
+
+/**
+ * @file test_ruuvi_interface_lis2dh12_fifo.c
+ * @brief FIFO block output and sample timing of FIFO reads.
+ *
+ * STM driver is mocked, FIFO content is generated by register read callback.
+ */
+
+static lis2dh12_fs_t m_scale;
+static lis2dh12_op_md_t m_resolution;
+static uint8_t m_fifo_level;
+static uint8_t m_overrun;
+
+static int32_t full_scale_set_cb (stmdev_ctx_t * ctx, lis2dh12_fs_t val,
+                                  int cmock_num_calls)
+{
+    m_scale = val;
+    return RD_SUCCESS;
+}
+
+static int32_t full_scale_get_cb (stmdev_ctx_t * ctx, lis2dh12_fs_t * val,
+                                  int cmock_num_calls)
+{
+    *val = m_scale;
+    return RD_SUCCESS;
+}
+
+static int32_t operating_mode_set_cb (stmdev_ctx_t * ctx, lis2dh12_op_md_t val,
+                                      int cmock_num_calls)
+{
+    m_resolution = val;
+    return RD_SUCCESS;
+}
+
+static int32_t operating_mode_get_cb (stmdev_ctx_t * ctx, lis2dh12_op_md_t * val,
+                                      int cmock_num_calls)
+{
+    *val = m_resolution;
+    return RD_SUCCESS;
+}
+
+static int32_t fifo_get_cb (stmdev_ctx_t * ctx, uint8_t * val, int cmock_num_calls)
+{
+    *val = PROPERTY_ENABLE;
+    return RD_SUCCESS;
+}
+
+static int32_t fifo_level_cb (stmdev_ctx_t * ctx, uint8_t * val, int cmock_num_calls)
+{
+    *val = m_fifo_level;
+    return RD_SUCCESS;
+}
+
+static int32_t fifo_ovr_cb (stmdev_ctx_t * ctx, uint8_t * val, int cmock_num_calls)
+{
+    *val = m_overrun;
+    return RD_SUCCESS;
+}
+
+// Sample N has value N << 4 on X, negated on Y and zero on Z.
+static int32_t read_reg_cb (stmdev_ctx_t * ctx, uint8_t reg, uint8_t * data,
+                            uint16_t len, int cmock_num_calls)
+{
+    axis3bit16_t * const p_raw = (axis3bit16_t *) data;
+
+    for (size_t ii = 0; ii < (len / sizeof (axis3bit16_t)); ii++)
+    {
+        p_raw[ii].i16bit[0] = (int16_t) (ii << 4U);
+        p_raw[ii].i16bit[1] = (int16_t) - (int16_t) (ii << 4U);
+        p_raw[ii].i16bit[2] = 0;
+    }
+
+    return RD_SUCCESS;
+}
+
+static void configure (const uint8_t scale, const uint8_t resolution)
+{
+    uint8_t cfg = scale;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_scale_set (&cfg));
+    TEST_ASSERT (scale == cfg);
+    cfg = resolution;
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_resolution_set (&cfg));
+    TEST_ASSERT (resolution == cfg);
+}
+
+void setUp (void)
+{
+    memset (&dev, 0, sizeof (dev));
+    dev.mode = RD_SENSOR_CFG_SLEEP;
+    lis2dh12_full_scale_set_StubWithCallback (&full_scale_set_cb);
+    lis2dh12_full_scale_get_StubWithCallback (&full_scale_get_cb);
+    lis2dh12_operating_mode_set_StubWithCallback (&operating_mode_set_cb);
+    lis2dh12_operating_mode_get_StubWithCallback (&operating_mode_get_cb);
+    lis2dh12_fifo_ovr_flag_get_StubWithCallback (&fifo_ovr_cb);
+    m_overrun = 0U;
+}
+
+void tearDown (void)
+{
+    memset (&dev, 0, sizeof (dev));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_block_read_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == ri_lis2dh12_fifo_block_read (NULL));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_block_read_full (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    configure (2U, 12U);
+    dev.samplerate = LIS2DH12_ODR_100Hz;
+    m_fifo_level = RI_LIS2DH12_FIFO_SIZE - 1U;
+    lis2dh12_fifo_get_StubWithCallback (&fifo_get_cb);
+    lis2dh12_fifo_data_level_get_StubWithCallback (&fifo_level_cb);
+    lis2dh12_read_reg_StubWithCallback (&read_reg_cb);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_block_read (&block));
+    TEST_ASSERT_EQUAL (RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES, block.count);
+    TEST_ASSERT_EQUAL (10000U, block.interval_us);
+    // Oldest sample is 31 samples of 10 ms before read.
+    TEST_ASSERT_EQUAL (1000U - 310U, block.timestamp_ms);
+
+    for (size_t ii = 0; ii < block.count; ii++)
+    {
+        TEST_ASSERT_EQUAL_INT16 ( (int16_t) ii, block.x[ii]);
+        TEST_ASSERT_EQUAL_INT16 (- (int16_t) ii, block.y[ii]);
+        TEST_ASSERT_EQUAL_INT16 (0, block.z[ii]);
+    }
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_block_read_empty (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    configure (2U, 12U);
+    dev.samplerate = LIS2DH12_ODR_10Hz;
+    m_fifo_level = 0;
+    lis2dh12_fifo_get_StubWithCallback (&fifo_get_cb);
+    lis2dh12_fifo_data_level_get_StubWithCallback (&fifo_level_cb);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_block_read (&block));
+    TEST_ASSERT_EQUAL (0, block.count);
+    TEST_ASSERT_EQUAL (100000U, block.interval_us);
+    TEST_ASSERT_EQUAL (1000U, block.timestamp_ms);
+}
+
+static void fifo_timing_setup (const uint8_t fifo_level)
+{
+    configure (2U, 12U);
+    dev.samplerate = LIS2DH12_ODR_100Hz;
+    dev.fifo_drain_ms = RD_UINT64_INVALID;
+    m_fifo_level = fifo_level;
+    lis2dh12_fifo_get_StubWithCallback (&fifo_get_cb);
+    lis2dh12_fifo_data_level_get_StubWithCallback (&fifo_level_cb);
+    lis2dh12_read_reg_StubWithCallback (&read_reg_cb);
+    rd_sensor_data_populate_Ignore();
+}
+
+static void fifo_drain (const uint64_t now, size_t num_elements,
+                        rd_sensor_data_t * const p_data)
+{
+    rd_sensor_timestamp_get_ExpectAndReturn (now);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_read (&num_elements, p_data));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_read_timestamps (void)
+{
+    rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE] = {0};
+    fifo_timing_setup (9U);
+    fifo_drain (1000U, RI_LIS2DH12_FIFO_SIZE, data);
+
+    // 10 samples, newest at read time, 10 ms apart.
+    for (size_t ii = 0; ii < 10U; ii++)
+    {
+        TEST_ASSERT_EQUAL (1000U - (10U * (9U - ii)), data[ii].timestamp_ms);
+    }
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_drift_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == ri_lis2dh12_fifo_drift_get (NULL));
+}
+
+/** Sensor sampling on its own clock and host reading FIFO with ms timestamps. */
+typedef struct
+{
+    uint64_t now_ns;         //!< Host time.
+    uint64_t next_sample_ns; //!< Time of next sample on sensor.
+    uint32_t interval_ns;    //!< Actual sample interval of sensor.
+    uint32_t rng;            //!< State of interrupt latency generator.
+} sensor_clock_t;
+
+static uint64_t m_now_ms;
+
+static uint64_t timestamp_cb (int cmock_num_calls)
+{
+    return m_now_ms;
+}
+
+static void sensor_clock_init (sensor_clock_t * const p_clock, const uint32_t interval_ns)
+{
+    p_clock->now_ns = 1000000000ULL;
+    p_clock->next_sample_ns = p_clock->now_ns + 3333333U;
+    p_clock->interval_ns = interval_ns;
+    p_clock->rng = 12345U;
+}
+
+/**
+ * Wait for watermark interrupt and drain FIFO.
+ * Interrupt is served up to max_latency_ms after FIFO has filled.
+ */
+static void sensor_clock_drain (sensor_clock_t * const p_clock,
+                                const uint32_t max_latency_ms,
+                                rd_sensor_data_t * const p_data)
+{
+    const uint64_t full_ns = p_clock->next_sample_ns
+                             + ( (RI_LIS2DH12_FIFO_SIZE - 1U) * (uint64_t) p_clock->interval_ns);
+    p_clock->rng = (p_clock->rng * 1103515245U) + 12345U;
+    const uint64_t latency_ns = (max_latency_ms) ?
+                                ( (p_clock->rng >> 8U) % (max_latency_ms * 1000000U)) : 0U;
+    p_clock->now_ns = full_ns + latency_ns;
+    size_t samples = 0;
+
+    while (p_clock->next_sample_ns <= p_clock->now_ns)
+    {
+        p_clock->next_sample_ns += p_clock->interval_ns;
+        samples++;
+    }
+
+    TEST_ASSERT_EQUAL (RI_LIS2DH12_FIFO_SIZE, samples);
+    m_fifo_level = (uint8_t) (samples - 1U);
+    m_now_ms = p_clock->now_ns / 1000000U;
+    samples = RI_LIS2DH12_FIFO_SIZE;
+    rd_sensor_timestamp_get_StubWithCallback (&timestamp_cb);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_read (&samples, p_data));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_drift_not_ready (void)
+{
+    static rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE];
+    sensor_clock_t clock;
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (0U);
+    sensor_clock_init (&clock, 10000000U);
+
+    for (size_t ii = 0; ii < (RI_LIS2DH12_DRIFT_MIN_SAMPLES / RI_LIS2DH12_FIFO_SIZE); ii++)
+    {
+        sensor_clock_drain (&clock, 0U, data);
+    }
+
+    // First drain only starts baseline.
+    TEST_ASSERT_EQUAL (RI_LIS2DH12_DRIFT_MIN_SAMPLES - RI_LIS2DH12_FIFO_SIZE,
+                       dev.fifo_base_samples);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    sensor_clock_drain (&clock, 0U, data);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+}
+
+/** Full FIFO on watermark is counted, 1 % slow clock is measured. */
+void test_ruuvi_interface_lis2dh12_fifo_drift_tracked (void)
+{
+    static rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE];
+    sensor_clock_t clock;
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (0U);
+    sensor_clock_init (&clock, 10100000U);
+
+    for (size_t ii = 0; ii < 400U; ii++)
+    {
+        sensor_clock_drain (&clock, 3U, data);
+    }
+
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    TEST_ASSERT_INT32_WITHIN (300, 10000, drift_ppm);
+    // Timestamps use measured interval.
+    const uint64_t now_ms = clock.now_ns / 1000000U;
+    TEST_ASSERT_UINT32_WITHIN (2U, now_ms - 313U, data[0].timestamp_ms);
+}
+
+/** Interrupt latency of drains is not reported as drift. */
+void test_ruuvi_interface_lis2dh12_fifo_drift_jitter (void)
+{
+    static rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE];
+    sensor_clock_t clock;
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (0U);
+    sensor_clock_init (&clock, 10000000U);
+
+    for (size_t ii = 0; ii < 400U; ii++)
+    {
+        sensor_clock_drain (&clock, 8U, data);
+    }
+
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    TEST_ASSERT_INT32_WITHIN (300, 0, drift_ppm);
+}
+
+/** Baseline is restarted after max samples, estimate is kept. */
+void test_ruuvi_interface_lis2dh12_fifo_drift_baseline_restart (void)
+{
+    static rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE];
+    sensor_clock_t clock;
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (0U);
+    sensor_clock_init (&clock, 9950000U);
+
+    for (size_t ii = 0; ii <= (RI_LIS2DH12_DRIFT_MAX_SAMPLES / RI_LIS2DH12_FIFO_SIZE); ii++)
+    {
+        sensor_clock_drain (&clock, 3U, data);
+    }
+
+    TEST_ASSERT_EQUAL (0U, dev.fifo_base_samples);
+    TEST_ASSERT_EQUAL (clock.now_ns / 1000000U, dev.fifo_base_ms);
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    TEST_ASSERT_INT32_WITHIN (100, -5000, drift_ppm);
+}
+
+/** Samples may have been lost on overrun, baseline is restarted. */
+void test_ruuvi_interface_lis2dh12_fifo_drift_overrun (void)
+{
+    static rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE];
+    sensor_clock_t clock;
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (0U);
+    sensor_clock_init (&clock, 10000000U);
+
+    for (size_t ii = 0; ii < 200U; ii++)
+    {
+        sensor_clock_drain (&clock, 3U, data);
+    }
+
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    m_overrun = 1U;
+    sensor_clock_drain (&clock, 3U, data);
+    TEST_ASSERT_EQUAL (0U, dev.fifo_base_samples);
+    TEST_ASSERT_EQUAL (clock.now_ns / 1000000U, dev.fifo_base_ms);
+    // Previous estimate is kept.
+    TEST_ASSERT (RD_SUCCESS == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+    m_overrun = 0U;
+    sensor_clock_drain (&clock, 3U, data);
+    TEST_ASSERT_EQUAL (RI_LIS2DH12_FIFO_SIZE, dev.fifo_base_samples);
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_drift_outlier (void)
+{
+    rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE] = {0};
+    int32_t drift_ppm = 0;
+    fifo_timing_setup (9U);
+    fifo_drain (1000U, RI_LIS2DH12_FIFO_SIZE, data);
+    fifo_drain (1101U, RI_LIS2DH12_FIFO_SIZE, data);
+    TEST_ASSERT_EQUAL (10U, dev.fifo_base_samples);
+    // 10 samples in 200 ms cannot be drift.
+    fifo_drain (1301U, RI_LIS2DH12_FIFO_SIZE, data);
+    TEST_ASSERT_EQUAL (0U, dev.fifo_base_samples);
+    TEST_ASSERT_EQUAL (1301U, dev.fifo_base_ms);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_lis2dh12_fifo_drift_get (&drift_ppm));
+}
+
+void test_ruuvi_interface_lis2dh12_fifo_drift_partial_read (void)
+{
+    rd_sensor_data_t data[RI_LIS2DH12_FIFO_SIZE] = {0};
+    fifo_timing_setup (9U);
+    fifo_drain (1000U, RI_LIS2DH12_FIFO_SIZE, data);
+    fifo_drain (1101U, RI_LIS2DH12_FIFO_SIZE, data);
+    // Samples are left on FIFO, next read does not cover time since this read.
+    fifo_drain (1202U, 4U, data);
+    TEST_ASSERT (RD_UINT64_INVALID == dev.fifo_drain_ms);
+    TEST_ASSERT_EQUAL (0U, dev.fifo_base_samples);
+    fifo_drain (1303U, RI_LIS2DH12_FIFO_SIZE, data);
+    TEST_ASSERT_EQUAL (0U, dev.fifo_base_samples);
+    TEST_ASSERT_EQUAL (1303U, dev.fifo_base_ms);
+}
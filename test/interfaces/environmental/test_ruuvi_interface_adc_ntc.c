@@ -0,0 +1,144 @@
+#ifdef TEST
+
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_interface_adc_ntc.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_adc_mcu.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define RATIO_STEPS       (1UL << 16U) //!< Ratios compared over 0 ... 1.
+#define BENCHMARK_SAMPLES (1000000U)   //!< Samples converted in benchmark.
+#define K_TO_C            (273.15)
+#define RANGE_MIN_C       (-40.0)      //!< Range of temperature error spec.
+#define RANGE_MAX_C       (125.0)
+#define RANGE_ERROR_MAX_C (0.005)
+
+void setUp (void)
+{
+}
+
+void tearDown (void)
+{
+}
+
+/** @brief Exact beta equation, as in the driver before lookup table. */
+static double reference_temperature (const float ratio)
+{
+    const double rt = ( (double) RI_ADC_NTC_BALANCE * ratio) / (1.0 - ratio);
+    const double t0 = (double) RI_ADC_NTC_DEFAULT_TEMP + K_TO_C;
+    return (1.0 / ( (1.0 / t0) + ( (1.0 / RI_ADC_NTC_DEFAULT_BETA)
+                                   * log (rt / RI_ADC_NTC_DEFAULT_RES)))) - K_TO_C;
+}
+
+/**
+ * Inverse temperature is linear in logarithm, so error of 1/T is bounded
+ * everywhere, even where beta equation has no physical meaning.
+ */
+void test_ri_adc_ntc_ratio_to_temperature_full_range (void)
+{
+    const double inverse_error_max = (double) RI_ADC_NTC_LN_ERROR_MAX
+                                     / RI_ADC_NTC_DEFAULT_BETA;
+
+    for (uint32_t ii = 1; ii < RATIO_STEPS; ii++)
+    {
+        const float ratio = (float) ii / (float) RATIO_STEPS;
+        const double expected = 1.0 / (reference_temperature (ratio) + K_TO_C);
+        const double actual = 1.0 / ( (double) ri_adc_ntc_ratio_to_temperature (ratio) + K_TO_C);
+
+        if (fabs (actual - expected) > inverse_error_max)
+        {
+            char msg[96];
+            snprintf (msg, sizeof (msg), "ratio %f: 1/T %e, expected %e", ratio, actual,
+                      expected);
+            TEST_FAIL_MESSAGE (msg);
+        }
+    }
+}
+
+void test_ri_adc_ntc_ratio_to_temperature_spec_range (void)
+{
+    double error_max = 0.0;
+    uint32_t compared = 0;
+
+    for (uint32_t ii = 1; ii < RATIO_STEPS; ii++)
+    {
+        const float ratio = (float) ii / (float) RATIO_STEPS;
+        const double expected = reference_temperature (ratio);
+
+        if ( (expected >= RANGE_MIN_C) && (expected <= RANGE_MAX_C))
+        {
+            const double error = fabs (ri_adc_ntc_ratio_to_temperature (ratio) - expected);
+            error_max = (error > error_max) ? error : error_max;
+            compared++;
+        }
+    }
+
+    char msg[96];
+    snprintf (msg, sizeof (msg), "%u ratios at -40 ... +125 C, max error %.5f C",
+              (unsigned) compared, error_max);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT (compared > 0U);
+    TEST_ASSERT (error_max <= RANGE_ERROR_MAX_C);
+}
+
+void test_ri_adc_ntc_ratio_to_temperature_calibration_point (void)
+{
+    const float ratio = RI_ADC_NTC_DEFAULT_RES / (RI_ADC_NTC_DEFAULT_RES + RI_ADC_NTC_BALANCE);
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, RI_ADC_NTC_DEFAULT_TEMP,
+                              ri_adc_ntc_ratio_to_temperature (ratio));
+}
+
+void test_ri_adc_ntc_ratio_to_temperature_endpoints (void)
+{
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, (float) reference_temperature (0.0F),
+                              ri_adc_ntc_ratio_to_temperature (0.0F));
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, (float) reference_temperature (1.0F),
+                              ri_adc_ntc_ratio_to_temperature (1.0F));
+}
+
+void test_ri_adc_ntc_ratio_to_temperature_invalid (void)
+{
+    TEST_ASSERT (isnan (ri_adc_ntc_ratio_to_temperature (-0.01F)));
+    TEST_ASSERT (isnan (ri_adc_ntc_ratio_to_temperature (1.01F)));
+    TEST_ASSERT (isnan (ri_adc_ntc_ratio_to_temperature (NAN)));
+}
+
+void test_ri_adc_ntc_ratio_to_temperature_benchmark (void)
+{
+    volatile float sink_ref = 0;
+    volatile float sink_new = 0;
+    const clock_t ref_start = clock();
+
+    for (uint32_t ii = 0; ii < BENCHMARK_SAMPLES; ii++)
+    {
+        const float ratio = (float) ( (ii % (RATIO_STEPS - 1U)) + 1U) / (float) RATIO_STEPS;
+        sink_ref += (float) reference_temperature (ratio);
+    }
+
+    const clock_t ref_ticks = clock() - ref_start;
+    const clock_t new_start = clock();
+
+    for (uint32_t ii = 0; ii < BENCHMARK_SAMPLES; ii++)
+    {
+        const float ratio = (float) ( (ii % (RATIO_STEPS - 1U)) + 1U) / (float) RATIO_STEPS;
+        sink_new += ri_adc_ntc_ratio_to_temperature (ratio);
+    }
+
+    const clock_t new_ticks = clock() - new_start;
+    char msg[128];
+    snprintf (msg, sizeof (msg),
+              "%u samples: libm log %.1f ms, lookup table %.1f ms",
+              BENCHMARK_SAMPLES,
+              (1000.0 * ref_ticks) / CLOCKS_PER_SEC,
+              (1000.0 * new_ticks) / CLOCKS_PER_SEC);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT_FLOAT_WITHIN (BENCHMARK_SAMPLES * 0.01F, sink_ref, sink_new);
+}
+
+#endif
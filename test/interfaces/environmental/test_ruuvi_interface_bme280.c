@@ -238,13 +238,18 @@ void test_ri_bme280_init_invalid_bus (void)
     rd_sensor_initialize_Expect (p_environmental_sensor);
     err_code = ri_bme280_init (p_environmental_sensor, bus, handle);
     TEST_ASSERT (RD_ERROR_INVALID_PARAM == err_code);
+    // Instance of failed init is released by uninit.
+    rd_sensor_uninitialize_Expect (p_environmental_sensor);
+    bme280_soft_reset_ExpectAnyArgsAndReturn (BME280_E_COMM_FAIL);
+    err_code = ri_bme280_uninit (p_environmental_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS != err_code);
 }
 
 
 void test_ri_bme280_init_spi_ok (void)
 {
     rd_status_t err_code = RD_SUCCESS;
-    struct rd_sensor_t n_environmental_sensor;
+    struct rd_sensor_t n_environmental_sensor = {0};
     rd_bus_t bus = RD_BUS_SPI;
     uint8_t handle = 1;
     uint8_t bme_mode = BME280_SLEEP_MODE;
@@ -258,12 +263,16 @@ void test_ri_bme280_init_spi_ok (void)
     err_code = ri_bme280_init (&n_environmental_sensor, bus, handle);
     TEST_ASSERT (1 == n_environmental_sensor.provides.datas.pressure_pa);
     TEST_ASSERT (RD_SUCCESS == err_code);
+    // Release instance for other tests.
+    rd_sensor_uninitialize_Expect (&n_environmental_sensor);
+    err_code = ri_bme280_uninit (&n_environmental_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS == err_code);
 }
 
 void test_ri_bme280_init_i2c_ok (void)
 {
     rd_status_t err_code = RD_SUCCESS;
-    struct rd_sensor_t n_environmental_sensor;
+    struct rd_sensor_t n_environmental_sensor = {0};
     rd_bus_t bus = RD_BUS_I2C;
     uint8_t handle = 1;
     uint8_t bme_mode = BME280_SLEEP_MODE;
@@ -277,6 +286,10 @@ void test_ri_bme280_init_i2c_ok (void)
     err_code = ri_bme280_init (&n_environmental_sensor, bus, handle);
     TEST_ASSERT (1 == n_environmental_sensor.provides.datas.pressure_pa);
     TEST_ASSERT (RD_SUCCESS == err_code);
+    // Release instance for other tests.
+    rd_sensor_uninitialize_Expect (&n_environmental_sensor);
+    err_code = ri_bme280_uninit (&n_environmental_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS == err_code);
 }
 
 
@@ -293,14 +306,35 @@ void test_ri_bme280_uninit_sensor_null (void)
 void test_ri_bme280_uninit_ok (void)
 {
     rd_status_t err_code = RD_SUCCESS;
-    struct rd_sensor_t * p_environmental_sensor = &environmental_sensor;
+    struct rd_sensor_t n_environmental_sensor = {0};
     rd_bus_t bus = RD_BUS_SPI;
     uint8_t handle = 1;
-    struct bme280_dev expect_dev;
-    memset (&expect_dev, 0, sizeof (expect_dev));
-    bme280_soft_reset_ExpectWithArrayAndReturn (&expect_dev, 1, BME280_OK);
-    rd_sensor_uninitialize_Expect (p_environmental_sensor);
-    err_code = ri_bme280_uninit (p_environmental_sensor, bus, handle);
+    uint8_t bme_mode = BME280_SLEEP_MODE;
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    rd_sensor_initialize_Expect (&n_environmental_sensor);
+    bme280_init_IgnoreAndReturn (RD_SUCCESS);
+    bme280_soft_reset_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    bme280_set_sensor_settings_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    err_code = ri_bme280_init (&n_environmental_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    rd_sensor_uninitialize_Expect (&n_environmental_sensor);
+    bme280_soft_reset_ExpectAnyArgsAndReturn (BME280_OK);
+    err_code = ri_bme280_uninit (&n_environmental_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (NULL == n_environmental_sensor.p_ctx);
+}
+
+void test_ri_bme280_uninit_not_initialized (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    struct rd_sensor_t n_environmental_sensor = {0};
+    rd_bus_t bus = RD_BUS_SPI;
+    uint8_t handle = 1;
+    // No soft reset on device of a free instance.
+    rd_sensor_uninitialize_Expect (&n_environmental_sensor);
+    err_code = ri_bme280_uninit (&n_environmental_sensor, bus, handle);
     TEST_ASSERT (RD_SUCCESS == err_code);
 }
 
@@ -1014,6 +1048,302 @@ void test_ri_bme280_data_get_null (void)
     TEST_ASSERT (RD_ERROR_NULL == err_code);
 }
 
+static void measurement_start_Expect (void)
+{
+    static uint8_t bme_mode = BME280_SLEEP_MODE;
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    bme280_set_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+}
+
+static void measurement_start_ok (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    dev.settings.osr_h = BME280_OVERSAMPLING_1X;
+    measurement_start_Expect();
+    err_code = ri_bme280_measurement_start (&ready);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (1000U + bme280_max_meas_time (1U) == ready);
+}
+
+static void measurement_cancel (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_SLEEP;
+    bme280_set_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == ri_bme280_mode_set (&mode));
+}
+
+void test_ri_bme280_measurement_start_ok (void)
+{
+    measurement_start_ok();
+    measurement_cancel();
+}
+
+void test_ri_bme280_measurement_start_twice (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    measurement_start_ok();
+    err_code = ri_bme280_measurement_start (&ready);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+    // Sleep cancels measurement.
+    measurement_cancel();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_bme280_measurement_complete());
+}
+
+void test_ri_bme280_measurement_start_continuous (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    uint8_t bme_mode = BME280_NORMAL_MODE;
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    err_code = ri_bme280_measurement_start (&ready);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_bme280_measurement_start_no_timestamp (void)
+{
+    uint64_t ready = 0;
+    uint8_t bme_mode = BME280_SLEEP_MODE;
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    rd_sensor_timestamp_get_ExpectAndReturn (RD_UINT64_INVALID);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_bme280_measurement_start (&ready));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_bme280_measurement_complete());
+}
+
+void test_ri_bme280_measurement_start_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == ri_bme280_measurement_start (NULL));
+}
+
+void test_ri_bme280_measurement_complete_not_started (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_bme280_measurement_complete());
+}
+
+void test_ri_bme280_measurement_complete_ok (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t bme_mode = BME280_FORCED_MODE;
+    const uint64_t ready = 1000U + bme280_max_meas_time (1U);
+    measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (ready - 1U);
+    err_code = ri_bme280_measurement_complete();
+    TEST_ASSERT (RD_ERROR_BUSY == err_code);
+    // Sensor still converting.
+    rd_sensor_timestamp_get_ExpectAndReturn (ready);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    err_code = ri_bme280_measurement_complete();
+    TEST_ASSERT (RD_ERROR_BUSY == err_code);
+    bme_mode = BME280_SLEEP_MODE;
+    rd_sensor_timestamp_get_ExpectAndReturn (ready + 1U);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    err_code = ri_bme280_measurement_complete();
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_bme280_measurement_complete());
+}
+
+void test_ri_bme280_measurement_data_get_busy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_data_t data = {0};
+    measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1001U);
+    err_code = ri_bme280_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (0U == data.valid.bitfield);
+    measurement_cancel();
+}
+
+void test_ri_bme280_cost_get_single (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 1U,
+        .dsp_function = RD_SENSOR_DSP_LAST,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    rd_sensor_cost_average_na_ExpectAndReturn (NULL, 1000000U, 3780U);
+    rd_sensor_cost_average_na_IgnoreArg_p_cost();
+    rd_status_t err_code = ri_bme280_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // Appendix B maximum: 1.25 + 2.3 + 2 * (2.3 + 0.575) ms.
+    TEST_ASSERT_EQUAL_UINT32 (9300U, cost.conversion_us);
+    // Datasheet: 3.6 uA at 1 Hz forced mode.
+    TEST_ASSERT_EQUAL_UINT32 (3685U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (100U, cost.sleep_na);
+    TEST_ASSERT_EQUAL_UINT32 (3780U, cost.average_na);
+}
+
+void test_ri_bme280_cost_get_continuous_os (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 8U,
+        .dsp_function = RD_SENSOR_DSP_OS,
+        .dsp_parameter = 16U,
+        .mode = RD_SENSOR_CFG_CONTINUOUS
+    };
+    rd_sensor_cost_t cost = {0};
+    const uint32_t conversion_us = 1250U + 3U * 16U * 2300U + 2U * 575U;
+    rd_sensor_cost_average_na_ExpectAndReturn (NULL, 125000U + conversion_us, 1U);
+    rd_sensor_cost_average_na_IgnoreArg_p_cost();
+    rd_status_t err_code = ri_bme280_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_UINT32 (conversion_us, cost.conversion_us);
+}
+
+void test_ri_bme280_cost_get_not_supported (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .dsp_function = RD_SENSOR_DSP_HIGH_PASS,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_bme280_cost_get (&config, &cost));
+    config.dsp_function = RD_SENSOR_DSP_LAST;
+    config.samplerate = RD_SENSOR_CFG_CUSTOM_1;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_bme280_cost_get (&config, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_bme280_cost_get (NULL, &cost));
+}
+
+static rd_sensor_t bme_1;
+static rd_sensor_t bme_2;
+
+static void instance_init (rd_sensor_t * const p_sensor, const rd_bus_t bus,
+                           const uint8_t handle)
+{
+    uint8_t bme_mode = BME280_SLEEP_MODE;
+    memset (p_sensor, 0, sizeof (rd_sensor_t));
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    rd_sensor_initialize_Expect (p_sensor);
+    bme280_init_IgnoreAndReturn (BME280_OK);
+    bme280_soft_reset_IgnoreAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    bme280_set_sensor_settings_ExpectAnyArgsAndReturn (BME280_OK);
+    rd_status_t err_code = ri_bme280_init (p_sensor, bus, handle);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+static void instance_uninit (rd_sensor_t * const p_sensor)
+{
+    rd_sensor_uninitialize_Expect (p_sensor);
+    bme280_soft_reset_IgnoreAndReturn (BME280_OK);
+    rd_status_t err_code = ri_bme280_uninit (p_sensor, RD_BUS_NONE, 0U);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_bme280_init_second_instance (void)
+{
+    instance_init (&bme_1, RD_BUS_SPI, 1U);
+    instance_init (&bme_2, RD_BUS_I2C, 0x77U);
+    TEST_ASSERT (&ri_bme280_samplerate_set == bme_1.samplerate_set);
+    TEST_ASSERT (&ri_bme280_data_get == bme_1.data_get);
+    TEST_ASSERT (&ri_bme280_measurement_start == bme_1.measurement_start);
+    TEST_ASSERT (&ri_bme280_cost_get == bme_2.cost_get);
+    TEST_ASSERT (NULL != bme_2.measurement_complete);
+    TEST_ASSERT (&ri_bme280_measurement_complete != bme_2.measurement_complete);
+    TEST_ASSERT (&ri_bme280_init == bme_2.init);
+    TEST_ASSERT (&ri_bme280_uninit == bme_2.uninit);
+    TEST_ASSERT (NULL != bme_2.samplerate_set);
+    TEST_ASSERT (&ri_bme280_samplerate_set != bme_2.samplerate_set);
+    TEST_ASSERT (&ri_bme280_data_get != bme_2.data_get);
+    TEST_ASSERT (&ri_bme280_resolution_get == bme_2.resolution_get);
+    TEST_ASSERT (&ri_bme280_scale_get == bme_2.scale_get);
+    TEST_ASSERT (1U == dev.dev_id);
+    TEST_ASSERT (BME280_SPI_INTF == dev.intf);
+    instance_uninit (&bme_2);
+    instance_uninit (&bme_1);
+}
+
+void test_ri_bme280_instances_independent (void)
+{
+    uint8_t bme_mode = BME280_SLEEP_MODE;
+    uint8_t dsp = RD_SENSOR_DSP_OS;
+    uint8_t parameter = 4U;
+    instance_init (&bme_1, RD_BUS_SPI, 1U);
+    instance_init (&bme_2, RD_BUS_I2C, 0x77U);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    bme280_set_sensor_settings_ExpectAnyArgsAndReturn (BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == bme_2.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (4U == parameter);
+    // First instance keeps its settings.
+    TEST_ASSERT (BME280_OVERSAMPLING_1X == dev.settings.osr_h);
+    bme280_get_sensor_settings_ExpectAnyArgsAndReturn (BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == bme_2.dsp_get (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_OS == dsp);
+    TEST_ASSERT (4U == parameter);
+    bme280_get_sensor_settings_ExpectAnyArgsAndReturn (BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == bme_1.dsp_get (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_CFG_DEFAULT == dsp);
+    instance_uninit (&bme_2);
+    instance_uninit (&bme_1);
+}
+
+void test_ri_bme280_uninit_reset_fails (void)
+{
+    rd_sensor_t bme_3 = {0};
+    instance_init (&bme_1, RD_BUS_SPI, 1U);
+    instance_init (&bme_2, RD_BUS_I2C, 0x77U);
+    rd_sensor_uninitialize_Expect (&bme_1);
+    bme280_soft_reset_IgnoreAndReturn (BME280_E_COMM_FAIL);
+    TEST_ASSERT (RD_SUCCESS != ri_bme280_uninit (&bme_1, RD_BUS_NONE, 0U));
+    // Instance is released regardless of reset.
+    instance_init (&bme_3, RD_BUS_SPI, 1U);
+    TEST_ASSERT (&ri_bme280_samplerate_set == bme_3.samplerate_set);
+    instance_uninit (&bme_3);
+    instance_uninit (&bme_2);
+}
+
+void test_ri_bme280_init_caller_context (void)
+{
+    struct bme280_dev ctx = {0};
+    uint8_t bme_mode = BME280_SLEEP_MODE;
+    memset (&bme_1, 0, sizeof (bme_1));
+    bme_1.p_ctx = &ctx;
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    rd_sensor_initialize_Expect (&bme_1);
+    bme280_init_IgnoreAndReturn (BME280_OK);
+    bme280_soft_reset_ExpectAndReturn (&ctx, BME280_OK);
+    bme280_get_sensor_mode_ExpectAnyArgsAndReturn (BME280_OK);
+    bme280_get_sensor_mode_ReturnThruPtr_sensor_mode (&bme_mode);
+    bme280_set_sensor_settings_ExpectAnyArgsAndReturn (BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == ri_bme280_init (&bme_1, RD_BUS_I2C, 0x77U));
+    TEST_ASSERT (0x77U == ctx.dev_id);
+    TEST_ASSERT (0U == dev.dev_id);
+    rd_sensor_uninitialize_Expect (&bme_1);
+    bme280_soft_reset_ExpectAndReturn (&ctx, BME280_OK);
+    TEST_ASSERT (RD_SUCCESS == ri_bme280_uninit (&bme_1, RD_BUS_NONE, 0U));
+    // Context of application stays with sensor.
+    TEST_ASSERT (&ctx == bme_1.p_ctx);
+}
+
+void test_ri_bme280_init_no_free_instance (void)
+{
+    rd_sensor_t bme_3 = {0};
+    instance_init (&bme_1, RD_BUS_SPI, 1U);
+    instance_init (&bme_2, RD_BUS_I2C, 0x77U);
+    rd_sensor_is_init_ExpectAnyArgsAndReturn (false);
+    rd_status_t err_code = ri_bme280_init (&bme_3, RD_BUS_I2C, 0x76U);
+    TEST_ASSERT (RD_ERROR_RESOURCES == err_code);
+    instance_uninit (&bme_2);
+    instance_uninit (&bme_1);
+    // Released instance can be used again.
+    instance_init (&bme_2, RD_BUS_I2C, 0x77U);
+    TEST_ASSERT (&ri_bme280_samplerate_set == bme_2.samplerate_set);
+    instance_uninit (&bme_2);
+}
+
 /** @brief @ref rd_sensor_setup_fp */
 rd_status_t ri_bme280_resolution_set (uint8_t * resolution);
 /** @brief @ref rd_sensor_setup_fp */
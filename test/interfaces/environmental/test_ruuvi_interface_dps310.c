@@ -13,6 +13,9 @@
 #define SIM_TIME_MS (1000U)
 #define SIM_TEMPERATURE_C (25.5F)
 #define SIM_PRESSURE_PA (100032.4F)
+#define SIM_DPS310_ERROR (1U)
+#define SIM_MEAS_CFG_REG (0x08U)
+#define SIM_MEAS_CFG_RDY (0x30U) //!< TMP_RDY and PRS_RDY.
 
 static void dummy_sleep (const uint32_t ms)
 {
@@ -64,6 +67,9 @@ void test_ri_dps310_init_ok (void)
     TEST_ASSERT (&ri_dps310_dsp_set == dps_ctx.dsp_set);
     TEST_ASSERT (&ri_dps310_dsp_get == dps_ctx.dsp_get);
     TEST_ASSERT (&ri_dps310_data_get == dps_ctx.data_get);
+    TEST_ASSERT (&ri_dps310_measurement_start == dps_ctx.measurement_start);
+    TEST_ASSERT (&ri_dps310_measurement_complete == dps_ctx.measurement_complete);
+    TEST_ASSERT (&ri_dps310_cost_get == dps_ctx.cost_get);
     TEST_ASSERT (expected.bitfield == dps_ctx.provides.bitfield);
 }
 
@@ -840,3 +846,405 @@ void test_ri_dps310_data_get_continuous (void)
     rd_status_t err_code = ri_dps310_data_get (&data);
     TEST_ASSERT (RD_SUCCESS == err_code);
 }
+
+static void measurement_start (void)
+{
+    uint64_t ready_ms = 0;
+    // Run singleton test to initialize sensor context.
+    test_ri_dps310_init_singleton();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    p_ctx->device_status = DPS310_READY;
+    p_ctx->temp_osr = DPS310_OS_8;
+    p_ctx->pres_osr = DPS310_OS_8;
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS);
+    dps310_measure_continuous_async_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    rd_status_t err_code = ri_dps310_measurement_start (&ready_ms);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // 2 x 14.8 ms rounded up.
+    TEST_ASSERT (SIM_TIME_MS + 30U == ready_ms);
+    // Simulate background mode started by driver.
+    p_ctx->device_status = DPS310_CONTINUOUS;
+}
+
+static void meas_cfg_expect (const uint8_t meas_cfg, const uint32_t err_code)
+{
+    static uint8_t reg;
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    reg = meas_cfg;
+    ri_spi_dps310_read_ExpectAndReturn (p_ctx->comm_ctx, SIM_MEAS_CFG_REG, NULL, 1U,
+                                        err_code);
+    ri_spi_dps310_read_IgnoreArg_p_reg_data();
+    ri_spi_dps310_read_ReturnThruPtr_p_reg_data (&reg);
+}
+
+static void measurement_result_expect (void)
+{
+    static float temperature_c = SIM_TEMPERATURE_C;
+    static float pressure_pa   = SIM_PRESSURE_PA;
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    meas_cfg_expect (SIM_MEAS_CFG_RDY, RD_SUCCESS);
+    dps310_get_last_result_ExpectAnyArgsAndReturn (DPS310_SUCCESS);
+    dps310_get_last_result_ReturnThruPtr_temp (&temperature_c);
+    dps310_get_last_result_ReturnThruPtr_pres (&pressure_pa);
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    rd_sensor_data_set_Expect (NULL, RD_SENSOR_PRES_FIELD, SIM_PRESSURE_PA);
+    rd_sensor_data_set_IgnoreArg_target();
+    rd_sensor_data_set_Expect (NULL, RD_SENSOR_TEMP_FIELD, SIM_TEMPERATURE_C);
+    rd_sensor_data_set_IgnoreArg_target();
+}
+
+void test_ri_dps310_measurement_start_null (void)
+{
+    test_ri_dps310_init_singleton();
+    TEST_ASSERT (RD_ERROR_NULL == ri_dps310_measurement_start (NULL));
+}
+
+void test_ri_dps310_measurement_start_invalid_state (void)
+{
+    uint64_t ready_ms = 0;
+    test_ri_dps310_init_singleton();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    p_ctx->device_status = DPS310_CONTINUOUS;
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_start (&ready_ms));
+}
+
+void test_ri_dps310_measurement_start_no_timestamp (void)
+{
+    uint64_t ready_ms = 0;
+    test_ri_dps310_init_singleton();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    p_ctx->device_status = DPS310_READY;
+    rd_sensor_timestamp_get_ExpectAndReturn (RD_UINT64_INVALID);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_start (&ready_ms));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_start_twice (void)
+{
+    uint64_t ready_ms = 0;
+    measurement_start();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    p_ctx->device_status = DPS310_READY;
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_start (&ready_ms));
+}
+
+void test_ri_dps310_measurement_start_error (void)
+{
+    uint64_t ready_ms = 0;
+    test_ri_dps310_init_singleton();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    p_ctx->device_status = DPS310_READY;
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS);
+    dps310_measure_continuous_async_ExpectAndReturn (p_ctx, SIM_DPS310_ERROR);
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    TEST_ASSERT (RD_ERROR_INTERNAL == ri_dps310_measurement_start (&ready_ms));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_mode_is_sleep (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_CONTINUOUS;
+    measurement_start();
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_mode_get (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+}
+
+void test_ri_dps310_measurement_complete_not_started (void)
+{
+    test_ri_dps310_init_singleton();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_complete_busy (void)
+{
+    measurement_start();
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 29U);
+    TEST_ASSERT (RD_ERROR_BUSY == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_complete_ok (void)
+{
+    measurement_start();
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 30U);
+    measurement_result_expect();
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_measurement_complete());
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_complete_error (void)
+{
+    dps310_ctx_t * p_ctx;
+    measurement_start();
+    p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 30U);
+    meas_cfg_expect (SIM_MEAS_CFG_RDY, RD_SUCCESS);
+    dps310_get_last_result_ExpectAnyArgsAndReturn (SIM_DPS310_ERROR);
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    TEST_ASSERT (RD_ERROR_INTERNAL == ri_dps310_measurement_complete());
+}
+
+/** Nominal conversion time has passed but sensor has not set both ready flags. */
+void test_ri_dps310_measurement_complete_not_ready (void)
+{
+    measurement_start();
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 30U);
+    meas_cfg_expect (0x20U, RD_SUCCESS);
+    TEST_ASSERT (RD_ERROR_BUSY == ri_dps310_measurement_complete());
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 40U);
+    measurement_result_expect();
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_complete_timeout (void)
+{
+    measurement_start();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 59U);
+    meas_cfg_expect (0U, RD_SUCCESS);
+    TEST_ASSERT (RD_ERROR_BUSY == ri_dps310_measurement_complete());
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 60U);
+    meas_cfg_expect (0U, RD_SUCCESS);
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    TEST_ASSERT (RD_ERROR_TIMEOUT == ri_dps310_measurement_complete());
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_measurement_complete_read_error (void)
+{
+    measurement_start();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 30U);
+    meas_cfg_expect (SIM_MEAS_CFG_RDY, RD_ERROR_INTERNAL);
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    TEST_ASSERT (RD_ERROR_INTERNAL == ri_dps310_measurement_complete());
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+void test_ri_dps310_uninit_cancels_measurement (void)
+{
+    measurement_start();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    dps310_uninit_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    rd_sensor_uninitialize_Expect (&dps_ctx);
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_uninit (&dps_ctx, RD_BUS_SPI, 1U));
+}
+
+void test_ri_dps310_cost_get_continuous_default (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = RD_SENSOR_CFG_DEFAULT,
+        .dsp_function = RD_SENSOR_DSP_OS,
+        .dsp_parameter = RD_SENSOR_CFG_DEFAULT,
+        .mode = RD_SENSOR_CFG_CONTINUOUS
+    };
+    rd_sensor_cost_t cost = {0};
+    // Default 1 Hz, OS 8 on both temperature and pressure.
+    const rd_sensor_cost_t expected =
+    {
+        .conversion_us = 29600U,
+        .charge_nc = 10212U,
+        .sleep_na = DPS310_STANDBY_NA
+    };
+    rd_sensor_cost_average_na_ExpectWithArrayAndReturn (&expected, 1, 1000000U, 10712U);
+    rd_status_t err_code = ri_dps310_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_UINT32 (29600U, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (10212U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (10712U, cost.average_na);
+}
+
+void test_ri_dps310_cost_get_single_rounds_rate_up (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 3U,
+        .dsp_function = RD_SENSOR_DSP_LAST,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    rd_sensor_cost_average_na_ExpectAndReturn (NULL, 250000U, 10436U);
+    rd_sensor_cost_average_na_IgnoreArg_p_cost();
+    rd_status_t err_code = ri_dps310_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_UINT32 (7200U, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (2484U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (10436U, cost.average_na);
+}
+
+void test_ri_dps310_cost_get_sleep (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .mode = RD_SENSOR_CFG_SLEEP
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (DPS310_STANDBY_NA, cost.average_na);
+}
+
+void test_ri_dps310_cost_get_not_supported (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 200U,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_dps310_cost_get (&config, &cost));
+    config.samplerate = 1U;
+    config.dsp_function = RD_SENSOR_DSP_HIGH_PASS;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_dps310_cost_get (&config, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_dps310_cost_get (NULL, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_dps310_cost_get (&config, NULL));
+}
+
+void test_ri_dps310_data_get_measurement_busy (void)
+{
+    const rd_sensor_data_fields_t fields =
+    {
+        .datas.temperature_c = 1,
+        .datas.pressure_pa = 1
+    };
+    float values[2];
+    rd_sensor_data_t data =
+    {
+        .fields = fields,
+        .data = values
+    };
+    measurement_start();
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 1U);
+    rd_status_t err_code = ri_dps310_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (0 == data.valid.bitfield);
+}
+
+void test_ri_dps310_data_get_measurement_ready (void)
+{
+    const rd_sensor_data_fields_t fields =
+    {
+        .datas.temperature_c = 1,
+        .datas.pressure_pa = 1
+    };
+    float values[2];
+    rd_sensor_data_t data =
+    {
+        .fields = fields,
+        .data = values
+    };
+    measurement_start();
+    rd_sensor_timestamp_get_ExpectAndReturn (SIM_TIME_MS + 100U);
+    measurement_result_expect();
+    rd_sensor_data_populate_ExpectAnyArgs();
+    rd_status_t err_code = ri_dps310_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_dps310_mode_set_sleep_cancels_measurement (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_SLEEP;
+    measurement_start();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    dps310_standby_ExpectAndReturn (p_ctx, DPS310_SUCCESS);
+    // Simulate standby done by driver.
+    p_ctx->device_status = DPS310_READY;
+    TEST_ASSERT (RD_SUCCESS == ri_dps310_mode_set (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_dps310_measurement_complete());
+}
+
+static rd_sensor_t dps_ctx_2;
+
+static void second_init (void)
+{
+    memset (&dps_ctx_2, 0, sizeof (dps_ctx_2));
+    rd_sensor_is_init_ExpectAndReturn (&dps_ctx_2, false);
+    rd_sensor_initialize_Expect (&dps_ctx_2);
+    dps310_init_ExpectAndReturn (NULL, DPS310_SUCCESS);
+    dps310_init_IgnoreArg_ctx();
+    rd_status_t err_code = ri_dps310_init (&dps_ctx_2, RD_BUS_SPI, 2U);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+static void second_uninit (void)
+{
+    dps310_uninit_ExpectAndReturn (dps_ctx_2.p_ctx, DPS310_SUCCESS);
+    rd_sensor_uninitialize_Expect (&dps_ctx_2);
+    rd_status_t err_code = ri_dps310_uninit (&dps_ctx_2, RD_BUS_SPI, 2U);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (NULL == dps_ctx_2.p_ctx);
+}
+
+void test_ri_dps310_init_second_instance (void)
+{
+    test_ri_dps310_init_singleton();
+    second_init();
+    TEST_ASSERT (NULL != dps_ctx_2.p_ctx);
+    TEST_ASSERT (dps_ctx.p_ctx != dps_ctx_2.p_ctx);
+    dps310_ctx_t * p_dps_ctx = (dps310_ctx_t *) dps_ctx_2.p_ctx;
+    uint8_t * comm_ctx = (uint8_t *) p_dps_ctx->comm_ctx;
+    TEST_ASSERT (2U == *comm_ctx);
+    comm_ctx = (uint8_t *) ( (dps310_ctx_t *) dps_ctx.p_ctx)->comm_ctx;
+    TEST_ASSERT (1U == *comm_ctx);
+    TEST_ASSERT (&ri_dps310_init == dps_ctx_2.init);
+    TEST_ASSERT (&ri_dps310_uninit == dps_ctx_2.uninit);
+    TEST_ASSERT (NULL != dps_ctx_2.samplerate_set);
+    TEST_ASSERT (&ri_dps310_samplerate_set != dps_ctx_2.samplerate_set);
+    TEST_ASSERT (&ri_dps310_data_get != dps_ctx_2.data_get);
+    TEST_ASSERT (&ri_dps310_resolution_get == dps_ctx_2.resolution_get);
+    TEST_ASSERT (&ri_dps310_scale_get == dps_ctx_2.scale_get);
+    second_uninit();
+}
+
+void test_ri_dps310_instances_independent (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_CONTINUOUS;
+    test_ri_dps310_init_singleton();
+    second_init();
+    dps310_ctx_t * const p_ctx = (dps310_ctx_t *) dps_ctx.p_ctx;
+    dps310_ctx_t * const p_ctx_2 = (dps310_ctx_t *) dps_ctx_2.p_ctx;
+    p_ctx->device_status = DPS310_READY;
+    p_ctx_2->device_status = DPS310_READY;
+    dps310_measure_continuous_async_ExpectAndReturn (p_ctx_2, DPS310_SUCCESS);
+    TEST_ASSERT (RD_SUCCESS == dps_ctx_2.mode_set (&mode));
+    // Simulate background mode started by driver.
+    p_ctx_2->device_status = DPS310_CONTINUOUS;
+    mode = RD_SENSOR_CFG_SLEEP;
+    TEST_ASSERT (RD_SUCCESS == dps_ctx_2.mode_get (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_CONTINUOUS == mode);
+    TEST_ASSERT (RD_SUCCESS == dps_ctx.mode_get (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+    second_uninit();
+}
+
+void test_ri_dps310_init_no_free_instance (void)
+{
+    rd_sensor_t dps_ctx_3 = {0};
+    test_ri_dps310_init_singleton();
+    second_init();
+    rd_sensor_is_init_ExpectAndReturn (&dps_ctx_3, false);
+    rd_status_t err_code = ri_dps310_init (&dps_ctx_3, RD_BUS_SPI, 3U);
+    TEST_ASSERT (RD_ERROR_RESOURCES == err_code);
+    TEST_ASSERT (NULL == dps_ctx_3.p_ctx);
+    second_uninit();
+}
+
+void test_ri_dps310_init_second_application_context (void)
+{
+    dps310_ctx_t init_ctx_2 = init_ctx;
+    test_ri_dps310_init_singleton();
+    memset (&dps_ctx_2, 0, sizeof (dps_ctx_2));
+    dps_ctx_2.p_ctx = &init_ctx_2;
+    rd_sensor_is_init_ExpectAndReturn (&dps_ctx_2, false);
+    rd_sensor_initialize_Expect (&dps_ctx_2);
+    dps310_init_ExpectAndReturn (&init_ctx_2, DPS310_SUCCESS);
+    rd_status_t err_code = ri_dps310_init (&dps_ctx_2, RD_BUS_SPI, 2U);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (&init_ctx_2 == dps_ctx_2.p_ctx);
+    dps310_uninit_ExpectAndReturn (&init_ctx_2, DPS310_SUCCESS);
+    rd_sensor_uninitialize_Expect (&dps_ctx_2);
+    err_code = ri_dps310_uninit (&dps_ctx_2, RD_BUS_SPI, 2U);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (&init_ctx_2 == dps_ctx_2.p_ctx);
+}
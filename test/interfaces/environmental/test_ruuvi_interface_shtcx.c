@@ -24,6 +24,10 @@ void setUp (void)
 
 void tearDown (void)
 {
+    // Uninit collects measurement left running by test.
+    rd_sensor_timestamp_get_IgnoreAndReturn (1000 + 14);
+    sensirion_sleep_usec_Ignore();
+    shtc1_read_IgnoreAndReturn (0);
     test_ri_shtcx_uninit_ok ();
 }
 
@@ -56,6 +60,9 @@ void test_ri_shtcx_init_ok (void)
     TEST_ASSERT (&ri_shtcx_dsp_set == shtcx_ctx.dsp_set);
     TEST_ASSERT (&ri_shtcx_dsp_get == shtcx_ctx.dsp_get);
     TEST_ASSERT (&ri_shtcx_data_get == shtcx_ctx.data_get);
+    TEST_ASSERT (&ri_shtcx_measurement_start == shtcx_ctx.measurement_start);
+    TEST_ASSERT (&ri_shtcx_measurement_complete == shtcx_ctx.measurement_complete);
+    TEST_ASSERT (&ri_shtcx_cost_get == shtcx_ctx.cost_get);
     TEST_ASSERT (expected.bitfield == shtcx_ctx.provides.bitfield);
 }
 
@@ -79,11 +86,32 @@ void test_ri_shtcx_mode_set_sleep (void)
     TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
 }
 
-// SHTC does not support continuous mode, this just modifies SW state of driver.
+static void measurement_start_expect (const uint64_t start_ms)
+{
+    rd_sensor_timestamp_get_ExpectAndReturn (start_ms);
+    shtc1_wake_up_ExpectAndReturn (0);
+    sensirion_sleep_usec_Expect (RI_SHTCX_WAKEUP_US);
+    shtc1_measure_ExpectAndReturn (0);
+}
+
+static void measurement_read_expect (const uint64_t now_ms)
+{
+    static int32_t temperature = 25000;
+    static int32_t humidity = 50000;
+    rd_sensor_timestamp_get_ExpectAndReturn (now_ms);
+    shtc1_read_ExpectAnyArgsAndReturn (0);
+    shtc1_read_ReturnThruPtr_temperature (&temperature);
+    shtc1_read_ReturnThruPtr_humidity (&humidity);
+    shtc1_sleep_ExpectAndReturn (0);
+}
+
+// SHTC does not support continuous mode, driver starts a measurement
+// and data_get collects it and starts the next one.
 void test_ri_shtcx_mode_set_continuous (void)
 {
     rd_status_t err_code = RD_SUCCESS;
     uint8_t mode = RD_SENSOR_CFG_CONTINUOUS;
+    measurement_start_expect (1000);
     err_code |= ri_shtcx_mode_set (&mode);
     TEST_ASSERT (RD_SUCCESS == err_code);
     TEST_ASSERT (RD_SENSOR_CFG_CONTINUOUS == mode);
@@ -151,14 +179,196 @@ void test_ri_shtcx_data_get_continuous (void)
     rd_status_t err_code = RD_SUCCESS;
     rd_sensor_data_t data;
     test_ri_shtcx_mode_set_continuous();
+    // Conversion done, result is read and next measurement started.
+    measurement_read_expect (1000 + 14);
+    measurement_start_expect (1000 + 15);
+    rd_sensor_data_populate_ExpectAnyArgs();
+    err_code |= ri_shtcx_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_shtcx_data_get_continuous_busy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_data_t data;
+    test_ri_shtcx_mode_set_continuous();
+    // Conversion running, no sample yet and nothing blocks.
+    rd_sensor_timestamp_get_ExpectAndReturn (1000 + 13);
+    err_code |= ri_shtcx_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_shtcx_measurement_start_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == ri_shtcx_measurement_start (NULL));
+}
+
+void test_ri_shtcx_measurement_start_ok (void)
+{
+    uint64_t ready_ms = 0;
+    uint8_t mode = 0;
+    measurement_start_expect (1000);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_measurement_start (&ready_ms));
+    // 12.1 ms conversion rounded up with margin.
+    TEST_ASSERT (1000 + 14 == ready_ms);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_mode_get (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+}
+
+void test_ri_shtcx_measurement_start_no_timestamp (void)
+{
+    uint64_t ready_ms = 0;
+    // Sensor is not woken up.
+    rd_sensor_timestamp_get_ExpectAndReturn (RD_UINT64_INVALID);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_start (&ready_ms));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_complete());
+}
+
+void test_ri_shtcx_measurement_start_twice (void)
+{
+    uint64_t ready_ms = 0;
+    test_ri_shtcx_measurement_start_ok();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_start (&ready_ms));
+}
+
+void test_ri_shtcx_measurement_start_error (void)
+{
+    uint64_t ready_ms = 0;
     rd_sensor_timestamp_get_ExpectAndReturn (1000);
     shtc1_wake_up_ExpectAndReturn (0);
     sensirion_sleep_usec_Expect (RI_SHTCX_WAKEUP_US);
-    shtc1_measure_blocking_read_ExpectAnyArgsAndReturn (0);
+    shtc1_measure_ExpectAndReturn (-1);
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == ri_shtcx_measurement_start (&ready_ms));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_complete());
+}
+
+void test_ri_shtcx_measurement_complete_not_started (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_complete());
+}
+
+void test_ri_shtcx_measurement_complete_busy (void)
+{
+    test_ri_shtcx_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1000 + 13);
+    TEST_ASSERT (RD_ERROR_BUSY == ri_shtcx_measurement_complete());
+}
+
+void test_ri_shtcx_measurement_complete_ok (void)
+{
+    rd_sensor_data_t data;
+    test_ri_shtcx_measurement_start_ok();
+    measurement_read_expect (1000 + 14);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_measurement_complete());
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_complete());
+    rd_sensor_data_populate_ExpectAnyArgs();
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_data_get (&data));
+}
+
+void test_ri_shtcx_measurement_complete_crc_error (void)
+{
+    rd_sensor_data_t data;
+    test_ri_shtcx_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1000 + 14);
+    shtc1_read_ExpectAnyArgsAndReturn (-2);
     shtc1_sleep_ExpectAndReturn (0);
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == ri_shtcx_measurement_complete());
+    // No valid sample.
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_data_get (&data));
+}
+
+void test_ri_shtcx_data_get_collects_measurement (void)
+{
+    rd_sensor_data_t data;
+    test_ri_shtcx_measurement_start_ok();
+    measurement_read_expect (1000 + 20);
     rd_sensor_data_populate_ExpectAnyArgs();
-    err_code |= ri_shtcx_data_get (&data);
-    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_data_get (&data));
+}
+
+void test_ri_shtcx_mode_set_sleep_while_measuring (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_SLEEP;
+    rd_sensor_data_t data;
+    test_ri_shtcx_mode_set_continuous();
+    // Wait for rest of conversion before reading result and sleep command.
+    rd_sensor_timestamp_get_ExpectAndReturn (1000 + 10);
+    sensirion_sleep_usec_Expect (4000U);
+    shtc1_read_ExpectAnyArgsAndReturn (0);
+    shtc1_sleep_ExpectAndReturn (0);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_mode_set (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_measurement_complete());
+    // Collected result is latest sample.
+    rd_sensor_data_populate_ExpectAnyArgs();
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_data_get (&data));
+}
+
+void test_ri_shtcx_mode_set_sleep_after_conversion (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_SLEEP;
+    test_ri_shtcx_measurement_start_ok();
+    measurement_read_expect (1000 + 14);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_mode_set (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+}
+
+void test_ri_shtcx_mode_set_single_while_measuring (void)
+{
+    uint8_t mode = RD_SENSOR_CFG_SINGLE;
+    test_ri_shtcx_measurement_start_ok();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_shtcx_mode_set (&mode));
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+}
+
+void test_ri_shtcx_cost_get_single (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = RD_SENSOR_CFG_DEFAULT,
+        .dsp_function = RD_SENSOR_DSP_LAST,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    const rd_sensor_cost_t expected =
+    {
+        .conversion_us = 12340U,
+        .charge_nc = 4644U,
+        .sleep_na = RI_SHTCX_SLEEP_NA
+    };
+    rd_sensor_cost_average_na_ExpectWithArrayAndReturn (&expected, 1,
+            RI_SHTCX_COST_INTERVAL_US, 4940U);
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (12340U, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (4644U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (4940U, cost.average_na);
+}
+
+void test_ri_shtcx_cost_get_sleep (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .mode = RD_SENSOR_CFG_SLEEP
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_SUCCESS == ri_shtcx_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (RI_SHTCX_SLEEP_NA, cost.average_na);
+}
+
+void test_ri_shtcx_cost_get_not_supported (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 10U,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_shtcx_cost_get (&config, &cost));
+    config.samplerate = RD_SENSOR_CFG_DEFAULT;
+    config.dsp_function = RD_SENSOR_DSP_OS;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_shtcx_cost_get (&config, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_shtcx_cost_get (NULL, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_shtcx_cost_get (&config, NULL));
 }
 
 #endif //TEST
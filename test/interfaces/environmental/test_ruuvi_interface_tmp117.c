@@ -72,6 +72,9 @@ void test_ri_tmp117_init_ok (void)
     TEST_ASSERT (&ri_tmp117_dsp_set == tmp_ctx.dsp_set);
     TEST_ASSERT (&ri_tmp117_dsp_get == tmp_ctx.dsp_get);
     TEST_ASSERT (&ri_tmp117_data_get == tmp_ctx.data_get);
+    TEST_ASSERT (&ri_tmp117_measurement_start == tmp_ctx.measurement_start);
+    TEST_ASSERT (&ri_tmp117_measurement_complete == tmp_ctx.measurement_complete);
+    TEST_ASSERT (&ri_tmp117_cost_get == tmp_ctx.cost_get);
     TEST_ASSERT (expected.bitfield == tmp_ctx.provides.bitfield);
 }
 
@@ -885,4 +888,369 @@ void test_ri_tmp117_data_get_continuous (void)
     rd_sensor_data_set_ExpectAnyArgs();
     err_code |= ri_tmp117_data_get (&data);
     TEST_ASSERT (RD_SUCCESS == err_code);
-}
\ No newline at end of file
+}
+static void measurement_start_Expect (void)
+{
+    static uint16_t reg_val = TMP117_VALUE_MODE_SLEEP;
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION,
+                                         TMP117_VALUE_MODE_SINGLE, RD_SUCCESS);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+}
+
+static void measurement_result_Expect (const uint16_t drdy)
+{
+    static uint16_t cfg;
+    static uint16_t temp_val = 128U;
+    cfg = drdy;
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&cfg);
+
+    if (0U != drdy)
+    {
+        ri_i2c_tmp117_read_ExpectAndReturn (mock_addr, TMP117_REG_TEMP_RESULT, NULL,
+                                            RD_SUCCESS);
+        ri_i2c_tmp117_read_IgnoreArg_reg_val();
+        ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&temp_val);
+    }
+}
+
+void test_ri_tmp117_measurement_start_ok (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    test_ri_tmp117_samplerate_set_1();
+    test_ri_tmp117_dsp_set_os_8();
+    measurement_start_Expect();
+    err_code |= ri_tmp117_measurement_start (&ready);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (1000U + TMP117_OS_8_TSAMPLE_MS == ready);
+}
+
+void test_ri_tmp117_measurement_start_twice (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    test_ri_tmp117_measurement_start_ok();
+    err_code |= ri_tmp117_measurement_start (&ready);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_tmp117_measurement_start_continuous (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint64_t ready = 0;
+    test_ri_tmp117_mode_set_continuous();
+    err_code |= ri_tmp117_measurement_start (&ready);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_tmp117_measurement_start_no_timestamp (void)
+{
+    static uint16_t reg_val = TMP117_VALUE_MODE_SLEEP;
+    uint64_t ready = 0;
+    test_ri_tmp117_samplerate_set_1();
+    test_ri_tmp117_dsp_set_os_8();
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION,
+                                         TMP117_VALUE_MODE_SINGLE, RD_SUCCESS);
+    rd_sensor_timestamp_get_ExpectAndReturn (RD_UINT64_INVALID);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_tmp117_measurement_start (&ready));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == ri_tmp117_measurement_complete());
+}
+
+void test_ri_tmp117_measurement_start_null (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= ri_tmp117_measurement_start (NULL);
+    TEST_ASSERT (RD_ERROR_NULL == err_code);
+}
+
+void test_ri_tmp117_measurement_complete_ok (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_data_t data = {0};
+    float temperature = 0;
+    data.fields.datas.temperature_c = 1;
+    data.data = &temperature;
+    test_ri_tmp117_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U + TMP117_OS_8_TSAMPLE_MS);
+    measurement_result_Expect (TMP117_MASK_DRDY);
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    rd_sensor_data_set_ExpectAnyArgs();
+    err_code |= ri_tmp117_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // Sample is timestamped at start of conversion.
+    TEST_ASSERT (1000U == data.timestamp_ms);
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_tmp117_measurement_complete_early (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    test_ri_tmp117_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U + TMP117_OS_8_TSAMPLE_MS - 1U);
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_ERROR_BUSY == err_code);
+}
+
+void test_ri_tmp117_measurement_complete_not_drdy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    test_ri_tmp117_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U + TMP117_OS_8_TSAMPLE_MS);
+    measurement_result_Expect (0U);
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_ERROR_BUSY == err_code);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U + TMP117_OS_8_TSAMPLE_MS + 5U);
+    measurement_result_Expect (TMP117_MASK_DRDY);
+    err_code = ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_tmp117_measurement_complete_not_started (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_tmp117_measurement_data_get_busy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_data_t data = {0};
+    test_ri_tmp117_measurement_start_ok();
+    rd_sensor_timestamp_get_ExpectAndReturn (1001U);
+    // No previous sample, nothing is returned while conversion runs.
+    err_code |= ri_tmp117_data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_tmp117_measurement_sleep_cancels (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    test_ri_tmp117_measurement_start_ok();
+    test_ri_tmp117_mode_set_sleep();
+    err_code |= ri_tmp117_measurement_complete();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+}
+
+void test_ri_tmp117_cost_get_continuous (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = 1U,
+        .dsp_function = RD_SENSOR_DSP_LAST,
+        .mode = RD_SENSOR_CFG_CONTINUOUS
+    };
+    rd_sensor_cost_t cost = {0};
+    // Sensor is in standby between conversions.
+    const rd_sensor_cost_t standby =
+    {
+        .conversion_us = TMP117_CONVERSION_US,
+        .charge_nc = 2092U,
+        .sleep_na = TMP117_STANDBY_NA
+    };
+    rd_sensor_cost_average_na_ExpectWithArrayAndReturn (&standby, 1, 1000000U, 3322U);
+    rd_status_t err_code = ri_tmp117_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_UINT32 (TMP117_CONVERSION_US, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (2092U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (TMP117_SHUTDOWN_NA, cost.sleep_na);
+    TEST_ASSERT_EQUAL_UINT32 (3322U, cost.average_na);
+}
+
+void test_ri_tmp117_cost_get_single_os (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .samplerate = RD_SENSOR_CFG_CUSTOM_1,
+        .dsp_function = RD_SENSOR_DSP_OS,
+        .dsp_parameter = 8U,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    // One sample per 4 s.
+    rd_sensor_cost_average_na_ExpectAndReturn (NULL, 4000000U, 4330U);
+    rd_sensor_cost_average_na_IgnoreArg_p_cost();
+    rd_status_t err_code = ri_tmp117_cost_get (&config, &cost);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_UINT32 (8U * TMP117_CONVERSION_US, cost.conversion_us);
+    TEST_ASSERT_EQUAL_UINT32 (16740U, cost.charge_nc);
+    TEST_ASSERT_EQUAL_UINT32 (4330U, cost.average_na);
+}
+
+void test_ri_tmp117_cost_get_sleep (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .mode = RD_SENSOR_CFG_SLEEP
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_SUCCESS == ri_tmp117_cost_get (&config, &cost));
+    TEST_ASSERT_EQUAL_UINT32 (TMP117_SHUTDOWN_NA, cost.average_na);
+}
+
+void test_ri_tmp117_cost_get_not_supported (void)
+{
+    rd_sensor_configuration_t config =
+    {
+        .dsp_function = RD_SENSOR_DSP_LOW_PASS,
+        .mode = RD_SENSOR_CFG_SINGLE
+    };
+    rd_sensor_cost_t cost = {0};
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == ri_tmp117_cost_get (&config, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_tmp117_cost_get (NULL, &cost));
+    TEST_ASSERT (RD_ERROR_NULL == ri_tmp117_cost_get (&config, NULL));
+}
+
+static rd_sensor_t tmp_ctx_2;
+static const uint8_t mock_addr_2 = 0x49U;
+
+static void second_init (void)
+{
+    static uint16_t id = TMP117_VALUE_ID;
+    rd_sensor_is_init_ExpectAndReturn (&tmp_ctx_2, false);
+    rd_sensor_initialize_Expect (&tmp_ctx_2);
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr_2, TMP117_REG_DEVICE_ID, NULL, RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&id);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION, 2,
+                                         RD_SUCCESS);
+    ri_delay_ms_ExpectAndReturn (TMP117_CC_RESET_DELAY_MS, RD_SUCCESS);
+    rd_status_t err_code = ri_tmp117_init (&tmp_ctx_2, RD_BUS_I2C, mock_addr_2);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+static void second_uninit (void)
+{
+    static uint16_t reg_val = TMP117_VALUE_MODE_SLEEP;
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION,
+                                         TMP117_VALUE_MODE_SLEEP, RD_SUCCESS);
+    rd_sensor_uninitialize_Expect (&tmp_ctx_2);
+    rd_status_t err_code = ri_tmp117_uninit (&tmp_ctx_2, RD_BUS_I2C, mock_addr_2);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void test_ri_tmp117_init_second_instance (void)
+{
+    second_init();
+    TEST_ASSERT (NULL != tmp_ctx.p_ctx);
+    TEST_ASSERT (NULL != tmp_ctx_2.p_ctx);
+    TEST_ASSERT (tmp_ctx.p_ctx != tmp_ctx_2.p_ctx);
+    TEST_ASSERT (&ri_tmp117_init == tmp_ctx_2.init);
+    TEST_ASSERT (&ri_tmp117_uninit == tmp_ctx_2.uninit);
+    TEST_ASSERT (&ri_tmp117_resolution_get == tmp_ctx_2.resolution_get);
+    TEST_ASSERT (&ri_tmp117_scale_get == tmp_ctx_2.scale_get);
+    TEST_ASSERT (NULL != tmp_ctx_2.samplerate_set);
+    TEST_ASSERT (tmp_ctx.samplerate_set != tmp_ctx_2.samplerate_set);
+    TEST_ASSERT (tmp_ctx.samplerate_get != tmp_ctx_2.samplerate_get);
+    TEST_ASSERT (tmp_ctx.mode_set != tmp_ctx_2.mode_set);
+    TEST_ASSERT (tmp_ctx.mode_get != tmp_ctx_2.mode_get);
+    TEST_ASSERT (tmp_ctx.dsp_set != tmp_ctx_2.dsp_set);
+    TEST_ASSERT (tmp_ctx.dsp_get != tmp_ctx_2.dsp_get);
+    TEST_ASSERT (tmp_ctx.data_get != tmp_ctx_2.data_get);
+    second_uninit();
+    TEST_ASSERT (NULL == tmp_ctx_2.p_ctx);
+}
+
+void test_ri_tmp117_instances_independent (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    uint8_t mode = RD_SENSOR_CFG_CONTINUOUS;
+    uint16_t reg_val = TMP117_VALUE_MODE_SLEEP;
+    uint16_t temperature = 0x0C80U; // 25 C
+    rd_sensor_data_t data = {0};
+    second_init();
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION,
+                                         TMP117_VALUE_MODE_CONT, RD_SUCCESS);
+    err_code |= tmp_ctx_2.mode_set (&mode);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // First sensor stays in sleep and can be configured.
+    mode = 0;
+    err_code |= tmp_ctx.mode_get (&mode);
+    TEST_ASSERT (RD_SENSOR_CFG_SLEEP == mode);
+    mode = 0;
+    err_code |= tmp_ctx_2.mode_get (&mode);
+    TEST_ASSERT (RD_SENSOR_CFG_CONTINUOUS == mode);
+    uint8_t samplerate = 1;
+    reg_val = TMP117_VALUE_CC_1000_MS;
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr, TMP117_REG_CONFIGURATION, reg_val,
+                                         RD_SUCCESS);
+    err_code |= tmp_ctx.samplerate_set (&samplerate);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // Samplerate of second sensor cannot be changed in continuous mode.
+    err_code |= tmp_ctx_2.samplerate_set (&samplerate);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+    err_code = RD_SUCCESS;
+    // Second sensor is read from its own address.
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr_2, TMP117_REG_TEMP_RESULT, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&temperature);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000);
+    rd_sensor_data_set_ExpectAnyArgs();
+    err_code |= tmp_ctx_2.data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    // First sensor has no sample, nothing is set.
+    err_code |= tmp_ctx.data_get (&data);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    second_uninit();
+}
+
+void test_ri_tmp117_init_no_free_instance (void)
+{
+    rd_sensor_t tmp_ctx_3 = {0};
+    second_init();
+    rd_sensor_is_init_ExpectAndReturn (&tmp_ctx_3, false);
+    rd_status_t err_code = ri_tmp117_init (&tmp_ctx_3, RD_BUS_I2C, 0x4AU);
+    TEST_ASSERT (RD_ERROR_RESOURCES == err_code);
+    TEST_ASSERT (NULL == tmp_ctx_3.p_ctx);
+    second_uninit();
+}
+
+void test_ri_tmp117_init_application_context (void)
+{
+    ri_tmp117_ctx_t app_ctx = {0};
+    uint8_t mode = RD_SENSOR_CFG_CONTINUOUS;
+    uint16_t reg_val = TMP117_VALUE_MODE_SLEEP;
+    tmp_ctx_2.p_ctx = &app_ctx;
+    second_init();
+    TEST_ASSERT (&app_ctx == tmp_ctx_2.p_ctx);
+    TEST_ASSERT (mock_addr_2 == app_ctx.address);
+    ri_i2c_tmp117_read_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION, NULL,
+                                        RD_SUCCESS);
+    ri_i2c_tmp117_read_IgnoreArg_reg_val();
+    ri_i2c_tmp117_read_ReturnThruPtr_reg_val (&reg_val);
+    ri_i2c_tmp117_write_ExpectAndReturn (mock_addr_2, TMP117_REG_CONFIGURATION,
+                                         TMP117_VALUE_MODE_CONT, RD_SUCCESS);
+    rd_status_t err_code = tmp_ctx_2.mode_set (&mode);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (app_ctx.continuous);
+    second_uninit();
+    TEST_ASSERT (&app_ctx == tmp_ctx_2.p_ctx);
+    TEST_ASSERT (!app_ctx.continuous);
+    tmp_ctx_2.p_ctx = NULL;
+}
@@ -0,0 +1,353 @@
+#ifdef TEST
+
+#include "unity.h"
+
+#include "macronix_flash.h"
+#include "mx25_sim.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_gpio.h"
+#include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define WRITE_MAX         (4096U)
+#define PATTERN_SEED      (0x5AU)
+#define READ_BENCH_SIZE   (64U * 1024U)
+#define LEGACY_READ_CHUNK (255U)
+
+static uint8_t m_data[WRITE_MAX];
+static uint8_t m_read[READ_BENCH_SIZE];
+
+static rd_status_t gpio_write_sim (const ri_gpio_id_t pin, const ri_gpio_state_t state,
+                                   int cmock_num_calls)
+{
+    TEST_ASSERT_EQUAL (RB_PORT_PIN_MAP (0, SS_SPI_MACRONIX), pin);
+    mx25_sim_select (RI_GPIO_LOW == state);
+    return RD_SUCCESS;
+}
+
+static uint64_t timestamp_sim (int cmock_num_calls)
+{
+    return mx25_sim_time_us() / 1000U;
+}
+
+void setUp (void)
+{
+    mx25_sim_init();
+    ri_gpio_write_StubWithCallback (&gpio_write_sim);
+    rd_sensor_timestamp_get_StubWithCallback (&timestamp_sim);
+    ri_log_Ignore();
+    ri_yield_IgnoreAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_NORMAL));
+    mx_config_cache_invalidate();
+
+    for (uint32_t ii = 0; ii < WRITE_MAX; ii++)
+    {
+        m_data[ii] = (uint8_t) (ii + PATTERN_SEED);
+    }
+}
+
+void tearDown (void)
+{
+}
+
+static void check_written (const uint32_t address, const uint32_t length)
+{
+    const uint8_t * const p_array = mx25_sim_memory();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &p_array[address], length);
+
+    if (address > 0U)
+    {
+        TEST_ASSERT_EQUAL_HEX8 (0xFFU, p_array[address - 1U]);
+    }
+
+    TEST_ASSERT_EQUAL_HEX8 (0xFFU, p_array[address + length]);
+}
+
+void test_mx_write_single_page (void)
+{
+    mx_write_stats_t stats;
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0x1000U, m_data, MX_PAGE_SIZE));
+    mx_write_stats_get (&stats);
+    mx25_sim_stats_get (&sim);
+    check_written (0x1000U, MX_PAGE_SIZE);
+    TEST_ASSERT_EQUAL (MX_PAGE_SIZE, stats.bytes);
+    TEST_ASSERT_EQUAL (1U, stats.pages);
+    TEST_ASSERT_EQUAL (1U, sim.programs);
+    TEST_ASSERT_FALSE (mx25_sim_is_busy());
+}
+
+void test_mx_write_unaligned_multi_page (void)
+{
+    mx_write_stats_t stats;
+    mx25_sim_stats_t sim;
+    const uint32_t address = 0x21F0U;
+    const uint32_t length = 1000U;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (address, m_data, length));
+    mx_write_stats_get (&stats);
+    mx25_sim_stats_get (&sim);
+    check_written (address, length);
+    // 16 bytes to page boundary, 3 full pages and 216 bytes.
+    TEST_ASSERT_EQUAL (5U, stats.pages);
+    TEST_ASSERT_EQUAL (5U, sim.programs);
+    TEST_ASSERT_EQUAL (0U, sim.wraps);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+}
+
+void test_mx_write_short_in_page (void)
+{
+    mx_write_stats_t stats;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0x30FFU, m_data, 1U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0x3100U, &m_data[1], 1U));
+    mx_write_stats_get (&stats);
+    check_written (0x30FFU, 2U);
+    TEST_ASSERT_EQUAL (1U, stats.pages);
+}
+
+void test_mx_write_zero_length (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0U, m_data, 0U));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (0U, sim.programs);
+}
+
+void test_mx_write_null (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, mx_write (0U, NULL, 1U));
+}
+
+void test_mx_write_waits_for_erase (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write_enable());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_sector_erase (0x4000U));
+    TEST_ASSERT_TRUE (mx25_sim_is_busy());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0x4080U, m_data, MX_PAGE_SIZE));
+    mx25_sim_stats_get (&sim);
+    check_written (0x4080U, MX_PAGE_SIZE);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+    TEST_ASSERT (mx25_sim_time_us() >= MX25_SIM_SE_LP_US);
+}
+
+/** Single page program across page boundary wraps to start of page. */
+void test_mx_program_wraps_at_page (void)
+{
+    mx25_sim_stats_t sim;
+    const uint8_t * const p_array = mx25_sim_memory();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write_enable());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_program (0x50F0U, m_data, 32U));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.wraps);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &p_array[0x50F0U], 16U);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (&m_data[16], &p_array[0x5000U], 16U);
+    TEST_ASSERT_EQUAL_HEX8 (0xFFU, p_array[0x5100U]);
+}
+
+/** Page program without write enable is ignored by flash. */
+void test_mx_program_requires_write_enable (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_program (0x6000U, m_data, 16U));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.ignored);
+    TEST_ASSERT_EQUAL_HEX8 (0xFFU, mx25_sim_memory() [0x6000U]);
+}
+
+/** Pattern used before mx_write: wait, write enable and verify, one program. */
+static void legacy_write (uint32_t address, const uint8_t * p_data, uint32_t length)
+{
+    while (length > 0U)
+    {
+        const uint32_t chunk = (length < MX_PAGE_SIZE) ? length : MX_PAGE_SIZE;
+        mx_spi_ready_for_transfer();
+        mx_program (address, p_data, chunk);
+        address += chunk;
+        p_data += chunk;
+        length -= chunk;
+    }
+
+    while (RD_ERROR_BUSY == mx_busy())
+    {
+    }
+}
+
+void test_mx_write_throughput (void)
+{
+    mx_write_stats_t stats;
+    mx25_sim_stats_t sim;
+    char msg[160];
+    legacy_write (0U, m_data, WRITE_MAX);
+    const uint64_t legacy_us = mx25_sim_time_us();
+    mx25_sim_stats_get (&sim);
+    const uint32_t legacy_transfers = sim.transfers;
+    mx25_sim_init();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0U, m_data, WRITE_MAX));
+    const uint64_t write_us = mx25_sim_time_us();
+    mx_write_stats_get (&stats);
+    mx25_sim_stats_get (&sim);
+    check_written (0U, WRITE_MAX);
+    snprintf (msg, sizeof (msg),
+              "%u bytes: legacy %u us %u transfers, mx_write %u us %u transfers, "
+              "%u B/s reported",
+              WRITE_MAX, (unsigned) legacy_us, (unsigned) legacy_transfers,
+              (unsigned) write_us, (unsigned) sim.transfers, (unsigned) stats.bytes_per_s);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT_EQUAL (WRITE_MAX / MX_PAGE_SIZE, stats.pages);
+    TEST_ASSERT (write_us <= legacy_us);
+    TEST_ASSERT ( (MX_STATUS_POLL_BURST / 4U) * sim.transfers < legacy_transfers);
+    TEST_ASSERT_UINT32_WITHIN (stats.bytes_per_s / 10U,
+                               (uint32_t) ( (1000000ULL * WRITE_MAX) / write_us),
+                               stats.bytes_per_s);
+}
+
+void test_mx_read_modes (void)
+{
+    const mx_read_mode_t modes[] =
+    {
+        MX_READ_NORMAL, MX_READ_FAST, MX_READ_DUAL, MX_READ_QUAD
+    };
+    mx25_sim_lanes_set (4U);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (0x7010U, m_data, WRITE_MAX));
+
+    for (size_t ii = 0; ii < (sizeof (modes) / sizeof (modes[0])); ii++)
+    {
+        memset (m_read, 0, WRITE_MAX);
+        TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (modes[ii]));
+        TEST_ASSERT_EQUAL (modes[ii], mx_read_mode_get());
+        TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read (0x7010U, m_read, WRITE_MAX));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, m_read, WRITE_MAX);
+    }
+}
+
+void test_mx_read_single_transfer (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read (0U, m_read, READ_BENCH_SIZE));
+    mx25_sim_stats_get (&sim);
+    // Command and data, chaining is left to platform transfer.
+    TEST_ASSERT_EQUAL (2U, sim.transfers);
+    TEST_ASSERT_EQUAL (READ_BENCH_SIZE + 4U, sim.bytes);
+}
+
+void test_mx_read_mode_not_supported (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_NOT_SUPPORTED, mx_read_mode_set (MX_READ_DUAL));
+    mx25_sim_lanes_set (2U);
+    TEST_ASSERT_EQUAL (RD_ERROR_NOT_SUPPORTED, mx_read_mode_set (MX_READ_QUAD));
+    TEST_ASSERT_EQUAL (MX_READ_NORMAL, mx_read_mode_get());
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, mx_read_mode_set (MX_READ_MODES));
+}
+
+void test_mx_read_mode_quad_sets_qe (void)
+{
+    mx25_sim_stats_t sim;
+    uint8_t status = 0;
+    mx25_sim_lanes_set (4U);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_QUAD));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_QUAD));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.wrsr);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_status_register (&status));
+    TEST_ASSERT_TRUE (status & (1U << REG_SR_BIT_QE));
+}
+
+void test_mx_high_performance_switch_keeps_qe (void)
+{
+    uint8_t status = 0;
+    mx25_sim_lanes_set (4U);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_QUAD));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (true));
+
+    while (RD_ERROR_BUSY == mx_busy())
+    {
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_status_register (&status));
+    TEST_ASSERT_TRUE (status & (1U << REG_SR_BIT_QE));
+    TEST_ASSERT_EQUAL_HEX8 (MX25_SIM_CR2_HP, mx25_sim_cr2());
+}
+
+void test_mx_high_performance_switch_cached (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (true));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (true));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.wrsr);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (false));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (false));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (2U, sim.wrsr);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+    // Flash reset: mode must be written again.
+    mx_config_cache_invalidate();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_high_performance_switch (false));
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (3U, sim.wrsr);
+}
+
+/** Read pattern used before read modes: READ in 255-byte transfers. */
+static void legacy_read (const uint32_t address, uint8_t * p_data, uint32_t length)
+{
+    const uint8_t cmd[] = {CMD_READ, (uint8_t) (address >> 16U), (uint8_t) (address >> 8U),
+                           (uint8_t) address
+                          };
+    ri_gpio_write (RB_PORT_PIN_MAP (0, SS_SPI_MACRONIX), RI_GPIO_LOW);
+    ri_spi_xfer_blocking_macronix (cmd, sizeof (cmd), NULL, 0U);
+
+    while (length > LEGACY_READ_CHUNK)
+    {
+        ri_spi_xfer_blocking_macronix (NULL, 0U, p_data, LEGACY_READ_CHUNK);
+        p_data += LEGACY_READ_CHUNK;
+        length -= LEGACY_READ_CHUNK;
+    }
+
+    ri_spi_xfer_blocking_macronix (NULL, 0U, p_data, length);
+    ri_gpio_write (RB_PORT_PIN_MAP (0, SS_SPI_MACRONIX), RI_GPIO_HIGH);
+}
+
+void test_mx_read_throughput (void)
+{
+    const mx_read_mode_t modes[] =
+    {
+        MX_READ_NORMAL, MX_READ_FAST, MX_READ_DUAL, MX_READ_QUAD
+    };
+    const char * const names[] = {"READ", "FAST_READ", "DREAD", "QREAD"};
+    uint64_t elapsed_us[sizeof (modes) / sizeof (modes[0])];
+    mx25_sim_stats_t sim;
+    char msg[128];
+    mx25_sim_lanes_set (4U);
+    uint64_t start = mx25_sim_time_us();
+    legacy_read (0U, m_read, READ_BENCH_SIZE);
+    const uint64_t legacy_us = mx25_sim_time_us() - start;
+    mx25_sim_stats_get (&sim);
+    snprintf (msg, sizeof (msg), "%u bytes legacy READ: %u us, %u kB/s, %u transfers",
+              READ_BENCH_SIZE, (unsigned) legacy_us,
+              (unsigned) ( (1000ULL * READ_BENCH_SIZE) / legacy_us),
+              (unsigned) sim.transfers);
+    TEST_MESSAGE (msg);
+
+    for (size_t ii = 0; ii < (sizeof (modes) / sizeof (modes[0])); ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (modes[ii]));
+        start = mx25_sim_time_us();
+        TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read (0U, m_read, READ_BENCH_SIZE));
+        elapsed_us[ii] = mx25_sim_time_us() - start;
+        snprintf (msg, sizeof (msg), "%u bytes %s: %u us, %u kB/s", READ_BENCH_SIZE,
+                  names[ii], (unsigned) elapsed_us[ii],
+                  (unsigned) ( (1000ULL * READ_BENCH_SIZE) / elapsed_us[ii]));
+        TEST_MESSAGE (msg);
+    }
+
+    TEST_ASSERT (elapsed_us[0] <= legacy_us);
+    // Command and address are clocked on one lane in all modes.
+    TEST_ASSERT_UINT32_WITHIN (8U, elapsed_us[1] / 2U, elapsed_us[2]);
+    TEST_ASSERT_UINT32_WITHIN (8U, elapsed_us[1] / 4U, elapsed_us[3]);
+}
+
+#endif
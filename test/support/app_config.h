@@ -0,0 +1,13 @@
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+/**
+ * @file app_config.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Application configuration of host tests, normally provided by application.
+ * Tests which need application options define them in project.yml.
+ */
+
+#endif
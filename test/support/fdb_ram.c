@@ -0,0 +1,155 @@
+/**
+ * @file fdb_ram.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "fdb_ram.h"
+
+#include <string.h>
+
+typedef struct
+{
+    fdb_time_t time;
+    uint32_t len;
+    uint8_t data[FDB_RAM_ENTRY_SIZE];
+} fdb_ram_entry_t;
+
+static fdb_ram_entry_t m_entries[FDB_RAM_ENTRIES];
+static uint32_t m_oldest;  //!< Slot of oldest entry.
+static uint32_t m_count;
+static uint32_t m_visits;
+
+static fdb_ram_entry_t * ram_entry (const uint32_t age)
+{
+    return &m_entries[ (m_oldest + age) % FDB_RAM_ENTRIES];
+}
+
+void fdb_ram_init (void)
+{
+    memset (m_entries, 0, sizeof (m_entries));
+    m_oldest = 0;
+    m_count = 0;
+    m_visits = 0;
+}
+
+uint32_t fdb_ram_entries (void)
+{
+    return m_count;
+}
+
+uint32_t fdb_ram_visits (void)
+{
+    return m_visits;
+}
+
+fdb_err_t fdb_tsdb_init (fdb_tsdb_t db, const char * name, const char * part_name,
+                         fdb_get_time get_time, size_t max_len, void * user_data)
+{
+    db->parent.name = name;
+    db->get_time = get_time;
+    db->max_len = max_len;
+    db->last_time = (m_count) ? ram_entry (m_count - 1U)->time : 0;
+    return FDB_NO_ERR;
+}
+
+void fdb_tsdb_deinit (fdb_tsdb_t db)
+{
+    db->get_time = NULL;
+}
+
+fdb_err_t fdb_tsl_append (fdb_tsdb_t db, fdb_blob_t blob)
+{
+    fdb_err_t err = FDB_NO_ERR;
+
+    if ( (NULL == db->get_time) || (blob->size > db->max_len)
+            || (blob->size > FDB_RAM_ENTRY_SIZE))
+    {
+        err = FDB_WRITE_ERR;
+    }
+    else
+    {
+        const fdb_time_t now = db->get_time();
+
+        // FlashDB rejects timestamps going backwards.
+        if ( (0U != m_count) && (now < db->last_time))
+        {
+            err = FDB_WRITE_ERR;
+        }
+        else
+        {
+            if (FDB_RAM_ENTRIES == m_count)
+            {
+                m_oldest = (m_oldest + 1U) % FDB_RAM_ENTRIES;
+                m_count--;
+            }
+
+            fdb_ram_entry_t * const p_entry = ram_entry (m_count);
+            p_entry->time = now;
+            p_entry->len = (uint32_t) blob->size;
+            memcpy (p_entry->data, blob->buf, blob->size);
+            m_count++;
+            db->last_time = now;
+        }
+    }
+
+    return err;
+}
+
+void fdb_tsl_iter_by_time (fdb_tsdb_t db, fdb_time_t from, fdb_time_t to, fdb_tsl_cb cb,
+                           void * cb_arg)
+{
+    bool stop = false;
+
+    for (uint32_t ii = 0; (ii < m_count) && !stop; ii++)
+    {
+        const fdb_ram_entry_t * const p_entry = ram_entry (ii);
+
+        if ( (p_entry->time >= from) && (p_entry->time <= to))
+        {
+            struct fdb_tsl tsl =
+            {
+                .status = FDB_TSL_WRITE,
+                .time = p_entry->time,
+                .log_len = p_entry->len,
+                .addr = { .index = ii, .log = (uint32_t) (p_entry - m_entries) }
+            };
+            m_visits++;
+            stop = cb (&tsl, cb_arg);
+        }
+    }
+}
+
+void fdb_tsl_iter (fdb_tsdb_t db, fdb_tsl_cb cb, void * cb_arg)
+{
+    fdb_tsl_iter_by_time (db, INT32_MIN, INT32_MAX, cb, cb_arg);
+}
+
+void fdb_tsl_clean (fdb_tsdb_t db)
+{
+    m_oldest = 0;
+    m_count = 0;
+    db->last_time = 0;
+}
+
+fdb_blob_t fdb_blob_make (fdb_blob_t blob, const void * value_buf, size_t buf_len)
+{
+    blob->buf = (void *) value_buf;
+    blob->size = buf_len;
+    return blob;
+}
+
+fdb_blob_t fdb_tsl_to_blob (fdb_tsl_t tsl, fdb_blob_t blob)
+{
+    blob->saved.addr = tsl->addr.log;
+    blob->saved.len = tsl->log_len;
+    return blob;
+}
+
+size_t fdb_blob_read (fdb_db_t db, fdb_blob_t blob)
+{
+    const fdb_ram_entry_t * const p_entry = &m_entries[blob->saved.addr];
+    const size_t len = (blob->size < blob->saved.len) ? blob->size : blob->saved.len;
+    memcpy (blob->buf, p_entry->data, len);
+    return len;
+}
@@ -0,0 +1,31 @@
+#ifndef FDB_RAM_H
+#define FDB_RAM_H
+/**
+ * @file fdb_ram.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * FlashDB time series database kept in RAM for host tests.
+ *
+ * Implements functions of flashdb.h for one database. Entries are kept in
+ * append order and the oldest entry is dropped when database is full, like
+ * FlashDB rollover. Timestamp of an entry is taken from get_time of the
+ * database at append. Reads through iterators count entries visited so that
+ * tests can check how much of the log was scanned.
+ */
+#include "flashdb.h"
+
+#define FDB_RAM_ENTRIES    (64U)  //!< Entries kept before oldest is dropped.
+#define FDB_RAM_ENTRY_SIZE (256U) //!< Largest entry, bytes.
+
+/** @brief Drop all entries and reset counters. */
+void fdb_ram_init (void);
+
+/** @brief Number of entries in database. */
+uint32_t fdb_ram_entries (void);
+
+/** @brief Entries given to iterator callbacks since @ref fdb_ram_init. */
+uint32_t fdb_ram_visits (void);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef FDS_H
+#define FDS_H
+/**
+ * @file fds.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Statistics of Nordic Flash Data Storage used by flash ringbuffer, for mocking
+ * in host tests. FDS is provided by nRF5 SDK.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct
+{
+    uint16_t pages_available;
+    uint16_t open_records;
+    uint16_t valid_records;
+    uint16_t dirty_records;
+    uint16_t words_reserved;
+    uint16_t words_used;
+    uint16_t largest_contig;
+    uint16_t freeable_words;
+    bool     corruption;
+} fds_stat_t;
+
+uint32_t fds_stat (fds_stat_t * const p_stat);
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FLASHDB_H
+#define FLASHDB_H
+/**
+ * @file flashdb.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Time series database API of FlashDB used by flash tasks, for host tests.
+ *
+ * FlashDB is provided by application and is not part of drivers. Types and
+ * functions here match FlashDB with 32-bit timestamps, functions are
+ * implemented in RAM by fdb_ram.c.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int32_t fdb_time_t;
+
+typedef enum
+{
+    FDB_NO_ERR,
+    FDB_ERASE_ERR,
+    FDB_READ_ERR,
+    FDB_WRITE_ERR,
+    FDB_PART_NOT_FOUND,
+    FDB_KV_NAME_ERR,
+    FDB_KV_NAME_EXIST,
+    FDB_SAVED_FULL,
+    FDB_INIT_FAILED,
+} fdb_err_t;
+
+typedef enum
+{
+    FDB_TSL_UNUSED,
+    FDB_TSL_PRE_WRITE,
+    FDB_TSL_WRITE,
+    FDB_TSL_USER_STATUS1,
+    FDB_TSL_DELETED,
+    FDB_TSL_USER_STATUS2,
+    FDB_TSL_STATUS_NUM,
+} fdb_tsl_status_t;
+
+struct fdb_db
+{
+    const char * name;
+};
+typedef struct fdb_db * fdb_db_t;
+
+struct fdb_blob
+{
+    void * buf;
+    size_t size;
+    struct
+    {
+        uint32_t meta_addr;
+        uint32_t addr;
+        size_t len;
+    } saved;
+};
+typedef struct fdb_blob * fdb_blob_t;
+
+struct fdb_tsl
+{
+    fdb_tsl_status_t status;
+    fdb_time_t time;
+    uint32_t log_len;
+    struct
+    {
+        uint32_t index;
+        uint32_t log;
+    } addr;
+};
+typedef struct fdb_tsl * fdb_tsl_t;
+
+typedef bool (*fdb_tsl_cb) (fdb_tsl_t tsl, void * arg);
+typedef fdb_time_t (*fdb_get_time) (void);
+
+struct fdb_tsdb
+{
+    struct fdb_db parent;
+    fdb_get_time get_time;
+    size_t max_len;
+    fdb_time_t last_time;
+};
+typedef struct fdb_tsdb * fdb_tsdb_t;
+
+fdb_err_t fdb_tsdb_init (fdb_tsdb_t db, const char * name, const char * part_name,
+                         fdb_get_time get_time, size_t max_len, void * user_data);
+void fdb_tsdb_deinit (fdb_tsdb_t db);
+fdb_err_t fdb_tsl_append (fdb_tsdb_t db, fdb_blob_t blob);
+void fdb_tsl_iter (fdb_tsdb_t db, fdb_tsl_cb cb, void * cb_arg);
+void fdb_tsl_iter_by_time (fdb_tsdb_t db, fdb_time_t from, fdb_time_t to, fdb_tsl_cb cb,
+                           void * cb_arg);
+void fdb_tsl_clean (fdb_tsdb_t db);
+fdb_blob_t fdb_blob_make (fdb_blob_t blob, const void * value_buf, size_t buf_len);
+size_t fdb_blob_read (fdb_db_t db, fdb_blob_t blob);
+fdb_blob_t fdb_tsl_to_blob (fdb_tsl_t tsl, fdb_blob_t blob);
+
+#endif
@@ -0,0 +1,396 @@
+/**
+ * @file mx25_sim.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "mx25_sim.h"
+#include "macronix_flash.h"
+
+#include <string.h>
+
+#define SIM_CMD_WRDI       (0x04U)
+#define SIM_ADDRESS_BYTES  (3U)
+#define SIM_SR_WIP         (1U << REG_SR_BIT_WIP)
+#define SIM_SR_WEL         (1U << REG_SR_BIT_WEL)
+#define SIM_SR_QE          (1U << REG_SR_BIT_QE)
+#define SIM_SR_WRITABLE    (0xFCU) //!< Block protect, QE and SRWD bits.
+#define SIM_DUMMY_INDEX    (SIM_ADDRESS_BYTES + 1U) //!< Dummy byte of fast reads.
+#define SIM_BYTE_NS        ((8ULL * 1000000000ULL) / MX25_SIM_SPI_HZ)
+
+static uint8_t m_array[MX25_SIM_SIZE];
+static uint8_t m_page[MX_PAGE_SIZE];
+static uint8_t m_wrsr[SIM_ADDRESS_BYTES];
+static mx25_sim_stats_t m_stats;
+static uint64_t m_now_ns;
+static uint64_t m_busy_until_ns;
+static bool m_busy;
+static bool m_selected;
+static uint8_t m_sr;
+static uint8_t m_cr1;
+static uint8_t m_cr2;
+static uint8_t m_cmd;
+static uint32_t m_index;   //!< Byte index in current chip select cycle.
+static uint32_t m_address;
+static uint32_t m_programmed; //!< Bytes latched to page buffer.
+static uint8_t m_lanes = 1U;  //!< Data lanes of simulated bus.
+static mx25_sim_fault_t m_fault;
+
+/** @brief Finish operation once its time has passed. */
+static void sim_update (void)
+{
+    if (m_busy && (m_now_ns >= m_busy_until_ns))
+    {
+        m_busy = false;
+        m_sr &= (uint8_t) ~ (SIM_SR_WIP | SIM_SR_WEL);
+    }
+}
+
+static void sim_start (const uint64_t duration_us)
+{
+    m_busy = true;
+    m_busy_until_ns = (MX25_SIM_FAULT_STUCK == m_fault) ? UINT64_MAX
+                      : m_now_ns + (duration_us * 1000ULL);
+    m_sr |= SIM_SR_WIP;
+}
+
+static bool sim_is_hp (void)
+{
+    return (0U != (m_cr2 & MX25_SIM_CR2_HP));
+}
+
+static bool sim_is_fast_read (void)
+{
+    return (CMD_FAST_READ == m_cmd) || (CMD_DREAD == m_cmd) || (CMD_QREAD == m_cmd);
+}
+
+static bool sim_has_address (void)
+{
+    return (CMD_READ == m_cmd) || (CMD_PROGRAM == m_cmd) || (CMD_SECTOR_ERASE == m_cmd)
+           || sim_is_fast_read();
+}
+
+/** @brief Data lanes the device drives output of current command on. */
+static uint8_t sim_output_lanes (void)
+{
+    uint8_t lanes = 1U;
+
+    if (CMD_DREAD == m_cmd)
+    {
+        lanes = 2U;
+    }
+    else if (CMD_QREAD == m_cmd)
+    {
+        // Quad output pins are hold and write protect unless QE is set.
+        lanes = (0U != (m_sr & SIM_SR_QE)) ? 4U : 0U;
+    }
+    else
+    {
+        // Single lane.
+    }
+
+    return lanes;
+}
+
+/**
+ * @brief Clock one byte, return byte driven by the device.
+ *
+ * @param[in] in Byte from the host.
+ * @param[in] lanes Lanes host receives on, bits per clock.
+ */
+static uint8_t sim_byte (const uint8_t in, const uint8_t lanes)
+{
+    uint8_t out = 0xFFU;
+    m_now_ns += SIM_BYTE_NS / lanes;
+    m_stats.bytes++;
+    sim_update();
+
+    if (0U == m_index)
+    {
+        m_cmd = in;
+        m_address = 0U;
+        m_programmed = 0U;
+        memset (m_page, 0xFF, sizeof (m_page));
+    }
+    else if (CMD_RDSR == m_cmd)
+    {
+        out = m_sr;
+    }
+    else if (m_busy)
+    {
+        // Only status register is readable while busy.
+    }
+    else if (CMD_RDCR == m_cmd)
+    {
+        out = (1U == (m_index % 2U)) ? m_cr1 : m_cr2;
+    }
+    else if (CMD_REMS == m_cmd)
+    {
+        if (m_index > SIM_ADDRESS_BYTES)
+        {
+            out = (0U == ( (m_index - SIM_ADDRESS_BYTES) % 2U)) ? MX25_SIM_DEVICE
+                  : MX25_SIM_MANUFACTURER;
+        }
+    }
+    else if (CMD_WRSR == m_cmd)
+    {
+        if (m_index <= SIM_ADDRESS_BYTES)
+        {
+            m_wrsr[m_index - 1U] = in;
+        }
+    }
+    else if (sim_has_address() && (m_index <= SIM_ADDRESS_BYTES))
+    {
+        m_address = (m_address << 8U) | in;
+        m_address %= MX25_SIM_SIZE;
+    }
+    else if ( (CMD_READ == m_cmd)
+              || (sim_is_fast_read() && (m_index > SIM_DUMMY_INDEX)))
+    {
+        // Host sampling wrong number of lanes sees garbage.
+        out = (sim_output_lanes() == lanes) ? m_array[m_address] : 0xA5U;
+        m_address = (m_address + 1U) % MX25_SIM_SIZE;
+    }
+    else if (CMD_PROGRAM == m_cmd)
+    {
+        // Page buffer wraps, only last page worth of data is kept.
+        const uint32_t offset = (m_address + m_programmed) % MX_PAGE_SIZE;
+        m_page[offset] = in;
+        m_programmed++;
+    }
+    else
+    {
+        // Command without data phase.
+    }
+
+    m_index++;
+    return out;
+}
+
+/** @brief Run command latched in current chip select cycle. */
+static void sim_execute (void)
+{
+    const bool writable = (!m_busy) && (0U != (m_sr & SIM_SR_WEL));
+    const bool write_protected = (MX25_SIM_FAULT_WRITE == m_fault);
+    bool ignored = false;
+
+    if ( (CMD_WREN == m_cmd) && (1U == m_index))
+    {
+        ignored = m_busy || (MX25_SIM_FAULT_WREN == m_fault);
+        m_sr |= (ignored) ? 0U : SIM_SR_WEL;
+    }
+    else if ( (SIM_CMD_WRDI == m_cmd) && (1U == m_index))
+    {
+        ignored = m_busy;
+        m_sr &= (uint8_t) ~ ( (m_busy) ? 0U : SIM_SR_WEL);
+    }
+    else if (CMD_PROGRAM == m_cmd)
+    {
+        ignored = (!writable) || write_protected || (m_index <= SIM_ADDRESS_BYTES)
+                  || (0U == m_programmed);
+
+        if (!ignored)
+        {
+            const uint32_t page = m_address - (m_address % MX_PAGE_SIZE);
+
+            // Programming only clears bits.
+            for (uint32_t ii = 0; ii < MX_PAGE_SIZE; ii++)
+            {
+                m_array[page + ii] &= m_page[ii];
+            }
+
+            m_stats.programs++;
+            m_stats.wraps += ( (m_address % MX_PAGE_SIZE) + m_programmed > MX_PAGE_SIZE)
+                             ? 1U : 0U;
+            sim_start (sim_is_hp() ? MX25_SIM_PP_HP_US : MX25_SIM_PP_LP_US);
+        }
+    }
+    else if ( (CMD_SECTOR_ERASE == m_cmd) && (m_index > SIM_ADDRESS_BYTES))
+    {
+        ignored = (!writable) || write_protected;
+
+        if (!ignored)
+        {
+            memset (&m_array[m_address - (m_address % MX_SECTOR_SIZE)], 0xFF,
+                    MX_SECTOR_SIZE);
+            m_stats.erases++;
+            sim_start (sim_is_hp() ? MX25_SIM_SE_HP_US : MX25_SIM_SE_LP_US);
+        }
+    }
+    else if ( (CMD_CHIP_ERASE == m_cmd) && (1U == m_index))
+    {
+        ignored = !writable;
+
+        if (!ignored)
+        {
+            memset (m_array, 0xFF, sizeof (m_array));
+            sim_start (MX25_SIM_CE_US);
+        }
+    }
+    else if ( (CMD_WRSR == m_cmd) && (m_index > 1U))
+    {
+        ignored = !writable;
+
+        if (!ignored)
+        {
+            m_sr = (uint8_t) ( (m_sr & (uint8_t) ~SIM_SR_WRITABLE)
+                               | (m_wrsr[0] & SIM_SR_WRITABLE));
+            m_cr1 = (m_index > 2U) ? m_wrsr[1] : m_cr1;
+            m_cr2 = (m_index > 3U) ? m_wrsr[2] : m_cr2;
+            m_stats.wrsr++;
+            sim_start (MX25_SIM_WRSR_US);
+        }
+    }
+    else
+    {
+        // Read commands have no effect on deselect.
+    }
+
+    m_stats.ignored += (ignored) ? 1U : 0U;
+}
+
+void mx25_sim_init (void)
+{
+    memset (m_array, 0xFF, sizeof (m_array));
+    memset (&m_stats, 0, sizeof (m_stats));
+    m_now_ns = 0U;
+    m_busy_until_ns = 0U;
+    m_busy = false;
+    m_selected = false;
+    m_sr = 0U;
+    m_cr1 = 0U;
+    m_cr2 = 0U;
+    m_index = 0U;
+    m_lanes = 1U;
+    m_fault = MX25_SIM_FAULT_NONE;
+}
+
+void mx25_sim_fault_set (const mx25_sim_fault_t fault)
+{
+    m_fault = fault;
+}
+
+void mx25_sim_lanes_set (const uint8_t lanes)
+{
+    m_lanes = lanes;
+}
+
+void mx25_sim_select (const bool selected)
+{
+    if (selected && !m_selected)
+    {
+        m_index = 0U;
+        m_stats.commands++;
+    }
+    else if (!selected && m_selected && (0U != m_index))
+    {
+        sim_update();
+        sim_execute();
+    }
+    else
+    {
+        // No edge.
+    }
+
+    m_selected = selected;
+}
+
+void mx25_sim_advance_us (const uint64_t us)
+{
+    m_now_ns += us * 1000ULL;
+    sim_update();
+}
+
+uint64_t mx25_sim_time_us (void)
+{
+    return m_now_ns / 1000ULL;
+}
+
+bool mx25_sim_is_busy (void)
+{
+    sim_update();
+    return m_busy;
+}
+
+const uint8_t * mx25_sim_memory (void)
+{
+    return m_array;
+}
+
+uint8_t mx25_sim_cr2 (void)
+{
+    return m_cr2;
+}
+
+void mx25_sim_stats_get (mx25_sim_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+rd_status_t ri_spi_xfer_blocking_macronix (const uint8_t * tx, const size_t tx_len,
+        uint8_t * rx, const size_t rx_len)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( ( (NULL == tx) && (0U != tx_len)) || ( (NULL == rx) && (0U != rx_len)))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (!m_selected)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        // Bus clocks the longer of buffers, over-read character is 0xFF.
+        const size_t length = (tx_len > rx_len) ? tx_len : rx_len;
+        m_stats.transfers++;
+
+        for (size_t ii = 0; ii < length; ii++)
+        {
+            const uint8_t out = sim_byte ( (ii < tx_len) ? tx[ii] : 0xFFU, 1U);
+
+            if (ii < rx_len)
+            {
+                rx[ii] = out;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+uint8_t ri_spi_data_lanes_macronix (void)
+{
+    return m_lanes;
+}
+
+rd_status_t ri_spi_rx_lanes_macronix (uint8_t * rx, const size_t rx_len,
+                                      const uint8_t lanes)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == rx) && (0U != rx_len))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == lanes) || (lanes > m_lanes))
+    {
+        err_code |= RD_ERROR_NOT_SUPPORTED;
+    }
+    else if (!m_selected)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_stats.transfers++;
+
+        for (size_t ii = 0; ii < rx_len; ii++)
+        {
+            rx[ii] = sim_byte (0xFFU, lanes);
+        }
+    }
+
+    return err_code;
+}
@@ -0,0 +1,89 @@
+#ifndef MX25_SIM_H
+#define MX25_SIM_H
+/**
+ * @file mx25_sim.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * Host model of a Macronix MX25R6435F behind ri_spi_xfer_blocking_macronix.
+ *
+ * Model keeps the memory array, status and configuration registers and a
+ * simulated clock. Bus transfers advance the clock by the time of clocked
+ * bytes, program and erase keep the device busy for their nominal time.
+ * Page program wraps at the page boundary like the real device and commands
+ * sent while the device is busy or without write enable are ignored.
+ * Dual and quad reads return garbage unless host receives on matching lanes.
+ *
+ * Chip select is routed to the model by the test, typically from a
+ * ri_gpio_write stub which calls @ref mx25_sim_select.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MX25_SIM_SIZE         (8UL * 1024UL * 1024UL) //!< Array size, bytes.
+#define MX25_SIM_MANUFACTURER (0xC2U)                 //!< REMS manufacturer ID.
+#define MX25_SIM_DEVICE       (0x17U)                 //!< REMS device ID.
+#define MX25_SIM_SPI_HZ       (8000000UL)             //!< Bus clock.
+#define MX25_SIM_CR2_HP       (0x02U)                 //!< High performance bit.
+
+/** @brief Nominal operation times, high performance and low power mode. */
+#define MX25_SIM_PP_HP_US     (850UL)
+#define MX25_SIM_PP_LP_US     (3200UL)
+#define MX25_SIM_SE_HP_US     (40000UL)
+#define MX25_SIM_SE_LP_US     (60000UL)
+#define MX25_SIM_CE_US        (20000000UL)
+#define MX25_SIM_WRSR_US      (6000UL)
+
+/** @brief Device misbehaviour injected by test. */
+typedef enum
+{
+    MX25_SIM_FAULT_NONE,  //!< Device works normally.
+    MX25_SIM_FAULT_WREN,  //!< Write enable is ignored.
+    MX25_SIM_FAULT_WRITE, //!< Program and erase are ignored like in protected area.
+    MX25_SIM_FAULT_STUCK  //!< Program and erase never finish.
+} mx25_sim_fault_t;
+
+/** @brief Counters of bus and array activity since @ref mx25_sim_init. */
+typedef struct
+{
+    uint32_t bytes;     //!< Bytes clocked on the bus.
+    uint32_t transfers; //!< Calls to ri_spi_xfer_blocking_macronix.
+    uint32_t commands;  //!< Chip select cycles.
+    uint32_t programs;  //!< Accepted page programs.
+    uint32_t erases;    //!< Accepted sector erases.
+    uint32_t wrsr;      //!< Accepted status register writes.
+    uint32_t ignored;   //!< Commands ignored, device busy or write not enabled.
+    uint32_t wraps;     //!< Page programs which wrapped to start of page.
+} mx25_sim_stats_t;
+
+/** @brief Erase array, clear registers, clock and statistics. */
+void mx25_sim_init (void);
+
+/** @brief Inject fault, @ref MX25_SIM_FAULT_NONE after @ref mx25_sim_init. */
+void mx25_sim_fault_set (const mx25_sim_fault_t fault);
+
+/** @brief Data lanes of simulated bus, 1 after @ref mx25_sim_init. */
+void mx25_sim_lanes_set (const uint8_t lanes);
+
+/** @brief Drive chip select, command executes on deselect. */
+void mx25_sim_select (const bool selected);
+
+/** @brief Let time pass without bus activity. */
+void mx25_sim_advance_us (const uint64_t us);
+
+/** @brief Simulated time since @ref mx25_sim_init. */
+uint64_t mx25_sim_time_us (void);
+
+/** @brief True while program, erase or register write is running. */
+bool mx25_sim_is_busy (void);
+
+/** @brief Direct view of memory array for checking results. */
+const uint8_t * mx25_sim_memory (void);
+
+/** @brief Configuration register 2, holds @ref MX25_SIM_CR2_HP. */
+uint8_t mx25_sim_cr2 (void);
+
+void mx25_sim_stats_get (mx25_sim_stats_t * const p_stats);
+
+#endif
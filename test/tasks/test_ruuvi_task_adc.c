@@ -9,6 +9,11 @@
 #include "mock_ruuvi_interface_atomic.h"
 #include "mock_ruuvi_interface_log.h"
 #include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_interface_scheduler.h"
+
+#include <math.h>
+#include <string.h>
 
 static volatile ri_atomic_t m_true = true;
 static volatile ri_atomic_t m_false = false;
@@ -447,4 +452,527 @@ void test_adc_ratiometric_configuration_null (void)
     float sample;
     err_code = rt_adc_ratiometric_sample (NULL, RI_ADC_AIN0, &sample);
     TEST_ASSERT (RD_ERROR_NULL == err_code);
-}
\ No newline at end of file
+}
+static const int16_t m_scan_raw[3] = {3000, 2048, 500};
+static ri_adc_channel_config_t m_scan_configs[3];
+static float m_scan_ratio_vdd;
+
+static rd_status_t scan_configure_cb (uint8_t channel_num,
+                                      ri_adc_pins_config_t * p_pins,
+                                      ri_adc_channel_config_t * p_config,
+                                      int cmock_num_calls)
+{
+    m_scan_configs[channel_num] = *p_config;
+    return RD_SUCCESS;
+}
+
+static rd_status_t scan_raw_cb (int16_t * const p_data, const size_t count,
+                                int cmock_num_calls)
+{
+    memcpy (p_data, m_scan_raw, count * sizeof (int16_t));
+    return RD_SUCCESS;
+}
+
+static rd_status_t scan_absolute_cb (const uint8_t channel_num,
+                                     ri_adc_get_data_t * const p_config,
+                                     const int16_t raw, float * const p_data,
+                                     int cmock_num_calls)
+{
+    *p_data = (raw / 1000.0F) * p_config->divider;
+    return RD_SUCCESS;
+}
+
+static rd_status_t scan_ratio_cb (const uint8_t channel_num,
+                                  ri_adc_get_data_t * const p_config,
+                                  const int16_t raw, float * const p_data,
+                                  int cmock_num_calls)
+{
+    m_scan_ratio_vdd = p_config->vdd;
+    *p_data = raw / 4096.0F;
+    return RD_SUCCESS;
+}
+
+static void scan_uninit_expect (void)
+{
+    ri_adc_stop_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_uninit_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_false);
+}
+
+void test_rt_adc_scan_sample_ok (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_configuration_t configuration = {0};
+    const rt_adc_scan_channel_t channels[3] =
+    {
+        {.handle = RI_ADC_AINVDD, .mode = ABSOLUTE, .divider = 1.0F},
+        {.handle = RI_ADC_AIN1, .mode = RATIOMETRIC, .divider = 1.0F},
+        {.handle = RI_ADC_AIN2, .mode = ABSOLUTE, .divider = 2.0F}
+    };
+    float samples[3] = {0};
+    float vdd = 0;
+    tearDown();
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+
+    for (uint8_t ii = 0; ii < 3; ii++)
+    {
+        ri_adc_mcu_is_valid_ch_ExpectAndReturn (ii, true);
+    }
+
+    ri_adc_configure_StubWithCallback (&scan_configure_cb);
+    ri_adc_scan_raw_data_StubWithCallback (&scan_raw_cb);
+    ri_adc_raw_to_absolute_StubWithCallback (&scan_absolute_cb);
+    ri_adc_raw_to_ratio_StubWithCallback (&scan_ratio_cb);
+    scan_uninit_expect();
+    err_code = rt_adc_scan_sample (&configuration, channels, 3U, samples);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT_EQUAL_FLOAT (3.0F, samples[0]);
+    TEST_ASSERT_EQUAL_FLOAT (0.5F, samples[1]);
+    TEST_ASSERT_EQUAL_FLOAT (1.0F, samples[2]);
+    TEST_ASSERT (RI_ADC_VREF_INTERNAL == m_scan_configs[0].vref);
+    TEST_ASSERT (RI_ADC_VREF_EXTERNAL == m_scan_configs[1].vref);
+    TEST_ASSERT (RI_ADC_VREF_INTERNAL == m_scan_configs[2].vref);
+    // Scanned VDD is used for ratio and is available to application.
+    TEST_ASSERT_EQUAL_FLOAT (3.0F, m_scan_ratio_vdd);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_get (&vdd));
+    TEST_ASSERT_EQUAL_FLOAT (3.0F, vdd);
+    TEST_ASSERT (!rt_adc_is_init());
+    setUp();
+}
+
+void test_rt_adc_scan_sample_repeated_handle (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_configuration_t configuration = {0};
+    const rt_adc_scan_channel_t channels[2] =
+    {
+        {.handle = RI_ADC_AIN1, .mode = ABSOLUTE, .divider = 1.0F},
+        {.handle = RI_ADC_AIN1, .mode = RATIOMETRIC, .divider = 1.0F}
+    };
+    float samples[2] = {0};
+    tearDown();
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_mcu_is_valid_ch_ExpectAndReturn (0, true);
+    ri_adc_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    scan_uninit_expect();
+    err_code = rt_adc_scan_sample (&configuration, channels, 2U, samples);
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == err_code);
+    TEST_ASSERT (isnan (samples[0]));
+    TEST_ASSERT (isnan (samples[1]));
+    TEST_ASSERT (!rt_adc_is_init());
+    setUp();
+}
+
+void test_rt_adc_scan_sample_busy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_configuration_t configuration = {0};
+    const rt_adc_scan_channel_t channel =
+    {
+        .handle = RI_ADC_AINVDD, .mode = ABSOLUTE, .divider = 1.0F
+    };
+    float sample = 0;
+    ri_atomic_flag_ExpectAnyArgsAndReturn (false);
+    err_code = rt_adc_scan_sample (&configuration, &channel, 1U, &sample);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
+    TEST_ASSERT (isnan (sample));
+}
+
+void test_rt_adc_scan_sample_invalid (void)
+{
+    rd_sensor_configuration_t configuration = {0};
+    const rt_adc_scan_channel_t channel =
+    {
+        .handle = RI_ADC_AINVDD, .mode = ABSOLUTE, .divider = 1.0F
+    };
+    float sample = 0;
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_scan_sample (NULL, &channel, 1U, &sample));
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_scan_sample (&configuration, NULL, 1U, &sample));
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_scan_sample (&configuration, &channel, 1U, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_adc_scan_sample (&configuration, &channel, 0U,
+                 &sample));
+}
+
+#define STREAM_COUNT     (8U)  //!< Samples per stream buffer.
+#define STREAM_EVENTS    (4U)  //!< Simulated scheduler queue size.
+#define STREAM_RECEIVED  (128U)
+
+static int16_t m_stream_buffers[2 * STREAM_COUNT];
+static ri_adc_stream_fp_t m_stream_isr;
+static int16_t * m_dma_queue[2]; //!< Buffers queued to simulated ADC.
+static size_t m_dma_queued;
+static size_t m_dma_position;
+static int16_t m_sim_value;      //!< Next sample of simulated source.
+static uint8_t m_events[STREAM_EVENTS][sizeof (uint8_t)];
+static ruuvi_scheduler_event_handler_t m_event_handlers[STREAM_EVENTS];
+static size_t m_events_queued;
+static bool m_scheduler_full;
+static int16_t m_received[STREAM_RECEIVED];
+static size_t m_received_count;
+
+static rd_status_t stream_buffer_put_cb (int16_t * const p_buffer, const size_t count,
+        int cmock_num_calls)
+{
+    rd_status_t err_code = RD_ERROR_BUSY;
+
+    if ( (STREAM_COUNT == count) && (m_dma_queued < 2U))
+    {
+        m_dma_queue[m_dma_queued++] = p_buffer;
+        err_code = RD_SUCCESS;
+    }
+
+    return err_code;
+}
+
+static rd_status_t stream_start_cb (const uint8_t channel_num,
+                                    uint32_t * const p_samplerate_hz,
+                                    const ri_adc_stream_fp_t on_full,
+                                    int cmock_num_calls)
+{
+    m_stream_isr = on_full;
+    *p_samplerate_hz = 10000U;
+    return RD_SUCCESS;
+}
+
+static rd_status_t stream_event_put_cb (const void * const p_event_data,
+                                        const uint16_t event_size,
+                                        const ruuvi_scheduler_event_handler_t handler,
+                                        int cmock_num_calls)
+{
+    rd_status_t err_code = RD_ERROR_NO_MEM;
+
+    if ( (!m_scheduler_full) && (m_events_queued < STREAM_EVENTS))
+    {
+        memcpy (m_events[m_events_queued], p_event_data, event_size);
+        m_event_handlers[m_events_queued++] = handler;
+        err_code = RD_SUCCESS;
+    }
+
+    return err_code;
+}
+
+/** @brief Simulated ADC: write a sawtooth into queued buffers. */
+static void sim_sample (const size_t samples)
+{
+    for (size_t ii = 0; ii < samples; ii++)
+    {
+        if (0U == m_dma_queued)
+        {
+            // No buffer, sample is lost.
+            m_sim_value++;
+        }
+        else
+        {
+            m_dma_queue[0][m_dma_position++] = m_sim_value++;
+
+            if (STREAM_COUNT == m_dma_position)
+            {
+                int16_t * const p_full = m_dma_queue[0];
+                m_dma_queue[0] = m_dma_queue[1];
+                m_dma_queued--;
+                m_dma_position = 0;
+                m_stream_isr (p_full, STREAM_COUNT);
+            }
+        }
+    }
+}
+
+static void sim_scheduler_execute (void)
+{
+    for (size_t ii = 0; ii < m_events_queued; ii++)
+    {
+        m_event_handlers[ii] (m_events[ii], sizeof (uint8_t));
+    }
+
+    m_events_queued = 0;
+}
+
+static void stream_app_cb (const int16_t * const p_samples, const size_t count)
+{
+    for (size_t ii = 0; (ii < count) && (m_received_count < STREAM_RECEIVED); ii++)
+    {
+        m_received[m_received_count++] = p_samples[ii];
+    }
+}
+
+static void stream_start (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_configuration_t configuration = {0};
+    uint32_t rate = 10000U;
+    m_dma_queued = 0;
+    m_dma_position = 0;
+    m_sim_value = 0;
+    m_events_queued = 0;
+    m_scheduler_full = false;
+    m_received_count = 0;
+    tearDown();
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_mcu_is_valid_ch_ExpectAndReturn (0, true);
+    ri_adc_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_stream_buffer_put_StubWithCallback (&stream_buffer_put_cb);
+    ri_adc_stream_start_StubWithCallback (&stream_start_cb);
+    ri_scheduler_event_put_StubWithCallback (&stream_event_put_cb);
+    rd_error_check_Ignore();
+    err_code = rt_adc_stream_start (&configuration, RI_ADC_AIN1, ABSOLUTE, &rate,
+                                    m_stream_buffers, STREAM_COUNT, &stream_app_cb);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (10000U == rate);
+    TEST_ASSERT (2U == m_dma_queued);
+}
+
+static void stream_stop (void)
+{
+    ri_adc_stream_stop_ExpectAndReturn (RD_SUCCESS);
+    scan_uninit_expect();
+    TEST_ASSERT (RD_SUCCESS == rt_adc_stream_stop());
+    setUp();
+}
+
+void test_rt_adc_stream_continuous (void)
+{
+    stream_start();
+
+    for (size_t ii = 0; ii < 8U; ii++)
+    {
+        sim_sample (STREAM_COUNT);
+        sim_scheduler_execute();
+    }
+
+    TEST_ASSERT (64U == m_received_count);
+
+    for (size_t ii = 0; ii < m_received_count; ii++)
+    {
+        TEST_ASSERT (ii == (size_t) m_received[ii]);
+    }
+
+    TEST_ASSERT (0U == rt_adc_stream_overrun_count());
+    stream_stop();
+}
+
+void test_rt_adc_stream_slow_application (void)
+{
+    stream_start();
+    // Both halves fill before application runs, third half is lost.
+    sim_sample (3U * STREAM_COUNT);
+    TEST_ASSERT (1U == rt_adc_stream_overrun_count());
+    sim_scheduler_execute();
+    TEST_ASSERT (2U * STREAM_COUNT == m_received_count);
+    TEST_ASSERT (2U == m_dma_queued);
+    sim_sample (STREAM_COUNT);
+    sim_scheduler_execute();
+    TEST_ASSERT (3U * STREAM_COUNT == m_received_count);
+    // Stream continues after the gap.
+    TEST_ASSERT (3 * STREAM_COUNT == m_received[2U * STREAM_COUNT]);
+    stream_stop();
+}
+
+void test_rt_adc_stream_scheduler_full (void)
+{
+    stream_start();
+    m_scheduler_full = true;
+    sim_sample (STREAM_COUNT);
+    // Buffer is given straight back to ADC.
+    TEST_ASSERT (1U == rt_adc_stream_overrun_count());
+    TEST_ASSERT (2U == m_dma_queued);
+    m_scheduler_full = false;
+    sim_sample (STREAM_COUNT);
+    sim_scheduler_execute();
+    TEST_ASSERT (STREAM_COUNT == m_received_count);
+    TEST_ASSERT (STREAM_COUNT == m_received[0]);
+    stream_stop();
+}
+
+void test_rt_adc_stream_stop_discards_buffers (void)
+{
+    stream_start();
+    sim_sample (STREAM_COUNT);
+    stream_stop();
+    sim_scheduler_execute();
+    TEST_ASSERT (0U == m_received_count);
+}
+
+void test_rt_adc_stream_convert (void)
+{
+    const int16_t raw[2] = {1000, 2000};
+    float volts[2] = {0};
+    stream_start();
+    ri_adc_raw_to_absolute_StubWithCallback (&scan_absolute_cb);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_stream_convert (raw, volts, 2U));
+    TEST_ASSERT_EQUAL_FLOAT (1.0F, volts[0]);
+    TEST_ASSERT_EQUAL_FLOAT (2.0F, volts[1]);
+    stream_stop();
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_adc_stream_convert (raw, volts, 2U));
+}
+
+void test_rt_adc_stream_start_fail (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_configuration_t configuration = {0};
+    uint32_t rate = 1U;
+    tearDown();
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_mcu_is_valid_ch_ExpectAndReturn (0, true);
+    ri_adc_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_stream_buffer_put_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_stream_buffer_put_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_stream_start_ExpectAnyArgsAndReturn (RD_ERROR_NOT_SUPPORTED);
+    ri_adc_stream_stop_ExpectAndReturn (RD_SUCCESS);
+    scan_uninit_expect();
+    err_code = rt_adc_stream_start (&configuration, RI_ADC_AIN1, ABSOLUTE, &rate,
+                                    m_stream_buffers, STREAM_COUNT, &stream_app_cb);
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == err_code);
+    TEST_ASSERT (!rt_adc_is_init());
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_adc_stream_stop());
+    setUp();
+}
+
+void test_rt_adc_stream_start_invalid (void)
+{
+    rd_sensor_configuration_t configuration = {0};
+    uint32_t rate = 10000U;
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_stream_start (&configuration, RI_ADC_AIN1,
+                 ABSOLUTE, &rate, NULL, STREAM_COUNT, &stream_app_cb));
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_stream_start (&configuration, RI_ADC_AIN1,
+                 ABSOLUTE, &rate, m_stream_buffers, STREAM_COUNT, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_adc_stream_start (&configuration,
+                 RI_ADC_AIN1, ABSOLUTE, &rate, m_stream_buffers, 0U, &stream_app_cb));
+}
+
+static uint64_t m_now;
+static float m_converted_vdd;
+static float m_vdd_value;
+
+static uint64_t vdd_timestamp_cb (int cmock_num_calls)
+{
+    return m_now;
+}
+
+static rd_status_t vdd_ratio_cb (uint8_t channel_num, ri_adc_get_data_t * p_config,
+                                 float * p_data, int cmock_num_calls)
+{
+    m_converted_vdd = p_config->vdd;
+    *p_data = 0.5F;
+    return RD_SUCCESS;
+}
+
+static void vdd_ratiometric_sample (const bool refresh)
+{
+    rd_sensor_configuration_t configuration = {0};
+    float sample = 0;
+    tearDown();
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_mcu_is_valid_ch_ExpectAndReturn (0, true);
+    ri_adc_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rd_sensor_timestamp_get_StubWithCallback (&vdd_timestamp_cb);
+
+    if (refresh)
+    {
+        ri_adc_mcu_is_valid_ch_ExpectAndReturn (1, true);
+        ri_adc_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        ri_adc_get_data_absolute_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        ri_adc_get_data_absolute_ReturnThruPtr_p_data (&m_vdd_value);
+    }
+
+    ri_adc_get_data_ratio_StubWithCallback (&vdd_ratio_cb);
+    rd_sensor_data_populate_ExpectAnyArgs ();
+    rd_sensor_data_populate_ReturnThruPtr_target (&m_adc_data);
+    rd_sensor_data_parse_ExpectAnyArgsAndReturn (0.5F);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_ratiometric_sample (&configuration, RI_ADC_AIN0,
+                 &sample));
+}
+
+static void vdd_sample (const float vdd)
+{
+    float sampled = vdd;
+    m_vdd_value = vdd;
+    test_rt_adc_vdd_prepare_ok();
+    ri_adc_get_data_absolute_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_adc_get_data_absolute_ReturnThruPtr_p_data (&sampled);
+    rd_sensor_data_populate_ExpectAnyArgs ();
+    rd_sensor_data_populate_ReturnThruPtr_target (&m_adc_data);
+    rd_sensor_timestamp_get_StubWithCallback (&vdd_timestamp_cb);
+    rd_sensor_data_parse_ExpectAnyArgsAndReturn (vdd);
+    scan_uninit_expect();
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_sample());
+    // Reinitialize for tearDown without resetting cache in setUp.
+    ri_atomic_flag_ExpectAnyArgsAndReturn (true);
+    ri_atomic_flag_ReturnThruPtr_flag (&m_true);
+    ri_adc_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_init());
+}
+
+void test_rt_adc_vdd_cache_refresh_stale (void)
+{
+    float vdd = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_configure (1000U, 0.01F));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_adc_vdd_cache_get (&vdd));
+    m_now = 5000U;
+    m_vdd_value = 2.9F;
+    // Empty cache is read before conversion.
+    vdd_ratiometric_sample (true);
+    TEST_ASSERT_EQUAL_FLOAT (2.9F, m_converted_vdd);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_get (&vdd));
+    TEST_ASSERT_EQUAL_FLOAT (2.9F, vdd);
+    // Fresh cache is used without extra conversion.
+    m_now = 5900U;
+    vdd_ratiometric_sample (false);
+    TEST_ASSERT_EQUAL_FLOAT (2.9F, m_converted_vdd);
+    // Stale cache is read again.
+    m_now = 7000U;
+    m_vdd_value = 2.7F;
+    vdd_ratiometric_sample (true);
+    TEST_ASSERT_EQUAL_FLOAT (2.7F, m_converted_vdd);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_configure (0U, RT_ADC_VDD_THRESHOLD_V));
+}
+
+void test_rt_adc_vdd_cache_opportunistic (void)
+{
+    float vdd = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_configure (1000U, 0.01F));
+    m_now = 100U;
+    vdd_sample (3.0F);
+    // Reading VDD for other reasons keeps cache fresh.
+    m_now = 900U;
+    vdd_sample (3.005F);
+    m_now = 1800U;
+    vdd_ratiometric_sample (false);
+    // Change under threshold does not move compensation.
+    TEST_ASSERT_EQUAL_FLOAT (3.0F, m_converted_vdd);
+    m_now = 1900U;
+    vdd_sample (3.05F);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_get (&vdd));
+    TEST_ASSERT_EQUAL_FLOAT (3.05F, vdd);
+    TEST_ASSERT (RD_SUCCESS == rt_adc_vdd_cache_configure (0U, RT_ADC_VDD_THRESHOLD_V));
+}
+
+void test_rt_adc_vdd_cache_disabled (void)
+{
+    float vdd = 0;
+    m_now = 100U;
+    vdd_sample (3.0F);
+    // Disabled cache is not read before conversion nor used in it.
+    vdd_ratiometric_sample (false);
+    TEST_ASSERT_EQUAL_FLOAT (3.30F, m_converted_vdd);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_adc_vdd_cache_get (&vdd));
+}
+
+void test_rt_adc_vdd_cache_configure_invalid (void)
+{
+    float vdd = 0;
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_adc_vdd_cache_configure (1000U, -0.1F));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_adc_vdd_cache_configure (1000U, NAN));
+    TEST_ASSERT (RD_ERROR_NULL == rt_adc_vdd_cache_get (NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_adc_vdd_cache_get (&vdd));
+}
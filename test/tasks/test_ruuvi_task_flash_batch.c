@@ -0,0 +1,316 @@
+#include "unity.h"
+
+#include "ruuvi_task_flash_batch.h"
+#include "mock_ruuvi_driver_sensor.h"
+
+#include <string.h>
+
+/**
+ * @file test_ruuvi_task_flash_batch.c
+ * @brief Batch records into a log kept in RAM.
+ *
+ * The RAM log stores each write as one entry like FlashDB time series log,
+ * so that number of entries and bytes written can be compared to writing
+ * each record as its own entry. Like FlashDB it rejects entries larger than
+ * maximum entry size of the log.
+ */
+
+#define RAM_LOG_ENTRIES     (32U)  //!< Entries in RAM log.
+#define RAM_LOG_ENTRY_SIZE  RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE //!< Largest entry in RAM log.
+#define BATCH_RECORDS       (8U)   //!< Records per batch in tests.
+#define MAX_AGE_MS          (1000U)
+
+/** @brief Example sensor record. */
+typedef struct
+{
+    uint32_t time_s;
+    int16_t temperature_cc;
+    uint16_t humidity_crh;
+    uint32_t pressure_pa;
+} record_t;
+
+typedef struct
+{
+    uint8_t data[RAM_LOG_ENTRY_SIZE];
+    uint16_t size;
+} ram_log_entry_t;
+
+static ram_log_entry_t m_log[RAM_LOG_ENTRIES];
+static size_t m_log_entries;
+static rd_status_t m_log_error;
+static uint8_t m_buffer[RT_FLASH_BATCH_BUFFER_SIZE (sizeof (record_t), BATCH_RECORDS)];
+static rt_flash_batch_t m_batch;
+static record_t m_unpacked[RAM_LOG_ENTRIES * BATCH_RECORDS];
+static size_t m_unpacked_count;
+
+static rd_status_t ram_log_append (const uint16_t size, const void * data)
+{
+    rd_status_t err_code = m_log_error;
+
+    if (RD_SUCCESS != err_code)
+    {
+        // Simulated flash error.
+    }
+    else if ( (m_log_entries >= RAM_LOG_ENTRIES) || (size > RAM_LOG_ENTRY_SIZE))
+    {
+        // FlashDB returns FDB_WRITE_ERR on too large blob.
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        memcpy (m_log[m_log_entries].data, data, size);
+        m_log[m_log_entries].size = size;
+        m_log_entries++;
+    }
+
+    return err_code;
+}
+
+static rd_status_t record_handler (const void * const p_record, const size_t record_size,
+                                   void * const p_context)
+{
+    TEST_ASSERT_EQUAL (sizeof (record_t), record_size);
+    memcpy (&m_unpacked[m_unpacked_count], p_record, record_size);
+    m_unpacked_count++;
+    return RD_SUCCESS;
+}
+
+static void make_record (record_t * const p_record, const uint32_t index)
+{
+    p_record->time_s = index;
+    p_record->temperature_cc = (int16_t) (2000 + index);
+    p_record->humidity_crh = (uint16_t) (4000U + index);
+    p_record->pressure_pa = 100000U + index;
+}
+
+static void unpack_log (void)
+{
+    for (size_t ii = 0; ii < m_log_entries; ii++)
+    {
+        TEST_ASSERT (RD_SUCCESS == rt_flash_batch_unpack (m_log[ii].data, m_log[ii].size,
+                     &record_handler, NULL));
+    }
+}
+
+void setUp (void)
+{
+    memset (m_log, 0, sizeof (m_log));
+    m_log_entries = 0;
+    m_log_error = RD_SUCCESS;
+    m_unpacked_count = 0;
+    rd_sensor_timestamp_get_IgnoreAndReturn (0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_init (&m_batch, m_buffer, sizeof (m_buffer),
+                 sizeof (record_t), MAX_AGE_MS, &ram_log_append));
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_flash_batch_init_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_init (NULL, m_buffer, sizeof (m_buffer),
+                 sizeof (record_t), MAX_AGE_MS, &ram_log_append));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_init (&m_batch, NULL, sizeof (m_buffer),
+                 sizeof (record_t), MAX_AGE_MS, &ram_log_append));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_init (&m_batch, m_buffer, sizeof (m_buffer),
+                 sizeof (record_t), MAX_AGE_MS, NULL));
+}
+
+void test_rt_flash_batch_init_too_small (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_LENGTH == rt_flash_batch_init (&m_batch, m_buffer,
+                 sizeof (record_t), sizeof (record_t), MAX_AGE_MS, &ram_log_append));
+    TEST_ASSERT (RD_ERROR_INVALID_LENGTH == rt_flash_batch_init (&m_batch, m_buffer,
+                 sizeof (m_buffer), 0, MAX_AGE_MS, &ram_log_append));
+}
+
+void test_rt_flash_batch_init_record_larger_than_entry (void)
+{
+    static uint8_t buffer[2U * RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE];
+    const uint8_t record_size = RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE
+                                - sizeof (rt_flash_batch_header_t) + 1U;
+    TEST_ASSERT (RD_ERROR_INVALID_LENGTH == rt_flash_batch_init (&m_batch, buffer,
+                 sizeof (buffer), record_size, MAX_AGE_MS, &ram_log_append));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_init (&m_batch, buffer, sizeof (buffer),
+                 record_size - 1U, MAX_AGE_MS, &ram_log_append));
+}
+
+/** Buffer larger than log entry is clamped so that every batch fits the log. */
+void test_rt_flash_batch_clamped_to_entry_size (void)
+{
+    static uint8_t buffer[RT_FLASH_BATCH_BUFFER_SIZE (sizeof (record_t), 64U)];
+    const size_t entry_records = (RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE
+                                  - sizeof (rt_flash_batch_header_t)) / sizeof (record_t);
+    const uint32_t records = (uint32_t) (entry_records * 3U) + 1U;
+    record_t record;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_init (&m_batch, buffer, sizeof (buffer),
+                 sizeof (record_t), MAX_AGE_MS, &ram_log_append));
+
+    for (uint32_t ii = 0; ii < records; ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    }
+
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT_EQUAL (4, m_log_entries);
+    TEST_ASSERT_EQUAL (RT_FLASH_BATCH_BUFFER_SIZE (sizeof (record_t), entry_records),
+                       m_log[0].size);
+    TEST_ASSERT (RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE >= m_log[0].size);
+    unpack_log();
+    TEST_ASSERT_EQUAL (records, m_unpacked_count);
+
+    for (uint32_t ii = 0; ii < m_unpacked_count; ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT_EQUAL_MEMORY (&record, &m_unpacked[ii], sizeof (record));
+    }
+}
+
+void test_rt_flash_batch_append_null (void)
+{
+    record_t record;
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_append (NULL, &record));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_append (&m_batch, NULL));
+}
+
+void test_rt_flash_batch_append_uninit (void)
+{
+    rt_flash_batch_t batch = {0};
+    record_t record;
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_flash_batch_append (&batch, &record));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_flash_batch_flush (&batch));
+}
+
+void test_rt_flash_batch_writes_on_size (void)
+{
+    record_t record;
+
+    for (uint32_t ii = 0; ii < (BATCH_RECORDS * 3U); ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    }
+
+    // N records per log entry instead of one.
+    TEST_ASSERT_EQUAL (3, m_log_entries);
+    TEST_ASSERT_EQUAL (sizeof (m_buffer), m_log[0].size);
+    unpack_log();
+    TEST_ASSERT_EQUAL (BATCH_RECORDS * 3U, m_unpacked_count);
+
+    for (uint32_t ii = 0; ii < m_unpacked_count; ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT_EQUAL_MEMORY (&record, &m_unpacked[ii], sizeof (record));
+    }
+}
+
+void test_rt_flash_batch_writes_on_age (void)
+{
+    record_t record;
+    make_record (&record, 0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    rd_sensor_timestamp_get_IgnoreAndReturn (MAX_AGE_MS - 1U);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_poll (&m_batch));
+    TEST_ASSERT_EQUAL (0, m_log_entries);
+    make_record (&record, 1);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT_EQUAL (0, m_log_entries);
+    rd_sensor_timestamp_get_IgnoreAndReturn (MAX_AGE_MS);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_poll (&m_batch));
+    TEST_ASSERT_EQUAL (1, m_log_entries);
+    TEST_ASSERT_EQUAL (RT_FLASH_BATCH_BUFFER_SIZE (sizeof (record_t), 2U), m_log[0].size);
+    rt_flash_batch_header_t header;
+    memcpy (&header, m_log[0].data, sizeof (header));
+    TEST_ASSERT_EQUAL (MAX_AGE_MS, header.age_ms);
+    TEST_ASSERT_EQUAL (2, header.count);
+}
+
+void test_rt_flash_batch_writes_on_append_after_age (void)
+{
+    record_t record;
+    make_record (&record, 0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    rd_sensor_timestamp_get_IgnoreAndReturn (MAX_AGE_MS + 1U);
+    make_record (&record, 1);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT_EQUAL (1, m_log_entries);
+    unpack_log();
+    TEST_ASSERT_EQUAL (2, m_unpacked_count);
+}
+
+void test_rt_flash_batch_no_age_limit (void)
+{
+    record_t record;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_init (&m_batch, m_buffer, sizeof (m_buffer),
+                 sizeof (record_t), 0, &ram_log_append));
+    make_record (&record, 0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    rd_sensor_timestamp_get_IgnoreAndReturn (UINT32_MAX);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_poll (&m_batch));
+    TEST_ASSERT_EQUAL (0, m_log_entries);
+}
+
+void test_rt_flash_batch_flush (void)
+{
+    record_t record;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT_EQUAL (0, m_log_entries);
+    make_record (&record, 0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT_EQUAL (1, m_log_entries);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT_EQUAL (1, m_log_entries);
+}
+
+void test_rt_flash_batch_write_error_keeps_records (void)
+{
+    record_t record;
+    m_log_error = RD_ERROR_INTERNAL;
+
+    for (uint32_t ii = 0; ii < (BATCH_RECORDS - 1U); ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    }
+
+    // Batch becomes full, write fails but record is staged.
+    make_record (&record, BATCH_RECORDS - 1U);
+    TEST_ASSERT (RD_ERROR_INTERNAL == rt_flash_batch_append (&m_batch, &record));
+    // No room for more.
+    make_record (&record, BATCH_RECORDS);
+    TEST_ASSERT (RD_ERROR_NO_MEM & rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT_EQUAL (0, m_log_entries);
+    // Flash recovers, staged records are written on next append.
+    m_log_error = RD_SUCCESS;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT_EQUAL (2, m_log_entries);
+    unpack_log();
+    TEST_ASSERT_EQUAL (BATCH_RECORDS + 1U, m_unpacked_count);
+
+    for (uint32_t ii = 0; ii < m_unpacked_count; ii++)
+    {
+        make_record (&record, ii);
+        TEST_ASSERT_EQUAL_MEMORY (&record, &m_unpacked[ii], sizeof (record));
+    }
+}
+
+void test_rt_flash_batch_unpack_invalid (void)
+{
+    record_t record;
+    make_record (&record, 0);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_append (&m_batch, &record));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_batch_flush (&m_batch));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_unpack (NULL, m_log[0].size,
+                 &record_handler, NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_batch_unpack (m_log[0].data, m_log[0].size,
+                 NULL, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_batch_unpack (m_log[0].data,
+                 m_log[0].size - 1U, &record_handler, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_batch_unpack (m_log[0].data, 2U,
+                 &record_handler, NULL));
+    TEST_ASSERT_EQUAL (0, m_unpacked_count);
+}
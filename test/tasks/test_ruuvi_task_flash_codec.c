@@ -0,0 +1,312 @@
+#include "unity.h"
+
+#include "ruuvi_task_flash_codec.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file test_ruuvi_task_flash_codec.c
+ * @brief Verify round trip of block codec, benchmark compression and throughput.
+ *
+ * Traces are generated to resemble LIS2DH12 logs in milli-g at 10 Hz ... 400 Hz:
+ * tag at rest, tag carried while walking and tag in a vibrating machine.
+ */
+
+#define TRACE_BLOCKS      (256U)   //!< Blocks per trace.
+#define BENCHMARK_ROUNDS  (64U)    //!< Passes over each trace in benchmark.
+#define RAW_SAMPLE_SIZE   (6U)     //!< X, Y, Z as int16.
+
+typedef enum
+{
+    TRACE_REST = 0,
+    TRACE_WALK,
+    TRACE_VIBRATION,
+    TRACE_NUM
+} trace_t;
+
+static const char * const m_trace_names[TRACE_NUM] = {"rest", "walk", "vibration"};
+static rd_sensor_fifo_block_t m_trace[TRACE_BLOCKS];
+static uint32_t m_seed;
+
+/** @brief Deterministic pseudorandom noise in -amplitude ... amplitude. */
+static int32_t noise (const int32_t amplitude)
+{
+    m_seed = (m_seed * 1103515245U) + 12345U;
+    return (int32_t) ( (m_seed >> 16U) % (uint32_t) ( (2 * amplitude) + 1)) - amplitude;
+}
+
+/** @brief Triangle wave approximating a sine, period in samples, amplitude in mg. */
+static int32_t wave (const uint32_t index, const uint32_t period, const int32_t amplitude)
+{
+    const int32_t phase = (int32_t) (index % period);
+    const int32_t half = (int32_t) period / 2;
+    const int32_t ramp = (phase < half) ? phase : (int32_t) period - phase;
+    return ( (4 * amplitude * ramp) / (int32_t) period) - amplitude;
+}
+
+static void trace_generate (const trace_t trace)
+{
+    m_seed = 1U;
+
+    for (uint32_t bb = 0; bb < TRACE_BLOCKS; bb++)
+    {
+        rd_sensor_fifo_block_t * const p_block = &m_trace[bb];
+        memset (p_block, 0, sizeof (rd_sensor_fifo_block_t));
+        p_block->count = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES;
+        p_block->interval_us = (TRACE_VIBRATION == trace) ? 2500U : 10000U;
+        p_block->timestamp_ms = 1000000U + (bb * RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES
+                                             * p_block->interval_us) / 1000U;
+
+        for (uint32_t ss = 0; ss < RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES; ss++)
+        {
+            const uint32_t index = (bb * RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES) + ss;
+
+            switch (trace)
+            {
+                case TRACE_REST:
+                    p_block->x[ss] = (int16_t) (12 + noise (4));
+                    p_block->y[ss] = (int16_t) (-20 + noise (4));
+                    p_block->z[ss] = (int16_t) (1000 + noise (4));
+                    break;
+
+                case TRACE_WALK:
+                    p_block->x[ss] = (int16_t) (wave (index, 50U, 300) + noise (16));
+                    p_block->y[ss] = (int16_t) (wave (index + 12U, 50U, 150) + noise (16));
+                    p_block->z[ss] = (int16_t) (1000 + wave (index, 25U, 400) + noise (16));
+                    break;
+
+                default:
+                    p_block->x[ss] = (int16_t) (wave (index, 7U, 1500) + noise (200));
+                    p_block->y[ss] = (int16_t) (wave (index, 5U, 1500) + noise (200));
+                    p_block->z[ss] = (int16_t) (1000 + wave (index, 3U, 2000) + noise (200));
+                    break;
+            }
+        }
+    }
+}
+
+static void assert_blocks_equal (const rd_sensor_fifo_block_t * const p_expect,
+                                 const rd_sensor_fifo_block_t * const p_actual)
+{
+    TEST_ASSERT_EQUAL (p_expect->count, p_actual->count);
+    TEST_ASSERT (p_expect->timestamp_ms == p_actual->timestamp_ms);
+    TEST_ASSERT_EQUAL (p_expect->interval_us, p_actual->interval_us);
+
+    for (size_t ii = 0; ii < p_expect->count; ii++)
+    {
+        TEST_ASSERT_EQUAL_INT16 (p_expect->x[ii], p_actual->x[ii]);
+        TEST_ASSERT_EQUAL_INT16 (p_expect->y[ii], p_actual->y[ii]);
+        TEST_ASSERT_EQUAL_INT16 (p_expect->z[ii], p_actual->z[ii]);
+    }
+}
+
+static void round_trip (const rd_sensor_fifo_block_t * const p_block)
+{
+    uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    rd_sensor_fifo_block_t decoded;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_codec_encode (p_block, encoded, &size, &samples));
+    TEST_ASSERT_EQUAL (p_block->count, samples);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_codec_decode (encoded, size, &decoded));
+    assert_blocks_equal (p_block, &decoded);
+}
+
+void setUp (void)
+{
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_flash_codec_encode_null (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_encode (NULL, encoded, &size, &samples));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_encode (&block, NULL, &size, &samples));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_encode (&block, encoded, NULL, &samples));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_encode (&block, encoded, &size, NULL));
+}
+
+void test_rt_flash_codec_encode_too_many_samples (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    block.count = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES + 1U;
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_flash_codec_encode (&block, encoded, &size,
+                 &samples));
+}
+
+void test_rt_flash_codec_round_trip_empty (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    block.timestamp_ms = 0x0102030405060708ULL;
+    block.interval_us = 1000000U;
+    round_trip (&block);
+}
+
+void test_rt_flash_codec_round_trip_extremes (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    block.timestamp_ms = UINT64_MAX;
+    block.interval_us = UINT32_MAX;
+    block.count = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES;
+
+    // Largest possible steps between samples wrap around.
+    for (size_t ii = 0; ii < block.count; ii++)
+    {
+        block.x[ii] = (ii & 1U) ? INT16_MAX : INT16_MIN;
+        block.y[ii] = (ii & 1U) ? INT16_MIN : INT16_MAX;
+        block.z[ii] = (int16_t) ( (ii * 4099U) & 0xFFFFU);
+    }
+
+    round_trip (&block);
+}
+
+void test_rt_flash_codec_worst_case_fits (void)
+{
+    rd_sensor_fifo_block_t block = {0};
+    uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    block.interval_us = UINT32_MAX;
+    block.count = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES;
+
+    // Steps of 2^14 are the smallest that need 3 bytes after zig-zag.
+    for (size_t ii = 0; ii < block.count; ii++)
+    {
+        block.x[ii] = (ii & 1U) ? 0 : 0x4000;
+        block.y[ii] = block.x[ii];
+        block.z[ii] = block.x[ii];
+    }
+
+    TEST_ASSERT (RD_SUCCESS == rt_flash_codec_encode (&block, encoded, &size, &samples));
+    TEST_ASSERT_EQUAL (RT_FLASH_CODEC_MAX_SIZE, size);
+}
+
+void test_rt_flash_codec_round_trip_traces (void)
+{
+    for (trace_t trace = TRACE_REST; trace < TRACE_NUM; trace++)
+    {
+        trace_generate (trace);
+
+        for (size_t bb = 0; bb < TRACE_BLOCKS; bb++)
+        {
+            round_trip (&m_trace[bb]);
+        }
+    }
+}
+
+void test_rt_flash_codec_encode_partial (void)
+{
+    uint8_t encoded[64];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    rd_sensor_fifo_block_t decoded;
+    trace_generate (TRACE_VIBRATION);
+    TEST_ASSERT (RD_ERROR_DATA_SIZE == rt_flash_codec_encode (&m_trace[0], encoded, &size,
+                 &samples));
+    TEST_ASSERT (samples > 0U);
+    TEST_ASSERT (samples < RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES);
+    TEST_ASSERT (size <= sizeof (encoded));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_codec_decode (encoded, size, &decoded));
+    TEST_ASSERT_EQUAL (samples, decoded.count);
+    TEST_ASSERT_EQUAL_INT16 (m_trace[0].x[samples - 1U], decoded.x[samples - 1U]);
+}
+
+void test_rt_flash_codec_encode_no_room (void)
+{
+    uint8_t encoded[RT_FLASH_CODEC_HEADER_SIZE + 1U];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0xFFU;
+    trace_generate (TRACE_REST);
+    TEST_ASSERT (RD_ERROR_NO_MEM == rt_flash_codec_encode (&m_trace[0], encoded, &size,
+                 &samples));
+    TEST_ASSERT_EQUAL (0, samples);
+}
+
+void test_rt_flash_codec_decode_invalid (void)
+{
+    uint8_t encoded[RT_FLASH_CODEC_MAX_SIZE];
+    size_t size = sizeof (encoded);
+    uint8_t samples = 0;
+    rd_sensor_fifo_block_t decoded;
+    trace_generate (TRACE_WALK);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_codec_encode (&m_trace[0], encoded, &size, &samples));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_decode (NULL, size, &decoded));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_codec_decode (encoded, size, NULL));
+    // Truncated and padded input.
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_codec_decode (encoded, size - 1U, &decoded));
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_codec_decode (encoded, size + 1U, &decoded));
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_codec_decode (encoded, 4U, &decoded));
+    // Unknown format.
+    encoded[0]++;
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_codec_decode (encoded, size, &decoded));
+    encoded[0]--;
+    // Too many samples.
+    encoded[1] = RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES + 1U;
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_codec_decode (encoded, size, &decoded));
+}
+
+void test_rt_flash_codec_benchmark (void)
+{
+    static uint8_t encoded[TRACE_BLOCKS][RT_FLASH_CODEC_MAX_SIZE];
+    static size_t sizes[TRACE_BLOCKS];
+    rd_sensor_fifo_block_t decoded;
+
+    for (trace_t trace = TRACE_REST; trace < TRACE_NUM; trace++)
+    {
+        size_t encoded_bytes = 0;
+        uint8_t samples = 0;
+        trace_generate (trace);
+        const clock_t encode_start = clock();
+
+        for (size_t rr = 0; rr < BENCHMARK_ROUNDS; rr++)
+        {
+            encoded_bytes = 0;
+
+            for (size_t bb = 0; bb < TRACE_BLOCKS; bb++)
+            {
+                sizes[bb] = RT_FLASH_CODEC_MAX_SIZE;
+                rt_flash_codec_encode (&m_trace[bb], encoded[bb], &sizes[bb], &samples);
+                encoded_bytes += sizes[bb];
+            }
+        }
+
+        const clock_t encode_ticks = clock() - encode_start;
+        const clock_t decode_start = clock();
+
+        for (size_t rr = 0; rr < BENCHMARK_ROUNDS; rr++)
+        {
+            for (size_t bb = 0; bb < TRACE_BLOCKS; bb++)
+            {
+                rt_flash_codec_decode (encoded[bb], sizes[bb], &decoded);
+            }
+        }
+
+        const clock_t decode_ticks = clock() - decode_start;
+        assert_blocks_equal (&m_trace[TRACE_BLOCKS - 1U], &decoded);
+        const double raw_bytes = (double) TRACE_BLOCKS * RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES
+                                 * RAW_SAMPLE_SIZE;
+        const double raw_total = raw_bytes * BENCHMARK_ROUNDS;
+        const double encode_s = (double) encode_ticks / CLOCKS_PER_SEC;
+        const double decode_s = (double) decode_ticks / CLOCKS_PER_SEC;
+        char msg[160];
+        snprintf (msg, sizeof (msg),
+                  "%s: %.2f bytes/sample, ratio %.2f, encode %.1f MB/s, decode %.1f MB/s",
+                  m_trace_names[trace],
+                  (double) encoded_bytes / (TRACE_BLOCKS * RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES),
+                  raw_bytes / (double) encoded_bytes,
+                  (encode_s > 0.0) ? (raw_total / encode_s / 1e6) : 0.0,
+                  (decode_s > 0.0) ? (raw_total / decode_s / 1e6) : 0.0);
+        TEST_MESSAGE (msg);
+    }
+}
@@ -0,0 +1,424 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_task_flash_ringbuffer.h"
+#include "ruuvi_task_flash_codec.h"
+#include "ruuvi_task_stream.h"
+#include "fdb_ram.h"
+#include "mock_fds.h"
+#include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_task_flashdb.h"
+#if RT_MACRONIX_GOVERNOR_ENABLED
+#include "mock_ruuvi_task_macronix_governor.h"
+#endif
+
+#include <string.h>
+
+/**
+ * @file test_ruuvi_task_flash_ringbuffer.c
+ * @brief Write and read time series log on FlashDB kept in RAM.
+ */
+
+#define SPLIT_INTERVAL_US (3333U) //!< Interval which does not divide to ms.
+#define STREAM_PAYLOAD    (6U)    //!< Payload of stream messages, 3 entries.
+
+static fdb_time_t m_now;
+static rd_sensor_fifo_block_t m_read[FDB_RAM_ENTRIES];
+static size_t m_read_count;
+static uint8_t m_delivered[FDB_RAM_ENTRIES]; //!< Payload of entries delivered by range read.
+static size_t m_delivered_count;
+static size_t m_stop_after;  //!< Range callback stops read after this many deliveries.
+
+static fdb_time_t get_time (void)
+{
+    return m_now;
+}
+
+static rd_status_t to_ruuvi_error (fdb_err_t fdb_err, int cmock_num_calls)
+{
+    return (FDB_NO_ERR == fdb_err) ? RD_SUCCESS : RD_ERROR_INTERNAL;
+}
+
+/** Decode each entry as a block. */
+static bool block_cb (fdb_tsl_t tsl, void * arg)
+{
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_block (tsl, &m_read[m_read_count]));
+    m_read_count++;
+    return false;
+}
+
+/** Deliver one byte payload of entry, stop when link is "lost". */
+static bool range_cb (fdb_tsl_t tsl, void * arg)
+{
+    void ** const args = (void **) arg;
+    struct fdb_blob blob;
+    uint8_t payload = 0;
+    bool stop = (m_delivered_count >= m_stop_after);
+
+    if (!stop)
+    {
+        (void) fdb_blob_make (&blob, &payload, sizeof (payload));
+        TEST_ASSERT_EQUAL (1U, fdb_blob_read ( (fdb_db_t) args[0],
+                                              fdb_tsl_to_blob (tsl, &blob)));
+        m_delivered[m_delivered_count] = payload;
+        m_delivered_count++;
+    }
+
+    return stop;
+}
+
+/**
+ * Log entries with payload 0 ... 6 at times
+ * 1000, 2000, 2000, 2000, 3000, 4000, 4000.
+ */
+static void log_write (void)
+{
+    static const fdb_time_t times[] = {1000, 2000, 2000, 2000, 3000, 4000, 4000};
+
+    for (uint8_t ii = 0; ii < (sizeof (times) / sizeof (times[0])); ii++)
+    {
+        m_now = times[ii];
+        TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_write (sizeof (ii), &ii));
+    }
+}
+
+static void assert_delivered (const uint8_t first, const uint8_t last)
+{
+    TEST_ASSERT_EQUAL (last - first + 1U, m_delivered_count);
+
+    for (size_t ii = 0; ii < m_delivered_count; ii++)
+    {
+        TEST_ASSERT_EQUAL (first + ii, m_delivered[ii]);
+    }
+}
+
+static ri_comm_message_t m_sent[FDB_RAM_ENTRIES];
+static size_t m_sent_count;
+
+/** Channel which transmits every message immediately. */
+static rd_status_t channel_send (ri_comm_message_t * const p_msg)
+{
+    memcpy (&m_sent[m_sent_count], p_msg, sizeof (ri_comm_message_t));
+    m_sent_count++;
+    return RD_SUCCESS;
+}
+
+/** Samples far apart so that each takes maximum space in codec. */
+static void block_make (rd_sensor_fifo_block_t * const p_block, const uint8_t count,
+                        const uint32_t interval_us)
+{
+    memset (p_block, 0, sizeof (rd_sensor_fifo_block_t));
+    p_block->count = count;
+    p_block->interval_us = interval_us;
+    p_block->timestamp_ms = 1000003U;
+
+    for (int16_t ii = 0; ii < count; ii++)
+    {
+        const int16_t sign = (ii % 2) ? -1 : 1;
+        p_block->x[ii] = (int16_t) (sign * (8000 + ii));
+        p_block->y[ii] = (int16_t) (-sign * (7000 + ii));
+        p_block->z[ii] = (int16_t) (sign * (6000 + ii));
+    }
+}
+
+void setUp (void)
+{
+    fdb_ram_init();
+    m_now = 1000;
+    m_read_count = 0;
+    m_delivered_count = 0;
+    m_stop_after = SIZE_MAX;
+    m_sent_count = 0;
+    ri_log_Ignore();
+    rt_macronix_high_performance_switch_Ignore();
+    rt_flashdb_to_ruuvi_error_StubWithCallback (&to_ruuvi_error);
+#if RT_MACRONIX_GOVERNOR_ENABLED
+    rt_macronix_governor_work_begin_IgnoreAndReturn (RD_SUCCESS);
+    rt_macronix_governor_work_end_IgnoreAndReturn (RD_SUCCESS);
+#endif
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_create ("log", &get_time, true));
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_flash_ringbuffer_write_block_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_write_block (NULL));
+    TEST_ASSERT_EQUAL (0, fdb_ram_entries());
+}
+
+void test_rt_flash_ringbuffer_write_block_round_trip (void)
+{
+    rd_sensor_fifo_block_t block;
+    block_make (&block, 8U, 10000U);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_write_block (&block));
+    TEST_ASSERT_EQUAL (1, fdb_ram_entries());
+    rt_flash_ringbuffer_read (&block_cb, NULL, NULL);
+    TEST_ASSERT_EQUAL (1, m_read_count);
+    TEST_ASSERT_EQUAL (block.count, m_read[0].count);
+    TEST_ASSERT (block.timestamp_ms == m_read[0].timestamp_ms);
+    TEST_ASSERT_EQUAL (block.interval_us, m_read[0].interval_us);
+    TEST_ASSERT_EQUAL_INT16_ARRAY (block.x, m_read[0].x, block.count);
+    TEST_ASSERT_EQUAL_INT16_ARRAY (block.y, m_read[0].y, block.count);
+    TEST_ASSERT_EQUAL_INT16_ARRAY (block.z, m_read[0].z, block.count);
+}
+
+/** Block which does not fit one entry is split, each part is timed from start of block. */
+void test_rt_flash_ringbuffer_write_block_split (void)
+{
+    rd_sensor_fifo_block_t block;
+    block_make (&block, RD_SENSOR_FIFO_BLOCK_MAX_SAMPLES, SPLIT_INTERVAL_US);
+    TEST_ASSERT (RT_FLASH_CODEC_MAX_SIZE > RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_write_block (&block));
+    TEST_ASSERT (fdb_ram_entries() > 1U);
+    rt_flash_ringbuffer_read (&block_cb, NULL, NULL);
+    TEST_ASSERT_EQUAL (fdb_ram_entries(), m_read_count);
+    size_t first = 0;
+
+    for (size_t ee = 0; ee < m_read_count; ee++)
+    {
+        const rd_sensor_fifo_block_t * const p_part = &m_read[ee];
+        const uint64_t expected_ms = block.timestamp_ms
+                                     + ( ( (uint64_t) first * SPLIT_INTERVAL_US) / 1000U);
+        TEST_ASSERT (expected_ms == p_part->timestamp_ms);
+        TEST_ASSERT_EQUAL (SPLIT_INTERVAL_US, p_part->interval_us);
+        TEST_ASSERT (0U < p_part->count);
+        TEST_ASSERT (first + p_part->count <= block.count);
+        TEST_ASSERT_EQUAL_INT16_ARRAY (&block.x[first], p_part->x, p_part->count);
+        TEST_ASSERT_EQUAL_INT16_ARRAY (&block.y[first], p_part->y, p_part->count);
+        TEST_ASSERT_EQUAL_INT16_ARRAY (&block.z[first], p_part->z, p_part->count);
+        first += p_part->count;
+    }
+
+    TEST_ASSERT_EQUAL (block.count, first);
+}
+
+/** Entry which was not written by write_block is rejected. */
+void test_rt_flash_ringbuffer_read_block_invalid (void)
+{
+    const uint8_t garbage[] = {0xFFU, 0x01U, 0x02U};
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_write (sizeof (garbage), garbage));
+    rd_sensor_fifo_block_t block;
+    struct fdb_tsl tsl = {0};
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_read_block (NULL, &block));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_read_block (&tsl, NULL));
+    tsl.log_len = RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE + 1U;
+    TEST_ASSERT (RD_ERROR_INVALID_DATA == rt_flash_ringbuffer_read_block (&tsl, &block));
+    tsl.log_len = sizeof (garbage);
+    TEST_ASSERT (RD_SUCCESS != rt_flash_ringbuffer_read_block (&tsl, &block));
+}
+
+void test_rt_flash_ringbuffer_read_range_invalid (void)
+{
+    rt_flash_ringbuffer_cursor_t cursor;
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_flash_ringbuffer_read_range (2000, 1000,
+                 &range_cb, NULL, NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_cursor_init (NULL, 0, 1));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_flash_ringbuffer_cursor_init (&cursor, 2, 1));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_cursor_init (&cursor, 0, 1));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_read_cursor (NULL, &range_cb, NULL,
+                 NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_read_cursor (&cursor, NULL, NULL,
+                 NULL));
+}
+
+/** Range bounds are inclusive and cover every entry sharing a timestamp. */
+void test_rt_flash_ringbuffer_read_range_equal_timestamps (void)
+{
+    log_write();
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_range (2000, 3000, &range_cb, NULL,
+                 NULL));
+    assert_delivered (1U, 4U);
+}
+
+void test_rt_flash_ringbuffer_read_range_empty (void)
+{
+    rt_flash_ringbuffer_cursor_t cursor;
+    log_write();
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_range (2001, 2999, &range_cb, NULL,
+                 NULL));
+    TEST_ASSERT_EQUAL (0, m_delivered_count);
+    // Empty log.
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_clear());
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_cursor_init (&cursor, INT32_MIN,
+                 INT32_MAX));
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_cursor (&cursor, &range_cb, NULL,
+                 NULL));
+    TEST_ASSERT_EQUAL (0, m_delivered_count);
+    TEST_ASSERT (cursor.complete);
+}
+
+/** Read interrupted between entries with same timestamp continues without repeats. */
+void test_rt_flash_ringbuffer_read_cursor_resume_equal_timestamps (void)
+{
+    rt_flash_ringbuffer_cursor_t cursor;
+    log_write();
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_cursor_init (&cursor, 0, 5000));
+    m_stop_after = 3U;
+    TEST_ASSERT (RD_STATUS_MORE_AVAILABLE == rt_flash_ringbuffer_read_cursor (&cursor,
+                 &range_cb, NULL, NULL));
+    assert_delivered (0U, 2U);
+    TEST_ASSERT (2000 == cursor.next_ms);
+    TEST_ASSERT_EQUAL (2U, cursor.delivered);
+    TEST_ASSERT_FALSE (cursor.complete);
+    // Entry refused by callback is given first on resume.
+    m_stop_after = 4U;
+    TEST_ASSERT (RD_STATUS_MORE_AVAILABLE == rt_flash_ringbuffer_read_cursor (&cursor,
+                 &range_cb, NULL, NULL));
+    assert_delivered (0U, 3U);
+    m_stop_after = SIZE_MAX;
+    m_sent_count = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_cursor (&cursor, &range_cb, NULL,
+                 NULL));
+    assert_delivered (0U, 6U);
+    TEST_ASSERT (cursor.complete);
+}
+
+/** Read which reached end of log stays complete and delivers nothing more. */
+void test_rt_flash_ringbuffer_read_cursor_end_of_log (void)
+{
+    rt_flash_ringbuffer_cursor_t cursor;
+    log_write();
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_cursor_init (&cursor, 3000, INT32_MAX));
+    // Stopped on last entry.
+    m_stop_after = 2U;
+    TEST_ASSERT (RD_STATUS_MORE_AVAILABLE == rt_flash_ringbuffer_read_cursor (&cursor,
+                 &range_cb, NULL, NULL));
+    assert_delivered (4U, 5U);
+    m_stop_after = SIZE_MAX;
+    m_sent_count = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_cursor (&cursor, &range_cb, NULL,
+                 NULL));
+    assert_delivered (4U, 6U);
+    TEST_ASSERT (cursor.complete);
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_read_cursor (&cursor, &range_cb, NULL,
+                 NULL));
+    assert_delivered (4U, 6U);
+}
+
+void test_rt_flash_ringbuffer_stream_read_invalid (void)
+{
+    rt_flash_ringbuffer_stream_t range = {.from_ms = 2000, .to_ms = 1000};
+    rt_stream_position_t position = RT_STREAM_POSITION_START;
+    uint8_t record[RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE];
+    size_t size = sizeof (record);
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_flash_ringbuffer_stream_read (&range, &position,
+                 record, &size));
+    range.from_ms = 0;
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_stream_read (NULL, &position, record,
+                 &size));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_stream_read (&range, NULL, record,
+                 &size));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_stream_read (&range, &position, NULL,
+                 &size));
+    TEST_ASSERT (RD_ERROR_NULL == rt_flash_ringbuffer_stream_read (&range, &position,
+                 record, NULL));
+    TEST_ASSERT (RD_ERROR_NOT_FOUND == rt_flash_ringbuffer_stream_read (&range, &position,
+                 record, &size));
+    // Entry does not fit.
+    log_write();
+    size = 0;
+    TEST_ASSERT (RD_ERROR_DATA_SIZE == rt_flash_ringbuffer_stream_read (&range, &position,
+                 record, &size));
+    TEST_ASSERT (RT_STREAM_POSITION_START == position);
+}
+
+/** Each read continues from previous entry, also between entries sharing a timestamp. */
+void test_rt_flash_ringbuffer_stream_read_resume (void)
+{
+    rt_flash_ringbuffer_stream_t range = {.from_ms = 2000, .to_ms = INT32_MAX};
+    rt_stream_position_t position = RT_STREAM_POSITION_START;
+    rt_stream_position_t saved = RT_STREAM_POSITION_START;
+    uint8_t record[RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE];
+    log_write();
+
+    for (uint8_t ii = 1U; ii <= 6U; ii++)
+    {
+        size_t size = sizeof (record);
+        TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_stream_read (&range, &position, record,
+                     &size));
+        TEST_ASSERT_EQUAL (1U, size);
+        TEST_ASSERT_EQUAL (ii, record[0]);
+
+        if (2U == ii)
+        {
+            saved = position;
+        }
+    }
+
+    size_t size = sizeof (record);
+    TEST_ASSERT (RD_ERROR_NOT_FOUND == rt_flash_ringbuffer_stream_read (&range, &position,
+                 record, &size));
+    // Restart from position between entries of time 2000.
+    TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_stream_read (&range, &saved, record,
+                 &size));
+    TEST_ASSERT_EQUAL (3U, record[0]);
+}
+
+/** Reading whole log visits each entry a constant number of times. */
+void test_rt_flash_ringbuffer_stream_read_linear (void)
+{
+    rt_flash_ringbuffer_stream_t range = {.from_ms = 0, .to_ms = INT32_MAX};
+    rt_stream_position_t position = RT_STREAM_POSITION_START;
+    uint8_t record[RT_FLASH_RINGBUFFER_ENTRY_MAX_SIZE];
+    const uint32_t entries = FDB_RAM_ENTRIES;
+
+    for (uint8_t ii = 0; ii < entries; ii++)
+    {
+        m_now += 1000;
+        TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_write (sizeof (ii), &ii));
+    }
+
+    for (uint8_t ii = 0; ii < entries; ii++)
+    {
+        size_t size = sizeof (record);
+        TEST_ASSERT (RD_SUCCESS == rt_flash_ringbuffer_stream_read (&range, &position, record,
+                     &size));
+        TEST_ASSERT_EQUAL (ii, record[0]);
+    }
+
+    // Previous entry, delivered entry and entry where read stops.
+    TEST_ASSERT (fdb_ram_visits() <= (3U * entries));
+}
+
+/** Log streamed through a channel, resumed from checkpoint after disconnect. */
+void test_rt_flash_ringbuffer_stream_through_channel (void)
+{
+    rt_flash_ringbuffer_stream_t range = {.from_ms = 0, .to_ms = INT32_MAX};
+    ri_comm_channel_t channel = {0};
+    rt_stream_t stream;
+    channel.send = &channel_send;
+    log_write();
+    TEST_ASSERT (RD_SUCCESS == rt_stream_init (&stream, &channel,
+                 &rt_flash_ringbuffer_stream_read, &range, 1U));
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&stream, RT_STREAM_POSITION_START,
+                 STREAM_PAYLOAD));
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&stream));
+    TEST_ASSERT_EQUAL (2U, m_sent_count);
+    // Second message is lost on disconnect.
+    rt_stream_stop (&stream);
+    m_sent_count = 1U;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&stream, rt_stream_checkpoint_get (&stream),
+                 STREAM_PAYLOAD));
+
+    while (!rt_stream_is_complete (&stream))
+    {
+        TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&stream));
+    }
+
+    uint8_t expected = 0U;
+
+    for (size_t mm = 0; mm < m_sent_count; mm++)
+    {
+        for (size_t pos = 0; pos < m_sent[mm].data_length; pos += 2U)
+        {
+            TEST_ASSERT_EQUAL (1U, m_sent[mm].data[pos]);
+            TEST_ASSERT_EQUAL (expected, m_sent[mm].data[pos + 1U]);
+            expected++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL (7U, expected);
+}
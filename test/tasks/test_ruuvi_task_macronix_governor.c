@@ -0,0 +1,333 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_task_macronix_governor.h"
+#include "ruuvi_task_macronix_queue.h"
+#include "macronix_flash.h"
+#include "mx25_sim.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_gpio.h"
+#include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_scheduler.h"
+#include "mock_ruuvi_interface_timer.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TIMERS_MAX   (2U)
+#define EVENTS_MAX   (16U)
+#define RUN_STEPS    (100000U)
+#define BATCH_SIZE   (16U * 1024U)
+#define BATCH_BASE   (0x80000U)
+
+typedef struct
+{
+    ruuvi_timer_timeout_handler_t isr;
+    uint32_t left_ms;
+    bool armed;
+} timer_sim_t;
+
+static timer_sim_t m_timers[TIMERS_MAX];
+static size_t m_num_timers;
+static ruuvi_scheduler_event_handler_t m_events[EVENTS_MAX];
+static size_t m_num_events;
+static uint8_t m_data[BATCH_SIZE];
+static size_t m_num_done;
+
+static rd_status_t gpio_write_sim (const ri_gpio_id_t pin, const ri_gpio_state_t state,
+                                   int cmock_num_calls)
+{
+    mx25_sim_select (RI_GPIO_LOW == state);
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_create_cb (ri_timer_id_t * p_timer_id,
+                                    ri_timer_mode_t mode,
+                                    ruuvi_timer_timeout_handler_t timeout_handler,
+                                    int cmock_num_calls)
+{
+    TEST_ASSERT (m_num_timers < TIMERS_MAX);
+    m_timers[m_num_timers].isr = timeout_handler;
+    *p_timer_id = &m_timers[m_num_timers];
+    m_num_timers++;
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_start_cb (ri_timer_id_t timer_id, uint32_t ms,
+                                   void * const context, int cmock_num_calls)
+{
+    timer_sim_t * const p_timer = (timer_sim_t *) timer_id;
+    p_timer->left_ms = ms;
+    p_timer->armed = true;
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_stop_cb (ri_timer_id_t timer_id, int cmock_num_calls)
+{
+    ( (timer_sim_t *) timer_id)->armed = false;
+    return RD_SUCCESS;
+}
+
+static rd_status_t event_put_cb (const void * const p_event_data,
+                                 const uint16_t event_size,
+                                 const ruuvi_scheduler_event_handler_t handler,
+                                 int cmock_num_calls)
+{
+    TEST_ASSERT (m_num_events < EVENTS_MAX);
+    m_events[m_num_events] = handler;
+    m_num_events++;
+    return RD_SUCCESS;
+}
+
+static void on_done (const rt_macronix_op_t * const p_op, const rd_status_t result)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, result);
+    m_num_done++;
+}
+
+/** Sleep until first armed timer expires and run its handler. */
+static bool timer_fire_next (void)
+{
+    timer_sim_t * p_next = NULL;
+
+    for (size_t ii = 0; ii < m_num_timers; ii++)
+    {
+        if (m_timers[ii].armed && ( (NULL == p_next)
+                                    || (m_timers[ii].left_ms < p_next->left_ms)))
+        {
+            p_next = &m_timers[ii];
+        }
+    }
+
+    if (NULL != p_next)
+    {
+        const uint32_t elapsed = p_next->left_ms;
+
+        for (size_t ii = 0; ii < m_num_timers; ii++)
+        {
+            m_timers[ii].left_ms -= (m_timers[ii].armed) ? elapsed : 0U;
+        }
+
+        p_next->armed = false;
+        mx25_sim_advance_us (1000U * elapsed);
+        p_next->isr (NULL);
+    }
+
+    return (NULL != p_next);
+}
+
+/** Application main loop: run scheduler, sleep until timer when idle. */
+static void run_until_idle (void)
+{
+    size_t steps = 0;
+    bool active = true;
+
+    while (active && (steps < RUN_STEPS))
+    {
+        if (0U < m_num_events)
+        {
+            const ruuvi_scheduler_event_handler_t handler = m_events[0];
+            m_num_events--;
+            memmove (&m_events[0], &m_events[1], m_num_events * sizeof (m_events[0]));
+            handler (NULL, 0U);
+        }
+        else
+        {
+            active = timer_fire_next();
+        }
+
+        steps++;
+    }
+
+    TEST_ASSERT (steps < RUN_STEPS);
+}
+
+/** Run queue until batch is done, governor timeout is left running. */
+static uint64_t run_batch (void)
+{
+    const uint64_t start = mx25_sim_time_us();
+    const rt_macronix_op_t erase = {.type = RT_MACRONIX_OP_ERASE, .address = BATCH_BASE,
+                                    .length = BATCH_SIZE, .done = &on_done
+                                   };
+    const rt_macronix_op_t program = {.type = RT_MACRONIX_OP_PROGRAM, .address = BATCH_BASE,
+                                      .p_data = m_data, .length = BATCH_SIZE,
+                                      .done = &on_done
+                                     };
+    m_num_done = 0U;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&erase));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&program));
+
+    while (2U > m_num_done)
+    {
+        TEST_ASSERT ( (0U < m_num_events) || timer_fire_next());
+
+        if (0U < m_num_events)
+        {
+            const ruuvi_scheduler_event_handler_t handler = m_events[0];
+            m_num_events--;
+            memmove (&m_events[0], &m_events[1], m_num_events * sizeof (m_events[0]));
+            handler (NULL, 0U);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &mx25_sim_memory() [BATCH_BASE], BATCH_SIZE);
+    return mx25_sim_time_us() - start;
+}
+
+void setUp (void)
+{
+    mx25_sim_init();
+    m_num_events = 0U;
+
+    // Modules keep their timers over uninit.
+    for (size_t ii = 0; ii < m_num_timers; ii++)
+    {
+        m_timers[ii].armed = false;
+    }
+
+    rd_error_check_Ignore();
+    ri_log_Ignore();
+    ri_yield_IgnoreAndReturn (RD_SUCCESS);
+    rd_sensor_timestamp_get_IgnoreAndReturn (0U);
+    ri_gpio_write_StubWithCallback (&gpio_write_sim);
+    ri_timer_is_init_IgnoreAndReturn (true);
+    ri_timer_create_StubWithCallback (&timer_create_cb);
+    ri_timer_start_StubWithCallback (&timer_start_cb);
+    ri_timer_stop_StubWithCallback (&timer_stop_cb);
+    ri_scheduler_event_put_StubWithCallback (&event_put_cb);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_NORMAL));
+    mx_config_cache_invalidate();
+
+    for (size_t ii = 0; ii < BATCH_SIZE; ii++)
+    {
+        m_data[ii] = (uint8_t) (ii * 3U);
+    }
+}
+
+void tearDown (void)
+{
+    rt_macronix_queue_uninit();
+    rt_macronix_governor_uninit();
+}
+
+void test_rt_macronix_governor_not_init (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, rt_macronix_governor_work_begin (1U));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, rt_macronix_governor_work_end (1U));
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+}
+
+void test_rt_macronix_governor_init (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, rt_macronix_governor_init());
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.wrsr);
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+}
+
+void test_rt_macronix_governor_small_work_stays_low_power (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+
+    for (uint32_t ii = 0; ii < (2U * RT_MACRONIX_GOVERNOR_BATCH_OPS); ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_work_begin (1U));
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_work_end (1U));
+    }
+
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, sim.wrsr);
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_FALSE (m_timers[0].armed);
+}
+
+void test_rt_macronix_governor_batch_then_idle (void)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+    TEST_ASSERT_EQUAL (RD_SUCCESS,
+                       rt_macronix_governor_work_begin (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+    TEST_ASSERT_TRUE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_EQUAL_HEX8 (MX25_SIM_CR2_HP, mx25_sim_cr2());
+    // Pending work holds high performance mode.
+    TEST_ASSERT_FALSE (m_timers[0].armed);
+    TEST_ASSERT_EQUAL (RD_SUCCESS,
+                       rt_macronix_governor_work_end (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+    TEST_ASSERT_TRUE (m_timers[0].armed);
+    TEST_ASSERT_EQUAL (RT_MACRONIX_GOVERNOR_IDLE_MS, m_timers[0].left_ms);
+    run_until_idle();
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+}
+
+void test_rt_macronix_governor_batches_within_idle_keep_mode (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+
+    for (uint32_t ii = 0; ii < 5U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS,
+                           rt_macronix_governor_work_begin (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+        TEST_ASSERT_EQUAL (RD_SUCCESS,
+                           rt_macronix_governor_work_end (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+        mx25_sim_advance_us (500U * RT_MACRONIX_GOVERNOR_IDLE_MS);
+    }
+
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    // Init, one switch to high performance and one back.
+    TEST_ASSERT_EQUAL (3U, sim.wrsr);
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+}
+
+void test_rt_macronix_governor_idle_waits_busy_flash (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+    TEST_ASSERT_EQUAL (RD_SUCCESS,
+                       rt_macronix_governor_work_begin (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+    TEST_ASSERT_EQUAL (RD_SUCCESS,
+                       rt_macronix_governor_work_end (RT_MACRONIX_GOVERNOR_BATCH_OPS));
+    // Chip erase which was not reported to governor.
+    mx_spi_ready_for_transfer();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_chip_erase());
+    TEST_ASSERT_TRUE (timer_fire_next());
+    m_events[0] (NULL, 0U);
+    m_num_events = 0U;
+    TEST_ASSERT_TRUE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_TRUE (m_timers[0].armed);
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+    // WRSR was not sent during chip erase.
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+}
+
+/** Queued erase and program batch with and without governor. */
+void test_rt_macronix_governor_queue_batch (void)
+{
+    mx25_sim_stats_t sim;
+    char msg[128];
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_init());
+    const uint64_t low_power_us = run_batch();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_governor_init());
+    const uint64_t governed_us = run_batch();
+    TEST_ASSERT_TRUE (rt_macronix_governor_is_high_performance());
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    snprintf (msg, sizeof (msg), "16 kB erase and program: low power %u us, governed %u us",
+              (unsigned) low_power_us, (unsigned) governed_us);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT (governed_us < ( (low_power_us * 3U) / 4U));
+    TEST_ASSERT_FALSE (rt_macronix_governor_is_high_performance());
+    TEST_ASSERT_EQUAL_HEX8 (0U, mx25_sim_cr2());
+    TEST_ASSERT_EQUAL (3U, sim.wrsr);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+}
@@ -0,0 +1,220 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_task_macronix_preerase.h"
+#include "macronix_flash.h"
+#include "mx25_sim.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_gpio.h"
+#include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_yield.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PART_BASE     (0x40000U)
+#define PART_SECTORS  (8U)
+#define PART_SIZE     (PART_SECTORS * MX_SECTOR_SIZE)
+#define RECORD_SIZE   (100U)
+#define RECORDS       (300U)  //!< About 7 sector rollovers.
+#define IDLE_US       (1000000U)
+
+static uint8_t m_record[RECORD_SIZE];
+static uint32_t m_write_pos;
+static uint64_t m_append_max_us;
+
+static rd_status_t gpio_write_sim (const ri_gpio_id_t pin, const ri_gpio_state_t state,
+                                   int cmock_num_calls)
+{
+    mx25_sim_select (RI_GPIO_LOW == state);
+    return RD_SUCCESS;
+}
+
+static uint64_t timestamp_sim (int cmock_num_calls)
+{
+    return mx25_sim_time_us() / 1000U;
+}
+
+/** Append like time series log: erase next sector when record does not fit. */
+static void log_append (void)
+{
+    const uint64_t start = mx25_sim_time_us();
+
+    if ( (m_write_pos % MX_SECTOR_SIZE) + RECORD_SIZE > MX_SECTOR_SIZE)
+    {
+        m_write_pos += MX_SECTOR_SIZE - (m_write_pos % MX_SECTOR_SIZE);
+
+        if (m_write_pos >= PART_BASE + PART_SIZE)
+        {
+            m_write_pos = PART_BASE;
+        }
+
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (m_write_pos,
+                           MX_SECTOR_SIZE));
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_write (m_write_pos, m_record,
+                       RECORD_SIZE));
+    m_write_pos += RECORD_SIZE;
+    const uint64_t elapsed = mx25_sim_time_us() - start;
+    m_append_max_us = (elapsed > m_append_max_us) ? elapsed : m_append_max_us;
+}
+
+/** Fill partition with old data, format first sector and log records. */
+static void run_log (const bool idle)
+{
+    static uint8_t old[MX_SECTOR_SIZE];
+    memset (old, 0, sizeof (old));
+
+    for (uint32_t ii = 0; ii < PART_SECTORS; ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, mx_write (PART_BASE + (ii * MX_SECTOR_SIZE), old,
+                           sizeof (old)));
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE, MX_SECTOR_SIZE));
+    m_write_pos = PART_BASE;
+    m_append_max_us = 0U;
+
+    for (uint32_t ii = 0; ii < RECORDS; ii++)
+    {
+        memset (m_record, (int) ii, sizeof (m_record));
+        log_append();
+        // Written data must survive background erases.
+        uint8_t check[RECORD_SIZE];
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_read (m_write_pos - RECORD_SIZE,
+                           check, sizeof (check)));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY (m_record, check, sizeof (check));
+
+        if (idle)
+        {
+            (void) rt_macronix_preerase_idle();
+        }
+
+        // Sleep until next sample.
+        mx25_sim_advance_us (IDLE_US);
+    }
+}
+
+void setUp (void)
+{
+    mx25_sim_init();
+    ri_gpio_write_StubWithCallback (&gpio_write_sim);
+    rd_sensor_timestamp_get_StubWithCallback (&timestamp_sim);
+    ri_log_Ignore();
+    ri_yield_IgnoreAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_NORMAL));
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_macronix_preerase_init_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_init (PART_BASE + 1U,
+                       PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_init (PART_BASE,
+                       PART_SIZE + 1U, 1U));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_init (PART_BASE,
+                       PART_SIZE, 0U));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_init (PART_BASE,
+                       PART_SIZE, PART_SECTORS));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_init (PART_BASE,
+                       (RT_MACRONIX_PREERASE_MAX_SECTORS + 1U) * MX_SECTOR_SIZE, 1U));
+}
+
+void test_rt_macronix_preerase_erase_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_erase (PART_BASE + 1U,
+                       MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_erase (PART_BASE,
+                       MX_PAGE_SIZE));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_erase (PART_BASE
+                       - MX_SECTOR_SIZE, MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_erase (PART_BASE,
+                       PART_SIZE + MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_preerase_write (PART_BASE
+                       + PART_SIZE - 1U, m_record, 2U));
+}
+
+void test_rt_macronix_preerase_idle_without_position (void)
+{
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_idle());
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (0U, sim.erases);
+}
+
+void test_rt_macronix_preerase_busy (void)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 2U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE, MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_idle());
+    TEST_ASSERT_EQUAL (RD_ERROR_BUSY, rt_macronix_preerase_idle());
+    TEST_ASSERT_TRUE (mx25_sim_is_busy());
+}
+
+/** Log rolls into sector which is being erased in background. */
+void test_rt_macronix_preerase_erase_waits_background (void)
+{
+    rt_macronix_preerase_stats_t stats;
+    mx25_sim_stats_t sim;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE, MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_idle());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE + MX_SECTOR_SIZE,
+                       MX_SECTOR_SIZE));
+    rt_macronix_preerase_stats_get (&stats);
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, stats.waits);
+    TEST_ASSERT_EQUAL (1U, stats.erases_skipped);
+    TEST_ASSERT_EQUAL (1U, stats.erases_blocking);
+    TEST_ASSERT_EQUAL (2U, sim.erases);
+    TEST_ASSERT_FALSE (mx25_sim_is_busy());
+}
+
+/** Erase of a written sector cannot be skipped. */
+void test_rt_macronix_preerase_written_sector_erased (void)
+{
+    rt_macronix_preerase_stats_t stats;
+    memset (m_record, 0, sizeof (m_record));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_init (PART_BASE, PART_SIZE, 1U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE, MX_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_write (PART_BASE, m_record,
+                       RECORD_SIZE));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_preerase_erase (PART_BASE, MX_SECTOR_SIZE));
+    rt_macronix_preerase_stats_get (&stats);
+    TEST_ASSERT_EQUAL (2U, stats.erases_blocking);
+    TEST_ASSERT_EQUAL_HEX8 (0xFFU, mx25_sim_memory() [PART_BASE]);
+}
+
+void test_rt_macronix_preerase_critical_path (void)
+{
+    rt_macronix_preerase_stats_t before;
+    rt_macronix_preerase_stats_t after;
+    char msg[160];
+    run_log (false);
+    rt_macronix_preerase_stats_get (&before);
+    const uint64_t before_max_us = m_append_max_us;
+    mx25_sim_init();
+    run_log (true);
+    rt_macronix_preerase_stats_get (&after);
+    snprintf (msg, sizeof (msg),
+              "%u records: blocking erases %u -> %u, background %u, "
+              "slowest append %u us -> %u us",
+              RECORDS, (unsigned) before.erases_blocking, (unsigned) after.erases_blocking,
+              (unsigned) after.erases_background, (unsigned) before_max_us,
+              (unsigned) m_append_max_us);
+    TEST_MESSAGE (msg);
+    // Format erase of first sector is always blocking.
+    TEST_ASSERT (before.erases_blocking > 5U);
+    TEST_ASSERT_EQUAL (1U, after.erases_blocking);
+    TEST_ASSERT_EQUAL (before.erases_blocking - 1U, after.erases_skipped);
+    TEST_ASSERT_EQUAL (0U, after.waits);
+    TEST_ASSERT (before_max_us >= MX25_SIM_SE_LP_US);
+    TEST_ASSERT (m_append_max_us < MX25_SIM_SE_LP_US / 4U);
+}
@@ -0,0 +1,519 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_task_macronix_queue.h"
+#include "macronix_flash.h"
+#include "mx25_sim.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_gpio.h"
+#include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_scheduler.h"
+#include "mock_ruuvi_interface_timer.h"
+#include "mock_ruuvi_interface_yield.h"
+#include "mock_ruuvi_task_macronix_governor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define EVENTS_MAX   (16U)
+#define DATA_SIZE    (1000U)
+#define RUN_STEPS    (100000U)
+
+static ruuvi_timer_timeout_handler_t m_isr;
+static uint32_t m_timer_ms;
+static bool m_timer_armed;
+static ruuvi_scheduler_event_handler_t m_events[EVENTS_MAX];
+static size_t m_num_events;
+static bool m_scheduler_full;
+
+static uint8_t m_data[DATA_SIZE];
+static uint8_t m_read[DATA_SIZE];
+static const void * m_done_ops[RT_MACRONIX_QUEUE_LENGTH + 1U];
+static rt_macronix_op_type_t m_done_types[RT_MACRONIX_QUEUE_LENGTH + 1U];
+static rd_status_t m_done_results[RT_MACRONIX_QUEUE_LENGTH + 1U];
+static size_t m_num_done;
+static uint64_t m_handler_max_us;
+static uint32_t m_work_begun;
+static uint32_t m_work_ended;
+static size_t m_num_handled;
+static uint32_t m_work_begun_busy; //!< Operations reported while flash was busy.
+static bool m_switch_on_begin;     //!< Switch flash mode on report like governor.
+
+static rd_status_t gpio_write_sim (const ri_gpio_id_t pin, const ri_gpio_state_t state,
+                                   int cmock_num_calls)
+{
+    mx25_sim_select (RI_GPIO_LOW == state);
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_create_cb (ri_timer_id_t * p_timer_id,
+                                    ri_timer_mode_t mode,
+                                    ruuvi_timer_timeout_handler_t timeout_handler,
+                                    int cmock_num_calls)
+{
+    static uint8_t timer;
+    TEST_ASSERT (RI_TIMER_MODE_SINGLE_SHOT == mode);
+    *p_timer_id = &timer;
+    m_isr = timeout_handler;
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_start_cb (ri_timer_id_t timer_id, uint32_t ms,
+                                   void * const context, int cmock_num_calls)
+{
+    m_timer_ms = ms;
+    m_timer_armed = true;
+    return RD_SUCCESS;
+}
+
+static rd_status_t event_put_cb (const void * const p_event_data,
+                                 const uint16_t event_size,
+                                 const ruuvi_scheduler_event_handler_t handler,
+                                 int cmock_num_calls)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_scheduler_full || (EVENTS_MAX <= m_num_events))
+    {
+        err_code = RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        m_events[m_num_events] = handler;
+        m_num_events++;
+    }
+
+    return err_code;
+}
+
+static rd_status_t work_begin_cb (const uint32_t ops, int cmock_num_calls)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    m_work_begun += ops;
+    m_work_begun_busy += (mx25_sim_is_busy()) ? ops : 0U;
+
+    // Governor switches on batches only.
+    if (m_switch_on_begin && (4U <= ops))
+    {
+        err_code |= mx_high_performance_switch (true);
+    }
+
+    return err_code;
+}
+
+static rd_status_t work_end_cb (const uint32_t ops, int cmock_num_calls)
+{
+    m_work_ended += ops;
+    return RD_SUCCESS;
+}
+
+static void on_done (const rt_macronix_op_t * const p_op, const rd_status_t result)
+{
+    m_done_ops[m_num_done] = p_op->p_context;
+    m_done_types[m_num_done] = p_op->type;
+    m_done_results[m_num_done] = result;
+    m_num_done++;
+}
+
+/** Application main loop: run scheduler, sleep until timer when idle. */
+static void run_until_idle (void)
+{
+    size_t steps = 0;
+
+    while ( ( (0U < m_num_events) || m_timer_armed) && (steps < RUN_STEPS))
+    {
+        if (0U < m_num_events)
+        {
+            const ruuvi_scheduler_event_handler_t handler = m_events[0];
+            m_num_events--;
+            memmove (&m_events[0], &m_events[1], m_num_events * sizeof (m_events[0]));
+            const uint64_t start = mx25_sim_time_us();
+            handler (NULL, 0U);
+            m_num_handled++;
+            const uint64_t elapsed = mx25_sim_time_us() - start;
+            m_handler_max_us = (elapsed > m_handler_max_us) ? elapsed : m_handler_max_us;
+        }
+        else
+        {
+            m_timer_armed = false;
+            mx25_sim_advance_us (1000U * m_timer_ms);
+            m_isr (NULL);
+        }
+
+        steps++;
+    }
+
+    TEST_ASSERT (steps < RUN_STEPS);
+}
+
+/** Run scheduler until flash has started an erase or program. */
+static void run_until_idle_or_erasing (void)
+{
+    while ( (0U < m_num_events) && (!mx25_sim_is_busy()))
+    {
+        const ruuvi_scheduler_event_handler_t handler = m_events[0];
+        m_num_events--;
+        memmove (&m_events[0], &m_events[1], m_num_events * sizeof (m_events[0]));
+        handler (NULL, 0U);
+        m_num_handled++;
+    }
+}
+
+void setUp (void)
+{
+    mx25_sim_init();
+    m_timer_armed = false;
+    m_num_events = 0U;
+    m_scheduler_full = false;
+    m_num_done = 0U;
+    m_handler_max_us = 0U;
+    m_work_begun = 0U;
+    m_work_ended = 0U;
+    m_num_handled = 0U;
+    m_work_begun_busy = 0U;
+    m_switch_on_begin = false;
+    mx_config_cache_invalidate();
+    memset (m_done_ops, 0, sizeof (m_done_ops));
+    rd_error_check_Ignore();
+    ri_log_Ignore();
+    ri_yield_IgnoreAndReturn (RD_SUCCESS);
+    ri_gpio_write_StubWithCallback (&gpio_write_sim);
+    ri_timer_is_init_IgnoreAndReturn (true);
+    ri_timer_create_StubWithCallback (&timer_create_cb);
+    ri_timer_start_StubWithCallback (&timer_start_cb);
+    ri_timer_stop_IgnoreAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_StubWithCallback (&event_put_cb);
+    rt_macronix_governor_work_begin_StubWithCallback (&work_begin_cb);
+    rt_macronix_governor_work_end_StubWithCallback (&work_end_cb);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, mx_read_mode_set (MX_READ_NORMAL));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_init());
+
+    for (size_t ii = 0; ii < DATA_SIZE; ii++)
+    {
+        m_data[ii] = (uint8_t) (ii * 7U);
+    }
+}
+
+void tearDown (void)
+{
+    rt_macronix_queue_uninit();
+}
+
+void test_rt_macronix_queue_init_twice (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, rt_macronix_queue_init());
+}
+
+void test_rt_macronix_queue_submit_not_init (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .length = MX_SECTOR_SIZE};
+    rt_macronix_queue_uninit();
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, rt_macronix_queue_submit (&op));
+}
+
+void test_rt_macronix_queue_submit_invalid (void)
+{
+    rt_macronix_op_t op = {.type = RT_MACRONIX_OP_PROGRAM, .length = 1U};
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, rt_macronix_queue_submit (NULL));
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, rt_macronix_queue_submit (&op));
+    op.p_data = m_data;
+    op.length = 0U;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_queue_submit (&op));
+    op.type = RT_MACRONIX_OP_ERASE;
+    op.length = MX_SECTOR_SIZE;
+    op.address = MX_PAGE_SIZE;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_queue_submit (&op));
+    op.address = 0U;
+    op.length = MX_PAGE_SIZE;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, rt_macronix_queue_submit (&op));
+    TEST_ASSERT_TRUE (rt_macronix_queue_is_idle());
+    TEST_ASSERT_EQUAL (0U, m_num_events);
+}
+
+void test_rt_macronix_queue_full (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .length = MX_SECTOR_SIZE};
+
+    for (size_t ii = 0; ii < RT_MACRONIX_QUEUE_LENGTH; ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    }
+
+    TEST_ASSERT_EQUAL (RD_ERROR_NO_MEM, rt_macronix_queue_submit (&op));
+    TEST_ASSERT_EQUAL (RT_MACRONIX_QUEUE_LENGTH, rt_macronix_queue_pending());
+    // Only first submit starts the queue.
+    TEST_ASSERT_EQUAL (1U, m_num_events);
+}
+
+void test_rt_macronix_queue_scheduler_full (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .length = MX_SECTOR_SIZE,
+                                 .done = &on_done
+                                };
+    m_scheduler_full = true;
+    TEST_ASSERT_EQUAL (RD_ERROR_NO_MEM, rt_macronix_queue_submit (&op));
+    TEST_ASSERT_TRUE (rt_macronix_queue_is_idle());
+    m_scheduler_full = false;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+}
+
+void test_rt_macronix_queue_erase_program_read (void)
+{
+    static const uint8_t tag_erase;
+    static const uint8_t tag_program;
+    static const uint8_t tag_read;
+    mx25_sim_stats_t sim;
+    const uint32_t address = 0x100F0U;
+    rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x10000U,
+                           .length = MX_SECTOR_SIZE, .done = &on_done,
+                           .p_context = (void *) &tag_erase
+                          };
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    op.type = RT_MACRONIX_OP_PROGRAM;
+    op.address = address;
+    op.p_data = m_data;
+    op.length = DATA_SIZE;
+    op.p_context = (void *) &tag_program;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    op.type = RT_MACRONIX_OP_READ;
+    op.p_data = m_read;
+    op.p_context = (void *) &tag_read;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    // Nothing touches flash before scheduler runs.
+    TEST_ASSERT_EQUAL (0U, mx25_sim_time_us());
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (3U, m_num_done);
+    TEST_ASSERT_EQUAL_PTR (&tag_erase, m_done_ops[0]);
+    TEST_ASSERT_EQUAL_PTR (&tag_program, m_done_ops[1]);
+    TEST_ASSERT_EQUAL_PTR (&tag_read, m_done_ops[2]);
+    TEST_ASSERT_EQUAL (RD_SUCCESS,
+                       m_done_results[0] | m_done_results[1] | m_done_results[2]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, m_read, DATA_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &mx25_sim_memory() [address], DATA_SIZE);
+    // 16 bytes to page boundary, 3 full pages and 216 bytes.
+    TEST_ASSERT_EQUAL (5U, sim.programs);
+    TEST_ASSERT_EQUAL (0U, sim.wraps);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+    TEST_ASSERT_TRUE (rt_macronix_queue_is_idle());
+}
+
+static void on_done_chain (const rt_macronix_op_t * const p_op, const rd_status_t result)
+{
+    on_done (p_op, result);
+
+    if (RT_MACRONIX_OP_ERASE == p_op->type)
+    {
+        const rt_macronix_op_t next = {.type = RT_MACRONIX_OP_PROGRAM,
+                                       .address = p_op->address, .p_data = m_data,
+                                       .length = MX_PAGE_SIZE, .done = &on_done
+                                      };
+        TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&next));
+    }
+}
+
+void test_rt_macronix_queue_submit_from_callback (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x3000U,
+                                 .length = MX_SECTOR_SIZE, .done = &on_done_chain
+                                };
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    TEST_ASSERT_EQUAL (2U, m_num_done);
+    TEST_ASSERT_EQUAL (RT_MACRONIX_OP_PROGRAM, m_done_types[1]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &mx25_sim_memory() [0x3000U], MX_PAGE_SIZE);
+}
+
+/** Application is blocked only for bus transfers, not for erase time. */
+void test_rt_macronix_queue_erase_does_not_block (void)
+{
+    mx25_sim_stats_t sim;
+    char msg[128];
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x20000U,
+                                 .length = 4U * MX_SECTOR_SIZE, .done = &on_done
+                                };
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    snprintf (msg, sizeof (msg),
+              "4 sector erase: %u us total, longest scheduler event %u us, %u commands",
+              (unsigned) mx25_sim_time_us(), (unsigned) m_handler_max_us,
+              (unsigned) sim.commands);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+    TEST_ASSERT_EQUAL (4U, sim.erases);
+    TEST_ASSERT (mx25_sim_time_us() >= 4U * MX25_SIM_SE_LP_US);
+    TEST_ASSERT (m_handler_max_us < 100U);
+}
+
+void test_rt_macronix_queue_isr_scheduler_full (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .length = MX_SECTOR_SIZE,
+                                 .done = &on_done
+                                };
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    m_events[0] (NULL, 0U);
+    m_num_events = 0U;
+    TEST_ASSERT_TRUE (m_timer_armed);
+    // Timer is restarted if handler cannot be queued.
+    m_timer_armed = false;
+    m_scheduler_full = true;
+    m_isr (NULL);
+    TEST_ASSERT_TRUE (m_timer_armed);
+    m_scheduler_full = false;
+    run_until_idle();
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+}
+
+/** Page programs and sector erases are reported to governor from handler. */
+void test_rt_macronix_queue_governor_work (void)
+{
+    rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x10000U,
+                           .length = 2U * MX_SECTOR_SIZE, .done = &on_done
+                          };
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    op.type = RT_MACRONIX_OP_PROGRAM;
+    op.address = 0x100F0U;
+    op.p_data = m_data;
+    op.length = DATA_SIZE;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    TEST_ASSERT_EQUAL (0U, m_work_begun);
+    run_until_idle();
+    // 2 sectors and 5 pages.
+    TEST_ASSERT_EQUAL (7U, m_work_begun);
+    TEST_ASSERT_EQUAL (7U, m_work_ended);
+}
+
+void test_rt_macronix_queue_governor_work_uninit (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .length = 3U * MX_SECTOR_SIZE};
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    m_events[0] (NULL, 0U);
+    rt_macronix_queue_uninit();
+    TEST_ASSERT_EQUAL (3U, m_work_begun);
+    TEST_ASSERT_EQUAL (3U, m_work_ended);
+}
+
+/** Program to protected area is ignored by flash, next operation still runs. */
+void test_rt_macronix_queue_program_rejected (void)
+{
+    rt_macronix_op_t op = {.type = RT_MACRONIX_OP_PROGRAM, .address = 0x1000U,
+                           .p_data = m_data, .length = MX_PAGE_SIZE, .done = &on_done
+                          };
+    mx25_sim_fault_set (MX25_SIM_FAULT_WRITE);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    op.type = RT_MACRONIX_OP_READ;
+    op.p_data = m_read;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    TEST_ASSERT_EQUAL (2U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_ERROR_INTERNAL, m_done_results[0]);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, m_done_results[1]);
+    TEST_ASSERT_EACH_EQUAL_HEX8 (0xFFU, m_read, MX_PAGE_SIZE);
+    TEST_ASSERT_TRUE (rt_macronix_queue_is_idle());
+}
+
+void test_rt_macronix_queue_write_enable_rejected (void)
+{
+    mx25_sim_stats_t sim;
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x2000U,
+                                 .length = 2U * MX_SECTOR_SIZE, .done = &on_done
+                                };
+    mx25_sim_fault_set (MX25_SIM_FAULT_WREN);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_ERROR_INTERNAL, m_done_results[0]);
+    // Erase is not sent without write enable.
+    TEST_ASSERT_EQUAL (0U, sim.erases);
+    TEST_ASSERT_EQUAL (1U, sim.ignored);
+}
+
+/** Flash which never finishes fails operation instead of polling forever. */
+void test_rt_macronix_queue_erase_timeout (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x2000U,
+                                 .length = 2U * MX_SECTOR_SIZE, .done = &on_done
+                                };
+    mx25_sim_fault_set (MX25_SIM_FAULT_STUCK);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_ERROR_TIMEOUT, m_done_results[0]);
+    TEST_ASSERT (mx25_sim_time_us() >= 1000U * RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS);
+    TEST_ASSERT (mx25_sim_time_us() < 2000U * RT_MACRONIX_QUEUE_ERASE_TIMEOUT_MS);
+    TEST_ASSERT_TRUE (rt_macronix_queue_is_idle());
+}
+
+void test_rt_macronix_queue_program_timeout (void)
+{
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_PROGRAM, .address = 0x1000U,
+                                 .p_data = m_data, .length = DATA_SIZE, .done = &on_done
+                                };
+    mx25_sim_fault_set (MX25_SIM_FAULT_STUCK);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_ERROR_TIMEOUT, m_done_results[0]);
+    TEST_ASSERT (mx25_sim_time_us() < 2000U * RT_MACRONIX_QUEUE_PROGRAM_TIMEOUT_MS);
+}
+
+/** Large read is split so that other scheduler events run in between. */
+void test_rt_macronix_queue_read_chunked (void)
+{
+    char msg[128];
+    const rt_macronix_op_t op = {.type = RT_MACRONIX_OP_READ, .address = 0x4000U,
+                                 .p_data = m_read, .length = DATA_SIZE, .done = &on_done
+                                };
+    memset (m_read, 0, sizeof (m_read));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    run_until_idle();
+    snprintf (msg, sizeof (msg), "%u byte read: %u scheduler events, longest %u us",
+              (unsigned) DATA_SIZE, (unsigned) m_num_handled, (unsigned) m_handler_max_us);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT_EQUAL (1U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, m_done_results[0]);
+    TEST_ASSERT_EACH_EQUAL_HEX8 (0xFFU, m_read, DATA_SIZE);
+    TEST_ASSERT_EQUAL ( (DATA_SIZE + RT_MACRONIX_QUEUE_READ_CHUNK - 1U)
+                        / RT_MACRONIX_QUEUE_READ_CHUNK, m_num_handled);
+    // Bus runs at 1 byte per us, leave room for command and status bytes.
+    TEST_ASSERT (m_handler_max_us < RT_MACRONIX_QUEUE_READ_CHUNK + 16U);
+}
+
+/** Batch submitted during erase is reported once erase is done, handler never spins. */
+void test_rt_macronix_queue_batch_during_erase (void)
+{
+    mx25_sim_stats_t sim;
+    char msg[128];
+    rt_macronix_op_t op = {.type = RT_MACRONIX_OP_ERASE, .address = 0x30000U,
+                           .length = MX_SECTOR_SIZE, .done = &on_done
+                          };
+    m_switch_on_begin = true;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    // Report and start erase.
+    run_until_idle_or_erasing();
+    TEST_ASSERT_TRUE (mx25_sim_is_busy());
+    op.type = RT_MACRONIX_OP_PROGRAM;
+    op.p_data = m_data;
+    op.length = DATA_SIZE;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_macronix_queue_submit (&op));
+    m_handler_max_us = 0U;
+    run_until_idle();
+    mx25_sim_stats_get (&sim);
+    snprintf (msg, sizeof (msg), "batch during erase: longest scheduler event %u us",
+              (unsigned) m_handler_max_us);
+    TEST_MESSAGE (msg);
+    TEST_ASSERT_EQUAL (2U, m_num_done);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, m_done_results[0] | m_done_results[1]);
+    TEST_ASSERT_EQUAL (1U + 4U, m_work_begun);
+    TEST_ASSERT_EQUAL (0U, m_work_begun_busy);
+    // Longest event is one page transfer, not rest of erase or WRSR.
+    TEST_ASSERT (m_handler_max_us < 1000U);
+    TEST_ASSERT_EQUAL (1U, sim.wrsr);
+    TEST_ASSERT_EQUAL (0U, sim.ignored);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_data, &mx25_sim_memory() [0x30000U], DATA_SIZE);
+}
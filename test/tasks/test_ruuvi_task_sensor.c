@@ -5,6 +5,8 @@
 #include "mock_ruuvi_interface_log.h"
 #include "mock_ruuvi_task_flash.h"
 
+#include <string.h>
+
 void setUp (void)
 {
     ri_log_Ignore();
@@ -92,3 +94,114 @@ void test_rt_sensor_configure_sensor_not_innit (void)
     err_code = rt_sensor_configure (&ctx);
     TEST_ASSERT (RD_ERROR_INVALID_STATE == err_code);
 }
+
+/** Average current is 100 nA per Hz, samplerate 99 is not supported. */
+static rd_status_t mock_cost (const rd_sensor_configuration_t * const p_config,
+                              rd_sensor_cost_t * const p_cost)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (99U == p_config->samplerate)
+    {
+        err_code |= RD_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        p_cost->average_na = 100U * p_config->samplerate;
+    }
+
+    return err_code;
+}
+
+static const rd_sensor_configuration_t m_fast_candidates[] =
+{
+    {.samplerate = 100U}, {.samplerate = 99U}, {.samplerate = 50U}, {.samplerate = 10U}
+};
+
+static const rd_sensor_configuration_t m_slow_candidates[] =
+{
+    {.samplerate = 20U}, {.samplerate = 1U}
+};
+
+static void plan_setup (rt_sensor_ctx_t * const p_ctx, rt_sensor_plan_t * const p_plans)
+{
+    memset (p_ctx, 0, 2 * sizeof (rt_sensor_ctx_t));
+    memset (p_plans, 0, 2 * sizeof (rt_sensor_plan_t));
+    p_ctx[0].sensor.cost_get = &mock_cost;
+    p_ctx[1].sensor.cost_get = &mock_cost;
+    p_plans[0].p_sensor = &p_ctx[0];
+    p_plans[0].p_candidates = m_fast_candidates;
+    p_plans[0].count = sizeof (m_fast_candidates) / sizeof (m_fast_candidates[0]);
+    p_plans[1].p_sensor = &p_ctx[1];
+    p_plans[1].p_candidates = m_slow_candidates;
+    p_plans[1].count = sizeof (m_slow_candidates) / sizeof (m_slow_candidates[0]);
+}
+
+void test_rt_sensor_plan_within_budget (void)
+{
+    rt_sensor_ctx_t ctx[2];
+    rt_sensor_plan_t plans[2];
+    uint32_t total_na = 0;
+    plan_setup (ctx, plans);
+    TEST_ASSERT (RD_SUCCESS == rt_sensor_plan (plans, 2U, 12000U, &total_na));
+    TEST_ASSERT_EQUAL_UINT32 (12000U, total_na);
+    TEST_ASSERT (0U == plans[0].selected);
+    TEST_ASSERT (0U == plans[1].selected);
+    TEST_ASSERT (100U == ctx[0].configuration.samplerate);
+    TEST_ASSERT (20U == ctx[1].configuration.samplerate);
+}
+
+void test_rt_sensor_plan_degrades_largest_saving (void)
+{
+    rt_sensor_ctx_t ctx[2];
+    rt_sensor_plan_t plans[2];
+    uint32_t total_na = 0;
+    plan_setup (ctx, plans);
+    // Fast sensor saves 5000 nA, unsupported candidate is skipped.
+    TEST_ASSERT (RD_SUCCESS == rt_sensor_plan (plans, 2U, 8000U, &total_na));
+    TEST_ASSERT_EQUAL_UINT32 (7000U, total_na);
+    TEST_ASSERT (2U == plans[0].selected);
+    TEST_ASSERT (0U == plans[1].selected);
+    TEST_ASSERT (50U == ctx[0].configuration.samplerate);
+    TEST_ASSERT_EQUAL_UINT32 (5000U, plans[0].average_na);
+    // Both sensors must degrade.
+    plan_setup (ctx, plans);
+    TEST_ASSERT (RD_SUCCESS == rt_sensor_plan (plans, 2U, 1500U, &total_na));
+    TEST_ASSERT_EQUAL_UINT32 (1100U, total_na);
+    TEST_ASSERT (10U == ctx[0].configuration.samplerate);
+    TEST_ASSERT (1U == ctx[1].configuration.samplerate);
+}
+
+void test_rt_sensor_plan_over_budget (void)
+{
+    rt_sensor_ctx_t ctx[2];
+    rt_sensor_plan_t plans[2];
+    uint32_t total_na = 0;
+    plan_setup (ctx, plans);
+    TEST_ASSERT (RD_ERROR_NOT_FOUND == rt_sensor_plan (plans, 2U, 1000U, &total_na));
+    TEST_ASSERT_EQUAL_UINT32 (1100U, total_na);
+    TEST_ASSERT (0U == ctx[0].configuration.samplerate);
+    TEST_ASSERT (0U == ctx[1].configuration.samplerate);
+}
+
+void test_rt_sensor_plan_invalid (void)
+{
+    rt_sensor_ctx_t ctx[2];
+    rt_sensor_plan_t plans[2];
+    const rd_sensor_configuration_t unsupported = {.samplerate = 99U};
+    plan_setup (ctx, plans);
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_plan (NULL, 2U, 1000U, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_sensor_plan (plans, 0U, 1000U, NULL));
+    plans[1].p_candidates = NULL;
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_plan (plans, 2U, 1000U, NULL));
+    plans[1].p_candidates = &unsupported;
+    plans[1].count = 1U;
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == rt_sensor_plan (plans, 2U, 1000U, NULL));
+}
+
+void test_rt_sensor_budget_na (void)
+{
+    // 1000 mAh in 1 year.
+    TEST_ASSERT_EQUAL_UINT32 (114155U, rt_sensor_budget_na (1000U, 365U));
+    TEST_ASSERT_EQUAL_UINT32 (0U, rt_sensor_budget_na (1000U, 0U));
+}
@@ -0,0 +1,373 @@
+#include "unity.h"
+
+#include "ruuvi_driver_error.h"
+#include "ruuvi_driver_sensor.h"
+#include "ruuvi_task_sensor_dsp.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCHMARK_SAMPLES (1000000U) //!< Samples filtered in benchmark.
+
+RT_SENSOR_DSP_DEFINE (m_dsp);
+
+static rd_sensor_t m_sensor;
+static float m_temperature;
+static float m_humidity;
+static uint64_t m_timestamp;
+static rd_status_t m_hw_dsp_code;
+static uint8_t m_hw_dsp;
+static uint8_t m_hw_parameter;
+
+static rd_status_t fake_data_get (rd_sensor_data_t * const p_data)
+{
+    rd_sensor_data_fields_t field = {0};
+    field.datas.temperature_c = 1;
+    rd_sensor_data_set (p_data, field, m_temperature);
+    field.bitfield = 0;
+    field.datas.humidity_rh = 1;
+    rd_sensor_data_set (p_data, field, m_humidity);
+    p_data->timestamp_ms = m_timestamp;
+    return RD_SUCCESS;
+}
+
+/** Hardware supports only DSP_LAST unless test sets m_hw_dsp_code. */
+static rd_status_t fake_dsp_set (uint8_t * dsp, uint8_t * parameter)
+{
+    rd_status_t err_code = m_hw_dsp_code;
+
+    if (RD_SENSOR_DSP_LAST == *dsp)
+    {
+        err_code = RD_SUCCESS;
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        m_hw_dsp = *dsp;
+        m_hw_parameter = *parameter;
+    }
+    else
+    {
+        *parameter = RD_SENSOR_ERR_NOT_SUPPORTED;
+    }
+
+    return err_code;
+}
+
+static rd_status_t fake_dsp_get (uint8_t * dsp, uint8_t * parameter)
+{
+    *dsp = m_hw_dsp;
+    *parameter = m_hw_parameter;
+    return RD_SUCCESS;
+}
+
+static uint64_t fake_timestamp (void)
+{
+    return m_timestamp;
+}
+
+static rd_status_t fake_uninit (rd_sensor_t * p_sensor, rd_bus_t bus, uint8_t handle)
+{
+    return RD_SUCCESS;
+}
+
+void setUp (void)
+{
+    memset (&m_sensor, 0, sizeof (m_sensor));
+    rd_sensor_initialize (&m_sensor);
+    m_sensor.uninit = &fake_uninit;
+    m_sensor.data_get = &fake_data_get;
+    m_sensor.dsp_set = &fake_dsp_set;
+    m_sensor.dsp_get = &fake_dsp_get;
+    m_sensor.provides.datas.temperature_c = 1;
+    m_sensor.provides.datas.humidity_rh = 1;
+    m_temperature = 0.0F;
+    m_humidity = 50.0F;
+    m_timestamp = 0;
+    m_hw_dsp_code = RD_ERROR_NOT_SUPPORTED;
+    m_hw_dsp = RD_SENSOR_DSP_LAST;
+    m_hw_parameter = 1U;
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_timestamp_function_set (&fake_timestamp));
+    TEST_ASSERT (RD_SUCCESS == RT_SENSOR_DSP_ATTACH (m_dsp, &m_sensor));
+}
+
+void tearDown (void)
+{
+    (void) rd_sensor_timestamp_function_set (NULL);
+}
+
+/** Read a new sample of sensor through stage. */
+static void sample (const float temperature, float * const p_temperature,
+                    float * const p_humidity)
+{
+    float values[2] = {0};
+    rd_sensor_data_t data = {0};
+    data.data = values;
+    data.fields.datas.temperature_c = 1;
+    data.fields.datas.humidity_rh = 1;
+    m_temperature = temperature;
+    m_timestamp++;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.data_get (&data));
+    rd_sensor_data_fields_t field = {0};
+    field.datas.temperature_c = 1;
+    *p_temperature = rd_sensor_data_parse (&data, field);
+    field.bitfield = 0;
+    field.datas.humidity_rh = 1;
+    *p_humidity = rd_sensor_data_parse (&data, field);
+}
+
+static void dsp_set_ok (uint8_t dsp, uint8_t parameter, const uint8_t expected)
+{
+    const uint8_t function = dsp;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (function == dsp);
+    TEST_ASSERT_EQUAL_UINT8 (expected, parameter);
+}
+
+void test_rt_sensor_dsp_attach_replaces_functions (void)
+{
+    TEST_ASSERT (&m_dsp_data_get == m_sensor.data_get);
+    TEST_ASSERT (&m_dsp_dsp_set == m_sensor.dsp_set);
+    TEST_ASSERT (&m_dsp_dsp_get == m_sensor.dsp_get);
+    TEST_ASSERT (&fake_data_get == m_dsp.data_get);
+}
+
+void test_rt_sensor_dsp_attach_error (void)
+{
+    rd_sensor_t uninit_sensor = {0};
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == RT_SENSOR_DSP_ATTACH (m_dsp, &m_sensor));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == RT_SENSOR_DSP_ATTACH (m_dsp, &uninit_sensor));
+    TEST_ASSERT (RD_ERROR_NULL == RT_SENSOR_DSP_ATTACH (m_dsp, NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_dsp_attach (NULL, &m_dsp_api, &m_sensor));
+}
+
+void test_rt_sensor_dsp_pass_through (void)
+{
+    float temperature;
+    float humidity;
+    sample (10.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (10.0F, temperature);
+    sample (20.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (20.0F, temperature);
+    TEST_ASSERT_EQUAL_FLOAT (50.0F, humidity);
+}
+
+void test_rt_sensor_dsp_low_pass (void)
+{
+    float temperature;
+    float humidity;
+    dsp_set_ok (RD_SENSOR_DSP_LOW_PASS, 4U, 4U);
+    sample (0.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (0.0F, temperature);
+    sample (16.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (4.0F, temperature);
+    sample (16.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (7.0F, temperature);
+    TEST_ASSERT_EQUAL_FLOAT (50.0F, humidity);
+
+    for (size_t ii = 0; ii < 100U; ii++)
+    {
+        sample (16.0F, &temperature, &humidity);
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT (16.0F, temperature);
+}
+
+void test_rt_sensor_dsp_low_pass_negative (void)
+{
+    float temperature;
+    float humidity;
+    dsp_set_ok (RD_SENSOR_DSP_LOW_PASS, RD_SENSOR_CFG_MAX, 128U);
+    sample (-20.5F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (-20.5F, temperature);
+
+    for (size_t ii = 0; ii < 3000U; ii++)
+    {
+        sample (-30.25F, &temperature, &humidity);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, -30.25F, temperature);
+}
+
+void test_rt_sensor_dsp_high_pass (void)
+{
+    float temperature;
+    float humidity;
+    dsp_set_ok (RD_SENSOR_DSP_HIGH_PASS, 2U, 2U);
+    sample (10.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (0.0F, temperature);
+    TEST_ASSERT_EQUAL_FLOAT (0.0F, humidity);
+    sample (14.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (2.0F, temperature);
+    sample (14.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (1.0F, temperature);
+}
+
+void test_rt_sensor_dsp_oversampling (void)
+{
+    float temperature;
+    float humidity;
+    const float expected[] = {1.0F, 1.5F, 2.0F, 2.5F, 3.5F, 4.5F};
+    dsp_set_ok (RD_SENSOR_DSP_OS, 4U, 4U);
+
+    for (size_t ii = 0; ii < sizeof (expected) / sizeof (expected[0]); ii++)
+    {
+        sample ( (float) (ii + 1U), &temperature, &humidity);
+        TEST_ASSERT_EQUAL_FLOAT (expected[ii], temperature);
+        TEST_ASSERT_EQUAL_FLOAT (50.0F, humidity);
+    }
+}
+
+void test_rt_sensor_dsp_same_sample_filtered_once (void)
+{
+    float values[2] = {0};
+    rd_sensor_data_t data = {0};
+    data.data = values;
+    data.fields.datas.temperature_c = 1;
+    dsp_set_ok (RD_SENSOR_DSP_LOW_PASS, 2U, 2U);
+    m_temperature = 0.0F;
+    m_timestamp = 1U;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.data_get (&data));
+    m_temperature = 8.0F;
+    m_timestamp = 2U;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.data_get (&data));
+    TEST_ASSERT_EQUAL_FLOAT (4.0F, values[0]);
+    TEST_ASSERT (RD_SUCCESS == m_sensor.data_get (&data));
+    TEST_ASSERT_EQUAL_FLOAT (4.0F, values[0]);
+}
+
+/** Samples without timestamp cannot be told apart, software filter is refused. */
+void test_rt_sensor_dsp_no_timestamp (void)
+{
+    uint8_t dsp = RD_SENSOR_DSP_LOW_PASS;
+    uint8_t parameter = 4U;
+    float temperature;
+    float humidity;
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_timestamp_function_set (NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_get (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == dsp);
+    sample (10.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (10.0F, temperature);
+}
+
+void test_rt_sensor_dsp_parameter_resolve (void)
+{
+    uint8_t dsp = RD_SENSOR_DSP_OS;
+    uint8_t parameter = RT_SENSOR_DSP_MAX_SAMPLES + 1U;
+    dsp_set_ok (RD_SENSOR_DSP_LOW_PASS, 5U, 8U);
+    dsp_set_ok (RD_SENSOR_DSP_LOW_PASS, RD_SENSOR_CFG_DEFAULT, 4U);
+    dsp_set_ok (RD_SENSOR_DSP_HIGH_PASS, RD_SENSOR_CFG_MIN, 1U);
+    dsp_set_ok (RD_SENSOR_DSP_OS, 5U, 5U);
+    dsp_set_ok (RD_SENSOR_DSP_OS, RD_SENSOR_CFG_MAX, RT_SENSOR_DSP_MAX_SAMPLES);
+    TEST_ASSERT (RD_ERROR_NOT_SUPPORTED == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == dsp);
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == m_dsp.function);
+}
+
+void test_rt_sensor_dsp_get (void)
+{
+    uint8_t dsp = RD_SENSOR_CFG_NO_CHANGE;
+    uint8_t parameter = RD_SENSOR_CFG_NO_CHANGE;
+    dsp_set_ok (RD_SENSOR_DSP_OS, 8U, 8U);
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_OS == dsp);
+    TEST_ASSERT (8U == parameter);
+    dsp = 0;
+    parameter = 0;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_get (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_OS == dsp);
+    TEST_ASSERT (8U == parameter);
+    TEST_ASSERT (RD_ERROR_NULL == m_sensor.dsp_get (NULL, &parameter));
+}
+
+void test_rt_sensor_dsp_hardware_preferred (void)
+{
+    uint8_t dsp = RD_SENSOR_DSP_LOW_PASS;
+    uint8_t parameter = 4U;
+    float temperature;
+    float humidity;
+    m_hw_dsp_code = RD_SUCCESS;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == m_dsp.function);
+    TEST_ASSERT (RD_SENSOR_DSP_LOW_PASS == m_hw_dsp);
+    dsp = 0;
+    TEST_ASSERT (RD_SUCCESS == m_sensor.dsp_get (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_LOW_PASS == dsp);
+    sample (0.0F, &temperature, &humidity);
+    sample (16.0F, &temperature, &humidity);
+    TEST_ASSERT_EQUAL_FLOAT (16.0F, temperature);
+}
+
+void test_rt_sensor_dsp_software_clears_hardware (void)
+{
+    m_hw_dsp = RD_SENSOR_DSP_LOW_PASS;
+    dsp_set_ok (RD_SENSOR_DSP_OS, 4U, 4U);
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == m_hw_dsp);
+}
+
+void test_rt_sensor_dsp_hardware_error (void)
+{
+    uint8_t dsp = RD_SENSOR_DSP_LOW_PASS;
+    uint8_t parameter = 4U;
+    m_hw_dsp_code = RD_ERROR_INVALID_STATE;
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == m_sensor.dsp_set (&dsp, &parameter));
+    TEST_ASSERT (RD_SENSOR_DSP_LAST == m_dsp.function);
+}
+
+void test_rt_sensor_dsp_benchmark (void)
+{
+    float values[2] = {0};
+    rd_sensor_data_t data = {0};
+    volatile float sink = 0;
+    data.data = values;
+    data.fields.datas.temperature_c = 1;
+    data.fields.datas.humidity_rh = 1;
+    const clock_t raw_start = clock();
+
+    for (size_t ii = 0; ii < BENCHMARK_SAMPLES; ii++)
+    {
+        m_temperature = (float) (ii & 0xFFU);
+        m_timestamp = ii;
+        (void) m_sensor.data_get (&data);
+        sink += values[0];
+    }
+
+    const clock_t raw_ticks = clock() - raw_start;
+    char msg[160];
+    clock_t ticks[3];
+    const uint8_t functions[3] =
+    {
+        RD_SENSOR_DSP_LOW_PASS, RD_SENSOR_DSP_HIGH_PASS, RD_SENSOR_DSP_OS
+    };
+
+    for (size_t ff = 0; ff < 3U; ff++)
+    {
+        dsp_set_ok (functions[ff], RD_SENSOR_CFG_MAX, (RD_SENSOR_DSP_OS == functions[ff])
+                    ? RT_SENSOR_DSP_MAX_SAMPLES : 128U);
+        const clock_t start = clock();
+
+        for (size_t ii = 0; ii < BENCHMARK_SAMPLES; ii++)
+        {
+            m_temperature = (float) (ii & 0xFFU);
+            m_timestamp = ii;
+            (void) m_sensor.data_get (&data);
+            sink += values[0];
+        }
+
+        ticks[ff] = clock() - start;
+    }
+
+    // Two fields per sample.
+    snprintf (msg, sizeof (msg),
+              "%u samples: data_get %.1f ms, low pass %.1f ms, high pass %.1f ms, "
+              "OS %.1f ms",
+              BENCHMARK_SAMPLES,
+              1000.0 * (double) raw_ticks / CLOCKS_PER_SEC,
+              1000.0 * (double) ticks[0] / CLOCKS_PER_SEC,
+              1000.0 * (double) ticks[1] / CLOCKS_PER_SEC,
+              1000.0 * (double) ticks[2] / CLOCKS_PER_SEC);
+    TEST_MESSAGE (msg);
+    (void) sink;
+}
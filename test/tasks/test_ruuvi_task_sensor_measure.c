@@ -0,0 +1,343 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_task_sensor_measure.h"
+#include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_driver_sensor.h"
+#include "mock_ruuvi_interface_scheduler.h"
+#include "mock_ruuvi_interface_timer.h"
+
+#include <string.h>
+
+#define SENSORS (3U)
+
+static rt_sensor_ctx_t m_sensors[SENSORS];
+static rt_sensor_ctx_t * const m_p_sensors[SENSORS] =
+{
+    &m_sensors[0], &m_sensors[1], &m_sensors[2]
+};
+static rt_sensor_measure_t m_measure;
+static uint32_t m_num_timers;
+
+// Fake sensors: 0 is ready at 10 ms, 1 at 30 ms, 2 is blocking.
+static uint64_t m_ready_ms[SENSORS];
+static rd_status_t m_complete[SENSORS];
+static uint8_t m_blocking_samples;
+
+static rt_sensor_ctx_t * m_reported[SENSORS + 1U];
+static rd_status_t m_results[SENSORS + 1U];
+static size_t m_num_reported;
+static rd_status_t m_done_result;
+static size_t m_num_done;
+
+static ruuvi_timer_timeout_handler_t m_isr;
+static void * m_timer_context;
+static uint32_t m_timer_ms;
+static uint8_t m_event[sizeof (void *)];
+static ruuvi_scheduler_event_handler_t m_handler;
+static size_t m_num_events;
+
+static rd_status_t start_0 (uint64_t * const p_ready_ms)
+{
+    *p_ready_ms = m_ready_ms[0];
+    return RD_SUCCESS;
+}
+
+static rd_status_t start_1 (uint64_t * const p_ready_ms)
+{
+    *p_ready_ms = m_ready_ms[1];
+    return RD_SUCCESS;
+}
+
+static rd_status_t start_ni (uint64_t * const p_ready_ms)
+{
+    return RD_ERROR_NOT_INITIALIZED;
+}
+
+static rd_status_t start_is (uint64_t * const p_ready_ms)
+{
+    return RD_ERROR_INVALID_STATE;
+}
+
+static rd_status_t complete_0 (void)
+{
+    return m_complete[0];
+}
+
+static rd_status_t complete_1 (void)
+{
+    return m_complete[1];
+}
+
+static rd_status_t blocking_single (uint8_t * mode)
+{
+    m_blocking_samples++;
+    *mode = RD_SENSOR_CFG_SLEEP;
+    return RD_SUCCESS;
+}
+
+static void on_ready (rt_sensor_ctx_t * const p_sensor, const rd_status_t result)
+{
+    m_reported[m_num_reported] = p_sensor;
+    m_results[m_num_reported] = result;
+    m_num_reported++;
+}
+
+static void on_done (const rd_status_t result)
+{
+    m_done_result = result;
+    m_num_done++;
+}
+
+static rd_status_t timer_create_cb (ri_timer_id_t * p_timer_id,
+                                    ri_timer_mode_t mode,
+                                    ruuvi_timer_timeout_handler_t timeout_handler,
+                                    int cmock_num_calls)
+{
+    static uint8_t timer;
+    TEST_ASSERT (RI_TIMER_MODE_SINGLE_SHOT == mode);
+    m_num_timers++;
+    *p_timer_id = &timer;
+    m_isr = timeout_handler;
+    return RD_SUCCESS;
+}
+
+static rd_status_t timer_start_cb (ri_timer_id_t timer_id, uint32_t ms,
+                                   void * const context, int cmock_num_calls)
+{
+    m_timer_ms = ms;
+    m_timer_context = context;
+    return RD_SUCCESS;
+}
+
+static rd_status_t event_put_cb (const void * const p_event_data,
+                                 const uint16_t event_size,
+                                 const ruuvi_scheduler_event_handler_t handler,
+                                 int cmock_num_calls)
+{
+    TEST_ASSERT (sizeof (m_event) == event_size);
+    memcpy (m_event, p_event_data, event_size);
+    m_handler = handler;
+    m_num_events++;
+    return RD_SUCCESS;
+}
+
+/** Run pending scheduler event at given time. */
+static void run_event (const uint64_t now)
+{
+    TEST_ASSERT (NULL != m_handler);
+    ruuvi_scheduler_event_handler_t handler = m_handler;
+    m_handler = NULL;
+    rd_sensor_timestamp_get_ExpectAndReturn (now);
+    handler (m_event, sizeof (m_event));
+}
+
+/** Fire timer, which queues handler. */
+static void fire_timer (void)
+{
+    TEST_ASSERT (NULL != m_isr);
+    m_isr (m_timer_context);
+}
+
+void setUp (void)
+{
+    memset (m_sensors, 0, sizeof (m_sensors));
+    memset (m_reported, 0, sizeof (m_reported));
+    m_ready_ms[0] = 1010U;
+    m_ready_ms[1] = 1030U;
+    m_complete[0] = RD_SUCCESS;
+    m_complete[1] = RD_SUCCESS;
+    m_blocking_samples = 0;
+    m_num_reported = 0;
+    m_num_done = 0;
+    m_done_result = RD_ERROR_INTERNAL;
+    m_handler = NULL;
+    m_num_events = 0;
+    m_timer_ms = 0;
+    m_sensors[0].sensor.measurement_start = &start_0;
+    m_sensors[0].sensor.measurement_complete = &complete_0;
+    m_sensors[1].sensor.measurement_start = &start_1;
+    m_sensors[1].sensor.measurement_complete = &complete_1;
+    m_sensors[2].sensor.measurement_start = &start_ni;
+    m_sensors[2].sensor.mode_set = &blocking_single;
+    rd_sensor_is_init_IgnoreAndReturn (true);
+    rd_error_check_Ignore();
+    ri_timer_is_init_IgnoreAndReturn (true);
+    ri_timer_create_StubWithCallback (&timer_create_cb);
+    ri_timer_start_StubWithCallback (&timer_start_cb);
+    ri_scheduler_event_put_StubWithCallback (&event_put_cb);
+    rd_status_t err_code = rt_sensor_measure_init (&m_measure, m_p_sensors, SENSORS,
+                           &on_ready, &on_done);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_sensor_measure_init_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_measure_init (NULL, m_p_sensors, SENSORS,
+                 NULL, NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_measure_init (&m_measure, NULL, SENSORS,
+                 NULL, NULL));
+}
+
+void test_rt_sensor_measure_init_keeps_timer (void)
+{
+    const ri_timer_id_t timer = m_measure.timer;
+    const uint32_t timers = m_num_timers;
+    TEST_ASSERT (RD_SUCCESS == rt_sensor_measure_init (&m_measure, m_p_sensors, SENSORS,
+                 &on_ready, &on_done));
+    TEST_ASSERT (timers == m_num_timers);
+    TEST_ASSERT (timer == m_measure.timer);
+}
+
+void test_rt_sensor_measure_init_count (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_sensor_measure_init (&m_measure,
+                 m_p_sensors, 0U, NULL, NULL));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_sensor_measure_init (&m_measure,
+                 m_p_sensors, RT_SENSOR_MEASURE_MAX_SENSORS + 1U, NULL, NULL));
+}
+
+void test_rt_sensor_measure_parallel (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    err_code |= rt_sensor_measure_start (&m_measure);
+    TEST_ASSERT (RD_SUCCESS == err_code);
+    TEST_ASSERT (rt_sensor_measure_is_running (&m_measure));
+    TEST_ASSERT (1U == m_blocking_samples);
+    // Blocking sensor is ready immediately.
+    TEST_ASSERT (1U == m_num_events);
+    run_event (1000U);
+    TEST_ASSERT (1U == m_num_reported);
+    TEST_ASSERT (&m_sensors[2] == m_reported[0]);
+    // Wait for first split-phase sensor.
+    TEST_ASSERT (10U == m_timer_ms);
+    fire_timer();
+    run_event (1010U);
+    TEST_ASSERT (2U == m_num_reported);
+    TEST_ASSERT (&m_sensors[0] == m_reported[1]);
+    TEST_ASSERT (20U == m_timer_ms);
+    fire_timer();
+    run_event (1030U);
+    TEST_ASSERT (3U == m_num_reported);
+    TEST_ASSERT (&m_sensors[1] == m_reported[2]);
+    TEST_ASSERT (RD_SUCCESS == m_results[2]);
+    TEST_ASSERT (1U == m_num_done);
+    TEST_ASSERT (RD_SUCCESS == m_done_result);
+    TEST_ASSERT (!rt_sensor_measure_is_running (&m_measure));
+}
+
+void test_rt_sensor_measure_same_ready_time (void)
+{
+    m_ready_ms[1] = m_ready_ms[0];
+    m_sensors[2].sensor.measurement_start = &start_is;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_sensor_measure_start (&m_measure));
+    TEST_ASSERT (0U == m_blocking_samples);
+    TEST_ASSERT (10U == m_timer_ms);
+    fire_timer();
+    run_event (1011U);
+    TEST_ASSERT (2U == m_num_reported);
+    TEST_ASSERT (1U == m_num_done);
+}
+
+void test_rt_sensor_measure_late_sensor (void)
+{
+    m_sensors[2].sensor.measurement_start = &start_is;
+    m_complete[0] = RD_ERROR_BUSY;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    (void) rt_sensor_measure_start (&m_measure);
+    fire_timer();
+    run_event (1010U);
+    TEST_ASSERT (0U == m_num_reported);
+    m_complete[0] = RD_SUCCESS;
+    TEST_ASSERT (RT_SENSOR_MEASURE_RETRY_MS == m_timer_ms);
+    fire_timer();
+    run_event (1010U + RT_SENSOR_MEASURE_RETRY_MS);
+    TEST_ASSERT (1U == m_num_reported);
+    TEST_ASSERT (RD_SUCCESS == m_results[0]);
+}
+
+void test_rt_sensor_measure_timeout (void)
+{
+    m_sensors[1].sensor.measurement_start = &start_is;
+    m_sensors[2].sensor.measurement_start = &start_is;
+    m_complete[0] = RD_ERROR_BUSY;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    (void) rt_sensor_measure_start (&m_measure);
+    uint64_t now = 1010U;
+
+    for (size_t ii = 0; ii < RT_SENSOR_MEASURE_RETRIES_MAX; ii++)
+    {
+        fire_timer();
+        run_event (now);
+        TEST_ASSERT (0U == m_num_reported);
+        now += RT_SENSOR_MEASURE_RETRY_MS;
+    }
+
+    fire_timer();
+    run_event (now);
+    TEST_ASSERT (1U == m_num_reported);
+    TEST_ASSERT (RD_ERROR_TIMEOUT == m_results[0]);
+    TEST_ASSERT (RD_ERROR_TIMEOUT == m_done_result);
+}
+
+void test_rt_sensor_measure_sensor_error (void)
+{
+    m_complete[1] = RD_ERROR_INTERNAL;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    (void) rt_sensor_measure_start (&m_measure);
+    run_event (1000U);
+    fire_timer();
+    run_event (1030U);
+    TEST_ASSERT (3U == m_num_reported);
+    TEST_ASSERT (RD_ERROR_INTERNAL == m_done_result);
+}
+
+void test_rt_sensor_measure_start_busy (void)
+{
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    (void) rt_sensor_measure_start (&m_measure);
+    TEST_ASSERT (RD_ERROR_BUSY == rt_sensor_measure_start (&m_measure));
+}
+
+void test_rt_sensor_measure_start_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == rt_sensor_measure_start (NULL));
+    TEST_ASSERT (!rt_sensor_measure_is_running (NULL));
+}
+
+void test_rt_sensor_measure_no_sensors_started (void)
+{
+    rd_sensor_is_init_IgnoreAndReturn (false);
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_sensor_measure_start (&m_measure));
+    TEST_ASSERT (!rt_sensor_measure_is_running (&m_measure));
+    TEST_ASSERT (0U == m_num_events);
+}
+
+/** Without timestamps ready time is never reached. */
+void test_rt_sensor_measure_no_timestamp (void)
+{
+    rd_sensor_timestamp_get_ExpectAndReturn (RD_UINT64_INVALID);
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_sensor_measure_start (&m_measure));
+    TEST_ASSERT (!rt_sensor_measure_is_running (&m_measure));
+    TEST_ASSERT (0U == m_blocking_samples);
+    TEST_ASSERT (0U == m_num_events);
+}
+
+void test_rt_sensor_measure_queue_full (void)
+{
+    m_sensors[2].sensor.measurement_start = &start_is;
+    rd_sensor_timestamp_get_ExpectAndReturn (1000U);
+    (void) rt_sensor_measure_start (&m_measure);
+    m_timer_ms = 0;
+    ri_scheduler_event_put_StubWithCallback (NULL);
+    ri_scheduler_event_put_IgnoreAndReturn (RD_ERROR_NO_MEM);
+    fire_timer();
+    TEST_ASSERT (RT_SENSOR_MEASURE_RETRY_MS == m_timer_ms);
+}
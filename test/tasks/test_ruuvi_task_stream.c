@@ -0,0 +1,318 @@
+#include "unity.h"
+
+#include "ruuvi_driver_enabled_modules.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication.h"
+#include "ruuvi_task_stream.h"
+
+#include <string.h>
+
+/**
+ * @file test_ruuvi_task_stream.c
+ * @brief Stream records through a channel with a limited transmit queue.
+ *
+ * Channel queues messages like SoftDevice: send fails with RD_ERROR_RESOURCES
+ * when queue is full, and test "transmits" queued messages by popping them
+ * and calling sent handler of stream.
+ */
+
+#define LOG_RECORDS     (100U) //!< Records in test log.
+#define RECORD_SIZE     (10U)  //!< Bytes per record, header makes 11.
+#define QUEUE_SIZE      (8U)   //!< Messages fitting in channel queue.
+#define PAYLOAD         (64U)  //!< Payload of negotiated MTU.
+#define WINDOW          (3U)   //!< Messages stream keeps in flight.
+
+static ri_comm_channel_t m_channel;
+static rt_stream_t m_stream;
+static ri_comm_message_t m_queue[QUEUE_SIZE];
+static size_t m_queue_head;
+static size_t m_queue_count;
+static size_t m_queue_limit;
+static rd_status_t m_send_error;
+static size_t m_max_queued;
+static uint32_t m_received[LOG_RECORDS * 2U];
+static size_t m_received_count;
+static uint32_t m_log_records;
+static uint8_t m_record_size;
+static uint32_t m_reads;
+
+static rd_status_t channel_send (ri_comm_message_t * const p_msg)
+{
+    rd_status_t err_code = m_send_error;
+
+    if (RD_SUCCESS != err_code)
+    {
+        // Simulated error.
+    }
+    else if (m_queue_count >= m_queue_limit)
+    {
+        err_code |= RD_ERROR_RESOURCES;
+    }
+    else
+    {
+        TEST_ASSERT (p_msg->data_length <= PAYLOAD);
+        memcpy (&m_queue[ (m_queue_head + m_queue_count) % QUEUE_SIZE], p_msg,
+                sizeof (ri_comm_message_t));
+        m_queue_count++;
+        m_max_queued = (m_queue_count > m_max_queued) ? m_queue_count : m_max_queued;
+    }
+
+    return err_code;
+}
+
+/**
+ * @brief Record n has index in first 4 bytes and filler after.
+ *
+ * Position is index of record, reads are counted to verify that stream
+ * continues from position instead of reading from start.
+ */
+static rd_status_t log_read (void * const p_context, rt_stream_position_t * const p_position,
+                             uint8_t * const p_record, size_t * const p_size)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    TEST_ASSERT (&m_log_records == p_context);
+    const uint32_t index = (uint32_t) *p_position;
+    m_reads++;
+
+    if (index >= m_log_records)
+    {
+        err_code |= RD_ERROR_NOT_FOUND;
+    }
+    else
+    {
+        memset (p_record, 0xA5, m_record_size);
+        memcpy (p_record, &index, sizeof (index));
+        *p_size = m_record_size;
+        (*p_position)++;
+    }
+
+    return err_code;
+}
+
+/** @brief Receive one queued message and unpack its records. */
+static void channel_transmit_one (void)
+{
+    TEST_ASSERT (m_queue_count > 0U);
+    const ri_comm_message_t * const p_msg = &m_queue[m_queue_head];
+    size_t pos = 0;
+
+    while (pos < p_msg->data_length)
+    {
+        const uint8_t size = p_msg->data[pos];
+        TEST_ASSERT_EQUAL (m_record_size, size);
+        memcpy (&m_received[m_received_count], &p_msg->data[pos + 1U], sizeof (uint32_t));
+        m_received_count++;
+        pos += 1U + size;
+    }
+
+    TEST_ASSERT_EQUAL (p_msg->data_length, pos);
+    m_queue_head = (m_queue_head + 1U) % QUEUE_SIZE;
+    m_queue_count--;
+}
+
+/** @brief Transmit all queued messages, notifying stream after each. */
+static void channel_run (void)
+{
+    while (m_queue_count > 0U)
+    {
+        channel_transmit_one();
+        TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    }
+}
+
+static void channel_disconnect (void)
+{
+    m_queue_head = 0;
+    m_queue_count = 0;
+    rt_stream_stop (&m_stream);
+}
+
+void setUp (void)
+{
+    memset (&m_channel, 0, sizeof (m_channel));
+    m_channel.send = &channel_send;
+    m_queue_head = 0;
+    m_queue_count = 0;
+    m_queue_limit = QUEUE_SIZE;
+    m_send_error = RD_SUCCESS;
+    m_max_queued = 0;
+    m_received_count = 0;
+    m_log_records = LOG_RECORDS;
+    m_record_size = RECORD_SIZE;
+    m_reads = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_init (&m_stream, &m_channel, &log_read,
+                 &m_log_records, WINDOW));
+}
+
+void tearDown (void)
+{
+}
+
+void test_rt_stream_init_null (void)
+{
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_init (NULL, &m_channel, &log_read, NULL, WINDOW));
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_init (&m_stream, NULL, &log_read, NULL, WINDOW));
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_init (&m_stream, &m_channel, NULL, NULL, WINDOW));
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_start (NULL, 0, PAYLOAD));
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_on_sent (NULL));
+    TEST_ASSERT (RD_ERROR_NULL == rt_stream_process (NULL));
+}
+
+void test_rt_stream_init_window (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_stream_init (&m_stream, &m_channel, &log_read,
+                 &m_log_records, 0));
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rt_stream_init (&m_stream, &m_channel, &log_read,
+                 &m_log_records, RT_STREAM_WINDOW_MAX + 1U));
+}
+
+void test_rt_stream_start_uninit (void)
+{
+    rt_stream_t stream = {0};
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_stream_start (&stream, 0, PAYLOAD));
+}
+
+void test_rt_stream_start_payload (void)
+{
+    TEST_ASSERT (RD_ERROR_INVALID_LENGTH == rt_stream_start (&m_stream, 0,
+                 RT_STREAM_RECORD_HEADER_SIZE));
+    TEST_ASSERT (RD_ERROR_INVALID_LENGTH == rt_stream_start (&m_stream, 0,
+                 RI_COMM_MESSAGE_MAX_LENGTH + 1U));
+}
+
+void test_rt_stream_window_limits_queue (void)
+{
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    // Channel has room for more, stream stops at window.
+    TEST_ASSERT_EQUAL (WINDOW, m_queue_count);
+    channel_transmit_one();
+    TEST_ASSERT_EQUAL (WINDOW - 1U, m_queue_count);
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    TEST_ASSERT_EQUAL (WINDOW, m_queue_count);
+    channel_run();
+    TEST_ASSERT_EQUAL (WINDOW, m_max_queued);
+}
+
+void test_rt_stream_packs_records (void)
+{
+    const size_t per_msg = PAYLOAD / (RECORD_SIZE + RT_STREAM_RECORD_HEADER_SIZE);
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (per_msg * (RECORD_SIZE + RT_STREAM_RECORD_HEADER_SIZE),
+                       m_queue[0].data_length);
+    TEST_ASSERT_EQUAL (1, m_queue[0].repeat_count);
+    channel_run();
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT_EQUAL (LOG_RECORDS, m_received_count);
+    TEST_ASSERT_EQUAL (LOG_RECORDS, rt_stream_checkpoint_get (&m_stream));
+    // Each record is read once, plus the read which found end of records.
+    TEST_ASSERT_EQUAL (LOG_RECORDS + 1U, m_reads);
+
+    for (uint32_t ii = 0; ii < LOG_RECORDS; ii++)
+    {
+        TEST_ASSERT_EQUAL (ii, m_received[ii]);
+    }
+}
+
+void test_rt_stream_checkpoint_follows_sent (void)
+{
+    const size_t per_msg = PAYLOAD / (RECORD_SIZE + RT_STREAM_RECORD_HEADER_SIZE);
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (0, rt_stream_checkpoint_get (&m_stream));
+    channel_transmit_one();
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    TEST_ASSERT_EQUAL (per_msg, rt_stream_checkpoint_get (&m_stream));
+    TEST_ASSERT_FALSE (rt_stream_is_complete (&m_stream));
+}
+
+void test_rt_stream_channel_full_retries (void)
+{
+    m_queue_limit = 1U;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (1, m_queue_count);
+    channel_run();
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT_EQUAL (LOG_RECORDS, m_received_count);
+
+    for (uint32_t ii = 0; ii < LOG_RECORDS; ii++)
+    {
+        TEST_ASSERT_EQUAL (ii, m_received[ii]);
+    }
+}
+
+void test_rt_stream_process_retries_full_channel (void)
+{
+    m_queue_limit = 0U;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (0, m_queue_count);
+    m_queue_limit = QUEUE_SIZE;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_process (&m_stream));
+    TEST_ASSERT_EQUAL (WINDOW, m_queue_count);
+}
+
+void test_rt_stream_resume_after_disconnect (void)
+{
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    channel_transmit_one();
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    channel_transmit_one();
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    // Link lost with messages queued, sent events for them never arrive.
+    const rt_stream_position_t checkpoint = rt_stream_checkpoint_get (&m_stream);
+    const size_t received = m_received_count;
+    channel_disconnect();
+    TEST_ASSERT_EQUAL (checkpoint, rt_stream_checkpoint_get (&m_stream));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, rt_stream_on_sent (&m_stream));
+    TEST_ASSERT_EQUAL (0, m_queue_count);
+    // Reconnect with a smaller MTU.
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, checkpoint, 24U));
+    channel_run();
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT_EQUAL (checkpoint, received);
+    TEST_ASSERT_EQUAL (LOG_RECORDS, m_received_count);
+
+    for (uint32_t ii = 0; ii < LOG_RECORDS; ii++)
+    {
+        TEST_ASSERT_EQUAL (ii, m_received[ii]);
+    }
+}
+
+void test_rt_stream_disconnect_at_end_is_not_complete (void)
+{
+    m_log_records = 4U;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_FALSE (rt_stream_is_complete (&m_stream));
+    channel_disconnect();
+    TEST_ASSERT_FALSE (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    channel_run();
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT_EQUAL (4, m_received_count);
+}
+
+void test_rt_stream_empty_log (void)
+{
+    m_log_records = 0;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (0, m_queue_count);
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+}
+
+void test_rt_stream_record_too_large (void)
+{
+    m_record_size = PAYLOAD;
+    TEST_ASSERT (RD_ERROR_DATA_SIZE == rt_stream_start (&m_stream, 0, PAYLOAD));
+    TEST_ASSERT_EQUAL (0, m_queue_count);
+    TEST_ASSERT (RD_SUCCESS == rt_stream_on_sent (&m_stream));
+    TEST_ASSERT_EQUAL (0, m_queue_count);
+}
+
+void test_rt_stream_send_error (void)
+{
+    m_send_error = RD_ERROR_INVALID_STATE;
+    TEST_ASSERT (RD_ERROR_INVALID_STATE == rt_stream_start (&m_stream, 0, PAYLOAD));
+    m_send_error = RD_SUCCESS;
+    TEST_ASSERT (RD_SUCCESS == rt_stream_process (&m_stream));
+    channel_run();
+    TEST_ASSERT (rt_stream_is_complete (&m_stream));
+    TEST_ASSERT_EQUAL (LOG_RECORDS, m_received_count);
+}
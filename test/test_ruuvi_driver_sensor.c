@@ -129,6 +129,7 @@ const rd_sensor_t mock_lis2dh12_dev =
     .fifo_enable           = ri_lis2dh12_fifo_use,
     .fifo_interrupt_enable = ri_lis2dh12_fifo_interrupt_use,
     .fifo_read             = ri_lis2dh12_fifo_read,
+    .fifo_block_read       = ri_lis2dh12_fifo_block_read,
     .level_interrupt_set   = ri_lis2dh12_activity_interrupt_use,
     .provides.datas.acceleration_x_g = 1,
     .provides.datas.acceleration_y_g = 1,
@@ -399,6 +400,140 @@ void test_ruuvi_driver_sensor_populate_three_overlap (void)
     TEST_ASSERT (data.timestamp_ms == shtcx_data.timestamp_ms);
 }
 
+void test_ruuvi_driver_sensor_populate_many_priority (void)
+{
+    float values[NUM_FIELDS] = {0};
+    rd_sensor_data_t data = {0};
+    data.data = values;
+    data.fields = all_provided;
+    float bme_values[3] = {0};
+    rd_sensor_data_t bme_data = {0};
+    bme_data.fields = bme280_provided;
+    bme_data.data = bme_values;
+    bme_data.timestamp_ms = 1;
+    mock_bme (&bme_data);
+    float shtcx_values[2] = {0};
+    rd_sensor_data_t shtcx_data = {0};
+    shtcx_data.fields = shtcx_provided;
+    shtcx_data.data = shtcx_values;
+    shtcx_data.timestamp_ms = 2;
+    mock_shtcx (&shtcx_data);
+    float dps_values[2] = {0};
+    rd_sensor_data_t dps_data = {0};
+    dps_data.fields = dps310_provided;
+    dps_data.data = dps_values;
+    dps_data.timestamp_ms = 3;
+    mock_dps310 (&dps_data);
+    float acc_values[4] = {0};
+    rd_sensor_data_t acc_data = {0};
+    acc_data.fields = lis2dh12_provided;
+    acc_data.data = acc_values;
+    acc_data.timestamp_ms = 4;
+    mock_lis2dh12 (&acc_data);
+    // BME280 is general fallback, SHTC humidity and DPS310 pressure take priority.
+    const rd_sensor_data_provider_t providers[] =
+    {
+        {.p_data = &bme_data},
+        {.p_data = &shtcx_data, .preferred = field_humi},
+        {.p_data = NULL},
+        {.p_data = &dps_data, .preferred = field_pres},
+        {.p_data = &acc_data}
+    };
+    rd_sensor_data_populate_many (&data, providers,
+                                  sizeof (providers) / sizeof (providers[0]),
+                                  all_provided);
+    TEST_ASSERT (values[HUMI_INDEX] == shtcx_data.data[0]);
+    TEST_ASSERT (values[PRES_INDEC] == dps_data.data[0]);
+    TEST_ASSERT (values[TEMP_INDEX] == bme_data.data[2]);
+    TEST_ASSERT (values[ACCX_INDEX] == acc_data.data[0]);
+    TEST_ASSERT (values[ACCY_INDEX] == acc_data.data[1]);
+    TEST_ASSERT (values[ACCZ_INDEX] == acc_data.data[2]);
+    TEST_ASSERT (data.timestamp_ms == bme_data.timestamp_ms);
+    // Luminosity is not provided.
+    TEST_ASSERT (!data.valid.datas.luminosity);
+}
+
+void test_ruuvi_driver_sensor_populate_many_matches_populate (void)
+{
+    float values[NUM_FIELDS] = {0};
+    float reference[NUM_FIELDS] = {0};
+    rd_sensor_data_t data = {0};
+    rd_sensor_data_t ref_data = {0};
+    data.data = values;
+    data.fields = all_provided;
+    ref_data.data = reference;
+    ref_data.fields = all_provided;
+    float shtcx_values[2] = {0};
+    rd_sensor_data_t shtcx_data = {0};
+    shtcx_data.fields = shtcx_provided;
+    shtcx_data.data = shtcx_values;
+    shtcx_data.timestamp_ms = 1;
+    mock_shtcx (&shtcx_data);
+    float acc_values[4] = {0};
+    rd_sensor_data_t acc_data = {0};
+    acc_data.fields = lis2dh12_provided;
+    acc_data.data = acc_values;
+    acc_data.timestamp_ms = 2;
+    mock_lis2dh12 (&acc_data);
+    float bme_values[3] = {0};
+    rd_sensor_data_t bme_data = {0};
+    bme_data.fields = bme280_provided;
+    bme_data.data = bme_values;
+    bme_data.timestamp_ms = 3;
+    mock_bme (&bme_data);
+    // Without preferences order of providers is priority, as with populate.
+    const rd_sensor_data_provider_t providers[] =
+    {
+        {.p_data = &shtcx_data},
+        {.p_data = &acc_data},
+        {.p_data = &bme_data}
+    };
+    rd_sensor_data_populate (&ref_data, &shtcx_data, field_temp);
+    rd_sensor_data_populate (&ref_data, &acc_data, field_temp);
+    rd_sensor_data_populate (&ref_data, &bme_data, field_temp);
+    rd_sensor_data_populate_many (&data, providers, 3, field_temp);
+    TEST_ASSERT_EQUAL_MEMORY (reference, values, sizeof (values));
+    TEST_ASSERT (ref_data.valid.bitfield == data.valid.bitfield);
+    TEST_ASSERT (ref_data.timestamp_ms == data.timestamp_ms);
+}
+
+void test_ruuvi_driver_sensor_populate_many_keeps_valid (void)
+{
+    float values[NUM_FIELDS] = {0};
+    rd_sensor_data_t data = {0};
+    data.data = values;
+    data.fields = all_provided;
+    data.timestamp_ms = 10;
+    rd_sensor_data_set (&data, field_humi, 50.0F);
+    float shtcx_values[2] = {0};
+    rd_sensor_data_t shtcx_data = {0};
+    shtcx_data.fields = shtcx_provided;
+    shtcx_data.data = shtcx_values;
+    shtcx_data.timestamp_ms = 1;
+    mock_shtcx (&shtcx_data);
+    const rd_sensor_data_provider_t providers[] =
+    {
+        {.p_data = &shtcx_data, .preferred = field_humi}
+    };
+    rd_sensor_data_populate_many (&data, providers, 1, all_provided);
+    TEST_ASSERT (values[HUMI_INDEX] == 50.0F);
+    TEST_ASSERT (values[TEMP_INDEX] == shtcx_data.data[1]);
+    TEST_ASSERT (data.timestamp_ms == 10);
+}
+
+void test_ruuvi_driver_sensor_populate_many_null (void)
+{
+    float values[NUM_FIELDS] = {0};
+    rd_sensor_data_t data = {0};
+    data.data = values;
+    data.fields = all_provided;
+    const rd_sensor_data_provider_t providers[] = {{.p_data = NULL}};
+    rd_sensor_data_populate_many (NULL, providers, 1, all_provided);
+    rd_sensor_data_populate_many (&data, NULL, 1, all_provided);
+    rd_sensor_data_populate_many (&data, providers, 1, all_provided);
+    TEST_ASSERT (0 == data.valid.bitfield);
+}
+
 /**
  * @brief Parse data from provided struct.
  *
@@ -710,6 +845,61 @@ void test_rd_sensor_is_init_uninit (void)
     TEST_ASSERT (strcmp (mock_lis2dh12_dev.name, not_init.name));
 }
 
+void test_rd_sensor_fifo_block_read_uninit (void)
+{
+    rd_sensor_t not_init;
+    rd_sensor_fifo_block_t block = {0};
+    memcpy (&not_init, &mock_lis2dh12_dev, sizeof (rd_sensor_t));
+    rd_sensor_uninitialize (&not_init);
+    TEST_ASSERT (RD_ERROR_NOT_INITIALIZED == not_init.fifo_block_read (&block));
+}
+
+void test_rd_sensor_measurement_uninit (void)
+{
+    rd_sensor_t not_init;
+    uint64_t ready_ms = 0;
+    memcpy (&not_init, &mock_lis2dh12_dev, sizeof (rd_sensor_t));
+    rd_sensor_uninitialize (&not_init);
+    TEST_ASSERT (RD_ERROR_NOT_INITIALIZED == not_init.measurement_start (&ready_ms));
+    TEST_ASSERT (RD_ERROR_NOT_INITIALIZED == not_init.measurement_complete());
+}
+
+void test_rd_sensor_cost_uninit (void)
+{
+    rd_sensor_t not_init;
+    rd_sensor_configuration_t config = {0};
+    rd_sensor_cost_t cost = {0};
+    memcpy (&not_init, &mock_lis2dh12_dev, sizeof (rd_sensor_t));
+    rd_sensor_uninitialize (&not_init);
+    TEST_ASSERT (RD_ERROR_NOT_INITIALIZED == not_init.cost_get (&config, &cost));
+}
+
+void test_rd_sensor_cost_average_na (void)
+{
+    // 135 uA for 15.5 ms, 150 nA sleep.
+    const rd_sensor_cost_t cost =
+    {
+        .conversion_us = 15500U,
+        .charge_nc = 2093U,
+        .sleep_na = 150U
+    };
+    // 2093 nC / 1 s + 150 nA * 0.9845 s.
+    TEST_ASSERT_EQUAL_UINT32 (2240U, rd_sensor_cost_average_na (&cost, 1000000U));
+    // Back-to-back conversions draw active current.
+    TEST_ASSERT_EQUAL_UINT32 (135032U, rd_sensor_cost_average_na (&cost, 10000U));
+    TEST_ASSERT_EQUAL_UINT32 (0U, rd_sensor_cost_average_na (NULL, 10000U));
+}
+
+void test_rd_sensor_cost_average_na_no_conversion (void)
+{
+    const rd_sensor_cost_t cost =
+    {
+        .sleep_na = 150U
+    };
+    TEST_ASSERT_EQUAL_UINT32 (150U, rd_sensor_cost_average_na (&cost, 0U));
+    TEST_ASSERT_EQUAL_UINT32 (150U, rd_sensor_cost_average_na (&cost, 1000U));
+}
+
 void test_rd_sensor_is_init_not_init (void)
 {
     rd_sensor_t not_init = {0};
@@ -852,9 +1042,49 @@ void test_rd_sensor_field_type_overflow (void)
     TEST_ASSERT (!memcmp (&type, &expected, sizeof (rd_sensor_data_bitfield_t)));
 }
 
+/** Every index of a sparse bitfield, compared to clearing lowest bits one by one. */
+void test_rd_sensor_field_type_sparse (void)
+{
+    float values[32] = {0};
+    rd_sensor_data_t data = {0};
+    data.fields.bitfield = 0xA5C3100FU;
+    data.valid.bitfield = 0x8041000AU;
+    data.data = values;
+    uint32_t remaining = data.fields.bitfield;
+    uint8_t index = 0U;
+
+    while (remaining)
+    {
+        const uint32_t bit = remaining & (~remaining + 1U);
+        rd_sensor_data_fields_t type = {0};
+        type.datas = rd_sensor_field_type (&data, index);
+        TEST_ASSERT_EQUAL_HEX32 (bit, type.bitfield);
+        TEST_ASSERT (rd_sensor_has_valid_data (&data, index) == !! (data.valid.bitfield & bit));
+        rd_sensor_data_set (&data, type, (float) index);
+        TEST_ASSERT_EQUAL_FLOAT ( (float) index, rd_sensor_data_parse (&data, type));
+        TEST_ASSERT_EQUAL_FLOAT ( (float) index, values[index]);
+        remaining &= ~bit;
+        index++;
+    }
+
+    TEST_ASSERT_EQUAL (rd_sensor_data_fieldcount (&data), index);
+}
+
 void test_rd_sensor_field_type_null (void)
 {
     rd_sensor_data_bitfield_t type = rd_sensor_field_type (NULL, 0);
     rd_sensor_data_bitfield_t expected = {0};
     TEST_ASSERT (!memcmp (&type, &expected, sizeof (rd_sensor_data_bitfield_t)));
-}
\ No newline at end of file
+}
+static uint64_t fake_millis (void)
+{
+    return 1000U;
+}
+
+void test_rd_sensor_timestamp_get (void)
+{
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_timestamp_function_set (&fake_millis));
+    TEST_ASSERT (1000U == rd_sensor_timestamp_get());
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_timestamp_function_set (NULL));
+    TEST_ASSERT (RD_UINT64_INVALID == rd_sensor_timestamp_get());
+}
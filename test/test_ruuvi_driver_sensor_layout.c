@@ -0,0 +1,198 @@
+#include "unity.h"
+
+#include "ruuvi_driver_sensor.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file test_ruuvi_driver_sensor_layout.c
+ * @brief Verify and benchmark compiled data layouts against bit counting.
+ */
+
+#define ALL_FIELDS        ((1UL << RD_SENSOR_DATA_FIELD_COUNT) - 1U) //!< Every defined field.
+#define BENCHMARK_ROUNDS  (100000U) //!< Full samples populated in benchmark.
+
+static float m_provided_values[RD_SENSOR_DATA_FIELD_COUNT];
+static float m_target_values[RD_SENSOR_DATA_FIELD_COUNT];
+static rd_sensor_data_t m_provided;
+static rd_sensor_data_t m_target;
+
+static void target_reset (const uint32_t fields)
+{
+    m_target.timestamp_ms = RD_SENSOR_INVALID_TIMSTAMP;
+    m_target.fields.bitfield = fields;
+    m_target.valid.bitfield = 0;
+
+    for (size_t ii = 0; ii < RD_SENSOR_DATA_FIELD_COUNT; ii++)
+    {
+        m_target_values[ii] = RD_FLOAT_INVALID;
+    }
+}
+
+void setUp (void)
+{
+    for (size_t ii = 0; ii < RD_SENSOR_DATA_FIELD_COUNT; ii++)
+    {
+        m_provided_values[ii] = (float) ii + 0.5F;
+    }
+
+    m_provided.timestamp_ms = 1234U;
+    m_provided.fields.bitfield = ALL_FIELDS;
+    m_provided.valid.bitfield = ALL_FIELDS;
+    m_provided.data = m_provided_values;
+    m_target.data = m_target_values;
+    target_reset (ALL_FIELDS);
+}
+
+void tearDown (void)
+{
+}
+
+void test_rd_sensor_data_layout_compile_null (void)
+{
+    rd_sensor_data_fields_t fields = {.bitfield = ALL_FIELDS};
+    TEST_ASSERT (RD_ERROR_NULL == rd_sensor_data_layout_compile (NULL, fields));
+}
+
+void test_rd_sensor_data_layout_compile_reserved (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {.bitfield = (1UL << RD_SENSOR_DATA_FIELD_COUNT)};
+    TEST_ASSERT (RD_ERROR_INVALID_PARAM == rd_sensor_data_layout_compile (&layout, fields));
+}
+
+void test_rd_sensor_data_layout_compile_matches_bitcount (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {0};
+    fields.datas.acceleration_x_g = 1;
+    fields.datas.humidity_rh = 1;
+    fields.datas.pressure_pa = 1;
+    fields.datas.temperature_c = 1;
+    fields.datas.voltage_ratio = 1;
+    rd_sensor_data_t data = {.fields = fields};
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&layout, fields));
+    TEST_ASSERT_EQUAL (rd_sensor_data_fieldcount (&data), layout.count);
+
+    for (uint8_t ii = 0; ii < layout.count; ii++)
+    {
+        rd_sensor_data_fields_t type = {.datas = rd_sensor_field_type (&data, ii)};
+        TEST_ASSERT_EQUAL_HEX32 (type.bitfield, 1UL << layout.bit[ii]);
+        TEST_ASSERT_EQUAL (ii, layout.index[layout.bit[ii]]);
+    }
+
+    TEST_ASSERT_EQUAL (RD_SENSOR_DATA_NO_INDEX, layout.index[1]);
+}
+
+void test_rd_sensor_data_layout_populate_all_fields (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {.bitfield = ALL_FIELDS};
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&layout, fields));
+    rd_sensor_data_layout_populate (&m_target, &layout, &m_provided, &layout, fields);
+    TEST_ASSERT_EQUAL_HEX32 (ALL_FIELDS, m_target.valid.bitfield);
+    TEST_ASSERT_EQUAL (m_provided.timestamp_ms, m_target.timestamp_ms);
+    TEST_ASSERT_EQUAL_MEMORY (m_provided_values, m_target_values, sizeof (m_target_values));
+}
+
+void test_rd_sensor_data_layout_populate_matches_populate (void)
+{
+    rd_sensor_data_layout_t t_layout;
+    rd_sensor_data_layout_t p_layout;
+    float reference[RD_SENSOR_DATA_FIELD_COUNT];
+    // Sparse, partially overlapping target, provided and requested fields.
+    const uint32_t target_fields = 0x2AAAAAU;
+    const rd_sensor_data_fields_t requested = {.bitfield = 0x0F0F0FU};
+    m_provided.fields.bitfield = 0x333333U;
+    m_provided.valid.bitfield = 0x233323U;
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&t_layout,
+                 (rd_sensor_data_fields_t) {.bitfield = target_fields}));
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&p_layout, m_provided.fields));
+    target_reset (target_fields);
+    rd_sensor_data_populate (&m_target, &m_provided, requested);
+    const uint32_t reference_valid = m_target.valid.bitfield;
+    memcpy (reference, m_target_values, sizeof (reference));
+    target_reset (target_fields);
+    rd_sensor_data_layout_populate (&m_target, &t_layout, &m_provided, &p_layout, requested);
+    TEST_ASSERT_EQUAL_HEX32 (reference_valid, m_target.valid.bitfield);
+    TEST_ASSERT_EQUAL_MEMORY (reference, m_target_values, sizeof (reference));
+}
+
+void test_rd_sensor_data_layout_populate_stale_layout (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {.bitfield = ALL_FIELDS};
+    rd_sensor_data_fields_t stale = {.datas.temperature_c = 1};
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&layout, stale));
+    // Layout does not match target, falls back to bit counting.
+    rd_sensor_data_layout_populate (&m_target, &layout, &m_provided, &layout, fields);
+    TEST_ASSERT_EQUAL_HEX32 (ALL_FIELDS, m_target.valid.bitfield);
+    TEST_ASSERT_EQUAL_MEMORY (m_provided_values, m_target_values, sizeof (m_target_values));
+}
+
+void test_rd_sensor_data_layout_populate_null (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {.bitfield = ALL_FIELDS};
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&layout, fields));
+    rd_sensor_data_layout_populate (NULL, &layout, &m_provided, &layout, fields);
+    rd_sensor_data_layout_populate (&m_target, &layout, NULL, &layout, fields);
+    TEST_ASSERT_EQUAL_HEX32 (0, m_target.valid.bitfield);
+}
+
+void test_rd_sensor_data_layout_benchmark (void)
+{
+    rd_sensor_data_layout_t layout;
+    rd_sensor_data_fields_t fields = {.bitfield = ALL_FIELDS};
+    volatile float sink = 0;
+    TEST_ASSERT (RD_SUCCESS == rd_sensor_data_layout_compile (&layout, fields));
+    const clock_t field_start = clock();
+
+    // Field-by-field parse and set, as applications did before bulk populate.
+    for (size_t rounds = 0; rounds < BENCHMARK_ROUNDS; rounds++)
+    {
+        target_reset (ALL_FIELDS);
+
+        for (uint8_t bit = 0; bit < RD_SENSOR_DATA_FIELD_COUNT; bit++)
+        {
+            const rd_sensor_data_fields_t next = {.bitfield = (1UL << bit)};
+            rd_sensor_data_set (&m_target, next, rd_sensor_data_parse (&m_provided, next));
+        }
+
+        sink += m_target_values[rounds % RD_SENSOR_DATA_FIELD_COUNT];
+    }
+
+    const clock_t field_ticks = clock() - field_start;
+    const clock_t populate_start = clock();
+
+    for (size_t rounds = 0; rounds < BENCHMARK_ROUNDS; rounds++)
+    {
+        target_reset (ALL_FIELDS);
+        rd_sensor_data_populate (&m_target, &m_provided, fields);
+        sink += m_target_values[rounds % RD_SENSOR_DATA_FIELD_COUNT];
+    }
+
+    const clock_t populate_ticks = clock() - populate_start;
+    const clock_t layout_start = clock();
+
+    for (size_t rounds = 0; rounds < BENCHMARK_ROUNDS; rounds++)
+    {
+        target_reset (ALL_FIELDS);
+        rd_sensor_data_layout_populate (&m_target, &layout, &m_provided, &layout, fields);
+        sink += m_target_values[rounds % RD_SENSOR_DATA_FIELD_COUNT];
+    }
+
+    const clock_t layout_ticks = clock() - layout_start;
+    TEST_ASSERT_EQUAL_MEMORY (m_provided_values, m_target_values, sizeof (m_target_values));
+    char msg[160];
+    snprintf (msg, sizeof (msg),
+              "%u x %u fields: parse/set %.1f ms, populate %.1f ms, layout populate %.1f ms",
+              BENCHMARK_ROUNDS, RD_SENSOR_DATA_FIELD_COUNT,
+              1000.0 * (double) field_ticks / CLOCKS_PER_SEC,
+              1000.0 * (double) populate_ticks / CLOCKS_PER_SEC,
+              1000.0 * (double) layout_ticks / CLOCKS_PER_SEC);
+    TEST_MESSAGE (msg);
+    (void) sink;
+}